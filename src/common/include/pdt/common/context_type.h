@@ -53,8 +53,11 @@ enum class CONTEXT_TYPE {
   FLANKING_GAP,
   FOUR_ROOMS,
   GOAL_ENCLOSURE,
+  MESH_R3,
+  MESH_SE3,
   NARROW_PASSAGE,
   OBSTACLE_FREE,
+  OCCUPANCY_GRID,
   OPEN_RAVE_MANIPULATOR,
   OPEN_RAVE_R3,
   OPEN_RAVE_R3XSO2,
@@ -66,6 +69,7 @@ enum class CONTEXT_TYPE {
   REPEATING_RECTANGLES,
   SPIRAL,
   START_ENCLOSURE,
+  VOXEL_GRID,
   WALL_GAP,
 };
 
@@ -77,8 +81,11 @@ NLOHMANN_JSON_SERIALIZE_ENUM(
                       {CONTEXT_TYPE::FLANKING_GAP, "FlankingGap"},
                       {CONTEXT_TYPE::FOUR_ROOMS, "FourRooms"},
                       {CONTEXT_TYPE::GOAL_ENCLOSURE, "GoalEnclosure"},
+                      {CONTEXT_TYPE::MESH_R3, "MeshR3"},
+                      {CONTEXT_TYPE::MESH_SE3, "MeshSE3"},
                       {CONTEXT_TYPE::NARROW_PASSAGE, "NarrowPassage"},
                       {CONTEXT_TYPE::OBSTACLE_FREE, "ObstacleFree"},
+                      {CONTEXT_TYPE::OCCUPANCY_GRID, "OccupancyGrid"},
                       {CONTEXT_TYPE::OPEN_RAVE_MANIPULATOR, "OpenRaveManipulator"},
                       {CONTEXT_TYPE::OPEN_RAVE_R3, "OpenRaveR3"},
                       {CONTEXT_TYPE::OPEN_RAVE_R3XSO2, "OpenRaveR3xSO2"},
@@ -90,6 +97,7 @@ NLOHMANN_JSON_SERIALIZE_ENUM(
                       {CONTEXT_TYPE::REPEATING_RECTANGLES, "RepeatingRectangles"},
                       {CONTEXT_TYPE::SPIRAL, "Spiral"},
                       {CONTEXT_TYPE::START_ENCLOSURE, "StartEnclosure"},
+                      {CONTEXT_TYPE::VOXEL_GRID, "VoxelGrid"},
                       {CONTEXT_TYPE::WALL_GAP, "WallGap"},
                   })
 
@@ -39,6 +39,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -95,6 +96,9 @@ class Configuration {
   // information about the state of the working directory and the OMPL seed.
   void registerAsExperiment();
 
+  // Whether the configuration was loaded from an experiment that should be resumed.
+  bool isResuming() const;
+
   // Dump the parameters.
   void dumpAll(std::ostream& out = std::cout) const;
   void dumpAll(const std::string& filename) const;
@@ -141,15 +145,23 @@ class Configuration {
 
   std::string executable_{};
 
+  // Whether this configuration resumes an experiment.
+  bool isResuming_{false};
+
   // All parameters as a big json structure.
   json::json parameters_{};
 
   // The parameters that were actually accessed.
   mutable json::json accessedParameters_{};
+
+  // Guards the parameters, since accessing a parameter registers the access. This allows
+  // experiments to share one configuration among multiple threads.
+  mutable std::recursive_mutex mutex_{};
 };
 
 template <typename T>
 T Configuration::get(const std::string& key) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   return get<T>(key, parameters_, "");
 }
 
@@ -179,6 +191,7 @@ T Configuration::get(const std::string& key, const json::json& parameters,
 
 template <typename T>
 void Configuration::add(const std::string& key, const T& value) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   // We allow overwriting the results/name field of the experiment. Conceptually this seems ok, but
   // from a software architecture standpoint this hints at a flaw. Would it be cleaner to have an
   // "Accessed" element in parameters_ rather than having accessedParameters_?
@@ -186,6 +199,12 @@ void Configuration::add(const std::string& key, const T& value) {
     parameters_["experiment"].erase("results");
   } else if (contains(key) && key == std::string("experiment/name")) {
     parameters_["experiment"].erase("name");
+  } else if (contains(key) && key == std::string("experiment/planners") &&
+             contains("experiment/racing")) {
+    // Racing narrows the planners down to the ones that were not eliminated. All raced planners
+    // are recorded in experiment/racing/planners.
+    parameters_["experiment"].erase("planners");
+    accessedParameters_["experiment"].erase("planners");
   }
   // We should prevent overwriting any other parameter to ensure reproducibility.
   if (contains(key) && get<T>(key) != value) {
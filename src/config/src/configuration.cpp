@@ -63,13 +63,16 @@ Configuration::Configuration(const int argc, const char **argv) :
 }
 
 void Configuration::clear() {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   executable_ = "";
+  isResuming_ = false;
   parameters_.clear();
   accessedParameters_.clear();
 }
 
 // Full namespace on the parameter to keep Doxygen happy
 void Configuration::load(const std::experimental::filesystem::path &config) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   if (!fs::exists(config)) {
     OMPL_ERROR("Cannot find provided configuration file at %s", config.c_str());
     throw std::ios_base::failure("Cannot find config file.");
@@ -166,7 +169,8 @@ void Configuration::load(const int argc, const char **argv) {
   po::options_description availableOptions("Configuration options");
   availableOptions.add_options()("help,h", "Display available options.")(
       "config-patch,c", po::value<std::string>(), "Path to the configuration patch file.")(
-      "path,p", po::value<std::string>(), "Path where the experiments should be stored.");
+      "path,p", po::value<std::string>(), "Path where the experiments should be stored.")(
+      "resume,r", po::value<std::string>(), "Path to the directory of an experiment to resume.");
 
   // Parse the command line arguments to see which options were invoked.
   po::variables_map invokedOptions;
@@ -179,8 +183,15 @@ void Configuration::load(const int argc, const char **argv) {
     std::terminate();
   }
 
-  // If the user does not provide a config file, we should always load the default configs.
-  if (!invokedOptions.count("config-patch")) {
+  // Resuming an experiment loads the config it was started with.
+  if (invokedOptions.count("resume")) {
+    if (invokedOptions.count("config-patch")) {
+      throw std::invalid_argument("Cannot resume an experiment with a different config patch.");
+    }
+    load(fs::path(invokedOptions["resume"].as<std::string>()) / "config.json");
+    isResuming_ = true;
+  } else if (!invokedOptions.count("config-patch")) {
+    // If the user does not provide a config file, we should always load the default configs.
     loadDefaultConfigs();
   } else {
     load(invokedOptions["config-patch"].as<std::string>());
@@ -203,6 +214,7 @@ void Configuration::load(const int argc, const char **argv) {
 }
 
 bool Configuration::contains(const std::string &key) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   return contains(key, parameters_);
 }
 
@@ -225,6 +237,7 @@ bool Configuration::contains(const std::string &key, const json::json &parameter
 }
 
 std::vector<std::string> Configuration::getChildren(const std::string &key) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   if (!contains(key)) {
     auto msg = "Requested children of nonexisting parameter '"s + key + "'.";
     throw std::invalid_argument(msg);
@@ -262,6 +275,7 @@ std::vector<std::string> Configuration::getChildren(const std::string &key,
 }
 
 std::string Configuration::dump(const std::string &key) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   if (!contains(key)) {
     auto msg = "Requested to dump nonexisting parameter '"s + key + "'.";
     throw std::invalid_argument(msg);
@@ -288,6 +302,7 @@ std::string Configuration::dump(const std::string &key, const json::json &parame
 }
 
 void Configuration::dumpAll(std::ostream &out) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   out << parameters_.dump(2) << '\n';
 }
 
@@ -309,6 +324,7 @@ void Configuration::dumpAll(const std::string &filename) const {
 }
 
 void Configuration::dumpAccessed(std::ostream &out) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   out << accessedParameters_.dump(2) << '\n';
 }
 
@@ -654,6 +670,7 @@ std::pair<const std::string, const std::string> Configuration::split(
 }
 
 void Configuration::registerAsExperiment() {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   // Check the status of the working directory.
   if (Version::GIT_STATUS == "DIRTY"s) {
     OMPL_WARN("Working directory is dirty.");
@@ -706,6 +723,10 @@ void Configuration::registerAsExperiment() {
   handleSeedSpecification();
 }
 
+bool Configuration::isResuming() const {
+  return isResuming_;
+}
+
 void Configuration::handleSeedSpecification() {
   if (parameters_["experiment"].contains("seed")) {
     auto seed = parameters_["experiment"]["seed"].get<unsigned long>();
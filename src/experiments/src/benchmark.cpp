@@ -35,10 +35,19 @@
 
 // Authors: Marlin Strub
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
 #include <functional>
 #include <future>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <thread>
 #include <tuple>
 #include <vector>
@@ -46,20 +55,38 @@
 #include <experimental/filesystem>
 
 #include <ompl/base/PlannerTerminationCondition.h>
+#include <ompl/base/ProblemDefinition.h>
+#include <ompl/base/ScopedState.h>
+#include <ompl/base/goals/GoalState.h>
+#include <ompl/base/goals/GoalStates.h>
 #include <ompl/geometric/planners/rrt/RRTConnect.h>
 #include <ompl/util/Console.h>
+#include <ompl/util/RandomNumbers.h>
 
 #include "pdt/config/configuration.h"
 #include "pdt/factories/context_factory.h"
 #include "pdt/factories/planner_factory.h"
+#include "pdt/loggers/binary_results.h"
+#include "pdt/loggers/experiment_journal.h"
+#include "pdt/loggers/memory_usage.h"
 #include "pdt/loggers/performance_loggers.h"
+#include "pdt/loggers/results_reader.h"
 #include "pdt/planning_contexts/all_contexts.h"
 #include "pdt/reports/multiquery_report.h"
 #include "pdt/reports/single_query_report.h"
 #include "pdt/statistics/planning_statistics.h"
+#include "pdt/statistics/rank_sum_test.h"
 #include "pdt/time/CumulativeTimer.h"
 #include "pdt/time/time.h"
+#include "pdt/utilities/call_counter.h"
 #include "pdt/utilities/get_best_cost.h"
+#include "pdt/utilities/memory_usage.h"
+#include "pdt/utilities/reports_intermediate_solutions.h"
+#include "pdt/utilities/thread_affinity.h"
+
+#ifdef PDT_COUNT_ALLOCATIONS
+#include "pdt/utilities/allocation_counter.h"
+#endif
 
 using namespace std::string_literals;
 namespace fs = std::experimental::filesystem;
@@ -166,6 +193,599 @@ bool checkContextValidity(const std::shared_ptr<pdt::config::Configuration> &con
   return true;
 }
 
+// The cores a benchmark worker is pinned to. The planner solves on one core while its cost is
+// sampled on its hyperthread sibling.
+struct CoreAssignment {
+  std::size_t solver{0u};
+  std::size_t sampler{0u};
+};
+
+// The cost logs of one planner that solved all queries of a context, and its memory usage on each
+// query if memory is profiled.
+struct PlannerRun {
+  std::string plannerName{};
+  std::vector<pdt::loggers::TimeCostLogger> loggers{};
+  std::vector<pdt::loggers::MemoryUsage> memoryUsages{};
+};
+
+// The memory usage of this process at a point in time.
+struct MemorySnapshot {
+  std::size_t residentSetSize{0u};
+  std::size_t numAllocations{0u};
+  std::size_t numAllocatedBytes{0u};
+};
+
+// Function to print the progress bar of the benchmark.
+void printProgress(const std::size_t currentRun, const std::size_t totalNumberOfRuns,
+                   const std::chrono::system_clock::time_point &experimentStartTime) {
+  if (currentRun == 0u) {
+    return;
+  }
+
+  // Compute the progress.
+  const auto progress = static_cast<float>(currentRun) / static_cast<float>(totalNumberOfRuns);
+
+  // estimate how much time is left by extrapolating from the time spent so far.
+  // This is more accurate than subtracting the time used so far from the worst case total
+  // time since it can take planners that terminate early into account.
+  const auto timeSoFar = std::chrono::system_clock::now() - experimentStartTime;
+  const auto extrapolatedRuntime = timeSoFar / progress;
+  const auto estimatedTimeString =
+      " (est. time left: "s +
+      pdt::time::toDurationString(
+          std::chrono::ceil<std::chrono::seconds>(extrapolatedRuntime - timeSoFar)) +
+      ")"s;
+
+  std::cout << '\r' << std::setw(2) << std::setfill(' ') << std::right << ' ' << "Progress"
+            << (std::ceil(progress * barWidth) != barWidth
+                    ? std::setw(static_cast<int>(std::ceil(progress * barWidth)))
+                    : std::setw(static_cast<int>(std::ceil(progress * barWidth) - 1u)))
+            << std::setfill('.') << (currentRun != totalNumberOfRuns ? '|' : '.') << std::right
+            << std::setw(barWidth - static_cast<int>(std::ceil(progress * barWidth)))
+            << std::setfill('.') << '.' << std::right << std::fixed << std::setw(6)
+            << std::setfill(' ') << std::setprecision(2) << progress * 100.0f << " %";
+  if (currentRun != totalNumberOfRuns) {
+    std::cout << estimatedTimeString;
+  } else {
+    std::cout << std::setfill(' ') << std::setw(static_cast<int>(estimatedTimeString.length()))
+              << " ";
+  }
+  std::cout << std::flush;
+}
+
+// Function to reset OMPL's global seed generator, from which contexts, planners and samplers draw
+// the seeds of their random number generators.
+void resetSeedGenerator(std::uint_fast32_t seed) {
+  // Resetting the seed generator is intended here, so silence OMPL's warning about it.
+  const auto logLevel = ompl::msg::getLogLevel();
+  ompl::msg::setLogLevel(ompl::msg::LogLevel::LOG_NONE);
+  ompl::RNG::setSeed(seed);
+  ompl::msg::setLogLevel(logLevel);
+}
+
+// Function to create another instance of the experiment's context, e.g., for a worker thread.
+// Contexts with randomly generated obstacles or queries draw their seeds from OMPL's global seed
+// generator, which is reset to the experiment seed such that all instances are identical.
+std::shared_ptr<pdt::planning_contexts::BaseContext> createContextInstance(
+    const pdt::factories::ContextFactory &contextFactory, const std::string &contextName) {
+  resetSeedGenerator(ompl::RNG::getSeed());
+  return contextFactory.create(contextName);
+}
+
+// Function to compute the seed of a (run, planner) job from the seed of the experiment. The seed
+// generator is reset to it before the planner of the job is allocated, such that every job draws
+// its own random numbers, also if it is run by a resumed experiment.
+std::uint_fast32_t computeJobSeed(std::size_t experimentSeed, std::size_t run,
+                                  const std::string &plannerName) {
+  // FNV-1a, like the hash of context snapshots, which is the same in every build.
+  std::uint64_t hash = 14695981039346656037u;
+  const auto job = std::to_string(experimentSeed) + '/' + std::to_string(run) + '/' + plannerName;
+  for (const auto character : job) {
+    hash ^= static_cast<unsigned char>(character);
+    hash *= 1099511628211u;
+  }
+
+  // OMPL does not accept a seed of zero.
+  const auto seed = static_cast<std::uint32_t>(hash ^ (hash >> 32u));
+  return seed != 0u ? seed : 1u;
+}
+
+// Workers that run jobs in parallel share the seed generator, so they reset it and allocate their
+// planners one at a time.
+std::mutex seedGeneratorMutex;
+
+// Function to convert the queries of a context to the real values of their start and goal states,
+// such that they can be recorded in the journal.
+std::vector<pdt::loggers::JournaledQuery> getJournaledQueries(
+    const std::shared_ptr<pdt::planning_contexts::BaseContext> &context) {
+  const auto space = context->getStateSpace();
+  auto toReals = [&space](const ompl::base::State *state) {
+    std::vector<double> reals;
+    space->copyToReals(reals, state);
+    return reals;
+  };
+  std::vector<pdt::loggers::JournaledQuery> queries;
+  for (std::size_t n = 0u; n < context->getNumQueries(); ++n) {
+    const auto pair = context->getNthStartGoalPair(n);
+    pdt::loggers::JournaledQuery query;
+    for (const auto &start : pair.start) {
+      query.starts.push_back(toReals(start.get()));
+    }
+    if (auto goal = std::dynamic_pointer_cast<ompl::base::GoalState>(pair.goal)) {
+      query.goals.push_back(toReals(goal->getState()));
+    } else if (auto goals = std::dynamic_pointer_cast<ompl::base::GoalStates>(pair.goal)) {
+      for (std::size_t i = 0u; i < goals->getStateCount(); ++i) {
+        query.goals.push_back(toReals(goals->getState(i)));
+      }
+    }
+    queries.push_back(query);
+  }
+  return queries;
+}
+
+// Function to replace the queries of a context with queries from the journal. The goals are of the
+// same type as the goals they replace, and goals that are not made of states are created anew.
+void setJournaledQueries(const std::shared_ptr<pdt::planning_contexts::BaseContext> &context,
+                         const std::vector<pdt::loggers::JournaledQuery> &queries) {
+  if (queries.size() != context->getNumQueries()) {
+    throw std::runtime_error("The journaled queries do not match the queries of the context.");
+  }
+  const auto spaceInfo = context->getSpaceInformation();
+  auto toState = [&spaceInfo](const std::vector<double> &reals) {
+    ompl::base::ScopedState<> state(spaceInfo);
+    state = reals;
+    return state;
+  };
+  std::vector<pdt::planning_contexts::StartGoalPair> pairs;
+  for (std::size_t n = 0u; n < queries.size(); ++n) {
+    pdt::planning_contexts::StartGoalPair pair;
+    for (const auto &start : queries[n].starts) {
+      pair.start.push_back(toState(start));
+    }
+    const auto previousGoal = context->getNthStartGoalPair(n).goal;
+    if (queries[n].goals.empty()) {
+      pair.goal = context->createGoal();
+    } else if (std::dynamic_pointer_cast<ompl::base::GoalState>(previousGoal)) {
+      auto goal = std::make_shared<ompl::base::GoalState>(spaceInfo);
+      goal->setState(toState(queries[n].goals.front()));
+      pair.goal = goal;
+    } else {
+      auto goal = std::make_shared<ompl::base::GoalStates>(spaceInfo);
+      for (const auto &reals : queries[n].goals) {
+        goal->addState(toState(reals));
+      }
+      pair.goal = goal;
+    }
+    pairs.push_back(pair);
+  }
+  context->setStartGoalPairs(pairs);
+}
+
+// Function to take a snapshot of the call counters of an instrumented context.
+pdt::loggers::CallCounts sampleCallCounters(const pdt::utilities::CallCounters &counters) {
+  pdt::loggers::CallCounts counts;
+  counts.isValid = {counters.isValid.getNumCalls(), counters.isValid.getDuration()};
+  counts.clearance = {counters.clearance.getNumCalls(), counters.clearance.getDuration()};
+  counts.checkMotion = {counters.checkMotion.getNumCalls(), counters.checkMotion.getDuration()};
+  counts.motionCost = {counters.motionCost.getNumCalls(), counters.motionCost.getDuration()};
+  return counts;
+}
+
+// Function to take a snapshot of the memory usage. This also resets the peak resident set size,
+// such that the peak of the following query can be measured.
+MemorySnapshot takeMemorySnapshot() {
+  MemorySnapshot snapshot;
+  pdt::utilities::resetPeakResidentSetSize();
+  snapshot.residentSetSize = pdt::utilities::getResidentSetSize();
+#ifdef PDT_COUNT_ALLOCATIONS
+  snapshot.numAllocations = pdt::utilities::getNumAllocations();
+  snapshot.numAllocatedBytes = pdt::utilities::getNumAllocatedBytes();
+#endif
+  return snapshot;
+}
+
+// Function to compute the memory usage since a snapshot was taken.
+pdt::loggers::MemoryUsage computeMemoryUsage(const MemorySnapshot &start) {
+  pdt::loggers::MemoryUsage usage;
+  usage.residentSetSizeDelta =
+      static_cast<std::int64_t>(pdt::utilities::getResidentSetSize()) -
+      static_cast<std::int64_t>(start.residentSetSize);
+  usage.peakResidentSetSize = pdt::utilities::getPeakResidentSetSize();
+#ifdef PDT_COUNT_ALLOCATIONS
+  usage.numAllocations = pdt::utilities::getNumAllocations() - start.numAllocations;
+  usage.numAllocatedBytes = pdt::utilities::getNumAllocatedBytes() - start.numAllocatedBytes;
+#endif
+  return usage;
+}
+
+// Function to run a planner on all queries of a context. If queries are defined (i.e. we evaluate
+// a multiquery setting), the planner runs _all_ queries before it is destroyed. The seed generator
+// is reset to the given seed before the planner is allocated. The callback is invoked after each
+// query.
+PlannerRun runPlanner(const std::shared_ptr<pdt::config::Configuration> &config,
+                      const std::shared_ptr<pdt::planning_contexts::BaseContext> &context,
+                      const pdt::factories::PlannerFactory &plannerFactory,
+                      const std::string &plannerName, std::uint_fast32_t seed,
+                      const std::optional<CoreAssignment> &cores,
+                      const std::function<void()> &queryDone) {
+  // Whether the memory usage of the planner is measured on every query.
+  const bool profileMemory = config->contains("experiment/memoryProfiling") &&
+                             config->get<bool>("experiment/memoryProfiling");
+
+  // Whether cost changes are logged when planners report them instead of polling the cost.
+  const bool eventDrivenLogging = config->contains("experiment/eventDrivenLogging") &&
+                                  config->get<bool>("experiment/eventDrivenLogging");
+
+  // The cost is sampled on the calling thread.
+  if (cores) {
+    pdt::utilities::pinCurrentThreadToCore(cores->sampler);
+  }
+
+  // Reset the seed generator to the seed of this job and hold it until the planner is allocated.
+  // Samplers that the planner allocates while it solves draw their seeds later, which in parallel
+  // experiments can interleave with the jobs of other workers.
+  std::unique_lock<std::mutex> seedGeneratorLock(seedGeneratorMutex);
+  resetSeedGenerator(seed);
+
+  // Allocate and run a dummy planner before allocating the actual planner.
+  // This results in more consistent measurements. I don't fully understand why, but it
+  // seems to be connected to running the planner in a separate thread.
+  {
+    auto reconciler = std::make_shared<ompl::geometric::RRTConnect>(context->getSpaceInformation());
+    reconciler->setName("ReconcilingPlanner");
+    reconciler->setProblemDefinition(context->instantiateNewProblemDefinition());
+    auto hotpath = std::async(std::launch::async, [&reconciler, &cores]() {
+      if (cores) {
+        pdt::utilities::pinCurrentThreadToCore(cores->solver);
+      }
+      reconciler->solve(ompl::base::timedPlannerTerminationCondition(0.0));
+    });
+    hotpath.get();
+  }
+
+  // Allocate the planner to be tested.
+  MemorySnapshot memorySnapshot;
+  if (profileMemory) {
+    memorySnapshot = takeMemorySnapshot();
+  }
+  std::shared_ptr<ompl::base::Planner> planner;
+  pdt::common::PLANNER_TYPE plannerType;
+  pdt::time::Duration factoryDuration;
+  std::tie(planner, plannerType, factoryDuration) = plannerFactory.create(plannerName);
+  seedGeneratorLock.unlock();
+
+  // The call counters are only available if the context is instrumented.
+  const auto counters = context->getCallCounters();
+
+  PlannerRun result;
+  const std::size_t numQueries = context->getNumQueries();
+  result.loggers.reserve(numQueries);
+  for (auto j = 0u; j < numQueries; ++j) {
+    pdt::time::CumulativeTimer configTimer;
+    // Create the logger for this run.
+    pdt::loggers::TimeCostLogger logger(context->getMaxSolveDuration(),
+                                        config->get<double>("experiment/logFrequency"));
+
+    // Count the calls of this query only, including the ones made while setting up the planner.
+    if (counters) {
+      counters->reset();
+    }
+
+    // Measure the memory usage of this query. The first query includes the memory used to allocate
+    // the planner.
+    if (profileMemory && j != 0u) {
+      memorySnapshot = takeMemorySnapshot();
+    }
+
+    // Prepare the planner for this query.
+    pdt::time::Duration querySetupDuration = std::chrono::seconds{0};
+    if (j == 0) {
+      // The PlannerFactory starts the planner with the 0th query.
+      // Set the planner up.
+      configTimer.start();
+      planner->setup();
+      configTimer.stop();
+
+      // Time is construction (from PlannerFactory) and setup.
+      querySetupDuration = factoryDuration + configTimer.duration();
+    } else {
+      // Clear the current query
+      configTimer.start();
+      planner->clearQuery();
+      configTimer.stop();
+
+      // get the problem setting for the nth query
+      const auto problemDefinition = context->instantiateNthProblemDefinition(j);
+
+      // Give it to the current planner
+      configTimer.start();
+      planner->setProblemDefinition(problemDefinition);
+      configTimer.stop();
+
+      // Time is just setup as constructed for previous query.
+      querySetupDuration = configTimer.duration();
+    }
+
+    // Compute the duration we have left for solving.
+    const auto maxSolveDuration =
+        pdt::time::seconds(context->getMaxSolveDuration() - querySetupDuration);
+    const std::chrono::microseconds idle(1000000u /
+                                         config->get<std::size_t>("experiment/logFrequency"));
+
+    // Planners that report their intermediate solutions can log cost changes exactly when they
+    // happen. All other planners are polled at the log frequency.
+    const auto problem = planner->getProblemDefinition();
+    const bool logCostChanges =
+        eventDrivenLogging && pdt::utilities::reportsIntermediateSolutions(plannerType);
+
+    // Solve the problem on a separate thread.
+    pdt::time::Clock::time_point addMeasurementStart;
+    const auto solveStartTime = pdt::time::Clock::now();
+    if (logCostChanges) {
+      logger.addMeasurement(querySetupDuration, pdt::utilities::getBestCost(planner, plannerType));
+      if (counters) {
+        logger.addCallCounts(querySetupDuration, sampleCallCounters(*counters));
+      }
+      problem->setIntermediateSolutionCallback(
+          [&logger, &counters, &querySetupDuration, &solveStartTime, &maxSolveDuration](
+              const ompl::base::Planner * /*planner*/,
+              const std::vector<const ompl::base::State *> & /*states*/,
+              const ompl::base::Cost cost) {
+            const auto elapsed = pdt::time::Clock::now() - solveStartTime;
+            if (pdt::time::seconds(elapsed) <= maxSolveDuration) {
+              logger.addCostChange(querySetupDuration + elapsed, cost);
+              if (counters) {
+                logger.addCallCounts(querySetupDuration + elapsed, sampleCallCounters(*counters));
+              }
+            }
+          });
+    }
+    std::future<void> future =
+        std::async(std::launch::async, [&planner, &maxSolveDuration, &cores]() {
+          if (cores) {
+            pdt::utilities::pinCurrentThreadToCore(cores->solver);
+          }
+          planner->solve(maxSolveDuration);
+        });
+
+    if (logCostChanges) {
+      // The cost changes are logged by the callback on the solving thread.
+      future.wait();
+    } else {
+      // Log the intermediate best costs.
+      do {
+        addMeasurementStart = pdt::time::Clock::now();
+        logger.addMeasurement(querySetupDuration + (addMeasurementStart - solveStartTime),
+                              pdt::utilities::getBestCost(planner, plannerType));
+        if (counters) {
+          logger.addCallCounts(querySetupDuration + (addMeasurementStart - solveStartTime),
+                               sampleCallCounters(*counters));
+        }
+
+        // Stop logging intermediate best costs if the planner overshoots.
+        if (pdt::time::seconds(addMeasurementStart - solveStartTime) > maxSolveDuration) {
+          break;
+        }
+      } while (future.wait_until(addMeasurementStart + idle) != std::future_status::ready);
+
+      // Wait until the planner returns.
+      OMPL_DEBUG(
+          "Stopped logging results for planner '%s' because it overshot the termination "
+          "condition.",
+          plannerName.c_str());
+    }
+    future.get();
+
+    // The callback refers to this query's logger.
+    if (logCostChanges) {
+      problem->setIntermediateSolutionCallback(ompl::base::ReportIntermediateSolutionFn());
+    }
+
+    // Get the final runtime.
+    const auto totalDuration = querySetupDuration + (pdt::time::Clock::now() - solveStartTime);
+
+    // Sample the call counters before computing the final cost, which calls the objective.
+    if (counters) {
+      logger.addCallCounts(totalDuration, sampleCallCounters(*counters));
+    }
+
+    // The planner keeps its memory until it is destroyed, so this measures what it accumulated.
+    if (profileMemory) {
+      result.memoryUsages.push_back(computeMemoryUsage(memorySnapshot));
+    }
+
+    // Store the final cost.
+    if (problem->hasExactSolution()) {
+      logger.addMeasurement(totalDuration,
+                            problem->getSolutionPath()->cost(context->getObjective()));
+    } else {
+      logger.addMeasurement(totalDuration,
+                            ompl::base::Cost(context->getObjective()->infiniteCost()));
+    }
+
+    // Anytime planners can stop early, e.g. if they know that they found the optimal solution.
+    // Thus, we need to add an additional final measurement point at the maximum runtime.
+    const auto maxRunDuration = context->getMaxSolveDuration();
+    if (totalDuration < maxRunDuration) {
+      if (problem->hasExactSolution()) {
+        logger.addMeasurement(maxRunDuration,
+                              problem->getSolutionPath()->cost(context->getObjective()));
+      } else {
+        logger.addMeasurement(maxRunDuration,
+                              ompl::base::Cost(context->getObjective()->infiniteCost()));
+      }
+    }
+
+    // Keep this run for the log.
+    result.loggers.push_back(std::move(logger));
+    queryDone();
+  }
+  result.plannerName = planner->getName();
+
+  return result;
+}
+
+// Function to add the logs of a planner to the results files, one file per query. The call counts
+// of instrumented contexts are added to separate csv files, one file per query. All files are
+// synced to disk, such that the run can be journaled afterwards.
+void logPlannerRun(const std::vector<std::string> &resultPaths,
+                   const std::vector<std::string> &callCountsPaths,
+                   const std::vector<std::string> &memoryUsagePaths, const PlannerRun &run,
+                   const bool append) {
+  for (auto j = 0u; j < resultPaths.size(); ++j) {
+    pdt::loggers::ResultLog<pdt::loggers::TimeCostLogger> results(resultPaths[j], append);
+    results.addResult(run.plannerName, run.loggers.at(j));
+  }
+  for (auto j = 0u; j < callCountsPaths.size(); ++j) {
+    std::ofstream file(callCountsPaths[j], append ? std::ofstream::app : std::ofstream::trunc);
+    file << run.loggers.at(j).createCallCountsLogString(run.plannerName);
+    file.close();
+    if (!file) {
+      throw std::ios_base::failure("Could not write call counts to "s + callCountsPaths[j] + "."s);
+    }
+    pdt::loggers::syncFile(callCountsPaths[j]);
+  }
+  for (auto j = 0u; j < memoryUsagePaths.size(); ++j) {
+    std::ofstream file(memoryUsagePaths[j], append ? std::ofstream::app : std::ofstream::trunc);
+    file << pdt::loggers::createMemoryUsageLogString(run.plannerName, run.memoryUsages.at(j));
+    file.close();
+    if (!file) {
+      throw std::ios_base::failure("Could not write memory usage to "s + memoryUsagePaths[j] +
+                                   "."s);
+    }
+    pdt::loggers::syncFile(memoryUsagePaths[j]);
+  }
+}
+
+// The initial solution durations and final costs of the runs of a planner on a query.
+struct RunSummaries {
+  std::vector<double> initialSolutionDurations{};
+  std::vector<double> finalCosts{};
+};
+
+// Adds the summary of a run, given its logged durations and costs.
+void addRunSummary(RunSummaries *summaries, const double *durations, const double *costs,
+                   const std::size_t numMeasurements) {
+  auto initialSolutionDuration = std::numeric_limits<double>::infinity();
+  for (auto i = 0u; i < numMeasurements; ++i) {
+    if (costs[i] < std::numeric_limits<double>::infinity()) {
+      initialSolutionDuration = durations[i];
+      break;
+    }
+  }
+  summaries->initialSolutionDurations.push_back(initialSolutionDuration);
+  summaries->finalCosts.push_back(numMeasurements == 0u ? std::numeric_limits<double>::infinity()
+                                                        : costs[numMeasurements - 1u]);
+}
+
+// Adds the summaries of a planner run on all queries.
+void addRunSummaries(std::map<std::string, std::vector<RunSummaries>> *summaries,
+                     const PlannerRun &run) {
+  auto &plannerSummaries = (*summaries)[run.plannerName];
+  plannerSummaries.resize(run.loggers.size());
+  for (auto j = 0u; j < run.loggers.size(); ++j) {
+    const auto &durations = run.loggers[j].getDurations();
+    const auto &costs = run.loggers[j].getCosts();
+    addRunSummary(&plannerSummaries[j], durations.data(), costs.data(),
+                  std::min(durations.size(), costs.size()));
+  }
+}
+
+// Loads the summaries of all runs that have been logged to the results.
+std::map<std::string, std::vector<RunSummaries>> loadRunSummaries(
+    const std::vector<std::string> &resultPaths) {
+  std::map<std::string, std::vector<RunSummaries>> summaries;
+  for (auto j = 0u; j < resultPaths.size(); ++j) {
+    if (!fs::exists(resultPaths[j])) {
+      continue;
+    }
+    const pdt::loggers::ResultsReader reader(resultPaths[j]);
+    for (std::size_t i = 0u; i < reader.getNumRuns(); ++i) {
+      auto &plannerSummaries = summaries[reader.getPlannerName(i)];
+      plannerSummaries.resize(resultPaths.size());
+      addRunSummary(&plannerSummaries[j], reader.getDurations(i), reader.getCosts(i),
+                    reader.getNumMeasurements(i));
+    }
+  }
+  return summaries;
+}
+
+// Finds the contenders that are dominated by another contender in the first runs. A planner
+// dominates another if it is significantly better in final cost or initial solution duration on
+// at least one query, and significantly worse in neither on any query.
+std::vector<std::string> findDominatedPlanners(
+    const std::vector<std::string> &contenders,
+    const std::map<std::string, std::vector<RunSummaries>> &summaries, const std::size_t numRuns,
+    const double significanceLevel) {
+  // Tests whether the values of the first runs of one planner tend to be smaller than the ones of
+  // another planner.
+  auto isSignificantlySmaller = [numRuns, significanceLevel](const std::vector<double> &values,
+                                                             const std::vector<double> &others) {
+    if (values.size() < numRuns || others.size() < numRuns) {
+      throw std::runtime_error("Cannot race planners with missing runs.");
+    }
+    const auto end = static_cast<std::vector<double>::difference_type>(numRuns);
+    return pdt::statistics::computeRankSumPValue(
+               std::vector<double>(values.begin(), values.begin() + end),
+               std::vector<double>(others.begin(), others.begin() + end)) < significanceLevel;
+  };
+
+  std::vector<std::string> dominated;
+  for (const auto &plannerName : contenders) {
+    for (const auto &otherName : contenders) {
+      if (otherName == plannerName) {
+        continue;
+      }
+      const auto &planner = summaries.at(plannerName);
+      const auto &other = summaries.at(otherName);
+      bool isOtherBetter = false;
+      bool isOtherWorse = false;
+      for (auto j = 0u; j < planner.size(); ++j) {
+        isOtherBetter = isOtherBetter ||
+                        isSignificantlySmaller(other[j].finalCosts, planner[j].finalCosts) ||
+                        isSignificantlySmaller(other[j].initialSolutionDurations,
+                                               planner[j].initialSolutionDurations);
+        isOtherWorse = isOtherWorse ||
+                       isSignificantlySmaller(planner[j].finalCosts, other[j].finalCosts) ||
+                       isSignificantlySmaller(planner[j].initialSolutionDurations,
+                                              other[j].initialSolutionDurations);
+      }
+      if (isOtherBetter && !isOtherWorse) {
+        dominated.push_back(plannerName);
+        break;
+      }
+    }
+  }
+
+  // Without a winner, the race continues with all contenders.
+  if (dominated.size() == contenders.size()) {
+    dominated.clear();
+  }
+  return dominated;
+}
+
+// Computes the largest width of the confidence intervals about the median initial solution
+// durations and the median final costs of all planners on all queries, relative to the medians.
+// Also returns the confidence these intervals achieve with the current number of runs.
+std::pair<double, double> computeMedianIntervalWidth(
+    const std::shared_ptr<pdt::config::Configuration> &config,
+    const std::vector<std::string> &resultPaths, const double confidence) {
+  double maxRelativeWidth = 0.0;
+  double achievedConfidence = 1.0;
+  for (const auto &path : resultPaths) {
+    pdt::statistics::PlanningStatistics stats(config, path, true);
+    for (const auto &plannerName : config->get<std::vector<std::string>>("experiment/planners")) {
+      maxRelativeWidth = std::max(
+          {maxRelativeWidth,
+           stats.getMedianInitialSolutionDurationRelativeIntervalWidth(plannerName, confidence),
+           stats.getMedianFinalCostRelativeIntervalWidth(plannerName, confidence)});
+    }
+    achievedConfidence =
+        std::min(achievedConfidence, stats.getMedianIntervalConfidence(confidence));
+  }
+  return {maxRelativeWidth, achievedConfidence};
+}
+
 int main(const int argc, const char **argv) {
   // Read the config files.
   auto config = std::make_shared<pdt::config::Configuration>(argc, argv);
@@ -184,10 +804,66 @@ int main(const int argc, const char **argv) {
   // Create a planner factory for planners in this context.
   pdt::factories::PlannerFactory plannerFactory(config, context);
 
+  // Determine how many planners run in parallel. Each worker occupies a pair of hyperthread
+  // siblings, one on which the planner solves and one on which its cost is sampled, such that the
+  // sampler does not compete with another worker for a physical core. A parallelism of zero uses
+  // all cores.
+  const auto corePairs = pdt::utilities::getSiblingCorePairs();
+  std::size_t numWorkers = 1u;
+  if (config->contains("experiment/parallelism")) {
+    numWorkers = config->get<std::size_t>("experiment/parallelism");
+    if (numWorkers == 0u) {
+      numWorkers = std::max<std::size_t>(1u, corePairs.size());
+    }
+  }
+  if (numWorkers > 1u && config->contains("experiment/regenerateQueries") &&
+      config->get<bool>("experiment/regenerateQueries")) {
+    throw std::invalid_argument(
+        "Regenerating queries is not supported when running planners in parallel.");
+  }
+  if (numWorkers > 1u && config->contains("experiment/memoryProfiling") &&
+      config->get<bool>("experiment/memoryProfiling")) {
+    throw std::invalid_argument(
+        "Memory profiling is not supported when running planners in parallel, as the memory usage "
+        "is measured for the whole process.");
+  }
+  if (numWorkers > corePairs.size()) {
+    OMPL_WARN("Running %zu workers on %zu cores. Workers will share cores.", numWorkers,
+              pdt::utilities::getNumAvailableCores());
+  }
+
+  // With sequential stopping, runs are added until the confidence intervals about the median
+  // initial solution durations and the median final costs are narrow enough. The configured number
+  // of runs is then the minimum number of runs.
+  const bool isStoppingSequentially = config->contains("experiment/sequentialStopping");
+  std::size_t minNumRuns = config->get<std::size_t>("experiment/numRuns");
+  std::size_t maxNumRuns = minNumRuns;
+  std::size_t numRunsPerCheck = 1u;
+  if (isStoppingSequentially) {
+    maxNumRuns = std::max(minNumRuns,
+                          config->get<std::size_t>("experiment/sequentialStopping/maxNumRuns"));
+    numRunsPerCheck = std::max<std::size_t>(
+        1u, config->get<std::size_t>("experiment/sequentialStopping/numRunsPerCheck"));
+  }
+
+  // When racing, planners that are dominated by another planner are eliminated after every round,
+  // such that only the contenders are run up to the configured number of runs.
+  const bool isRacing = config->contains("experiment/racing");
+  if (isRacing) {
+    if (isStoppingSequentially) {
+      throw std::invalid_argument("Racing cannot be combined with sequential stopping.");
+    }
+    minNumRuns = std::clamp<std::size_t>(config->get<std::size_t>("experiment/racing/minNumRuns"),
+                                         1u, maxNumRuns);
+    numRunsPerCheck = std::max<std::size_t>(
+        1u, config->get<std::size_t>("experiment/racing/numRunsPerRound"));
+  }
+
   // Print some basic info about this benchmark.
   auto estimatedRuntime = config->get<std::size_t>("experiment/numRuns") *
                           config->get<std::vector<std::string>>("experiment/planners").size() *
-                          context->getMaxSolveDuration() * numQueries;
+                          context->getMaxSolveDuration() * numQueries /
+                          static_cast<double>(numWorkers);
   auto estimatedDoneBy =
       pdt::time::toDateString(std::chrono::time_point_cast<std::chrono::nanoseconds>(
           std::chrono::time_point_cast<pdt::time::Duration>(experimentStartTime) +
@@ -199,12 +875,39 @@ int main(const int argc, const char **argv) {
   std::cout << std::setw(2) << std::setfill(' ') << ' ' << std::left << std::setw(30)
             << std::setfill('.') << "Number of runs per planner" << std::setw(20) << std::right
             << config->get<std::size_t>("experiment/numRuns") << '\n';
+  if (isStoppingSequentially) {
+    std::cout << std::setw(2) << std::setfill(' ') << ' ' << std::left << std::setw(30)
+              << std::setfill('.') << "Maximum number of runs" << std::setw(20) << std::right
+              << maxNumRuns << '\n';
+    std::cout << std::setw(2) << std::setfill(' ') << ' ' << std::left << std::setw(30)
+              << std::setfill('.') << "Maximum relative CI width" << std::setw(20) << std::right
+              << config->get<double>("experiment/sequentialStopping/maxRelativeIntervalWidth")
+              << '\n';
+  }
+  if (isRacing) {
+    std::cout << std::setw(2) << std::setfill(' ') << ' ' << std::left << std::setw(30)
+              << std::setfill('.') << "Runs before racing" << std::setw(20) << std::right
+              << minNumRuns << '\n';
+    std::cout << std::setw(2) << std::setfill(' ') << ' ' << std::left << std::setw(30)
+              << std::setfill('.') << "Runs per racing round" << std::setw(20) << std::right
+              << numRunsPerCheck << '\n';
+  }
   std::cout << std::setw(2) << std::setfill(' ') << ' ' << std::left << std::setw(30)
             << std::setfill('.') << "Maximum time per run" << std::setw(20) << std::right
             << context->getMaxSolveDuration().count() << " s\n";
   std::cout << std::setw(2) << std::setfill(' ') << ' ' << std::left << std::setw(30)
             << std::setfill('.') << "Cost log frequency" << std::setw(20) << std::right
             << config->get<std::size_t>("experiment/logFrequency") << " Hz\n";
+  std::cout << std::setw(2) << std::setfill(' ') << ' ' << std::left << std::setw(30)
+            << std::setfill('.') << "Event-driven cost logging" << std::setw(20) << std::right
+            << (config->contains("experiment/eventDrivenLogging") &&
+                        config->get<bool>("experiment/eventDrivenLogging")
+                    ? "yes"
+                    : "no")
+            << '\n';
+  std::cout << std::setw(2) << std::setfill(' ') << ' ' << std::left << std::setw(30)
+            << std::setfill('.') << "Number of parallel workers" << std::setw(20) << std::right
+            << numWorkers << '\n';
   std::cout << std::setw(2) << std::setfill(' ') << ' ' << std::left << std::setw(30)
             << std::setfill('.') << "Expected runtime no more than" << std::setw(20) << std::right
             << pdt::time::toDurationString(estimatedRuntime) << " HH:MM:SS\n";
@@ -259,9 +962,12 @@ int main(const int argc, const char **argv) {
   }
   std::cout << "\nBenchmark\n";
 
-  // Create a name for this experiment.
-  std::string experimentName = experimentStartTimeString + "_" + context->getName();
-  config->add<std::string>("experiment/name", experimentName);
+  // Create a name for this experiment, unless we're resuming one.
+  if (!config->isResuming()) {
+    config->add<std::string>("experiment/name",
+                             experimentStartTimeString + "_" + context->getName());
+  }
+  const auto experimentName = config->get<std::string>("experiment/name");
 
   // Create the directory for the results of this experiment to live in.
   fs::path experimentDirectory(fs::path(config->get<std::string>("experiment/baseDirectory")) /
@@ -271,199 +977,336 @@ int main(const int argc, const char **argv) {
 
   std::vector<std::string> resultPaths;
 
+  // The results are either logged as csv or in the more compact binary format.
+  std::string resultsExtension = ".csv"s;
+  if (config->contains("experiment/resultsFormat")) {
+    const auto format = config->get<std::string>("experiment/resultsFormat");
+    if (format == "binary"s) {
+      resultsExtension = pdt::loggers::binary_results::EXTENSION;
+    } else if (format != "csv"s) {
+      throw std::invalid_argument("Unknown results format '"s + format +
+                                  "'. Expected 'csv' or 'binary'."s);
+    }
+  }
+
   // Preallocate the paths of the files we are about to create
   for (auto i = 0u; i < numQueries; ++i) {
-    const fs::path path =
-        (fs::absolute(experimentDirectory) / ("raw/results_" + std::to_string(i) + ".csv"s));
+    const fs::path path = (fs::absolute(experimentDirectory) /
+                           ("raw/results_" + std::to_string(i) + resultsExtension));
     resultPaths.push_back(path.string());
   }
 
   // Add the result path to the experiment.
   config->add<std::vector<std::string>>("experiment/results", resultPaths);
+
+  // Instrumented contexts additionally log how often and how long their validity checker, motion
+  // validator, and objective were called.
+  std::vector<std::string> callCountsPaths;
+  if (context->getCallCounters()) {
+    for (auto i = 0u; i < numQueries; ++i) {
+      const fs::path path =
+          (fs::absolute(experimentDirectory) / ("raw/calls_" + std::to_string(i) + ".csv"s));
+      callCountsPaths.push_back(path.string());
+    }
+    config->add<std::vector<std::string>>("experiment/callCounts", callCountsPaths);
+  }
+
+  // The memory usage of every run is logged to separate files, one line per run.
+  std::vector<std::string> memoryUsagePaths;
+  if (config->contains("experiment/memoryProfiling") &&
+      config->get<bool>("experiment/memoryProfiling")) {
+    for (auto i = 0u; i < numQueries; ++i) {
+      const fs::path path =
+          (fs::absolute(experimentDirectory) / ("raw/memory_" + std::to_string(i) + ".csv"s));
+      memoryUsagePaths.push_back(path.string());
+    }
+    config->add<std::vector<std::string>>("experiment/memoryUsage", memoryUsagePaths);
+    if (!pdt::utilities::resetPeakResidentSetSize()) {
+      OMPL_WARN(
+          "Cannot reset the peak resident set size. The reported peaks are the peaks since the "
+          "benchmark started.");
+    }
+  }
   config->add<std::string>("experiment/experimentDirectory",
                            fs::absolute(experimentDirectory).string());
 
-  // Compute the total number of runs.
-  const auto totalNumberOfRuns =
-      config->get<std::size_t>("experiment/numRuns") *
-      config->get<std::vector<std::string>>("experiment/planners").size() * numQueries;
-  auto currentRun = 0u;
+  // Dump the complete config before running the planners, such that the experiment can be
+  // resumed if it is interrupted.
+  auto configPath = experimentDirectory / "config.json"s;
+  if (!config->isResuming()) {
+    fs::create_directories(experimentDirectory);
+    config->dumpAll(configPath.string());
+  }
 
-  // May the best planner win.
-  for (auto i = 0u; i < config->get<std::size_t>("experiment/numRuns"); ++i) {
-    // Randomly shuffle the planners.
-    auto plannerNames = config->get<std::vector<std::string>>("experiment/planners");
-    std::random_shuffle(plannerNames.begin(), plannerNames.end());
-
-    // In a multiquery setting: regenerate the start/goal pairs if so desired
-    if (i > 0 && config->contains("experiment/regenerateQueries") &&
-        config->get<bool>("experiment/regenerateQueries")) {
-      context->regenerateQueries();
-    }
-
-    // If multiple starts/goal queries are defined (i.e. we evaluate a multiquery setting),
-    // the planners run _all_ queries before the next planner runs the _same_ queries.
-    for (const auto &plannerName : plannerNames) {
-      // Allocate and run a dummy planner before allocating the actual planner.
-      // This results in more consistent measurements. I don't fully understand why, but it
-      // seems to be connected to running the planner in a separate thread.
-      {
-        auto reconciler =
-            std::make_shared<ompl::geometric::RRTConnect>(context->getSpaceInformation());
-        reconciler->setName("ReconcilingPlanner");
-        reconciler->setProblemDefinition(context->instantiateNewProblemDefinition());
-        auto hotpath = std::async(std::launch::async, [&reconciler]() {
-          reconciler->solve(ompl::base::timedPlannerTerminationCondition(0.0));
-        });
-        hotpath.get();
-      }
+  // Keep a journal of the completed runs. It also records the order in which the planners are run,
+  // which is randomly shuffled for every run.
+  const auto journalPath = experimentDirectory / "journal.jsonl"s;
+  std::unique_ptr<pdt::loggers::ExperimentJournal> journal;
+  if (config->isResuming()) {
+    journal = std::make_unique<pdt::loggers::ExperimentJournal>(journalPath);
+    if (journal->getSeed() != ompl::RNG::getSeed()) {
+      throw std::runtime_error("The seed of the resumed experiment does not match its journal.");
+    }
 
-      // Allocate the planner to be tested.
-      std::shared_ptr<ompl::base::Planner> planner;
-      pdt::common::PLANNER_TYPE plannerType;
-      pdt::time::Duration factoryDuration;
-      std::tie(planner, plannerType, factoryDuration) = plannerFactory.create(plannerName);
-
-      for (auto j = 0u; j < numQueries; ++j) {
-        pdt::time::CumulativeTimer configTimer;
-        // Create the logger for this run.
-        pdt::loggers::TimeCostLogger logger(context->getMaxSolveDuration(),
-                                            config->get<double>("experiment/logFrequency"));
-
-        // Prepare the planner for this query.
-        pdt::time::Duration querySetupDuration = std::chrono::seconds{0};
-        if (j == 0) {
-          // The PlannerFactory starts the planner with the 0th query.
-          // Set the planner up.
-          configTimer.start();
-          planner->setup();
-          configTimer.stop();
-
-          // Time is construction (from PlannerFactory) and setup.
-          querySetupDuration = factoryDuration + configTimer.duration();
-        } else {
-          // Clear the current query
-          configTimer.start();
-          planner->clearQuery();
-          configTimer.stop();
-
-          // get the problem setting for the nth query
-          const auto problemDefinition = context->instantiateNthProblemDefinition(j);
-
-          // Give it to the current planner
-          configTimer.start();
-          planner->setProblemDefinition(problemDefinition);
-          configTimer.stop();
-
-          // Time is just setup as constructed for previous query.
-          querySetupDuration = configTimer.duration();
-        }
+    // Discard runs that were logged after the last journal entry before the experiment stopped.
+    for (const auto &path : resultPaths) {
+      pdt::loggers::truncateResults(path, journal->getNumCompletedRuns());
+    }
+    for (const auto &path : callCountsPaths) {
+      pdt::loggers::truncateResults(path, journal->getNumCompletedRuns(),
+                                    pdt::loggers::TimeCostLogger::NUM_CALL_COUNTS_LINES);
+    }
+    for (const auto &path : memoryUsagePaths) {
+      pdt::loggers::truncateResults(path, journal->getNumCompletedRuns(), 1u);
+    }
+  } else {
+    std::vector<std::vector<std::string>> plannerOrders;
+    for (auto i = 0u; i < maxNumRuns; ++i) {
+      auto plannerNames = config->get<std::vector<std::string>>("experiment/planners");
+      std::random_shuffle(plannerNames.begin(), plannerNames.end());
+      plannerOrders.push_back(plannerNames);
+    }
+    journal = std::make_unique<pdt::loggers::ExperimentJournal>(journalPath, ompl::RNG::getSeed(),
+                                                                plannerOrders);
+  }
 
-        // Create the performance log:
-        // If it's not the first time we run this query (i.e. not the first run, and not the first
-        // planner), tell the log to expect to append to the existing file.
-        pdt::loggers::ResultLog<pdt::loggers::TimeCostLogger> results(
-            resultPaths[j], i != 0u || plannerName != plannerNames.front());
-
-        // Compute the duration we have left for solving.
-        const auto maxSolveDuration =
-            pdt::time::seconds(context->getMaxSolveDuration() - querySetupDuration);
-        const std::chrono::microseconds idle(1000000u /
-                                             config->get<std::size_t>("experiment/logFrequency"));
-
-        // Solve the problem on a separate thread.
-        pdt::time::Clock::time_point addMeasurementStart;
-        const auto solveStartTime = pdt::time::Clock::now();
-        std::future<void> future = std::async(std::launch::async, [&planner, &maxSolveDuration]() {
-          planner->solve(maxSolveDuration);
-        });
+  // The planners that have not been eliminated.
+  auto contenders = config->get<std::vector<std::string>>("experiment/planners");
 
-        // Log the intermediate best costs.
-        do {
-          addMeasurementStart = pdt::time::Clock::now();
-          logger.addMeasurement(querySetupDuration + (addMeasurementStart - solveStartTime),
-                                pdt::utilities::getBestCost(planner, plannerType));
+  // The summaries of the runs of all planners, which decide the races. A resumed race is replayed
+  // from the results that were logged before it was interrupted.
+  std::map<std::string, std::vector<RunSummaries>> runSummaries;
+  if (isRacing && config->isResuming()) {
+    runSummaries = loadRunSummaries(resultPaths);
+  }
 
-          // Stop logging intermediate best costs if the planner overshoots.
-          if (pdt::time::seconds(addMeasurementStart - solveStartTime) > maxSolveDuration) {
-            break;
-          }
-        } while (future.wait_until(addMeasurementStart + idle) != std::future_status::ready);
-
-        // Wait until the planner returns.
-        OMPL_DEBUG(
-            "Stopped logging results for planner '%s' because it overshot the termination "
-            "condition.",
-            plannerName.c_str());
-        future.get();
-
-        // Get the final runtime.
-        const auto totalDuration = querySetupDuration + (pdt::time::Clock::now() - solveStartTime);
-
-        // Store the final cost.
-        const auto problem = planner->getProblemDefinition();
-        if (problem->hasExactSolution()) {
-          logger.addMeasurement(totalDuration,
-                                problem->getSolutionPath()->cost(context->getObjective()));
-        } else {
-          logger.addMeasurement(totalDuration,
-                                ompl::base::Cost(context->getObjective()->infiniteCost()));
+  // Enumerate the (run, planner) jobs of a range of runs that remain, in the order in which they
+  // are run sequentially. Their results are logged in this order, even if they are run in parallel.
+  auto getRemainingJobs = [&journal, &contenders, numQueries](std::size_t beginRun,
+                                                              std::size_t endRun) {
+    std::vector<std::pair<std::size_t, std::string>> remainingJobs;
+    for (std::size_t i = beginRun; i < endRun; ++i) {
+      for (const auto &plannerName : journal->getPlannerOrders()[i]) {
+        if (std::find(contenders.begin(), contenders.end(), plannerName) == contenders.end()) {
+          continue;
+        }
+        bool isCompleted = true;
+        for (std::size_t j = 0u; j < numQueries; ++j) {
+          isCompleted = isCompleted && journal->isCompleted(i, plannerName, j);
         }
+        if (!isCompleted) {
+          remainingJobs.emplace_back(i, plannerName);
+        }
+      }
+    }
+    return remainingJobs;
+  };
+
+  // The runs are scheduled in rounds, the first of which contains the minimum number of runs. A
+  // resumed experiment continues in the round in which it was interrupted, unless it is a race.
+  std::size_t numScheduledRuns = minNumRuns;
+  for (std::size_t i = 0u; i < journal->getPlannerOrders().size() && !isRacing; ++i) {
+    for (const auto &plannerName : journal->getPlannerOrders()[i]) {
+      while (journal->isCompleted(i, plannerName, 0u) && numScheduledRuns <= i) {
+        numScheduledRuns = std::min(numScheduledRuns + numRunsPerCheck, maxNumRuns);
+      }
+    }
+  }
+  auto jobs = getRemainingJobs(0u, numScheduledRuns);
+  if (config->isResuming()) {
+    std::cout << std::setw(2) << std::setfill(' ') << ' ' << "Resuming after "
+              << journal->getNumCompletedRuns() << " completed planner runs\n";
+  }
+
+  // Compute the total number of runs. This grows if rounds are added.
+  std::size_t totalNumberOfRuns = jobs.size() * numQueries;
+  std::atomic<std::size_t> currentRun{0u};
+
+  // If it's not the first time we run the queries, tell the log to expect to append to the
+  // existing files.
+  std::size_t numLoggedRuns = journal->getNumCompletedRuns();
+
+  // The contexts in which the planners are run. If planners are run in parallel, every worker plans
+  // in its own instance of the context, which it reuses for all its jobs. The instances are created
+  // here rather than per job, because creating an instance resets OMPL's global seed generator,
+  // which the workers would otherwise race on. Every instance is created identically, so a job
+  // plans on the same queries regardless of the worker it runs on.
+  std::vector<std::shared_ptr<pdt::planning_contexts::BaseContext>> contexts;
+  std::vector<pdt::factories::PlannerFactory> plannerFactories;
+  if (numWorkers == 1u) {
+    contexts.push_back(context);
+  } else {
+    plannerFactories.reserve(numWorkers);
+    for (auto w = 0u; w < numWorkers; ++w) {
+      contexts.push_back(
+          createContextInstance(contextFactory, config->get<std::string>("experiment/context")));
+      plannerFactories.emplace_back(config, contexts.back());
+    }
+  }
 
-        // Anytime planners can stop early, e.g. if they know that they found the optimal solution.
-        // Thus, we need to add an additional final measurement point at the maximum runtime.
-        const auto maxRunDuration = context->getMaxSolveDuration();
-        if (totalDuration < maxRunDuration) {
-          if (problem->hasExactSolution()) {
-            logger.addMeasurement(maxRunDuration,
-                                  problem->getSolutionPath()->cost(context->getObjective()));
-          } else {
-            logger.addMeasurement(maxRunDuration,
-                                  ompl::base::Cost(context->getObjective()->infiniteCost()));
+  // Runs a round of jobs, logs their results and records them in the journal.
+  std::size_t queriesRun = 0u;
+  auto runJobs = [&](const std::vector<std::pair<std::size_t, std::string>> &roundJobs) {
+    if (numWorkers == 1u) {
+      for (const auto &job : roundJobs) {
+        // In a multiquery setting: regenerate the start/goal pairs for every run if so desired. The
+        // queries of every run are journaled, such that a resumed run plans on the same queries.
+        if (job.first != queriesRun) {
+          queriesRun = job.first;
+          if (config->contains("experiment/regenerateQueries") &&
+              config->get<bool>("experiment/regenerateQueries")) {
+            if (journal->hasQueries(job.first)) {
+              setJournaledQueries(context, journal->getQueries(job.first));
+            } else {
+              context->regenerateQueries();
+              journal->recordQueries(job.first, getJournaledQueries(context));
+            }
           }
         }
 
-        // Add this run to the log and report it to the console.
-        results.addResult(planner->getName(), logger);
-
-        // Compute the progress.
-        ++currentRun;
-        const auto progress =
-            static_cast<float>(currentRun) / static_cast<float>(totalNumberOfRuns);
-
-        // estimate how much time is left by extrapolating from the time spent so far.
-        // This is more accurate than subtracting the time used so far from the worst case total
-        // time since it can take planners that terminate early into account.
-        const auto timeSoFar = std::chrono::system_clock::now() - experimentStartTime;
-        const auto extrapolatedRuntime = timeSoFar / progress;
-        const auto estimatedTimeString =
-            " (est. time left: "s +
-            pdt::time::toDurationString(
-                std::chrono::ceil<std::chrono::seconds>(extrapolatedRuntime - timeSoFar)) +
-            ")"s;
-
-        std::cout << '\r' << std::setw(2) << std::setfill(' ') << std::right << ' ' << "Progress"
-                  << (std::ceil(progress * barWidth) != barWidth
-                          ? std::setw(static_cast<int>(std::ceil(progress * barWidth)))
-                          : std::setw(static_cast<int>(std::ceil(progress * barWidth) - 1u)))
-                  << std::setfill('.') << (currentRun != totalNumberOfRuns ? '|' : '.')
-                  << std::right
-                  << std::setw(barWidth - static_cast<int>(std::ceil(progress * barWidth)))
-                  << std::setfill('.') << '.' << std::right << std::fixed << std::setw(6)
-                  << std::setfill(' ') << std::setprecision(2) << progress * 100.0f << " %";
-        if (currentRun != totalNumberOfRuns) {
-          std::cout << estimatedTimeString;
-        } else {
-          std::cout << std::setfill(' ')
-                    << std::setw(static_cast<int>(estimatedTimeString.length())) << " ";
+        const auto run = runPlanner(config, context, plannerFactory, job.second,
+                                    computeJobSeed(journal->getSeed(), job.first, job.second), {},
+                                    [&currentRun, &totalNumberOfRuns, &experimentStartTime]() {
+                                      printProgress(++currentRun, totalNumberOfRuns,
+                                                    experimentStartTime);
+                                    });
+
+        // Add this run to the log and record it in the journal.
+        logPlannerRun(resultPaths, callCountsPaths, memoryUsagePaths, run,
+                      numLoggedRuns++ != 0u);
+        journal->markCompleted(job.first, job.second, numQueries);
+        if (isRacing) {
+          addRunSummaries(&runSummaries, run);
         }
-        std::cout << std::flush;
       }
+    } else {
+      std::vector<std::promise<PlannerRun>> promises(roundJobs.size());
+      std::vector<std::future<PlannerRun>> futures;
+      for (auto &promise : promises) {
+        futures.push_back(promise.get_future());
+      }
+
+      // Start the workers.
+      std::atomic<std::size_t> nextJob{0u};
+      std::atomic<bool> stopWorkers{false};
+      std::vector<std::thread> workers;
+      for (auto w = 0u; w < numWorkers; ++w) {
+        workers.emplace_back([&, w]() {
+          const auto cores = corePairs.empty()
+                                 ? CoreAssignment{2u * w, 2u * w + 1u}
+                                 : CoreAssignment{corePairs[w % corePairs.size()].first,
+                                                  corePairs[w % corePairs.size()].second};
+          for (auto k = nextJob++; k < roundJobs.size() && !stopWorkers; k = nextJob++) {
+            try {
+              promises[k].set_value(runPlanner(
+                  config, contexts[w], plannerFactories[w], roundJobs[k].second,
+                  computeJobSeed(journal->getSeed(), roundJobs[k].first, roundJobs[k].second),
+                  cores, [&currentRun]() { ++currentRun; }));
+            } catch (...) {
+              promises[k].set_exception(std::current_exception());
+            }
+          }
+        });
+      }
+
+      // Log the results in order as they become available.
+      try {
+        for (auto k = 0u; k < futures.size(); ++k) {
+          while (futures[k].wait_for(std::chrono::seconds(1)) != std::future_status::ready) {
+            printProgress(currentRun, totalNumberOfRuns, experimentStartTime);
+          }
+          const auto run = futures[k].get();
+          logPlannerRun(resultPaths, callCountsPaths, memoryUsagePaths, run,
+                        numLoggedRuns++ != 0u);
+          journal->markCompleted(roundJobs[k].first, roundJobs[k].second, numQueries);
+          if (isRacing) {
+            addRunSummaries(&runSummaries, run);
+          }
+        }
+      } catch (...) {
+        stopWorkers = true;
+        for (auto &worker : workers) {
+          worker.join();
+        }
+        throw;
+      }
+      for (auto &worker : workers) {
+        worker.join();
+      }
+      printProgress(currentRun, totalNumberOfRuns, experimentStartTime);
     }
+  };
+
+  // May the best planner win.
+  runJobs(jobs);
+
+  // Add rounds until the confidence intervals are narrow enough or the maximum number of runs is
+  // reached.
+  if (isStoppingSequentially) {
+    const auto confidence = config->get<double>("experiment/sequentialStopping/confidence");
+    const auto maxRelativeWidth =
+        config->get<double>("experiment/sequentialStopping/maxRelativeIntervalWidth");
+    auto [relativeWidth, achievedConfidence] =
+        computeMedianIntervalWidth(config, resultPaths, confidence);
+    while (relativeWidth > maxRelativeWidth && numScheduledRuns < maxNumRuns) {
+      const auto numRuns = std::min(numScheduledRuns + numRunsPerCheck, maxNumRuns);
+      jobs = getRemainingJobs(numScheduledRuns, numRuns);
+      numScheduledRuns = numRuns;
+      totalNumberOfRuns += jobs.size() * numQueries;
+      runJobs(jobs);
+      std::tie(relativeWidth, achievedConfidence) =
+          computeMedianIntervalWidth(config, resultPaths, confidence);
+    }
+
+    // Record the outcome.
+    config->add<std::size_t>("experiment/sequentialStopping/numRunsPerPlanner", numScheduledRuns);
+    config->add<double>("experiment/sequentialStopping/achievedConfidence", achievedConfidence);
+    config->add<double>("experiment/sequentialStopping/achievedRelativeIntervalWidth",
+                        relativeWidth);
+    std::cout << '\n'
+              << std::setw(2u) << std::setfill(' ') << ' ' << std::setw(30) << std::setfill('.')
+              << std::left << "Number of runs per planner" << std::setw(20) << std::right
+              << numScheduledRuns << '\n'
+              << std::setw(2u) << std::setfill(' ') << ' ' << std::setw(30) << std::setfill('.')
+              << std::left << "Relative CI width" << std::setw(20) << std::right << relativeWidth
+              << '\n'
+              << std::setw(2u) << std::setfill(' ') << ' ' << std::setw(30) << std::setfill('.')
+              << std::left << "Achieved confidence" << std::setw(20) << std::right
+              << achievedConfidence * 100.0 << " %\n";
+  }
+
+  // Race the planners. After every round, the dominated planners are eliminated and the next round
+  // is run with the remaining contenders.
+  if (isRacing) {
+    const auto significanceLevel = config->get<double>("experiment/racing/significanceLevel");
+    for (std::size_t round = 1u; numScheduledRuns < maxNumRuns; ++round) {
+      for (const auto &plannerName : findDominatedPlanners(contenders, runSummaries,
+                                                           numScheduledRuns, significanceLevel)) {
+        config->add<std::size_t>("experiment/racing/eliminated/"s + plannerName + "/round"s,
+                                 round);
+        config->add<std::size_t>("experiment/racing/eliminated/"s + plannerName + "/numRuns"s,
+                                 numScheduledRuns);
+        contenders.erase(std::find(contenders.begin(), contenders.end(), plannerName));
+        std::cout << '\n'
+                  << std::setw(2u) << std::setfill(' ') << ' ' << "Eliminated " << plannerName
+                  << " after round " << round << " (" << numScheduledRuns << " runs)\n";
+      }
+
+      const auto numRuns = std::min(numScheduledRuns + numRunsPerCheck, maxNumRuns);
+      jobs = getRemainingJobs(numScheduledRuns, numRuns);
+      numScheduledRuns = numRuns;
+      totalNumberOfRuns += jobs.size() * numQueries;
+      runJobs(jobs);
+    }
+
+    // The statistics and the report consider the planners that were not eliminated.
+    config->add<std::vector<std::string>>(
+        "experiment/racing/planners",
+        config->get<std::vector<std::string>>("experiment/planners"));
+    config->add<std::vector<std::string>>("experiment/planners", contenders);
   }
 
   // dump the complete config to make sure that we can produce the report once we ran the experiment
-  auto configPath = experimentDirectory / "config.json"s;
   config->dumpAll(configPath.string());
 
   // Register the end time of the experiment.
@@ -471,6 +1314,16 @@ int main(const int argc, const char **argv) {
   auto experimentEndTimeString = pdt::time::toDateString(experimentEndTime);
   pdt::time::Duration experimentDuration = experimentEndTime - experimentStartTime;
 
+  // Accumulate the motion validation statistics of all contexts.
+  std::size_t numCheckedMotions = 0u;
+  double numValidMotions = 0.0;
+  for (const auto &instance : contexts) {
+    const auto spaceInfo = instance->getSpaceInformation();
+    numCheckedMotions += spaceInfo->getCheckedMotionCount();
+    numValidMotions += spaceInfo->getMotionValidator()->getValidMotionFraction() *
+                       static_cast<double>(spaceInfo->getCheckedMotionCount());
+  }
+
   // Report the elapsed time and some statistics.
   std::cout << '\n'
             << std::setw(2u) << std::setfill(' ') << ' ' << std::setw(30) << std::setfill('.')
@@ -478,11 +1331,12 @@ int main(const int argc, const char **argv) {
             << pdt::time::toDurationString(experimentEndTime - experimentStartTime) << " HH:MM:SS\n"
             << std::setw(2u) << std::setfill(' ') << ' ' << std::setw(30) << std::setfill('.')
             << std::left << "Number of checked motions" << std::setw(20) << std::right
-            << context->getSpaceInformation()->getCheckedMotionCount() << '\n'
+            << numCheckedMotions << '\n'
             << std::setw(2u) << std::setfill(' ') << ' ' << std::setw(30) << std::setfill('.')
             << std::left << "Percentage of valid motions" << std::setw(20) << std::right
-            << context->getSpaceInformation()->getMotionValidator()->getValidMotionFraction() *
-                   100.0f
+            << (numCheckedMotions == 0u
+                    ? 0.0
+                    : numValidMotions / static_cast<double>(numCheckedMotions) * 100.0)
             << " %\n";
 
   // Generate the statistic.
@@ -36,13 +36,20 @@
 // Authors: Marlin Strub
 
 #include <iostream>
+#include <memory>
 
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics.hpp>
 
 #include "pdt/config/configuration.h"
 #include "pdt/factories/context_factory.h"
+#include "pdt/obstacles/hyperrectangle.h"
 #include "pdt/planning_contexts/all_contexts.h"
+#include "pdt/planning_contexts/bisection_motion_validator.h"
+#include "pdt/planning_contexts/context_validity_checker.h"
+#include "pdt/planning_contexts/counting_validity_checker.h"
+#include "pdt/planning_contexts/hyperrectangle_motion_validator.h"
+#include "pdt/time/time.h"
 
 using namespace std::string_literals;
 
@@ -55,6 +62,39 @@ using AccumulatorSet = boost::accumulators::accumulator_set<
                 boost::accumulators::tag::max, boost::accumulators::tag::mean,
                 boost::accumulators::tag::median, boost::accumulators::tag::lazy_variance>>;
 
+// Returns whether the validity of the context is fully described by its obstacles and
+// antiobstacles, and all of them are hyperrectangles. Only then can the exact motion validator
+// check its motions.
+bool hasHyperrectanglesOnly(const std::shared_ptr<pdt::planning_contexts::BaseContext>& context) {
+  if (!std::dynamic_pointer_cast<pdt::planning_contexts::RealVectorGeometricContext>(context)) {
+    return false;
+  }
+
+  // Contexts based on grids or meshes have their own validity checkers.
+  auto checker = context->getSpaceInformation()->getStateValidityChecker();
+  if (auto counting =
+          std::dynamic_pointer_cast<pdt::planning_contexts::CountingValidityChecker>(checker)) {
+    checker = counting->getValidityChecker();
+  }
+  if (!std::dynamic_pointer_cast<pdt::planning_contexts::ContextValidityChecker>(checker)) {
+    return false;
+  }
+
+  for (const auto& obstacle : context->getObstacles()) {
+    if (!std::dynamic_pointer_cast<
+            pdt::obstacles::Hyperrectangle<pdt::obstacles::BaseObstacle>>(obstacle)) {
+      return false;
+    }
+  }
+  for (const auto& antiObstacle : context->getAntiObstacles()) {
+    if (!std::dynamic_pointer_cast<
+            pdt::obstacles::Hyperrectangle<pdt::obstacles::BaseAntiObstacle>>(antiObstacle)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 int main(const int argc, const char** argv) {
   // Read the config files.
   auto config = std::make_shared<pdt::config::Configuration>(argc, argv);
@@ -84,17 +124,50 @@ int main(const int argc, const char** argv) {
       candidateResolutions.size(), std::make_pair(AccumulatorSet{}, AccumulatorSet{}));
   std::pair<AccumulatorSet, AccumulatorSet> groundTruthTimingResults;
 
+  // Prepare the results of the exact motion validator. It has false negatives if it accepts edges
+  // that the ground truth rejects, and finds extra collisions if it rejects edges that the ground
+  // truth accepts, which happens when the ground truth resolution steps over small obstacles.
+  std::pair<AccumulatorSet, AccumulatorSet> exactTimingResults;
+  std::size_t exactFalseNegatives = 0u;
+  std::size_t exactExtraCollisions = 0u;
+  bool testedExactValidator = false;
+
+  // Prepare the results of the bisection motion validator. It checks the same states as the
+  // discrete motion validator at every resolution, only in a different order, so it should never
+  // disagree with it. Its timing of invalid edges is the time to reject them.
+  std::vector<std::pair<AccumulatorSet, AccumulatorSet>> bisectionTimingResults(
+      candidateResolutions.size(), std::make_pair(AccumulatorSet{}, AccumulatorSet{}));
+  std::vector<std::size_t> bisectionDisagreements(candidateResolutions.size(), 0u);
+
   std::size_t numTestedEdges = 0u;
   std::size_t numTestedValid = 0u;
   std::size_t numTestedInvalid = 0u;
+  double laterContextsDuration = 0.0;
   for (std::size_t c = 0u; c < config->get<std::size_t>("experiment/numContexts"); ++c) {
-    // Create the context.
+    // Create the context. Later contexts can reuse what the first one loaded, so report both.
     pdt::factories::ContextFactory contextFactory(config);
+    const auto creationStart = pdt::time::Clock::now();
     auto context = contextFactory.create(config->get<std::string>("experiment/context"));
+    const auto creationDuration = pdt::time::seconds(pdt::time::Clock::now() - creationStart);
+    if (c == 0u) {
+      std::cout << "Created the first context in " << creationDuration << " s." << std::endl;
+    } else {
+      laterContextsDuration += creationDuration;
+    }
 
     // Get the space info.
     auto spaceInfo = context->getSpaceInformation();
 
+    // Create the exact motion validator if this context is made of hyperrectangles.
+    std::unique_ptr<pdt::planning_contexts::HyperrectangleMotionValidator> exactValidator;
+    if (hasHyperrectanglesOnly(context)) {
+      exactValidator = std::make_unique<pdt::planning_contexts::HyperrectangleMotionValidator>(
+          spaceInfo, context->getObstacles(), context->getAntiObstacles());
+    }
+
+    // Create the bisection motion validator.
+    pdt::planning_contexts::BisectionMotionValidator bisectionValidator(spaceInfo);
+
     // Get a state sampler.
     auto sampler = spaceInfo->allocStateSampler();
 
@@ -125,6 +198,26 @@ int main(const int argc, const char** argv) {
       bool isValid = spaceInfo->checkMotion(state1, state2);
       const auto stop = pdt::time::Clock::now();
 
+      if (exactValidator) {
+        testedExactValidator = true;
+        const auto exactStart = pdt::time::Clock::now();
+        const bool isExactValid = exactValidator->checkMotion(state1, state2);
+        const auto exactStop = pdt::time::Clock::now();
+        const auto exactDuration =
+            std::chrono::duration_cast<pdt::time::Duration>(exactStop - exactStart).count();
+        if (isValid) {
+          exactTimingResults.first(exactDuration);
+          if (!isExactValid) {
+            ++exactExtraCollisions;
+          }
+        } else {
+          exactTimingResults.second(exactDuration);
+          if (isExactValid) {
+            ++exactFalseNegatives;
+          }
+        }
+      }
+
       if (isValid) {
         ++numTestedValid;
         groundTruthTimingResults.first(
@@ -139,6 +232,16 @@ int main(const int argc, const char** argv) {
 
           timingResults[j].first(
               std::chrono::duration_cast<pdt::time::Duration>(stop - start).count());
+
+          const auto bisectionStart = pdt::time::Clock::now();
+          const bool isBisectionValid = bisectionValidator.checkMotion(state1, state2);
+          const auto bisectionStop = pdt::time::Clock::now();
+          bisectionTimingResults[j].first(
+              std::chrono::duration_cast<pdt::time::Duration>(bisectionStop - bisectionStart)
+                  .count());
+          if (!isBisectionValid) {
+            ++bisectionDisagreements[j];
+          }
         }
       } else {
         ++numTestedInvalid;
@@ -162,6 +265,16 @@ int main(const int argc, const char** argv) {
 
           timingResults[j].second(
               std::chrono::duration_cast<pdt::time::Duration>(stop - start).count());
+
+          const auto bisectionStart = pdt::time::Clock::now();
+          const bool isBisectionValid = bisectionValidator.checkMotion(state1, state2);
+          const auto bisectionStop = pdt::time::Clock::now();
+          bisectionTimingResults[j].second(
+              std::chrono::duration_cast<pdt::time::Duration>(bisectionStop - bisectionStart)
+                  .count());
+          if (isBisectionValid != isValid) {
+            ++bisectionDisagreements[j];
+          }
         }
       }
 
@@ -186,6 +299,12 @@ int main(const int argc, const char** argv) {
 
   std::cout << "\nFinal Results for " << numTestedEdges << " edges (valid: " << numTestedValid
             << ", invalid: " << numTestedInvalid << ")\n\n";
+  if (config->get<std::size_t>("experiment/numContexts") > 1u) {
+    std::cout << "Mean creation time of later contexts [s]: "
+              << laterContextsDuration /
+                     static_cast<double>(config->get<std::size_t>("experiment/numContexts") - 1u)
+              << "\n\n";
+  }
   std::cout.width(10);
   for (std::size_t i = 0u; i < candidateResolutions.size(); ++i) {
     std::cout << "Resolution: " << std::fixed << candidateResolutions[i]
@@ -218,6 +337,65 @@ int main(const int argc, const char** argv) {
               << "\n\n";
   }
 
+  // Report the time the bisection motion validator takes to reject invalid edges compared to the
+  // discrete motion validator.
+  for (std::size_t i = 0u; i < candidateResolutions.size(); ++i) {
+    const auto discreteRejectMean =
+        boost::accumulators::extract_result<boost::accumulators::tag::mean>(
+            timingResults[i].second);
+    const auto bisectionRejectMean =
+        boost::accumulators::extract_result<boost::accumulators::tag::mean>(
+            bisectionTimingResults[i].second);
+    std::cout << "Bisection at resolution: " << std::fixed << candidateResolutions[i]
+              << "\n\tDisagreements: " << bisectionDisagreements[i] << "\tValid Mean: "
+              << boost::accumulators::extract_result<boost::accumulators::tag::mean>(
+                     bisectionTimingResults[i].first)
+              << "\tTime to Reject Mean: " << bisectionRejectMean
+              << "\tTime to Reject Max: "
+              << boost::accumulators::extract_result<boost::accumulators::tag::max>(
+                     bisectionTimingResults[i].second)
+              << "\tTime to Reject Speedup: " << discreteRejectMean / bisectionRejectMean
+              << "\n\n";
+  }
+
+  // Report the exact motion validator and its speedup over every resolution, if it was tested.
+  if (testedExactValidator) {
+    const auto exactValidMean = boost::accumulators::extract_result<boost::accumulators::tag::mean>(
+        exactTimingResults.first);
+    const auto exactInvalidMean =
+        boost::accumulators::extract_result<boost::accumulators::tag::mean>(
+            exactTimingResults.second);
+    std::cout << "Exact\n\tFalse Neg: " << exactFalseNegatives << "\tFalse Neg [%]: "
+              << static_cast<float>(exactFalseNegatives) / static_cast<float>(numTestedInvalid)
+              << "\tExtra Collisions: " << exactExtraCollisions
+              << "\tValid Mean: " << exactValidMean << "\tInvalid Mean: " << exactInvalidMean
+              << "\n";
+    std::cout << "\tSpeedup over ground truth (valid / invalid): "
+              << boost::accumulators::extract_result<boost::accumulators::tag::mean>(
+                     groundTruthTimingResults.first) /
+                     exactValidMean
+              << " / "
+              << boost::accumulators::extract_result<boost::accumulators::tag::mean>(
+                     groundTruthTimingResults.second) /
+                     exactInvalidMean
+              << "\n";
+    for (std::size_t i = 0u; i < candidateResolutions.size(); ++i) {
+      std::cout << "\tSpeedup over resolution " << std::fixed << candidateResolutions[i]
+                << " (valid / invalid): "
+                << boost::accumulators::extract_result<boost::accumulators::tag::mean>(
+                       timingResults[i].first) /
+                       exactValidMean
+                << " / "
+                << boost::accumulators::extract_result<boost::accumulators::tag::mean>(
+                       timingResults[i].second) /
+                       exactInvalidMean
+                << "\n";
+    }
+  } else {
+    std::cout << "Exact\n\tSkipped, the obstacles of the context are not all hyperrectangles.\n";
+  }
+  std::cout << "\n";
+
   config->dumpAccessed();
 
   return 0;
@@ -0,0 +1,93 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <experimental/filesystem>
+
+#include "pdt/config/configuration.h"
+#include "pdt/loggers/binary_results.h"
+#include "pdt/loggers/results_reader.h"
+
+using namespace std::string_literals;
+namespace fs = std::experimental::filesystem;
+
+// Converts the results of an existing experiment from csv to the binary results format. Call it
+// with the config of the experiment, e.g., 'convert_results -c path/to/experiment/config.json'.
+// The csv files are left untouched and the converted experiment is described by
+// 'config_binary.json', which can be passed to the benchmark_report executable.
+int main(const int argc, const char** argv) {
+  // Read the config files.
+  auto config = std::make_shared<pdt::config::Configuration>(argc, argv);
+
+  std::vector<std::string> binaryPaths;
+  for (const auto& csvPath : config->get<std::vector<std::string>>("experiment/results")) {
+    fs::path binaryPath(csvPath);
+    binaryPath.replace_extension(pdt::loggers::binary_results::EXTENSION);
+    if (fs::exists(binaryPath)) {
+      throw std::ios_base::failure("Binary results already exist at '"s + binaryPath.string() +
+                                   "'."s);
+    }
+
+    // Read the csv file and append its runs in order.
+    const pdt::loggers::ResultsReader reader(csvPath);
+    const auto numRuns = reader.getNumRuns();
+    for (std::size_t i = 0u; i < numRuns; ++i) {
+      const auto numMeasurements = reader.getNumMeasurements(i);
+      const auto durations = reader.getDurations(i);
+      const auto costs = reader.getCosts(i);
+      pdt::loggers::binary_results::appendRun(
+          binaryPath, reader.getPlannerName(i),
+          std::vector<double>(durations, durations + numMeasurements),
+          std::vector<double>(costs, costs + numMeasurements));
+    }
+
+    std::cout << std::setw(2) << std::setfill(' ') << ' ' << "Converted " << numRuns
+              << " runs to " << binaryPath << '\n';
+    binaryPaths.push_back(binaryPath.string());
+  }
+
+  // Describe the converted experiment with its own config.
+  config->add<std::vector<std::string>>("experiment/results", binaryPaths);
+  config->dumpAll(
+      (fs::path(config->get<std::string>("experiment/experimentDirectory")) / "config_binary.json")
+          .string());
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include <iostream>
+#include <vector>
+
+#include "pdt/config/configuration.h"
+#include "pdt/factories/context_factory.h"
+#include "pdt/objectives/max_min_clearance_optimization_objective.h"
+#include "pdt/planning_contexts/all_contexts.h"
+#include "pdt/time/time.h"
+
+using namespace std::string_literals;
+
+int main(const int argc, const char** argv) {
+  // Read the config files.
+  auto config = std::make_shared<pdt::config::Configuration>(argc, argv);
+  config->registerAsExperiment();
+
+  std::cout << "seed: " << config->get<std::size_t>("experiment/seed") << std::endl;
+
+  // Create the context.
+  pdt::factories::ContextFactory contextFactory(config);
+  auto context = contextFactory.create(config->get<std::string>("experiment/context"));
+  auto spaceInfo = context->getSpaceInformation();
+
+  // The exhaustive objective computes the clearance of every state along an edge, the skipping
+  // objective skips the states that the Lipschitz continuity of the clearance rules out.
+  pdt::objectives::MaxMinClearanceOptimizationObjective exhaustive(spaceInfo);
+  pdt::objectives::MaxMinClearanceOptimizationObjective skipping(spaceInfo);
+  skipping.setClearanceLipschitzConstant(1.0);
+
+  // Sample the edges up front, such that both objectives compute the costs of the same edges.
+  const auto numEdges = config->get<std::size_t>("experiment/numEdges");
+  auto sampler = spaceInfo->allocStateSampler();
+  std::vector<ompl::base::State*> states(2u * numEdges);
+  for (auto& state : states) {
+    state = spaceInfo->allocState();
+    sampler->sampleUniform(state);
+  }
+
+  // Compute the costs with both objectives.
+  std::vector<double> exhaustiveCosts(numEdges);
+  std::vector<double> skippingCosts(numEdges);
+  auto start = pdt::time::Clock::now();
+  for (std::size_t i = 0u; i < numEdges; ++i) {
+    exhaustiveCosts[i] = exhaustive.motionCost(states[2u * i], states[2u * i + 1u]).value();
+  }
+  const auto exhaustiveDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+  start = pdt::time::Clock::now();
+  for (std::size_t i = 0u; i < numEdges; ++i) {
+    skippingCosts[i] = skipping.motionCost(states[2u * i], states[2u * i + 1u]).value();
+  }
+  const auto skippingDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+
+  // The skipping objective must compute exactly the same costs.
+  std::size_t numMismatches = 0u;
+  for (std::size_t i = 0u; i < numEdges; ++i) {
+    if (exhaustiveCosts[i] != skippingCosts[i]) {
+      ++numMismatches;
+    }
+  }
+
+  std::cout << "\nEdges: " << numEdges << "\n\tExhaustive mean [us]: "
+            << 1e6 * exhaustiveDuration / static_cast<double>(numEdges)
+            << "\n\tSkipping mean [us]: " << 1e6 * skippingDuration / static_cast<double>(numEdges)
+            << "\n\tSpeedup: " << exhaustiveDuration / skippingDuration
+            << "\n\tMismatches: " << numMismatches << "\n\n";
+
+  spaceInfo->freeStates(states);
+
+  config->dumpAccessed();
+
+  return 0;
+}
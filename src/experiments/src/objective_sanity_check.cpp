@@ -35,6 +35,8 @@
 
 // Authors: Marlin Strub
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 #include <boost/accumulators/accumulators.hpp>
@@ -43,6 +45,8 @@
 #include "pdt/config/configuration.h"
 #include "pdt/factories/context_factory.h"
 #include "pdt/planning_contexts/all_contexts.h"
+#include "pdt/planning_contexts/context_validity_checker.h"
+#include "pdt/time/time.h"
 
 using namespace std::string_literals;
 
@@ -70,10 +74,26 @@ int main(const int argc, const char** argv) {
   auto numEdges = 0u;
   auto numValidEdges = 0u;
 
+  // Keep track of how much the clearance of distance fields differs from the exact clearance.
+  auto numDistanceFieldStates = 0u;
+  auto numDistanceFieldViolations = 0u;
+  auto maxDistanceFieldError = 0.0;
+  auto distanceFieldErrorBound = 0.0;
+
+  // Keep track of how long it takes to create contexts after the first.
+  auto laterContextsDuration = 0.0;
+
   // Let's test.
   for (auto i = 0u; i < config->get<std::size_t>("experiment/numContexts"); ++i) {
     // Create a new context and an associated problem.
+    const auto creationStart = pdt::time::Clock::now();
     auto context = contextFactory.create(config->get<std::string>("experiment/context"));
+    const auto creationDuration = pdt::time::seconds(pdt::time::Clock::now() - creationStart);
+    if (i == 0u) {
+      std::cout << "Created the first context in " << creationDuration << " s." << std::endl;
+    } else {
+      laterContextsDuration += creationDuration;
+    }
     auto problem = context->instantiateNewProblemDefinition();
     auto objective = problem->getOptimizationObjective();
 
@@ -85,6 +105,13 @@ int main(const int argc, const char** argv) {
     auto state1 = spaceInfo->allocState();
     auto state2 = spaceInfo->allocState();
 
+    // Get the checker if it approximates the clearance with a distance field.
+    auto checker = std::dynamic_pointer_cast<pdt::planning_contexts::ContextValidityChecker>(
+        spaceInfo->getStateValidityChecker());
+    if (checker && !checker->getDistanceField()) {
+      checker.reset();
+    }
+
     // Test edge costs.
     for (auto ii = 0u; ii < config->get<std::size_t>("experiment/numEdges"); ++ii) {
       if (numEdges % 1000 == 0u) {
@@ -99,6 +126,21 @@ int main(const int argc, const char** argv) {
         sampler->sampleUniform(state2);
       } while (!spaceInfo->isValid(state2));
 
+      // Make sure the clearance of the distance field is within its error bound.
+      if (checker) {
+        distanceFieldErrorBound = checker->getDistanceField()->getErrorBound();
+        for (const auto state : {state1, state2}) {
+          const auto error =
+              std::abs(checker->clearance(state) - checker->computeExactClearance(state));
+          maxDistanceFieldError = std::max(maxDistanceFieldError, error);
+          ++numDistanceFieldStates;
+          if (error > distanceFieldErrorBound) {
+            ++numDistanceFieldViolations;
+            OMPL_WARN("Found state with a distance field clearance outside of the error bound.");
+          }
+        }
+      }
+
       // Compute the true and heuristic costs between the states.
       auto trueCost = objective->motionCost(state1, state2);
       auto heuristicCost = objective->motionCostHeuristic(state1, state2);
@@ -154,6 +196,17 @@ int main(const int argc, const char** argv) {
             << ", "
             << boost::accumulators::extract_result<boost::accumulators::tag::max>(accuracyStats)
             << '\n';
+  if (config->get<std::size_t>("experiment/numContexts") > 1u) {
+    std::cout << "Mean creation time of later contexts [s]: "
+              << laterContextsDuration /
+                     static_cast<double>(config->get<std::size_t>("experiment/numContexts") - 1u)
+              << '\n';
+  }
+  if (numDistanceFieldStates != 0u) {
+    std::cout << "Distance field [states, violations, max error, error bound]:\n"
+              << numDistanceFieldStates << ", " << numDistanceFieldViolations << ", "
+              << maxDistanceFieldError << ", " << distanceFieldErrorBound << '\n';
+  }
 
   return 0;
 }
@@ -0,0 +1,132 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <ompl/util/RandomNumbers.h>
+
+#include "pdt/config/configuration.h"
+#include "pdt/objectives/point_source_tree.h"
+#include "pdt/time/time.h"
+
+using namespace std::string_literals;
+
+int main(const int argc, const char** argv) {
+  // Read the config files.
+  auto config = std::make_shared<pdt::config::Configuration>(argc, argv);
+  config->registerAsExperiment();
+
+  std::cout << "seed: " << config->get<std::size_t>("experiment/seed") << std::endl;
+
+  const auto dimension = config->get<std::size_t>("experiment/dimensions");
+  const auto numQueries = config->get<std::size_t>("experiment/numQueries");
+  const auto openingAngle = config->get<double>("experiment/openingAngle");
+  ompl::RNG rng;
+
+  // Sample the query points up front, such that all potentials are evaluated at the same points.
+  std::vector<double> queries(numQueries * dimension);
+  for (auto& coordinate : queries) {
+    coordinate = rng.uniformReal(-0.5, 0.5);
+  }
+
+  for (const auto numSources : config->get<std::vector<std::size_t>>("experiment/numSources")) {
+    // Sample the sources uniformly in the unit cube.
+    std::vector<std::vector<double>> sources(numSources, std::vector<double>(dimension));
+    for (auto& source : sources) {
+      for (auto& coordinate : source) {
+        coordinate = rng.uniformReal(-0.5, 0.5);
+      }
+    }
+    pdt::objectives::PointSourceTree tree(sources, openingAngle);
+
+    // The reference sums all sources one by one, like the objective used to.
+    std::vector<double> referencePotentials(numQueries, 0.0);
+    auto start = pdt::time::Clock::now();
+    for (std::size_t i = 0u; i < numQueries; ++i) {
+      for (const auto& source : sources) {
+        double squaredDistance = 0.0;
+        for (std::size_t dim = 0u; dim < dimension; ++dim) {
+          squaredDistance += std::pow(source[dim] - queries[i * dimension + dim], 2.0);
+        }
+        referencePotentials[i] += std::min(1.0 / squaredDistance, 1000.0);
+      }
+    }
+    const auto referenceDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+
+    // The exact path of the tree sums blocks of sources at once.
+    std::vector<double> exactPotentials(numQueries);
+    start = pdt::time::Clock::now();
+    for (std::size_t i = 0u; i < numQueries; ++i) {
+      exactPotentials[i] = tree.exactPotential(&queries[i * dimension]);
+    }
+    const auto exactDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+
+    // The tree approximates far clusters.
+    std::vector<double> treePotentials(numQueries);
+    start = pdt::time::Clock::now();
+    for (std::size_t i = 0u; i < numQueries; ++i) {
+      treePotentials[i] = tree.potential(&queries[i * dimension]);
+    }
+    const auto treeDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+
+    // Compute the largest relative errors with respect to the reference.
+    double maxExactError = 0.0;
+    double maxTreeError = 0.0;
+    for (std::size_t i = 0u; i < numQueries; ++i) {
+      const auto reference = referencePotentials[i];
+      maxExactError =
+          std::max(maxExactError, std::abs(exactPotentials[i] - reference) / reference);
+      maxTreeError = std::max(maxTreeError, std::abs(treePotentials[i] - reference) / reference);
+    }
+
+    const auto numEvaluations = static_cast<double>(numQueries);
+    std::cout << "\nSources: " << numSources
+              << "\n\tReference throughput [1/s]: " << numEvaluations / referenceDuration
+              << "\n\tExact throughput [1/s]: " << numEvaluations / exactDuration
+              << "\n\tTree throughput [1/s]: " << numEvaluations / treeDuration
+              << "\n\tExact max relative error: " << maxExactError
+              << "\n\tTree max relative error: " << maxTreeError << '\n';
+  }
+  std::cout << '\n';
+
+  config->dumpAccessed();
+
+  return 0;
+}
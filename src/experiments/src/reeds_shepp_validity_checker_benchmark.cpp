@@ -0,0 +1,209 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <ompl/base/ScopedState.h>
+#include <ompl/base/SpaceInformation.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+#include <ompl/base/spaces/ReedsSheppStateSpace.h>
+#include <ompl/util/RandomNumbers.h>
+
+#include "pdt/config/configuration.h"
+#include "pdt/obstacles/base_obstacle.h"
+#include "pdt/obstacles/hyperrectangle.h"
+#include "pdt/planning_contexts/reeds_shepp_validity_checker.h"
+#include "pdt/time/time.h"
+
+namespace {
+
+using Point = std::array<double, 2u>;
+using Rectangle = pdt::obstacles::Hyperrectangle<pdt::obstacles::BaseObstacle>;
+
+// The width and length of the car of the Reeds-Shepp validity checker.
+constexpr double CAR_WIDTH{0.02};
+constexpr double CAR_LENGTH{0.04};
+
+// Returns whether the car intersects the rectangle, by projecting the corners of both onto the
+// four axes, one obstacle at a time. This is the test the Reeds-Shepp validity checker used to do.
+bool intersectsReference(double x, double y, double yaw, const Rectangle& obs) {
+  const auto anchor = obs.getAnchor();
+  const auto halfWidth = obs.getWidths().at(0u) / 2.0;
+  const auto halfHeight = obs.getWidths().at(1u) / 2.0;
+  const std::array<Point, 4u> obsCorners{{{anchor[0u] - halfWidth, anchor[1u] + halfHeight},
+                                          {anchor[0u] + halfWidth, anchor[1u] + halfHeight},
+                                          {anchor[0u] + halfWidth, anchor[1u] - halfHeight},
+                                          {anchor[0u] - halfWidth, anchor[1u] - halfHeight}}};
+  const std::array<Point, 4u> carCornersCar{{{CAR_LENGTH / 2.0, -CAR_WIDTH / 2.0},
+                                             {CAR_LENGTH / 2.0, CAR_WIDTH / 2.0},
+                                             {-CAR_LENGTH / 2.0, CAR_WIDTH / 2.0},
+                                             {-CAR_LENGTH / 2.0, -CAR_WIDTH / 2.0}}};
+  std::array<Point, 4u> carCorners{};
+  for (auto i = 0u; i < 4u; ++i) {
+    const auto psi = std::atan2(carCornersCar[i][1u], carCornersCar[i][0u]);
+    const auto rad = std::hypot(carCornersCar[i][0u], carCornersCar[i][1u]);
+    carCorners[i] = {rad * std::cos(yaw + psi) + x, rad * std::sin(yaw + psi) + y};
+  }
+  const std::array<Point, 4u> axes{
+      {{obsCorners[1u][0u] - obsCorners[0u][0u], obsCorners[1u][1u] - obsCorners[0u][1u]},
+       {obsCorners[1u][0u] - obsCorners[2u][0u], obsCorners[1u][1u] - obsCorners[2u][1u]},
+       {carCorners[0u][0u] - carCorners[3u][0u], carCorners[0u][1u] - carCorners[3u][1u]},
+       {carCorners[0u][0u] - carCorners[1u][0u], carCorners[0u][1u] - carCorners[1u][1u]}}};
+  const auto project = [](const Point& point, const Point& axis) {
+    const auto fraction = (point[0u] * axis[0u] + point[1u] * axis[1u]) /
+                          (axis[0u] * axis[0u] + axis[1u] * axis[1u]);
+    return fraction * (axis[0u] * axis[0u] + axis[1u] * axis[1u]);
+  };
+  for (const auto& axis : axes) {
+    std::array<double, 4u> car{};
+    std::array<double, 4u> obstacle{};
+    for (auto i = 0u; i < 4u; ++i) {
+      car[i] = project(carCorners[i], axis);
+      obstacle[i] = project(obsCorners[i], axis);
+    }
+    const auto [minCar, maxCar] = std::minmax_element(car.begin(), car.end());
+    const auto [minObs, maxObs] = std::minmax_element(obstacle.begin(), obstacle.end());
+    if (*maxCar < *minObs || *maxObs < *minCar) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(const int argc, const char** argv) {
+  // Read the config files.
+  auto config = std::make_shared<pdt::config::Configuration>(argc, argv);
+  config->registerAsExperiment();
+
+  std::cout << "seed: " << config->get<std::size_t>("experiment/seed") << std::endl;
+
+  const auto numStates = config->get<std::size_t>("experiment/numStates");
+  const auto minSideLength = config->get<double>("experiment/minSideLength");
+  const auto maxSideLength = config->get<double>("experiment/maxSideLength");
+  ompl::RNG rng;
+
+  // The cars live in the unit square, like in the ReedsSheppRandomRectangles context.
+  auto space = std::make_shared<ompl::base::ReedsSheppStateSpace>();
+  ompl::base::RealVectorBounds bounds(2u);
+  bounds.setLow(-0.5);
+  bounds.setHigh(0.5);
+  space->setBounds(bounds);
+  auto spaceInfo = std::make_shared<ompl::base::SpaceInformation>(space);
+  auto positionSpaceInfo = std::make_shared<ompl::base::SpaceInformation>(space->getSubspace(0u));
+  spaceInfo->setup();
+
+  // Sample the states up front.
+  std::vector<ompl::base::ScopedState<>> states;
+  states.reserve(numStates);
+  for (std::size_t i = 0u; i < numStates; ++i) {
+    states.emplace_back(spaceInfo);
+    states.back().random();
+  }
+
+  for (const auto numObstacles : config->get<std::vector<std::size_t>>("experiment/numObstacles")) {
+    std::vector<std::shared_ptr<pdt::obstacles::BaseObstacle>> obstacles;
+    obstacles.reserve(numObstacles);
+    for (std::size_t i = 0u; i < numObstacles; ++i) {
+      ompl::base::ScopedState<> anchor(positionSpaceInfo);
+      anchor.random();
+      obstacles.push_back(std::make_shared<Rectangle>(
+          positionSpaceInfo, anchor,
+          std::vector<double>{rng.uniformReal(minSideLength, maxSideLength),
+                              rng.uniformReal(minSideLength, maxSideLength)}));
+    }
+
+    auto start = pdt::time::Clock::now();
+    pdt::planning_contexts::ReedsSheppValidityChecker checker(spaceInfo);
+    checker.addObstacles(obstacles);
+    const auto buildDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+
+    std::vector<bool> isValid(numStates);
+    start = pdt::time::Clock::now();
+    for (std::size_t i = 0u; i < numStates; ++i) {
+      isValid[i] = checker.isValid(states[i].get());
+    }
+    const auto checkerDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+
+    // The reference checks every obstacle whose circumcircle overlaps the one of the car.
+    std::vector<bool> isValidReference(numStates, true);
+    const auto carCircumradius = std::hypot(CAR_WIDTH, CAR_LENGTH) / 2.0;
+    start = pdt::time::Clock::now();
+    for (std::size_t i = 0u; i < numStates; ++i) {
+      const auto state = states[i]->as<ompl::base::SE2StateSpace::StateType>();
+      for (const auto& obstacle : obstacles) {
+        const auto rectangle = std::static_pointer_cast<Rectangle>(obstacle);
+        const auto anchor = rectangle->getAnchor();
+        if (std::hypot(anchor[0u] - state->getX(), anchor[1u] - state->getY()) >=
+            rectangle->getCircumradius() + carCircumradius) {
+          continue;
+        }
+        if (intersectsReference(state->getX(), state->getY(), state->getYaw(), *rectangle)) {
+          isValidReference[i] = false;
+          break;
+        }
+      }
+    }
+    const auto referenceDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+
+    std::size_t numMismatches = 0u;
+    std::size_t numInvalid = 0u;
+    for (std::size_t i = 0u; i < numStates; ++i) {
+      numMismatches += isValid[i] != isValidReference[i] ? 1u : 0u;
+      numInvalid += isValid[i] ? 0u : 1u;
+    }
+
+    std::cout << "\nObstacles: " << numObstacles << "\n\tBuild time [s]: " << buildDuration
+              << "\n\tChecker throughput [1/s]: "
+              << static_cast<double>(numStates) / checkerDuration
+              << "\n\tReference throughput [1/s]: "
+              << static_cast<double>(numStates) / referenceDuration
+              << "\n\tInvalid states: " << numInvalid << "\n\tMismatches: " << numMismatches
+              << '\n';
+  }
+  std::cout << '\n';
+
+  config->dumpAccessed();
+
+  return 0;
+}
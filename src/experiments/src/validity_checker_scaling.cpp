@@ -0,0 +1,162 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ompl/base/ScopedState.h>
+#include <ompl/base/SpaceInformation.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+#include <ompl/util/RandomNumbers.h>
+
+#include "pdt/config/configuration.h"
+#include "pdt/obstacles/base_obstacle.h"
+#include "pdt/obstacles/hyperrectangle.h"
+#include "pdt/planning_contexts/context_validity_checker.h"
+#include "pdt/planning_contexts/context_validity_checker_bvh.h"
+#include "pdt/planning_contexts/context_validity_checker_gnat.h"
+#include "pdt/time/time.h"
+
+using namespace std::string_literals;
+
+namespace {
+
+// The results of timing one validity checker on one set of obstacles.
+struct CheckerTiming {
+  double buildDuration{0.0};
+  double meanQueryDuration{0.0};
+  std::size_t numInvalid{0u};
+};
+
+// Adds the obstacles to the checker and checks all states.
+CheckerTiming timeChecker(
+    const std::shared_ptr<pdt::planning_contexts::ContextValidityChecker>& checker,
+    const std::vector<std::shared_ptr<pdt::obstacles::BaseObstacle>>& obstacles,
+    const std::vector<ompl::base::ScopedState<>>& states) {
+  CheckerTiming timing;
+  auto start = pdt::time::Clock::now();
+  checker->addObstacles(obstacles);
+  timing.buildDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+
+  start = pdt::time::Clock::now();
+  for (const auto& state : states) {
+    if (!checker->isValid(state.get())) {
+      ++timing.numInvalid;
+    }
+  }
+  timing.meanQueryDuration =
+      pdt::time::seconds(pdt::time::Clock::now() - start) / static_cast<double>(states.size());
+  return timing;
+}
+
+}  // namespace
+
+int main(const int argc, const char** argv) {
+  // Read the config files.
+  auto config = std::make_shared<pdt::config::Configuration>(argc, argv);
+  config->registerAsExperiment();
+
+  const auto dimension = config->get<std::size_t>("experiment/dimensions");
+  const auto obstacleCounts = config->get<std::vector<std::size_t>>("experiment/obstacleCounts");
+  const auto numQueries = config->get<std::size_t>("experiment/numQueries");
+  const auto minSideLength = config->get<double>("experiment/minSideLength");
+  const auto maxSideLength = config->get<double>("experiment/maxSideLength");
+  const auto maxLinearObstacles = config->get<std::size_t>("experiment/maxLinearObstacles");
+  const auto maxGnatObstacles = config->get<std::size_t>("experiment/maxGnatObstacles");
+
+  std::cout << "seed: " << config->get<std::size_t>("experiment/seed") << std::endl;
+
+  // Create the state space. This is the unit hypercube, like the random rectangles contexts.
+  auto space = std::make_shared<ompl::base::RealVectorStateSpace>(static_cast<unsigned>(dimension));
+  space->setBounds(-0.5, 0.5);
+  auto spaceInfo = std::make_shared<ompl::base::SpaceInformation>(space);
+  spaceInfo->setStateValidityChecker([](const ompl::base::State*) { return true; });
+  spaceInfo->setup();
+
+  ompl::RNG rng;
+  for (const auto numObstacles : obstacleCounts) {
+    // Create the obstacles.
+    std::vector<std::shared_ptr<pdt::obstacles::BaseObstacle>> obstacles;
+    obstacles.reserve(numObstacles);
+    while (obstacles.size() < numObstacles) {
+      ompl::base::ScopedState<> anchor(spaceInfo);
+      anchor.random();
+      std::vector<double> widths(dimension, 0.0);
+      for (auto& width : widths) {
+        width = rng.uniformReal(minSideLength, maxSideLength);
+      }
+      obstacles.emplace_back(
+          std::make_shared<pdt::obstacles::Hyperrectangle<pdt::obstacles::BaseObstacle>>(
+              spaceInfo, anchor, widths));
+    }
+
+    // Create the query states.
+    std::vector<ompl::base::ScopedState<>> states(numQueries, ompl::base::ScopedState<>(space));
+    for (auto& state : states) {
+      state.random();
+    }
+
+    std::cout << "\nObstacles: " << numObstacles << "\n";
+    auto report = [&states](const std::string& name, const CheckerTiming& timing) {
+      std::cout << "  " << name << "\tBuild [s]: " << std::fixed << timing.buildDuration
+                << "\tQuery mean [us]: " << 1e6 * timing.meanQueryDuration
+                << "\tInvalid: " << timing.numInvalid << " / " << states.size() << "\n";
+    };
+
+    // The linear and GNAT checkers are too slow to build or query with very many obstacles.
+    if (numObstacles <= maxLinearObstacles) {
+      report("Linear", timeChecker(std::make_shared<pdt::planning_contexts::ContextValidityChecker>(
+                                       spaceInfo),
+                                   obstacles, states));
+    }
+    if (numObstacles <= maxGnatObstacles) {
+      report("GNAT",
+             timeChecker(std::make_shared<pdt::planning_contexts::ContextValidityCheckerGNAT>(
+                             spaceInfo),
+                         obstacles, states));
+    }
+    report("BVH", timeChecker(std::make_shared<pdt::planning_contexts::ContextValidityCheckerBVH>(
+                                  spaceInfo),
+                              obstacles, states));
+  }
+
+  config->dumpAccessed();
+
+  return 0;
+}
@@ -0,0 +1,173 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <ompl/util/RandomNumbers.h>
+
+#include "pdt/config/configuration.h"
+#include "pdt/obstacles/voxel_map.h"
+#include "pdt/time/time.h"
+
+namespace {
+
+// A warehouse with two blocks of shelving racks in a grid of n x n x n / 2 voxels, where n is a
+// multiple of 128. The racks consist of shelves on posts and are separated by aisles.
+bool isInWarehouse(const std::array<std::size_t, 3u>& voxel, std::size_t n) {
+  const auto s = n / 128u;
+  const auto [x, y, z] = voxel;
+  if (z >= 48u * s || x < 8u * s || x >= 120u * s) {
+    return false;
+  }
+  if (!((y >= 16u * s && y < 56u * s) || (y >= 72u * s && y < 112u * s))) {
+    return false;
+  }
+  const auto rackX = (x - 8u * s) % (20u * s);
+  if (rackX >= 6u * s) {
+    return false;
+  }
+  return z % (16u * s) < 2u * s || (y % (8u * s) < s && (rackX < s || rackX >= 5u * s));
+}
+
+}  // namespace
+
+int main(const int argc, const char** argv) {
+  // Read the config files.
+  auto config = std::make_shared<pdt::config::Configuration>(argc, argv);
+  config->registerAsExperiment();
+
+  std::cout << "seed: " << config->get<std::size_t>("experiment/seed") << std::endl;
+
+  const auto numQueries = config->get<std::size_t>("experiment/numQueries");
+  const auto numClearanceQueries = config->get<std::size_t>("experiment/numClearanceQueries");
+  const auto segmentLength = config->get<double>("experiment/segmentLength");
+  ompl::RNG rng;
+
+  for (const auto n : config->get<std::vector<std::size_t>>("experiment/sideLengths")) {
+    if (n == 0u || n % 128u != 0u) {
+      std::cout << "\nSkipping side length " << n << ", which is not a multiple of 128.\n";
+      continue;
+    }
+    const std::array<std::size_t, 3u> numVoxels{n, n, n / 2u};
+
+    // Build the map voxel by voxel, the way a loader would.
+    auto start = pdt::time::Clock::now();
+    pdt::obstacles::VoxelMap map(numVoxels);
+    for (std::size_t z = 0u; z < numVoxels[2u]; ++z) {
+      for (std::size_t y = 0u; y < numVoxels[1u]; ++y) {
+        for (std::size_t x = 0u; x < numVoxels[0u]; ++x) {
+          if (isInWarehouse({x, y, z}, n)) {
+            map.setOccupied({x, y, z}, true);
+          }
+        }
+      }
+    }
+    map.compact();
+    const auto buildDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+
+    // Sample the queries in voxel coordinates up front.
+    std::vector<std::array<double, 3u>> points(numQueries);
+    std::vector<std::array<double, 3u>> ends(numQueries);
+    for (std::size_t i = 0u; i < numQueries; ++i) {
+      for (auto dim = 0u; dim < 3u; ++dim) {
+        const auto upper = static_cast<double>(numVoxels[dim]);
+        points[i][dim] = rng.uniformReal(0.0, upper);
+        ends[i][dim] = std::clamp(
+            points[i][dim] + rng.uniformReal(-0.5, 0.5) * segmentLength * static_cast<double>(n),
+            0.0, upper);
+      }
+    }
+
+    // Points are checked against the definition of the warehouse.
+    std::size_t numMismatches = 0u;
+    std::size_t numOccupied = 0u;
+    start = pdt::time::Clock::now();
+    for (const auto& point : points) {
+      numOccupied += map.isOccupied(point.data()) ? 1u : 0u;
+    }
+    const auto pointDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+    for (const auto& point : points) {
+      const std::array<std::size_t, 3u> voxel{static_cast<std::size_t>(point[0u]),
+                                              static_cast<std::size_t>(point[1u]),
+                                              static_cast<std::size_t>(point[2u])};
+      if (map.isOccupied(point.data()) != isInWarehouse(voxel, n)) {
+        ++numMismatches;
+      }
+    }
+
+    std::size_t numBlocked = 0u;
+    start = pdt::time::Clock::now();
+    for (std::size_t i = 0u; i < numQueries; ++i) {
+      numBlocked += std::isinf(map.findFirstOccupied(points[i].data(), ends[i].data())) ? 0u : 1u;
+    }
+    const auto segmentDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+
+    const std::array<double, 3u> voxelSideLengths{1.0, 1.0, 1.0};
+    double sumClearance = 0.0;
+    start = pdt::time::Clock::now();
+    for (std::size_t i = 0u; i < std::min(numClearanceQueries, numQueries); ++i) {
+      sumClearance += map.computeClearance(points[i].data(), voxelSideLengths.data());
+    }
+    const auto clearanceDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+
+    const auto numVoxelsTotal = numVoxels[0u] * numVoxels[1u] * numVoxels[2u];
+    std::cout << "\nVoxels: " << numVoxelsTotal << " (" << n << " x " << n << " x " << n / 2u
+              << ")\n\tOccupied voxels: " << map.countOccupied()
+              << "\n\tBuild time [s]: " << buildDuration
+              << "\n\tMemory [MB]: " << static_cast<double>(map.getNumBytes()) / 1e6
+              << "\n\tDense bit grid memory [MB]: " << static_cast<double>(numVoxelsTotal) / 8e6
+              << "\n\tPoint throughput [1/s]: " << static_cast<double>(numQueries) / pointDuration
+              << "\n\tPoint mismatches: " << numMismatches
+              << "\n\tOccupied points: " << numOccupied
+              << "\n\tSegment throughput [1/s]: "
+              << static_cast<double>(numQueries) / segmentDuration
+              << "\n\tBlocked segments: " << numBlocked << "\n\tClearance throughput [1/s]: "
+              << static_cast<double>(std::min(numClearanceQueries, numQueries)) / clearanceDuration
+              << "\n\tMean clearance [voxels]: "
+              << sumClearance / static_cast<double>(std::min(numClearanceQueries, numQueries))
+              << '\n';
+  }
+  std::cout << '\n';
+
+  config->dumpAccessed();
+
+  return 0;
+}
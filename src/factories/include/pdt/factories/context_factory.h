@@ -54,10 +54,21 @@ class ContextFactory {
   ContextFactory(const std::shared_ptr<const config::Configuration> &config);
   ~ContextFactory() = default;
 
-  /** \brief Creates a context. */
+  /** \brief Creates a context, which is instrumented if the experiment asks for it. */
   std::shared_ptr<planning_contexts::BaseContext> create(const std::string &contextName) const;
 
  private:
+  /** \brief Allocates a context of the type specified in the config. */
+  std::shared_ptr<planning_contexts::BaseContext> allocate(const std::string &contextName) const;
+
+  /** \brief Restores a context from its snapshot if the config asks for one and the snapshot
+   * matches the config. Otherwise creates the context and writes the snapshot if the config asks
+   * for one. */
+  template <typename Context>
+  std::shared_ptr<Context> allocateWithSnapshot(
+      const std::shared_ptr<ompl::base::SpaceInformation> &spaceInfo,
+      const std::string &contextName) const;
+
   /** \brief Create a space info with a real vector state space. */
   std::shared_ptr<ompl::base::SpaceInformation> createRealVectorSpaceInfo(
       const std::string &parentKey) const;
@@ -37,6 +37,8 @@
 
 #include "pdt/factories/context_factory.h"
 
+#include <experimental/filesystem>
+
 #include <ompl/base/StateSpace.h>
 #include <ompl/base/spaces/RealVectorStateSpace.h>
 #include <ompl/base/spaces/ReedsSheppStateSpace.h>
@@ -47,14 +49,19 @@
 #include "nlohmann/json.hpp"
 
 #include "pdt/common/context_type.h"
+#include "pdt/config/directory.h"
+#include "pdt/obstacles/distance_field.h"
 #include "pdt/planning_contexts/all_contexts.h"
+#include "pdt/planning_contexts/bisection_motion_validator.h"
+#include "pdt/planning_contexts/context_snapshot.h"
+#include "pdt/spaces/SE3WAxisAngleBoundStateSpace.h"
+#include "pdt/time/time.h"
 
 #ifdef PDT_OPEN_RAVE
 #include "pdt/open_rave/open_rave_manipulator.h"
 #include "pdt/open_rave/open_rave_r3.h"
 #include "pdt/open_rave/open_rave_r3xso2.h"
 #include "pdt/open_rave/open_rave_se3.h"
-#include "pdt/spaces/SE3WAxisAngleBoundStateSpace.h"
 #endif
 
 namespace pdt {
@@ -62,6 +69,7 @@ namespace pdt {
 namespace factories {
 
 using namespace std::string_literals;
+namespace fs = std::experimental::filesystem;
 namespace json = nlohmann;
 
 ContextFactory::ContextFactory(const std::shared_ptr<const config::Configuration>& config) :
@@ -74,6 +82,72 @@ ContextFactory::ContextFactory(const std::shared_ptr<const config::Configuration
 
 std::shared_ptr<planning_contexts::BaseContext> ContextFactory::create(
     const std::string& contextName) const {
+  auto context = allocate(contextName);
+
+  // Replace the discrete motion validator if requested.
+  const std::string validatorKey{"context/" + contextName + "/motionValidator"};
+  if (config_->contains(validatorKey)) {
+    const auto validatorType = config_->get<std::string>(validatorKey);
+    if (validatorType == "bisection"s) {
+      auto spaceInfo = context->getSpaceInformation();
+      spaceInfo->setMotionValidator(
+          std::make_shared<planning_contexts::BisectionMotionValidator>(spaceInfo));
+      spaceInfo->setup();
+    } else if (validatorType == "exact"s) {
+      auto geometricContext =
+          std::dynamic_pointer_cast<planning_contexts::RealVectorGeometricContext>(context);
+      if (!geometricContext) {
+        throw std::invalid_argument("Context '"s + contextName +
+                                    "' does not support exact motion validation."s);
+      }
+      geometricContext->useExactMotionValidation();
+    } else if (validatorType != "discrete"s) {
+      throw std::invalid_argument("Requested unknown motion validator '"s + validatorType +
+                                  "'."s);
+    }
+  }
+
+  // Approximate the clearance with a distance field if requested, unless it cannot be as precise as
+  // requested.
+  const std::string resolutionKey{"context/" + contextName + "/distanceFieldResolution"};
+  if (config_->contains(resolutionKey)) {
+    auto geometricContext =
+        std::dynamic_pointer_cast<planning_contexts::RealVectorGeometricContext>(context);
+    if (!geometricContext) {
+      throw std::invalid_argument("Context '"s + contextName +
+                                  "' does not support distance fields."s);
+    }
+    const auto resolution = config_->get<double>(resolutionKey);
+    const std::string toleranceKey{"context/" + contextName + "/clearanceTolerance"};
+    if (config_->contains(toleranceKey) &&
+        obstacles::DistanceField::computeErrorBound(context->getDimension(), resolution) >
+            config_->get<double>(toleranceKey)) {
+      OMPL_INFORM("%s: A distance field with resolution %f is not precise enough, using the exact "
+                  "clearance.",
+                  contextName.c_str(), resolution);
+    } else {
+      geometricContext->useDistanceField(resolution);
+    }
+  }
+
+  // Only contexts whose generated parts are hyperrectangles and states can be snapshotted.
+  if (config_->contains("context/" + contextName + "/snapshot") &&
+      !std::dynamic_pointer_cast<planning_contexts::RandomRectangles>(context) &&
+      !std::dynamic_pointer_cast<planning_contexts::RandomRectanglesMultiStartGoal>(context)) {
+    throw std::invalid_argument("Context '"s + contextName + "' does not support snapshots."s);
+  }
+
+  // Count and time the calls to the validity checker, motion validator, and objective if requested.
+  if (config_->contains("experiment/instrumentation") &&
+      config_->get<bool>("experiment/instrumentation")) {
+    context->instrument();
+  }
+
+  return context;
+}
+
+std::shared_ptr<planning_contexts::BaseContext> ContextFactory::allocate(
+    const std::string& contextName) const {
   // Generate the parent key for convenient lookups in the config.
   const std::string parentKey{"context/" + contextName};
 
@@ -141,6 +215,30 @@ std::shared_ptr<planning_contexts::BaseContext> ContextFactory::create(
         throw std::runtime_error(msg);
       }
     }
+    case common::CONTEXT_TYPE::MESH_R3: {
+      try {
+        return std::make_shared<planning_contexts::MeshR3>(createRealVectorSpaceInfo(parentKey),
+                                                           config_, contextName);
+      } catch (const json::detail::type_error& e) {
+        auto msg = "Error allocating a MeshR3 context with exception:\n    "s + e.what();
+        throw std::runtime_error(msg);
+      }
+    }
+    case common::CONTEXT_TYPE::MESH_SE3: {
+      try {
+        // Allocate an SE3 state space with bounded rotations.
+        // The bounds of the translational part are set in the context.
+        auto stateSpace = std::make_shared<spaces::SE3WAxisAngleBoundStateSpace>();
+        stateSpace->setMaxRotation(config_->get<double>(parentKey + "/maxRotation"));
+
+        // Allocate the state information for this space.
+        auto spaceInfo = std::make_shared<ompl::base::SpaceInformation>(stateSpace);
+        return std::make_shared<planning_contexts::MeshSE3>(spaceInfo, config_, contextName);
+      } catch (const json::detail::type_error& e) {
+        auto msg = "Error allocating a MeshSE3 context with exception:\n    "s + e.what();
+        throw std::runtime_error(msg);
+      }
+    }
     case common::CONTEXT_TYPE::NARROW_PASSAGE: {
       try {
         return std::make_shared<planning_contexts::NarrowPassage>(
@@ -159,6 +257,15 @@ std::shared_ptr<planning_contexts::BaseContext> ContextFactory::create(
         throw std::runtime_error(msg);
       }
     }
+    case common::CONTEXT_TYPE::OCCUPANCY_GRID: {
+      try {
+        return std::make_shared<planning_contexts::OccupancyGrid>(
+            createRealVectorSpaceInfo(parentKey), config_, contextName);
+      } catch (const json::detail::type_error& e) {
+        auto msg = "Error allocating an OccupancyGrid context with exception:\n    "s + e.what();
+        throw std::runtime_error(msg);
+      }
+    }
 #ifdef PDT_OPEN_RAVE
     case common::CONTEXT_TYPE::OPEN_RAVE_MANIPULATOR: {
       try {
@@ -245,8 +352,8 @@ std::shared_ptr<planning_contexts::BaseContext> ContextFactory::create(
 #endif
     case common::CONTEXT_TYPE::RANDOM_RECTANGLES: {
       try {
-        return std::make_shared<planning_contexts::RandomRectangles>(
-            createRealVectorSpaceInfo(parentKey), config_, contextName);
+        return allocateWithSnapshot<planning_contexts::RandomRectangles>(
+            createRealVectorSpaceInfo(parentKey), contextName);
       } catch (const json::detail::type_error& e) {
         auto msg = "Error allocating a RandomRectangles context with exception:\n    "s + e.what();
         throw std::runtime_error(msg);
@@ -254,8 +361,8 @@ std::shared_ptr<planning_contexts::BaseContext> ContextFactory::create(
     }
     case common::CONTEXT_TYPE::RANDOM_RECTANGLES_MULTI_START_GOAL: {
       try {
-        return std::make_shared<planning_contexts::RandomRectanglesMultiStartGoal>(
-            createRealVectorSpaceInfo(parentKey), config_, contextName);
+        return allocateWithSnapshot<planning_contexts::RandomRectanglesMultiStartGoal>(
+            createRealVectorSpaceInfo(parentKey), contextName);
       } catch (const json::detail::type_error& e) {
         auto msg =
             "Error allocating a RandomRectanglesMultiStartGoal context with exception:\n    "s +
@@ -292,6 +399,15 @@ std::shared_ptr<planning_contexts::BaseContext> ContextFactory::create(
         throw std::runtime_error(msg);
       }
     }
+    case common::CONTEXT_TYPE::VOXEL_GRID: {
+      try {
+        return std::make_shared<planning_contexts::VoxelGrid>(
+            createRealVectorSpaceInfo(parentKey), config_, contextName);
+      } catch (const json::detail::type_error& e) {
+        auto msg = "Error allocating a VoxelGrid context with exception:\n    "s + e.what();
+        throw std::runtime_error(msg);
+      }
+    }
     case common::CONTEXT_TYPE::WALL_GAP: {
       try {
         return std::make_shared<planning_contexts::WallGap>(createRealVectorSpaceInfo(parentKey),
@@ -308,6 +424,49 @@ std::shared_ptr<planning_contexts::BaseContext> ContextFactory::create(
   }
 }
 
+template <typename Context>
+std::shared_ptr<Context> ContextFactory::allocateWithSnapshot(
+    const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
+    const std::string& contextName) const {
+  const std::string snapshotKey{"context/" + contextName + "/snapshot"};
+  if (!config_->contains(snapshotKey)) {
+    return std::make_shared<Context>(spaceInfo, config_, contextName);
+  }
+
+  // Relative paths are relative to the source directory, like all other files of contexts.
+  fs::path path(config_->get<std::string>(snapshotKey));
+  if (path.is_relative()) {
+    path = config::Directory::SOURCE / path;
+  }
+  const auto configHash = planning_contexts::context_snapshot::computeConfigHash(*config_,
+                                                                                 contextName);
+
+  // Restore the context if its snapshot belongs to this config.
+  if (fs::exists(path)) {
+    try {
+      const auto start = time::Clock::now();
+      planning_contexts::context_snapshot::Reader snapshot(path);
+      if (snapshot.getConfigHash() == configHash) {
+        auto context = std::make_shared<Context>(spaceInfo, config_, contextName, snapshot);
+        OMPL_INFORM("%s: Restored from snapshot '%s' in %.3f ms.", contextName.c_str(),
+                    path.c_str(), 1e3 * time::seconds(time::Clock::now() - start));
+        return context;
+      }
+      OMPL_WARN("%s: Snapshot '%s' is stale, regenerating it.", contextName.c_str(),
+                path.c_str());
+    } catch (const std::ios_base::failure& error) {
+      OMPL_WARN("%s: Could not read snapshot, regenerating it. %s", contextName.c_str(),
+                error.what());
+    }
+  }
+
+  // Otherwise generate the context and write its snapshot.
+  auto context = std::make_shared<Context>(spaceInfo, config_, contextName);
+  planning_contexts::context_snapshot::write(path, *context, configHash);
+  OMPL_INFORM("%s: Wrote snapshot '%s'.", contextName.c_str(), path.c_str());
+  return context;
+}
+
 std::shared_ptr<ompl::base::SpaceInformation> ContextFactory::createRealVectorSpaceInfo(
     const std::string& parentKey) const {
   assert(config_->get<std::vector<double>>(parentKey + "/boundarySideLengths").size() ==
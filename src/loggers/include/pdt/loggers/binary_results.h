@@ -0,0 +1,140 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <experimental/filesystem>
+
+namespace pdt {
+
+namespace loggers {
+
+/** \brief The binary results container stores the measured runs of a query in a compact form:
+ * A header, followed by one record per run. A record holds the length of the planner name and the
+ * number of measurements, followed by the name, the durations and the costs, and ends with a
+ * trailer that points back to its beginning. Runs are only ever appended behind the last complete
+ * record, so an interrupted append can at most leave an incomplete last record, which readers
+ * ignore and the next append replaces. All offsets are in bytes from the beginning of the file and
+ * all arrays are aligned to eight bytes, such that the file can be memory mapped and read in
+ * place. */
+namespace binary_results {
+
+/** \brief The magic bytes at the beginning of every binary results file. */
+constexpr char MAGIC[8] = {'P', 'D', 'T', 'R', 'E', 'S', '\0', '\0'};
+
+/** \brief The magic bytes at the end of every complete record. */
+constexpr char RECORD_MAGIC[8] = {'P', 'D', 'T', 'R', 'U', 'N', '\0', '\0'};
+
+/** \brief The version of the format. */
+constexpr std::uint64_t VERSION = 2u;
+
+/** \brief The file extension of binary results files. */
+constexpr auto EXTENSION = ".bin";
+
+/** \brief The header at the beginning of the file. */
+struct Header {
+  char magic[8];
+  std::uint64_t version;
+};
+
+/** \brief The beginning of a record, one per run. */
+struct RecordHeader {
+  std::uint64_t nameLength;
+  std::uint64_t numMeasurements;
+};
+
+/** \brief The end of a record, which marks it as complete. */
+struct RecordTrailer {
+  std::uint64_t recordOffset;
+  char magic[8];
+};
+
+/** \brief The location of the parts of a record, which readers collect when they open a file. */
+struct IndexEntry {
+  std::uint64_t nameOffset;
+  std::uint64_t nameLength;
+  std::uint64_t numMeasurements;
+  std::uint64_t durationsOffset;
+  std::uint64_t costsOffset;
+};
+
+/** \brief Checks whether a file is a binary results file by its magic bytes. */
+bool isBinaryResultsFile(const std::experimental::filesystem::path& path);
+
+/** \brief Appends a run to the file and syncs it to disk. A new or empty file is initialized with
+ * a header. An incomplete last record is replaced by the new one. */
+void appendRun(const std::experimental::filesystem::path& path, const std::string& plannerName,
+               const std::vector<double>& durations, const std::vector<double>& costs);
+
+/** \brief A read-only, memory mapped view of a binary results file. */
+class Reader {
+ public:
+  Reader(const std::experimental::filesystem::path& path);
+  ~Reader();
+
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+
+  /** \brief The number of runs in the file. */
+  std::size_t getNumRuns() const;
+
+  /** \brief Access to the i-th run. The pointers are valid for the lifetime of the reader. */
+  std::string getPlannerName(std::size_t i) const;
+  std::size_t getNumMeasurements(std::size_t i) const;
+  const double* getDurations(std::size_t i) const;
+  const double* getCosts(std::size_t i) const;
+
+ private:
+  const IndexEntry& getEntry(std::size_t i) const;
+
+  /** \brief The mapped file. */
+  const char* data_{nullptr};
+  std::size_t size_{0u};
+
+  /** \brief The locations of the complete records within the mapped file. */
+  std::vector<IndexEntry> index_{};
+};
+
+}  // namespace binary_results
+
+}  // namespace loggers
+
+}  // namespace pdt
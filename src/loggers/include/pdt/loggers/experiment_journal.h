@@ -0,0 +1,136 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <experimental/filesystem>
+
+namespace pdt {
+
+namespace loggers {
+
+/** \brief The start and goal states of a query, each as the real values of the state. A query
+ * without goal states has a goal that is not made of states. */
+struct JournaledQuery {
+  std::vector<std::vector<double>> starts{};
+  std::vector<std::vector<double>> goals{};
+};
+
+/** \brief A journal of the progress of an experiment, which allows resuming it after it was
+ * interrupted. The first line of the journal records the seed of the experiment and the order in
+ * which the planners are run in each run. Every following line records a planner that completed
+ * its queries of a run or the queries of a run, if they are regenerated for every run. Lines are
+ * appended with a single write and synced to disk, so a crash can at most leave an incomplete last
+ * line, which is removed from the journal when it is loaded. The seed of every (run, planner) job
+ * is derived from the seed of the experiment, and OMPL's seed generator is reset to it before the
+ * planner of the job is allocated, such that a resumed experiment does not replay the random
+ * numbers of completed jobs. */
+class ExperimentJournal {
+ public:
+  /** \brief Starts a new journal. Throws if a journal already exists at the path. */
+  ExperimentJournal(const std::experimental::filesystem::path& path, std::size_t seed,
+                    const std::vector<std::vector<std::string>>& plannerOrders);
+
+  /** \brief Loads an existing journal. */
+  ExperimentJournal(const std::experimental::filesystem::path& path);
+
+  ~ExperimentJournal() = default;
+
+  /** \brief The seed of the journaled experiment. */
+  std::size_t getSeed() const;
+
+  /** \brief The order in which the planners are run, one order per run. */
+  const std::vector<std::vector<std::string>>& getPlannerOrders() const;
+
+  /** \brief Whether the planner completed the query of the run. */
+  bool isCompleted(std::size_t run, const std::string& plannerName, std::size_t query) const;
+
+  /** \brief The number of (run, planner) pairs for which all queries are completed. */
+  std::size_t getNumCompletedRuns() const;
+
+  /** \brief Records that the planner completed all queries of the run. The results of the run
+   * must already be synced to disk, such that the journal never claims runs that are lost. */
+  void markCompleted(std::size_t run, const std::string& plannerName, std::size_t numQueries);
+
+  /** \brief Records the queries of the run, such that a resumed experiment plans on the same
+   * queries. */
+  void recordQueries(std::size_t run, const std::vector<JournaledQuery>& queries);
+
+  /** \brief Whether the queries of the run are recorded. */
+  bool hasQueries(std::size_t run) const;
+
+  /** \brief The recorded queries of the run. */
+  const std::vector<JournaledQuery>& getQueries(std::size_t run) const;
+
+ private:
+  /** \brief Appends a line to the journal and syncs it to disk. */
+  void append(const std::string& line) const;
+
+  /** \brief The path to the journal. */
+  const std::experimental::filesystem::path path_;
+
+  /** \brief The seed of the experiment. */
+  std::size_t seed_{0u};
+
+  /** \brief The planner orders of all runs. */
+  std::vector<std::vector<std::string>> plannerOrders_{};
+
+  /** \brief The completed (run, planner, query) tuples. */
+  std::set<std::tuple<std::size_t, std::string, std::size_t>> completed_{};
+
+  /** \brief The number of completed (run, planner) pairs. */
+  std::size_t numCompletedRuns_{0u};
+
+  /** \brief The recorded queries of the runs. */
+  std::map<std::size_t, std::vector<JournaledQuery>> queries_{};
+};
+
+/** \brief Discards all but the first runs of a results file, e.g., runs that were logged after the
+ * last entry of the journal of an interrupted experiment. Every run of a csv file consists of the
+ * given number of lines. */
+void truncateResults(const std::experimental::filesystem::path& path, std::size_t numRuns,
+                     std::size_t numLinesPerRun = 2u);
+
+}  // namespace loggers
+
+}  // namespace pdt
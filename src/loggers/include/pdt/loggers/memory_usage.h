@@ -0,0 +1,75 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <experimental/filesystem>
+
+namespace pdt {
+
+namespace loggers {
+
+/** \brief The memory usage of a planner while it solved one query. */
+struct MemoryUsage {
+  /** \brief The change of the resident set size in bytes. */
+  std::int64_t residentSetSizeDelta{0};
+
+  /** \brief The peak resident set size in bytes. */
+  std::size_t peakResidentSetSize{0u};
+
+  /** \brief The number of allocations and allocated bytes, if allocations were counted. */
+  std::optional<std::size_t> numAllocations{};
+  std::optional<std::size_t> numAllocatedBytes{};
+};
+
+/** \brief Output the memory usage of a run as one line with the planner name as label. Allocation
+ * counts that are not available are written as nan. */
+std::string createMemoryUsageLogString(const std::string& plannerName, const MemoryUsage& usage);
+
+/** \brief Reads the memory usage of all runs logged to a file. */
+std::vector<std::pair<std::string, MemoryUsage>> readMemoryUsage(
+    const std::experimental::filesystem::path& path);
+
+}  // namespace loggers
+
+}  // namespace pdt
@@ -46,6 +46,7 @@
 
 #include <ompl/base/Cost.h>
 
+#include "pdt/loggers/binary_results.h"
 #include "pdt/time/time.h"
 
 namespace pdt {
@@ -91,7 +92,21 @@ class NullLogger {
   bool empty_;
 };
 
-/** \brief A vector of time & cost */
+/** \brief The number of calls to a function and the time spent in them. */
+struct CallCount {
+  std::size_t numCalls{0u};
+  time::Duration duration{0.0};
+};
+
+/** \brief The calls to the instrumented functions of a context. */
+struct CallCounts {
+  CallCount isValid{};
+  CallCount clearance{};
+  CallCount checkMotion{};
+  CallCount motionCost{};
+};
+
+/** \brief A vector of time & cost, optionally along with the call counts of the context. */
 class TimeCostLogger {
  public:
   using logData = std::pair<const time::Duration, const ompl::base::Cost>;
@@ -102,15 +117,39 @@ class TimeCostLogger {
   /** \brief Output the data with the appropriate label*/
   std::string createLogString(const std::string& labelPrefix) const;
 
+  /** \brief Output the data as separate arrays of durations and costs */
+  std::vector<double> getDurations() const;
+  std::vector<double> getCosts() const;
+
   /** \brief std::vector pass-throughs */
   bool empty() const { return measurements_.empty(); }
   void addMeasurement(const time::Duration& duration, const ompl::base::Cost& cost);
   logData lastMeasurement() { return measurements_.back(); };
 
+  /** \brief Adds a cost that changed at the given duration. The previous cost is held until just
+   * before the change, such that interpolating the measurements reproduces the step. */
+  void addCostChange(const time::Duration& duration, const ompl::base::Cost& cost);
+
+  /** \brief Adds the call counts of an instrumented context at the given duration. */
+  void addCallCounts(const time::Duration& duration, const CallCounts& counts);
+
+  /** \brief Whether call counts have been added. */
+  bool hasCallCounts() const { return !callCounts_.empty(); }
+
+  /** \brief Output the call counts with the appropriate label, one line for the durations and
+   * one line each for the number of calls and the time spent in every instrumented function. */
+  std::string createCallCountsLogString(const std::string& labelPrefix) const;
+
+  /** \brief The number of lines of a call counts log string. */
+  static constexpr std::size_t NUM_CALL_COUNTS_LINES{9u};
+
  private:
   // The measurements
   std::vector<logData> measurements_{};
 
+  // The call counts, sampled alongside the measurements if the context is instrumented.
+  std::vector<std::pair<time::Duration, CallCounts>> callCounts_{};
+
   /** \brief Preallocated size */
   std::size_t allocSize_{0u};
 };
@@ -195,7 +234,11 @@ class TargetTimeResults {
 };
 
 //******* The file that writes the data to disk*******//
-/** \brief A class to write results to disk. */
+/** \brief Flushes a written file from the page cache to disk, such that it survives a power loss.
+ * Throws if the file cannot be synced. */
+void syncFile(const std::experimental::filesystem::path& path);
+
+/** \brief A class to write results to disk. Every added result is synced to disk. */
 template <class Logger>
 class ResultLog {
  public:
@@ -254,10 +297,17 @@ class ResultLog {
     }
 
     // Write the data.
-    filestream << logger.createLogString(plannerName);
+    if (filepath_.extension() == binary_results::EXTENSION) {
+      filestream.close();
+      binary_results::appendRun(filepath_, plannerName, logger.getDurations(), logger.getCosts());
+    } else {
+      filestream << logger.createLogString(plannerName);
+    }
 
-    // Close the file:
+    // Close the file and make sure the result is on disk before anything refers to it, e.g., the
+    // journal of the experiment.
     filestream.close();
+    syncFile(filepath_);
 
     // This file should not accidentally be written to.
     fs::permissions(filepath_,
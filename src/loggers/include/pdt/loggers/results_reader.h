@@ -0,0 +1,85 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <experimental/filesystem>
+
+#include "pdt/loggers/binary_results.h"
+
+namespace pdt {
+
+namespace loggers {
+
+/** \brief Reads the measured runs of a results file, in either the csv or the binary format. Csv
+ * results consist of two rows per run, a row of durations followed by a row of costs, each led by
+ * the planner name. They are parsed once into storage owned by the reader. Binary results are
+ * memory mapped and read in place. */
+class ResultsReader {
+ public:
+  ResultsReader(const std::experimental::filesystem::path& path);
+  ~ResultsReader() = default;
+
+  ResultsReader(const ResultsReader&) = delete;
+  ResultsReader& operator=(const ResultsReader&) = delete;
+
+  /** \brief The number of runs in the file. */
+  std::size_t getNumRuns() const;
+
+  /** \brief Access to the i-th run. The pointers are valid for the lifetime of the reader. */
+  std::string getPlannerName(std::size_t i) const;
+  std::size_t getNumMeasurements(std::size_t i) const;
+  const double* getDurations(std::size_t i) const;
+  const double* getCosts(std::size_t i) const;
+
+ private:
+  /** \brief The mapped binary results, if the file is in the binary format. */
+  std::unique_ptr<binary_results::Reader> binaryReader_{};
+
+  /** \brief The parsed csv results, if the file is in the csv format. */
+  std::vector<std::string> plannerNames_{};
+  std::vector<std::vector<double>> durations_{};
+  std::vector<std::vector<double>> costs_{};
+};
+
+}  // namespace loggers
+
+}  // namespace pdt
@@ -0,0 +1,292 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/loggers/binary_results.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace pdt {
+
+namespace loggers {
+
+namespace binary_results {
+
+namespace fs = std::experimental::filesystem;
+using namespace std::string_literals;
+
+namespace {
+
+// Pads an offset to the alignment of the arrays.
+std::uint64_t align(std::uint64_t offset) {
+  return (offset + 7u) & ~static_cast<std::uint64_t>(7u);
+}
+
+// Locates the parts of the record with the given header at the given offset. Returns the end of
+// the record, or zero if a file of the given size cannot hold all of it.
+std::uint64_t locateRecord(std::uint64_t offset, const RecordHeader& record, std::uint64_t size,
+                           IndexEntry* entry) {
+  // Lengths that exceed the file cannot overflow the offsets below.
+  if (record.nameLength > size || record.numMeasurements > size / sizeof(double)) {
+    return 0u;
+  }
+  entry->nameOffset = offset + sizeof(RecordHeader);
+  entry->nameLength = record.nameLength;
+  entry->numMeasurements = record.numMeasurements;
+  entry->durationsOffset = align(entry->nameOffset + entry->nameLength);
+  entry->costsOffset = entry->durationsOffset + entry->numMeasurements * sizeof(double);
+  const auto end = entry->costsOffset + entry->numMeasurements * sizeof(double) +
+                   sizeof(RecordTrailer);
+  return end <= size ? end : 0u;
+}
+
+// Collects the complete records of a file in memory. Records are only appended, so the first
+// incomplete record is the last one.
+std::vector<IndexEntry> readIndex(const char* data, std::uint64_t size) {
+  std::vector<IndexEntry> index;
+  std::uint64_t offset = sizeof(Header);
+  while (offset + sizeof(RecordHeader) <= size) {
+    RecordHeader record;
+    std::memcpy(&record, data + offset, sizeof(RecordHeader));
+    IndexEntry entry{};
+    const auto end = locateRecord(offset, record, size, &entry);
+    if (end == 0u) {
+      break;
+    }
+    RecordTrailer trailer;
+    std::memcpy(&trailer, data + end - sizeof(RecordTrailer), sizeof(RecordTrailer));
+    if (trailer.recordOffset != offset ||
+        std::memcmp(trailer.magic, RECORD_MAGIC, sizeof(RECORD_MAGIC)) != 0) {
+      break;
+    }
+    index.push_back(entry);
+    offset = end;
+  }
+  return index;
+}
+
+// Returns the end of the last complete record of an open file. Usually the file ends with a
+// complete record, whose trailer is checked. Only if it does not, the file is scanned.
+std::uint64_t findEndOfRecords(int fd, std::uint64_t size) {
+  const auto trailerOffset = size - sizeof(RecordTrailer);
+  RecordTrailer trailer;
+  RecordHeader record;
+  IndexEntry entry{};
+  if (size >= sizeof(Header) + sizeof(RecordHeader) + sizeof(RecordTrailer) &&
+      pread(fd, &trailer, sizeof(RecordTrailer), static_cast<off_t>(trailerOffset)) ==
+          static_cast<ssize_t>(sizeof(RecordTrailer)) &&
+      std::memcmp(trailer.magic, RECORD_MAGIC, sizeof(RECORD_MAGIC)) == 0 &&
+      trailer.recordOffset >= sizeof(Header) && trailer.recordOffset < size &&
+      pread(fd, &record, sizeof(RecordHeader), static_cast<off_t>(trailer.recordOffset)) ==
+          static_cast<ssize_t>(sizeof(RecordHeader)) &&
+      locateRecord(trailer.recordOffset, record, size, &entry) == size) {
+    return size;
+  }
+
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED) {
+    return 0u;
+  }
+  const auto index = readIndex(static_cast<const char*>(data), size);
+  munmap(data, size);
+  if (index.empty()) {
+    return sizeof(Header);
+  }
+  return index.back().costsOffset + index.back().numMeasurements * sizeof(double) +
+         sizeof(RecordTrailer);
+}
+
+}  // namespace
+
+bool isBinaryResultsFile(const fs::path& path) {
+  std::ifstream file(path.string(), std::ios::in | std::ios::binary);
+  char magic[sizeof(MAGIC)];
+  if (!file.read(magic, sizeof(MAGIC))) {
+    return false;
+  }
+  return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+void appendRun(const fs::path& path, const std::string& plannerName,
+               const std::vector<double>& durations, const std::vector<double>& costs) {
+  if (durations.size() != costs.size()) {
+    throw std::invalid_argument("Every measured duration needs a measured cost.");
+  }
+
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    throw std::ios_base::failure("Could not open binary results file at "s + path.string() + "."s);
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0) {
+    close(fd);
+    throw std::ios_base::failure("Could not open binary results file at "s + path.string() + "."s);
+  }
+  const auto size = static_cast<std::uint64_t>(status.st_size);
+
+  // Write the header if this is a new file. Otherwise find where the last complete record ends,
+  // and cut off an incomplete one behind it.
+  std::vector<char> buffer;
+  std::uint64_t end = 0u;
+  if (size == 0u) {
+    Header header{};
+    std::copy(std::begin(MAGIC), std::end(MAGIC), std::begin(header.magic));
+    header.version = VERSION;
+    buffer.resize(sizeof(Header));
+    std::memcpy(buffer.data(), &header, sizeof(Header));
+  } else {
+    Header header;
+    if (size < sizeof(Header) ||
+        pread(fd, &header, sizeof(Header), 0) != static_cast<ssize_t>(sizeof(Header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+      close(fd);
+      throw std::ios_base::failure("'"s + path.string() + "' is not a binary results file."s);
+    }
+    end = findEndOfRecords(fd, size);
+    if (end == 0u || (end != size && ftruncate(fd, static_cast<off_t>(end)) != 0)) {
+      close(fd);
+      throw std::ios_base::failure("Could not repair binary results file at "s + path.string() +
+                                   "."s);
+    }
+  }
+
+  // Assemble the record, write it with a single call behind the last complete one, and sync it to
+  // disk.
+  RecordHeader record{plannerName.size(), durations.size()};
+  IndexEntry entry{};
+  const auto recordOffset = end + buffer.size();
+  const auto recordEnd = locateRecord(recordOffset, record,
+                                      std::numeric_limits<std::uint64_t>::max(), &entry);
+  RecordTrailer trailer{};
+  trailer.recordOffset = recordOffset;
+  std::copy(std::begin(RECORD_MAGIC), std::end(RECORD_MAGIC), std::begin(trailer.magic));
+  const auto arraySize = entry.numMeasurements * sizeof(double);
+  buffer.resize(recordEnd - end, '\0');
+  std::memcpy(buffer.data() + (recordOffset - end), &record, sizeof(RecordHeader));
+  std::memcpy(buffer.data() + (entry.nameOffset - end), plannerName.data(), plannerName.size());
+  std::memcpy(buffer.data() + (entry.durationsOffset - end), durations.data(), arraySize);
+  std::memcpy(buffer.data() + (entry.costsOffset - end), costs.data(), arraySize);
+  std::memcpy(buffer.data() + (recordEnd - sizeof(RecordTrailer) - end), &trailer,
+              sizeof(RecordTrailer));
+
+  const auto numWritten = pwrite(fd, buffer.data(), buffer.size(), static_cast<off_t>(end));
+  const auto synced = fsync(fd) == 0;
+  close(fd);
+  if (numWritten < 0 || static_cast<std::size_t>(numWritten) != buffer.size() || !synced) {
+    throw std::ios_base::failure("Could not write to binary results file at "s + path.string() +
+                                 "."s);
+  }
+}
+
+Reader::Reader(const fs::path& path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::ios_base::failure("Could not open binary results file at "s + path.string() + "."s);
+  }
+
+  struct stat status;
+  if (fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(Header)) {
+    close(fd);
+    throw std::ios_base::failure("'"s + path.string() + "' is not a binary results file."s);
+  }
+  size_ = static_cast<std::size_t>(status.st_size);
+
+  // The mapping stays valid after the file descriptor is closed.
+  void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw std::ios_base::failure("Could not map binary results file at "s + path.string() + "."s);
+  }
+  madvise(data, size_, MADV_SEQUENTIAL);
+  data_ = static_cast<const char*>(data);
+
+  // Validate the header and collect the complete records.
+  const auto header = reinterpret_cast<const Header*>(data_);
+  if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION) {
+    munmap(const_cast<char*>(data_), size_);
+    throw std::ios_base::failure("'"s + path.string() + "' is not a valid binary results file."s);
+  }
+  index_ = readIndex(data_, size_);
+}
+
+Reader::~Reader() {
+  munmap(const_cast<char*>(data_), size_);
+}
+
+std::size_t Reader::getNumRuns() const {
+  return index_.size();
+}
+
+std::string Reader::getPlannerName(std::size_t i) const {
+  const auto& entry = getEntry(i);
+  return std::string(data_ + entry.nameOffset, entry.nameLength);
+}
+
+std::size_t Reader::getNumMeasurements(std::size_t i) const {
+  return getEntry(i).numMeasurements;
+}
+
+const double* Reader::getDurations(std::size_t i) const {
+  return reinterpret_cast<const double*>(data_ + getEntry(i).durationsOffset);
+}
+
+const double* Reader::getCosts(std::size_t i) const {
+  return reinterpret_cast<const double*>(data_ + getEntry(i).costsOffset);
+}
+
+const IndexEntry& Reader::getEntry(std::size_t i) const {
+  if (i >= index_.size()) {
+    throw std::out_of_range("Requested run "s + std::to_string(i) +
+                            " of a binary results file with "s +
+                            std::to_string(index_.size()) + " runs."s);
+  }
+  return index_[i];
+}
+
+}  // namespace binary_results
+
+}  // namespace loggers
+
+}  // namespace pdt
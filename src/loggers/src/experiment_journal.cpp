@@ -0,0 +1,274 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/loggers/experiment_journal.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <stdexcept>
+
+#include <ompl/util/Console.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#include "nlohmann/json.hpp"
+#pragma GCC diagnostic pop
+
+#include "pdt/loggers/binary_results.h"
+#include "pdt/loggers/performance_loggers.h"
+
+namespace pdt {
+
+namespace loggers {
+
+namespace fs = std::experimental::filesystem;
+namespace json = nlohmann;
+using namespace std::string_literals;
+
+ExperimentJournal::ExperimentJournal(const fs::path& path, std::size_t seed,
+                                     const std::vector<std::vector<std::string>>& plannerOrders) :
+    path_(path),
+    seed_(seed),
+    plannerOrders_(plannerOrders) {
+  if (fs::exists(path_)) {
+    throw std::ios_base::failure("Told to start a new journal where one already exists.");
+  }
+  fs::create_directories(path_.parent_path());
+
+  // Write the header to a temporary file first, such that the journal either exists completely or
+  // not at all.
+  const auto temporaryPath = fs::path(path_.string() + ".tmp"s);
+  {
+    std::ofstream file(temporaryPath.string(), std::ofstream::out | std::ofstream::trunc);
+    if (file.fail()) {
+      throw std::ios_base::failure("Could not create journal at "s + temporaryPath.string() + "."s);
+    }
+    json::json header;
+    header["seed"] = seed_;
+    header["plannerOrders"] = plannerOrders_;
+    file << header.dump() << '\n';
+    file.flush();
+    if (file.fail()) {
+      throw std::ios_base::failure("Could not write journal at "s + temporaryPath.string() + "."s);
+    }
+  }
+  fs::rename(temporaryPath, path_);
+}
+
+ExperimentJournal::ExperimentJournal(const fs::path& path) : path_(path) {
+  std::ifstream file(path_.string());
+  if (file.fail()) {
+    throw std::ios_base::failure("Could not open journal at "s + path_.string() + "."s);
+  }
+
+  // Read the header.
+  std::string line;
+  if (!std::getline(file, line)) {
+    throw std::runtime_error("Journal at "s + path_.string() + " is empty."s);
+  }
+  const auto header = json::json::parse(line);
+  seed_ = header.at("seed").get<std::size_t>();
+  plannerOrders_ = header.at("plannerOrders").get<std::vector<std::vector<std::string>>>();
+
+  // Read the completed runs.
+  while (true) {
+    const auto lineBegin = file.tellg();
+    if (!std::getline(file, line)) {
+      break;
+    }
+    json::json entry;
+    try {
+      entry = json::json::parse(line);
+    } catch (const json::json::parse_error&) {
+      // Only the last line can be incomplete, if the experiment was interrupted while writing it.
+      // It is cut off, such that the next entry is not appended to it.
+      if (file.peek() != std::ifstream::traits_type::eof()) {
+        throw;
+      }
+      OMPL_WARN("Discarding incomplete last line of journal at %s.", path_.c_str());
+      file.close();
+      fs::resize_file(path_, static_cast<std::uintmax_t>(lineBegin));
+      break;
+    }
+    const auto run = entry.at("run").get<std::size_t>();
+    if (entry.contains("startGoalPairs")) {
+      auto& queries = queries_[run];
+      for (const auto& pair : entry.at("startGoalPairs")) {
+        queries.push_back(JournaledQuery{
+            pair.at("starts").get<std::vector<std::vector<double>>>(),
+            pair.at("goals").get<std::vector<std::vector<double>>>()});
+      }
+      continue;
+    }
+    const auto plannerName = entry.at("planner").get<std::string>();
+    for (const auto query : entry.at("queries").get<std::vector<std::size_t>>()) {
+      completed_.emplace(run, plannerName, query);
+    }
+    ++numCompletedRuns_;
+  }
+}
+
+std::size_t ExperimentJournal::getSeed() const {
+  return seed_;
+}
+
+const std::vector<std::vector<std::string>>& ExperimentJournal::getPlannerOrders() const {
+  return plannerOrders_;
+}
+
+bool ExperimentJournal::isCompleted(std::size_t run, const std::string& plannerName,
+                                    std::size_t query) const {
+  return completed_.find(std::make_tuple(run, plannerName, query)) != completed_.end();
+}
+
+std::size_t ExperimentJournal::getNumCompletedRuns() const {
+  return numCompletedRuns_;
+}
+
+void ExperimentJournal::markCompleted(std::size_t run, const std::string& plannerName,
+                                      std::size_t numQueries) {
+  std::vector<std::size_t> queries;
+  for (std::size_t query = 0u; query < numQueries; ++query) {
+    queries.push_back(query);
+  }
+  json::json entry;
+  entry["run"] = run;
+  entry["planner"] = plannerName;
+  entry["queries"] = queries;
+  append(entry.dump() + '\n');
+
+  for (const auto query : queries) {
+    completed_.emplace(run, plannerName, query);
+  }
+  ++numCompletedRuns_;
+}
+
+void ExperimentJournal::recordQueries(std::size_t run,
+                                      const std::vector<JournaledQuery>& queries) {
+  json::json entry;
+  entry["run"] = run;
+  entry["startGoalPairs"] = json::json::array();
+  for (const auto& query : queries) {
+    json::json pair;
+    pair["starts"] = query.starts;
+    pair["goals"] = query.goals;
+    entry["startGoalPairs"].push_back(pair);
+  }
+  append(entry.dump() + '\n');
+  queries_[run] = queries;
+}
+
+bool ExperimentJournal::hasQueries(std::size_t run) const {
+  return queries_.find(run) != queries_.end();
+}
+
+const std::vector<JournaledQuery>& ExperimentJournal::getQueries(std::size_t run) const {
+  return queries_.at(run);
+}
+
+void ExperimentJournal::append(const std::string& line) const {
+  const int fd = open(path_.c_str(), O_WRONLY | O_APPEND);
+  if (fd < 0) {
+    throw std::ios_base::failure("Could not open journal at "s + path_.string() + "."s);
+  }
+  const auto numWritten = write(fd, line.data(), line.size());
+  const auto synced = fsync(fd) == 0;
+  close(fd);
+  if (numWritten < 0 || static_cast<std::size_t>(numWritten) != line.size() || !synced) {
+    throw std::ios_base::failure("Could not write journal at "s + path_.string() + "."s);
+  }
+}
+
+void truncateResults(const fs::path& path, std::size_t numRuns, std::size_t numLinesPerRun) {
+  if (!fs::exists(path)) {
+    if (numRuns != 0u) {
+      throw std::ios_base::failure("Results at "s + path.string() + " are missing."s);
+    }
+    return;
+  }
+
+  // Write the runs we keep to a temporary file, which then replaces the results.
+  const auto temporaryPath = fs::path(path.string() + ".tmp"s);
+  fs::remove(temporaryPath);
+  if (binary_results::isBinaryResultsFile(path)) {
+    binary_results::Reader reader(path);
+    if (reader.getNumRuns() < numRuns) {
+      throw std::runtime_error("Results at "s + path.string() + " have fewer runs than expected."s);
+    }
+    if (reader.getNumRuns() == numRuns) {
+      return;
+    }
+    for (std::size_t i = 0u; i < numRuns; ++i) {
+      const auto numMeasurements = reader.getNumMeasurements(i);
+      binary_results::appendRun(
+          temporaryPath, reader.getPlannerName(i),
+          std::vector<double>(reader.getDurations(i), reader.getDurations(i) + numMeasurements),
+          std::vector<double>(reader.getCosts(i), reader.getCosts(i) + numMeasurements));
+    }
+  } else {
+    // Every run consists of a fixed number of lines in a csv file.
+    std::ifstream in(path.string());
+    std::ofstream out(temporaryPath.string(), std::ofstream::out | std::ofstream::trunc);
+    std::string line;
+    std::size_t numLines = 0u;
+    while (numLines < numLinesPerRun * numRuns && std::getline(in, line)) {
+      out << line << '\n';
+      ++numLines;
+    }
+    if (numLines < numLinesPerRun * numRuns) {
+      throw std::runtime_error("Results at "s + path.string() + " have fewer runs than expected."s);
+    }
+    const bool hasMoreRuns = static_cast<bool>(std::getline(in, line));
+    out.close();
+    if (!hasMoreRuns) {
+      fs::remove(temporaryPath);
+      return;
+    }
+  }
+
+  // The kept runs must be on disk before they replace the results.
+  syncFile(temporaryPath);
+  OMPL_WARN("Discarding runs of %s that are not in the journal.", path.c_str());
+  fs::rename(temporaryPath, path);
+  fs::permissions(path, fs::perms::owner_read | fs::perms::group_read | fs::perms::others_read);
+}
+
+}  // namespace loggers
+
+}  // namespace pdt
@@ -0,0 +1,106 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/loggers/memory_usage.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace pdt {
+
+namespace loggers {
+
+using namespace std::string_literals;
+
+namespace fs = std::experimental::filesystem;
+
+std::string createMemoryUsageLogString(const std::string& plannerName, const MemoryUsage& usage) {
+  std::stringstream rval;
+  rval << plannerName << ", " << usage.residentSetSizeDelta << ", " << usage.peakResidentSetSize;
+  for (const auto& count : {usage.numAllocations, usage.numAllocatedBytes}) {
+    rval << ", ";
+    if (count) {
+      rval << *count;
+    } else {
+      rval << "nan";
+    }
+  }
+  rval << '\n';
+  return rval.str();
+}
+
+std::vector<std::pair<std::string, MemoryUsage>> readMemoryUsage(const fs::path& path) {
+  std::ifstream file(path.string());
+  if (!file) {
+    throw std::ios_base::failure("Could not read memory usage at "s + path.string() + "."s);
+  }
+
+  std::vector<std::pair<std::string, MemoryUsage>> usages;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    std::vector<std::string> entries;
+    std::stringstream stream(line);
+    std::string entry;
+    while (std::getline(stream, entry, ',')) {
+      entries.push_back(entry.substr(entry.find_first_not_of(' ')));
+    }
+    if (entries.size() != 5u) {
+      throw std::runtime_error("Malformed memory usage at "s + path.string() + "."s);
+    }
+
+    MemoryUsage usage;
+    usage.residentSetSizeDelta = std::stoll(entries[1]);
+    usage.peakResidentSetSize = std::stoull(entries[2]);
+    if (entries[3] != "nan"s) {
+      usage.numAllocations = std::stoull(entries[3]);
+    }
+    if (entries[4] != "nan"s) {
+      usage.numAllocatedBytes = std::stoull(entries[4]);
+    }
+    usages.emplace_back(entries[0], usage);
+  }
+
+  return usages;
+}
+
+}  // namespace loggers
+
+}  // namespace pdt
@@ -37,6 +37,9 @@
 
 #include "pdt/loggers/performance_loggers.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <cmath>
 #include <iomanip>
 
@@ -57,6 +60,7 @@ constexpr double ALLOC_SAFETY_FACTOR = 10.0;
 
 // Convenience namespace.
 namespace fs = std::experimental::filesystem;
+using namespace std::string_literals;
 
 TimeCostLogger::TimeCostLogger(const time::Duration& maxDuration, double logFrequency) :
     allocSize_(static_cast<std::size_t>(std::ceil(
@@ -69,6 +73,17 @@ void TimeCostLogger::addMeasurement(const time::Duration& duration, const ompl::
   measurements_.emplace_back(duration, cost);
 }
 
+void TimeCostLogger::addCostChange(const time::Duration& duration, const ompl::base::Cost& cost) {
+  if (!measurements_.empty()) {
+    const time::Duration justBefore(std::nextafter(duration.count(), 0.0));
+    if (justBefore > measurements_.back().first) {
+      const auto previousCost = measurements_.back().second;
+      measurements_.emplace_back(justBefore, previousCost);
+    }
+  }
+  measurements_.emplace_back(duration, cost);
+}
+
 std::string TimeCostLogger::createLogString(const std::string& prefix) const {
   if (measurements_.capacity() > allocSize_) {
     OMPL_WARN(
@@ -105,6 +120,62 @@ std::string TimeCostLogger::createLogString(const std::string& prefix) const {
   return rval.str();
 }
 
+void TimeCostLogger::addCallCounts(const time::Duration& duration, const CallCounts& counts) {
+  // Only instrumented runs pay for the allocation.
+  if (callCounts_.empty()) {
+    callCounts_.reserve(allocSize_);
+  }
+  callCounts_.emplace_back(duration, counts);
+}
+
+std::string TimeCostLogger::createCallCountsLogString(const std::string& prefix) const {
+  std::stringstream rval;
+  rval << std::setprecision(21);
+
+  // Dumps one series, selected by the given function.
+  auto dump = [this, &prefix, &rval](const std::string& name, const auto& select) {
+    rval << prefix << ", " << name;
+    for (const auto& sample : callCounts_) {
+      rval << ", " << select(sample);
+    }
+    rval << '\n';
+  };
+
+  dump("durations", [](const auto& sample) { return time::seconds(sample.first); });
+  const std::vector<std::pair<std::string, CallCount CallCounts::*>> functions{
+      {"isValid", &CallCounts::isValid},
+      {"clearance", &CallCounts::clearance},
+      {"checkMotion", &CallCounts::checkMotion},
+      {"motionCost", &CallCounts::motionCost}};
+  for (const auto& function : functions) {
+    const auto member = function.second;
+    dump(function.first + " calls",
+         [member](const auto& sample) { return (sample.second.*member).numCalls; });
+    dump(function.first + " seconds",
+         [member](const auto& sample) { return time::seconds((sample.second.*member).duration); });
+  }
+
+  return rval.str();
+}
+
+std::vector<double> TimeCostLogger::getDurations() const {
+  std::vector<double> durations;
+  durations.reserve(measurements_.size());
+  for (const auto& measurement : measurements_) {
+    durations.push_back(std::chrono::duration<double, std::ratio<1>>(measurement.first).count());
+  }
+  return durations;
+}
+
+std::vector<double> TimeCostLogger::getCosts() const {
+  std::vector<double> costs;
+  costs.reserve(measurements_.size());
+  for (const auto& measurement : measurements_) {
+    costs.push_back(measurement.second.value());
+  }
+  return costs;
+}
+
 TimeIterationCostLogger::TimeIterationCostLogger(double runTimeSeconds,
                                                  unsigned int recordPeriodMicrosecond) {
   allocSize_ =
@@ -258,6 +329,18 @@ std::string TargetTimeResults::output(const std::string& labelPrefix) {
   return rval.str();
 }
 
+void syncFile(const fs::path& path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::ios_base::failure("Could not open "s + path.string() + " to sync it."s);
+  }
+  const auto synced = fsync(fd) == 0;
+  close(fd);
+  if (!synced) {
+    throw std::ios_base::failure("Could not sync "s + path.string() + " to disk."s);
+  }
+}
+
 }  // namespace loggers
 
 }  // namespace pdt
@@ -0,0 +1,123 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/loggers/results_reader.h"
+
+#include <fstream>
+#include <stdexcept>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Weffc++"
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#include "csv/parser.hpp"
+#pragma GCC diagnostic pop
+
+namespace pdt {
+
+namespace loggers {
+
+namespace fs = std::experimental::filesystem;
+using namespace std::string_literals;
+
+ResultsReader::ResultsReader(const fs::path& path) {
+  if (binary_results::isBinaryResultsFile(path)) {
+    binaryReader_ = std::make_unique<binary_results::Reader>(path);
+    return;
+  }
+
+  // Open the csv file.
+  std::ifstream filestream(path.string());
+  if (filestream.fail()) {
+    throw std::ios_base::failure("Cannot open results at '"s + path.string() + "'."s);
+  }
+  aria::csv::CsvParser parser(filestream);
+
+  // Every run consists of a row of durations followed by a row of costs.
+  bool timeRow = true;
+  for (auto& row : parser) {
+    if (row.size() == 0) {
+      throw std::runtime_error("Empty row.");
+    }
+    if (timeRow) {
+      plannerNames_.push_back(row.at(0));
+      durations_.emplace_back();
+      durations_.back().reserve(row.size() - 1u);
+      for (std::size_t i = 1u; i < row.size(); ++i) {
+        durations_.back().push_back(std::stod(row.at(i)));
+      }
+    } else {
+      if (row.at(0) != plannerNames_.back() || row.size() != durations_.back().size() + 1u) {
+        throw std::runtime_error("Csv file has unexpected structure.");
+      }
+      costs_.emplace_back();
+      costs_.back().reserve(row.size() - 1u);
+      for (std::size_t i = 1u; i < row.size(); ++i) {
+        costs_.back().push_back(std::stod(row.at(i)));
+      }
+    }
+    timeRow = !timeRow;
+  }
+
+  // A run without costs is incomplete.
+  if (!timeRow) {
+    throw std::runtime_error("Csv file has unexpected structure.");
+  }
+}
+
+std::size_t ResultsReader::getNumRuns() const {
+  return binaryReader_ ? binaryReader_->getNumRuns() : costs_.size();
+}
+
+std::string ResultsReader::getPlannerName(std::size_t i) const {
+  return binaryReader_ ? binaryReader_->getPlannerName(i) : plannerNames_.at(i);
+}
+
+std::size_t ResultsReader::getNumMeasurements(std::size_t i) const {
+  return binaryReader_ ? binaryReader_->getNumMeasurements(i) : costs_.at(i).size();
+}
+
+const double* ResultsReader::getDurations(std::size_t i) const {
+  return binaryReader_ ? binaryReader_->getDurations(i) : durations_.at(i).data();
+}
+
+const double* ResultsReader::getCosts(std::size_t i) const {
+  return binaryReader_ ? binaryReader_->getCosts(i) : costs_.at(i).data();
+}
+
+}  // namespace loggers
+
+}  // namespace pdt
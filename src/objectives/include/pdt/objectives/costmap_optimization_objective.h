@@ -0,0 +1,126 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <ompl/base/OptimizationObjective.h>
+#include <ompl/base/SpaceInformation.h>
+#include <ompl/base/State.h>
+
+#include "pdt/objectives/base_optimization_objective.h"
+#include "pdt/objectives/optimization_objective_visitor.h"
+#include "pdt/obstacles/raster.h"
+
+namespace pdt {
+
+namespace objectives {
+
+// The integral of a piecewise constant cost over the path. The cells of the cost map evenly divide
+// the bounds of a two dimensional real vector state space. The first row of the map spans the
+// lowest y values, the first column the lowest x values.
+class CostMapOptimizationObjective : public ompl::base::OptimizationObjective,
+                                     public BaseOptimizationObjective {
+ public:
+  CostMapOptimizationObjective(const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
+                               const obstacles::Raster& costMap);
+  virtual ~CostMapOptimizationObjective() = default;
+
+  // The cost of the cell that contains the state.
+  ompl::base::Cost stateCost(const ompl::base::State* state) const override;
+
+  // The exact line integral of the cost over the straight line between the states. This uses prefix
+  // sums over the rows and columns of the map, which makes it linear in the number of rows or columns
+  // the motion crosses, whichever is smaller.
+  ompl::base::Cost motionCost(const ompl::base::State* state1,
+                              const ompl::base::State* state2) const override;
+
+  // The distance between the states times the minimum cost of the map.
+  ompl::base::Cost motionCostHeuristic(const ompl::base::State* state1,
+                                       const ompl::base::State* state2) const override;
+
+  void accept(const ObjectiveVisitor& visitor) const override;
+
+  // Get the dimensions of the cost map.
+  std::size_t getNumRows() const;
+  std::size_t getNumCols() const;
+
+  // Get the cost of a cell.
+  double getCellCost(std::size_t row, std::size_t col) const;
+
+  // Get the extreme costs of the map.
+  double getMinCost() const;
+  double getMaxCost() const;
+
+ private:
+  // Integrate the cost along the line between the points (in cell coordinates) using the prefix sums
+  // of the lines of cells parallel to the major axis of the motion.
+  double integrate(double major1, double minor1, double major2, double minor2,
+                   std::size_t numMinorCells, std::size_t numMajorCells,
+                   const std::vector<double>& costs, const std::vector<double>& prefixSums) const;
+
+  // Get the coordinates of a state in units of cells.
+  std::array<double, 2u> getCellCoordinates(const ompl::base::State* state) const;
+
+  // The cost map, row by row.
+  const obstacles::Raster costMap_;
+
+  // The cost map column by column.
+  std::vector<double> transposedCosts_{};
+
+  // The prefix sums of every row (numCols + 1 entries each) and every column (numRows + 1 entries
+  // each).
+  std::vector<double> rowPrefixSums_{};
+  std::vector<double> colPrefixSums_{};
+
+  // The lower bounds of the state space and the size of each cell.
+  std::array<double, 2u> origin_{};
+  std::array<double, 2u> cellSize_{};
+
+  // The extreme costs of the map.
+  double minCost_{0.0};
+  double maxCost_{0.0};
+
+  const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo_ = OptimizationObjective::si_;
+};
+
+}  // namespace objectives
+
+}  // namespace pdt
@@ -0,0 +1,100 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <memory>
+
+#include <ompl/base/OptimizationObjective.h>
+#include <ompl/base/ProblemDefinition.h>
+#include <ompl/base/State.h>
+#include <ompl/base/samplers/InformedStateSampler.h>
+
+#include "pdt/objectives/base_optimization_objective.h"
+#include "pdt/objectives/optimization_objective_visitor.h"
+#include "pdt/utilities/call_counter.h"
+
+namespace pdt {
+
+namespace objectives {
+
+// An objective that forwards all calls to another objective, while counting and timing the calls
+// to the motion cost.
+class CountingOptimizationObjective : public ompl::base::OptimizationObjective,
+                                      public BaseOptimizationObjective {
+ public:
+  // The constructor.
+  CountingOptimizationObjective(const ompl::base::OptimizationObjectivePtr& objective,
+                                const std::shared_ptr<utilities::CallCounters>& counters);
+
+  // The destructor.
+  virtual ~CountingOptimizationObjective() = default;
+
+  // The wrapped objective decides on all costs.
+  bool isSatisfied(ompl::base::Cost cost) const override;
+  ompl::base::Cost stateCost(const ompl::base::State* state) const override;
+  bool isCostBetterThan(ompl::base::Cost cost1, ompl::base::Cost cost2) const override;
+  ompl::base::Cost identityCost() const override;
+  ompl::base::Cost infiniteCost() const override;
+  ompl::base::Cost initialCost(const ompl::base::State* state) const override;
+  ompl::base::Cost terminalCost(const ompl::base::State* state) const override;
+  ompl::base::Cost combineCosts(ompl::base::Cost cost1, ompl::base::Cost cost2) const override;
+  bool isSymmetric() const override;
+  ompl::base::Cost averageStateCost(unsigned int numStates) const override;
+  ompl::base::Cost motionCostHeuristic(const ompl::base::State* state1,
+                                       const ompl::base::State* state2) const override;
+  ompl::base::InformedSamplerPtr allocInformedStateSampler(
+      const ompl::base::ProblemDefinitionPtr& problem, unsigned int maxNumberCalls) const override;
+
+  // The motion cost of the wrapped objective is counted and timed.
+  ompl::base::Cost motionCost(const ompl::base::State* state1,
+                              const ompl::base::State* state2) const override;
+
+  // Returns the wrapped objective.
+  ompl::base::OptimizationObjectivePtr getObjective() const;
+
+  // Visitors visit the wrapped objective, if it is visitable.
+  void accept(const ObjectiveVisitor& visitor) const override;
+
+ private:
+  const ompl::base::OptimizationObjectivePtr objective_;
+  const std::shared_ptr<utilities::CallCounters> counters_;
+};
+
+}  // namespace objectives
+
+}  // namespace pdt
@@ -56,7 +56,7 @@ class MaxMinClearanceOptimizationObjective : public ompl::base::OptimizationObje
       const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo);
 
   // The destructor.
-  virtual ~MaxMinClearanceOptimizationObjective();
+  virtual ~MaxMinClearanceOptimizationObjective() = default;
 
   // The state cost is the clearance of a state.
   ompl::base::Cost stateCost(const ompl::base::State* state) const override;
@@ -75,7 +75,9 @@ class MaxMinClearanceOptimizationObjective : public ompl::base::OptimizationObje
   // Combining cost means returning the cost which corresponds to the lower clearance.
   ompl::base::Cost combineCosts(ompl::base::Cost cost1, ompl::base::Cost cost2) const override;
 
-  // The motion cost is the state cost of the state closest to an obstacle.
+  // The motion cost is the state cost of the state closest to an obstacle. If the clearance is
+  // Lipschitz continuous, states that cannot be closer to an obstacle than the closest state so far
+  // are skipped, which gives exactly the same cost with fewer clearance computations.
   ompl::base::Cost motionCost(const ompl::base::State* state1,
                               const ompl::base::State* state2) const override;
 
@@ -89,8 +91,13 @@ class MaxMinClearanceOptimizationObjective : public ompl::base::OptimizationObje
   // This method makes this objective visitable.
   void accept(const ObjectiveVisitor& visitor) const override;
 
+  // Sets the Lipschitz constant of the clearance with respect to the distance of the state space,
+  // i.e., the clearances of two states differ by at most this constant times their distance. A
+  // constant of zero means the clearance is not known to be Lipschitz continuous.
+  void setClearanceLipschitzConstant(double constant);
+
  private:
-  ompl::base::State* testState_;
+  double clearanceLipschitzConstant_{0.0};
   const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo_ = OptimizationObjective::si_;
 };
 
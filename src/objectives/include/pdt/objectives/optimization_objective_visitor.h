@@ -42,6 +42,7 @@ namespace pdt {
 namespace objectives {
 
 // Forward declarations.
+class CostMapOptimizationObjective;
 class PotentialFieldOptimizationObjective;
 class ReciprocalClearanceOptimizationObjective;
 class MaxMinClearanceOptimizationObjective;
@@ -52,6 +53,7 @@ class ObjectiveVisitor {
   virtual ~ObjectiveVisitor() = default;
 
   // Any objective visitor must implement its actions on all objectives.
+  virtual void visit(const CostMapOptimizationObjective& objective) const = 0;
   virtual void visit(const PotentialFieldOptimizationObjective& objective) const = 0;
   virtual void visit(const ReciprocalClearanceOptimizationObjective& objective) const = 0;
   virtual void visit(const MaxMinClearanceOptimizationObjective& objective) const = 0;
@@ -0,0 +1,121 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace pdt {
+
+namespace objectives {
+
+// A kd-tree over the point sources of a potential field. Every source contributes the inverse of
+// its squared distance to a point, capped at MAX_POTENTIAL. Clusters of sources that are far away
+// compared to their size are approximated by their centroid (Barnes-Hut), all other sources are
+// summed exactly.
+class PointSourceTree {
+ public:
+  // An opening angle of zero sums all sources exactly. Larger angles approximate more clusters.
+  PointSourceTree(const std::vector<std::vector<double>>& sources, double openingAngle);
+  ~PointSourceTree() = default;
+
+  // Returns the potential of all sources at the point, approximating far clusters.
+  double potential(const double* point) const;
+
+  // Returns the exact potential of all sources at the point.
+  double exactPotential(const double* point) const;
+
+  // Returns the number of sources.
+  std::size_t size() const;
+
+  // The potential of a single source is capped at this value.
+  static constexpr double MAX_POTENTIAL{1000.0};
+
+  // The number of sources that are summed at once by the exact path. The loop over one block is
+  // branch free, which lets the compiler vectorize it.
+  static constexpr std::size_t LANE_WIDTH{8u};
+
+  // Nodes with at most this many sources are leaves, whose sources are summed exactly. Trees over
+  // at most this many sources are never traversed.
+  static constexpr std::size_t LEAF_SIZE{64u};
+
+ private:
+  struct Node {
+    // The range of the sources of this node.
+    std::size_t begin{0u};
+    std::size_t end{0u};
+
+    // The indices of the children, or zero if this node is a leaf.
+    std::size_t left{0u};
+    std::size_t right{0u};
+
+    // The squared diagonal of the bounding box of the sources.
+    double squaredSize{0.0};
+  };
+
+  // Builds the subtree over the given sources and returns the index of its root.
+  std::size_t build(const std::vector<std::vector<double>>& sources,
+                    std::vector<std::size_t>* indices, std::size_t begin, std::size_t end);
+
+  // Returns the potential of the sources of the subtree at the point.
+  double potential(const double* point, std::size_t node) const;
+
+  // Returns the exact potential of the sources in the range at the point.
+  double sumPotentials(const double* point, std::size_t begin, std::size_t end) const;
+
+  // The dimension of the sources.
+  const std::size_t dimension_;
+
+  // The squared opening angle.
+  const double squaredOpeningAngle_;
+
+  // The coordinates of all sources in tree order, one array per dimension.
+  std::vector<std::vector<double>> coordinates_{};
+
+  // The nodes of the tree, the root first.
+  std::vector<Node> nodes_{};
+
+  // The centroids and the lower and upper bounding box corners of all nodes, node by node.
+  std::vector<double> centroids_{};
+  std::vector<double> lowerCorners_{};
+  std::vector<double> upperCorners_{};
+};
+
+}  // namespace objectives
+
+}  // namespace pdt
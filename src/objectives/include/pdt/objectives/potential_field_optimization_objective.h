@@ -37,6 +37,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include <ompl/base/SpaceInformation.h>
 #include <ompl/base/State.h>
 #include <ompl/base/objectives/StateCostIntegralObjective.h>
@@ -44,6 +46,7 @@
 #include "pdt/config/configuration.h"
 #include "pdt/objectives/base_optimization_objective.h"
 #include "pdt/objectives/optimization_objective_visitor.h"
+#include "pdt/objectives/point_source_tree.h"
 
 namespace pdt {
 
@@ -56,8 +59,10 @@ class PotentialFieldOptimizationObjective : public ompl::base::StateCostIntegral
   PotentialFieldOptimizationObjective(
       const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
       const std::shared_ptr<const config::Configuration> config);
-  virtual ~PotentialFieldOptimizationObjective();
+  virtual ~PotentialFieldOptimizationObjective() = default;
 
+  // The sum of the inverse squared distances to all sources, each capped at 1000. Far clusters of
+  // sources are approximated if the objective has a nonzero opening angle.
   ompl::base::Cost stateCost(const ompl::base::State* state) const override;
 
   ompl::base::Cost motionCostHeuristic(const ompl::base::State* state1,
@@ -67,7 +72,7 @@ class PotentialFieldOptimizationObjective : public ompl::base::StateCostIntegral
 
  private:
   const std::shared_ptr<const config::Configuration> config_;
-  std::vector<ompl::base::State*> pointSources_;
+  std::unique_ptr<PointSourceTree> pointSources_{};
   const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo_ = OptimizationObjective::si_;
 };
 
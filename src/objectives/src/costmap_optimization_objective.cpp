@@ -0,0 +1,248 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Authors: Marlin Strub
+
+#include "pdt/objectives/costmap_optimization_objective.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+
+namespace pdt {
+
+namespace objectives {
+
+namespace {
+
+// Returns the integral of the costs of a line of cells from the beginning of the line to the
+// coordinate (in units of cells) along the line.
+double integrateLine(double coordinate, const std::size_t line, const std::size_t numCells,
+                     const std::vector<double>& costs, const std::vector<double>& prefixSums) {
+  // Interpolated coordinates can leave the map by rounding errors.
+  coordinate = std::clamp(coordinate, 0.0, static_cast<double>(numCells));
+  const auto cell = std::min(static_cast<std::size_t>(coordinate), numCells - 1u);
+  return prefixSums[line * (numCells + 1u) + cell] +
+         (coordinate - static_cast<double>(cell)) * costs[line * numCells + cell];
+}
+
+}  // namespace
+
+CostMapOptimizationObjective::CostMapOptimizationObjective(
+    const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
+    const obstacles::Raster& costMap) :
+    ompl::base::OptimizationObjective(spaceInfo),
+    costMap_(costMap) {
+  // Make sure this is the expected state space type.
+  if (spaceInfo_->getStateSpace()->getType() !=
+          ompl::base::StateSpaceType::STATE_SPACE_REAL_VECTOR ||
+      spaceInfo_->getStateDimension() != 2u) {
+    throw std::runtime_error(
+        "Cost map optimization objective only implemented for two dimensional real vector state "
+        "spaces.");
+  }
+
+  // Make sure the cost map is sane.
+  if (costMap_.numRows == 0u || costMap_.numCols == 0u ||
+      costMap_.values.size() != costMap_.numRows * costMap_.numCols) {
+    throw std::runtime_error("Cost map optimization objective needs a nonempty cost map.");
+  }
+  const auto [minCost, maxCost] =
+      std::minmax_element(costMap_.values.begin(), costMap_.values.end());
+  minCost_ = *minCost;
+  maxCost_ = *maxCost;
+  if (minCost_ < 0.0) {
+    throw std::runtime_error("Cost map optimization objective needs nonnegative costs.");
+  }
+
+  // Optimization objectives have descriptions. (...)
+  description_ = "Cost Map";
+
+  // No path to the goal can be cheaper than its length times the minimum cost of the map.
+  setCostToGoHeuristic([minCost = minCost_](const ompl::base::State* state,
+                                            const ompl::base::Goal* goal) {
+    return ompl::base::Cost(minCost * ompl::base::goalRegionCostToGo(state, goal).value());
+  });
+
+  // The cells evenly divide the bounds of the state space.
+  const auto& bounds =
+      spaceInfo_->getStateSpace()->as<ompl::base::RealVectorStateSpace>()->getBounds();
+  origin_ = {bounds.low.at(0u), bounds.low.at(1u)};
+  cellSize_ = {(bounds.high.at(0u) - bounds.low.at(0u)) / static_cast<double>(costMap_.numCols),
+               (bounds.high.at(1u) - bounds.low.at(1u)) / static_cast<double>(costMap_.numRows)};
+
+  // Store the costs column by column.
+  transposedCosts_.resize(costMap_.values.size());
+  for (std::size_t row = 0u; row < costMap_.numRows; ++row) {
+    for (std::size_t col = 0u; col < costMap_.numCols; ++col) {
+      transposedCosts_[col * costMap_.numRows + row] = costMap_(row, col);
+    }
+  }
+
+  // Compute the prefix sums of all rows.
+  rowPrefixSums_.resize(costMap_.numRows * (costMap_.numCols + 1u), 0.0);
+  for (std::size_t row = 0u; row < costMap_.numRows; ++row) {
+    for (std::size_t col = 0u; col < costMap_.numCols; ++col) {
+      rowPrefixSums_[row * (costMap_.numCols + 1u) + col + 1u] =
+          rowPrefixSums_[row * (costMap_.numCols + 1u) + col] + costMap_(row, col);
+    }
+  }
+
+  // Compute the prefix sums of all columns.
+  colPrefixSums_.resize(costMap_.numCols * (costMap_.numRows + 1u), 0.0);
+  for (std::size_t col = 0u; col < costMap_.numCols; ++col) {
+    for (std::size_t row = 0u; row < costMap_.numRows; ++row) {
+      colPrefixSums_[col * (costMap_.numRows + 1u) + row + 1u] =
+          colPrefixSums_[col * (costMap_.numRows + 1u) + row] + costMap_(row, col);
+    }
+  }
+}
+
+ompl::base::Cost CostMapOptimizationObjective::stateCost(const ompl::base::State* state) const {
+  const auto coordinates = getCellCoordinates(state);
+  return ompl::base::Cost(
+      costMap_(std::min(static_cast<std::size_t>(coordinates[1u]), costMap_.numRows - 1u),
+               std::min(static_cast<std::size_t>(coordinates[0u]), costMap_.numCols - 1u)));
+}
+
+ompl::base::Cost CostMapOptimizationObjective::motionCost(const ompl::base::State* state1,
+                                                          const ompl::base::State* state2) const {
+  const auto coordinates1 = getCellCoordinates(state1);
+  const auto coordinates2 = getCellCoordinates(state2);
+  const auto deltaX = std::abs(coordinates2[0u] - coordinates1[0u]);
+  const auto deltaY = std::abs(coordinates2[1u] - coordinates1[1u]);
+
+  // The motion does not leave the starting point.
+  if (deltaX == 0.0 && deltaY == 0.0) {
+    return identityCost();
+  }
+
+  // The motion is parametrized by its major axis, the axis along which it crosses more cells. The
+  // integral along the major axis is scaled to the length of the motion.
+  const auto length = std::hypot(deltaX * cellSize_[0u], deltaY * cellSize_[1u]);
+  if (deltaX >= deltaY) {
+    return ompl::base::Cost(length / deltaX *
+                            integrate(coordinates1[0u], coordinates1[1u], coordinates2[0u],
+                                      coordinates2[1u], costMap_.numRows, costMap_.numCols,
+                                      costMap_.values, rowPrefixSums_));
+  }
+  return ompl::base::Cost(length / deltaY *
+                          integrate(coordinates1[1u], coordinates1[0u], coordinates2[1u],
+                                    coordinates2[0u], costMap_.numCols, costMap_.numRows,
+                                    transposedCosts_, colPrefixSums_));
+}
+
+ompl::base::Cost CostMapOptimizationObjective::motionCostHeuristic(
+    const ompl::base::State* state1, const ompl::base::State* state2) const {
+  return ompl::base::Cost(minCost_ * spaceInfo_->distance(state1, state2));
+}
+
+void CostMapOptimizationObjective::accept(const ObjectiveVisitor& visitor) const {
+  visitor.visit(*this);
+}
+
+std::size_t CostMapOptimizationObjective::getNumRows() const {
+  return costMap_.numRows;
+}
+
+std::size_t CostMapOptimizationObjective::getNumCols() const {
+  return costMap_.numCols;
+}
+
+double CostMapOptimizationObjective::getCellCost(std::size_t row, std::size_t col) const {
+  return costMap_(row, col);
+}
+
+double CostMapOptimizationObjective::getMinCost() const {
+  return minCost_;
+}
+
+double CostMapOptimizationObjective::getMaxCost() const {
+  return maxCost_;
+}
+
+double CostMapOptimizationObjective::integrate(double major1, double minor1, double major2,
+                                               double minor2, std::size_t numMinorCells,
+                                               std::size_t numMajorCells,
+                                               const std::vector<double>& costs,
+                                               const std::vector<double>& prefixSums) const {
+  // Let the motion go in the direction of increasing minor coordinates.
+  if (minor2 < minor1) {
+    std::swap(major1, major2);
+    std::swap(minor1, minor2);
+  }
+
+  // The motion is parallel to the major axis, it stays in a single line of cells.
+  if (minor1 == minor2) {
+    const auto line = std::min(static_cast<std::size_t>(minor1), numMinorCells - 1u);
+    return std::abs(integrateLine(major2, line, numMajorCells, costs, prefixSums) -
+                    integrateLine(major1, line, numMajorCells, costs, prefixSums));
+  }
+
+  // Walk along the lines of cells the motion crosses. Within each line the cost only depends on the
+  // major coordinate, so the integral over the part of the motion in this line is the difference of
+  // two prefix sums.
+  const auto slope = (major2 - major1) / (minor2 - minor1);
+  const auto firstLine = std::min(static_cast<std::size_t>(minor1), numMinorCells - 1u);
+  const auto lastLine = std::min(static_cast<std::size_t>(minor2), numMinorCells - 1u);
+  double integral = 0.0;
+  double entry = major1;
+  for (auto line = firstLine; line <= lastLine; ++line) {
+    const auto exit =
+        line == lastLine ? major2 : major1 + (static_cast<double>(line + 1u) - minor1) * slope;
+    integral += std::abs(integrateLine(exit, line, numMajorCells, costs, prefixSums) -
+                         integrateLine(entry, line, numMajorCells, costs, prefixSums));
+    entry = exit;
+  }
+
+  return integral;
+}
+
+std::array<double, 2u> CostMapOptimizationObjective::getCellCoordinates(
+    const ompl::base::State* state) const {
+  // States on or outside of the bounds are clamped onto the map.
+  const auto rState = state->as<ompl::base::RealVectorStateSpace::StateType>();
+  return {std::clamp((rState->values[0u] - origin_[0u]) / cellSize_[0u], 0.0,
+                     static_cast<double>(costMap_.numCols)),
+          std::clamp((rState->values[1u] - origin_[1u]) / cellSize_[1u], 0.0,
+                     static_cast<double>(costMap_.numRows))};
+}
+
+}  // namespace objectives
+
+}  // namespace pdt
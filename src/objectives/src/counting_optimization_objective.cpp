@@ -0,0 +1,133 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/objectives/counting_optimization_objective.h"
+
+namespace pdt {
+
+namespace objectives {
+
+CountingOptimizationObjective::CountingOptimizationObjective(
+    const ompl::base::OptimizationObjectivePtr& objective,
+    const std::shared_ptr<utilities::CallCounters>& counters) :
+    ompl::base::OptimizationObjective(objective->getSpaceInformation()),
+    objective_(objective),
+    counters_(counters) {
+  description_ = objective_->getDescription();
+  setCostThreshold(objective_->getCostThreshold());
+
+  // The heuristic is only set if the wrapped objective has one, so that planners that query
+  // whether a heuristic exists behave as if they were given the wrapped objective.
+  if (objective_->hasCostToGoHeuristic()) {
+    setCostToGoHeuristic(
+        [objective = objective_](const ompl::base::State* state, const ompl::base::Goal* goal) {
+          return objective->costToGo(state, goal);
+        });
+  }
+}
+
+bool CountingOptimizationObjective::isSatisfied(ompl::base::Cost cost) const {
+  return objective_->isSatisfied(cost);
+}
+
+ompl::base::Cost CountingOptimizationObjective::stateCost(const ompl::base::State* state) const {
+  return objective_->stateCost(state);
+}
+
+bool CountingOptimizationObjective::isCostBetterThan(ompl::base::Cost cost1,
+                                                     ompl::base::Cost cost2) const {
+  return objective_->isCostBetterThan(cost1, cost2);
+}
+
+ompl::base::Cost CountingOptimizationObjective::identityCost() const {
+  return objective_->identityCost();
+}
+
+ompl::base::Cost CountingOptimizationObjective::infiniteCost() const {
+  return objective_->infiniteCost();
+}
+
+ompl::base::Cost CountingOptimizationObjective::initialCost(const ompl::base::State* state) const {
+  return objective_->initialCost(state);
+}
+
+ompl::base::Cost CountingOptimizationObjective::terminalCost(const ompl::base::State* state) const {
+  return objective_->terminalCost(state);
+}
+
+ompl::base::Cost CountingOptimizationObjective::combineCosts(ompl::base::Cost cost1,
+                                                             ompl::base::Cost cost2) const {
+  return objective_->combineCosts(cost1, cost2);
+}
+
+bool CountingOptimizationObjective::isSymmetric() const {
+  return objective_->isSymmetric();
+}
+
+ompl::base::Cost CountingOptimizationObjective::averageStateCost(unsigned int numStates) const {
+  return objective_->averageStateCost(numStates);
+}
+
+ompl::base::Cost CountingOptimizationObjective::motionCostHeuristic(
+    const ompl::base::State* state1, const ompl::base::State* state2) const {
+  return objective_->motionCostHeuristic(state1, state2);
+}
+
+ompl::base::InformedSamplerPtr CountingOptimizationObjective::allocInformedStateSampler(
+    const ompl::base::ProblemDefinitionPtr& problem, unsigned int maxNumberCalls) const {
+  return objective_->allocInformedStateSampler(problem, maxNumberCalls);
+}
+
+ompl::base::Cost CountingOptimizationObjective::motionCost(const ompl::base::State* state1,
+                                                           const ompl::base::State* state2) const {
+  utilities::ScopedCall call(&counters_->motionCost);
+  return objective_->motionCost(state1, state2);
+}
+
+ompl::base::OptimizationObjectivePtr CountingOptimizationObjective::getObjective() const {
+  return objective_;
+}
+
+void CountingOptimizationObjective::accept(const ObjectiveVisitor& visitor) const {
+  if (auto visitable = std::dynamic_pointer_cast<BaseOptimizationObjective>(objective_)) {
+    visitable->accept(visitor);
+  }
+}
+
+}  // namespace objectives
+
+}  // namespace pdt
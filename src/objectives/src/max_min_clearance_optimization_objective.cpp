@@ -37,6 +37,8 @@
 
 #include "pdt/objectives/max_min_clearance_optimization_objective.h"
 
+#include <cmath>
+#include <limits>
 #include <memory>
 
 #include <ompl/base/spaces/RealVectorStateSpace.h>
@@ -45,10 +47,39 @@ namespace pdt {
 
 namespace objectives {
 
+namespace {
+
+// The clearance computations may differ from their Lipschitz bound by rounding errors.
+constexpr double SKIP_TOLERANCE{1e-9};
+
+// Returns a scratch state of the given space that belongs to the calling thread, which makes
+// motion costs safe to compute from multiple threads without allocating a state per motion.
+ompl::base::State* getScratchState(const ompl::base::StateSpacePtr& space) {
+  struct ScratchState {
+    ~ScratchState() {
+      if (state != nullptr) {
+        space->freeState(state);
+      }
+    }
+    ompl::base::StateSpacePtr space{};
+    ompl::base::State* state{nullptr};
+  };
+  thread_local ScratchState scratch;
+  if (scratch.space != space) {
+    if (scratch.state != nullptr) {
+      scratch.space->freeState(scratch.state);
+    }
+    scratch.space = space;
+    scratch.state = space->allocState();
+  }
+  return scratch.state;
+}
+
+}  // namespace
+
 MaxMinClearanceOptimizationObjective::MaxMinClearanceOptimizationObjective(
     const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo) :
     ompl::base::OptimizationObjective(spaceInfo),
-    testState_(spaceInfo->allocState()),
     spaceInfo_(spaceInfo) {
   // Optimization objectives have descriptions. (...)
   description_ = "Maximum Minimal Clearance";
@@ -57,10 +88,6 @@ MaxMinClearanceOptimizationObjective::MaxMinClearanceOptimizationObjective(
   setCostToGoHeuristic(ompl::base::goalRegionCostToGo);
 }
 
-MaxMinClearanceOptimizationObjective::~MaxMinClearanceOptimizationObjective() {
-  spaceInfo_->freeState(testState_);
-}
-
 ompl::base::Cost MaxMinClearanceOptimizationObjective::stateCost(
     const ompl::base::State* state) const {
   return ompl::base::Cost(spaceInfo_->getStateValidityChecker()->clearance(state));
@@ -104,11 +131,34 @@ ompl::base::Cost MaxMinClearanceOptimizationObjective::motionCost(
   // state along the edge).
   ompl::base::Cost totalCost = stateCost(state1);
 
+  // The clearance of a state is at most the Lipschitz constant times the distance between two
+  // consecutive states lower than that of the previous state.
+  const auto segmentClearance = clearanceLipschitzConstant_ *
+                                spaceInfo_->distance(state1, state2) /
+                                static_cast<double>(segmentCount);
+
   // Check all states along the edge.
+  auto testState = getScratchState(spaceInfo_->getStateSpace());
   for (std::size_t i = 1; i < segmentCount; ++i) {
     spaceInfo_->getStateSpace()->interpolate(
-        state1, state2, static_cast<double>(i) / static_cast<double>(segmentCount), testState_);
-    totalCost = combineCosts(stateCost(testState_), totalCost);
+        state1, state2, static_cast<double>(i) / static_cast<double>(segmentCount), testState);
+    const auto cost = stateCost(testState);
+    totalCost = combineCosts(cost, totalCost);
+
+    // The states that cannot be closer to an obstacle than the combined cost do not change it, so
+    // they can be skipped. The tolerance absorbs rounding errors in the clearance computations.
+    if (segmentClearance > 0.0) {
+      const auto margin = cost.value() - totalCost.value() -
+                          std::numeric_limits<double>::epsilon() - SKIP_TOLERANCE;
+      if (margin > 0.0) {
+        const auto numSkippable = std::ceil(margin / segmentClearance) - 1.0;
+        if (numSkippable >= static_cast<double>(segmentCount - i)) {
+          break;
+        } else if (numSkippable >= 1.0) {
+          i += static_cast<std::size_t>(numSkippable);
+        }
+      }
+    }
   }
 
   return totalCost;
@@ -127,6 +177,10 @@ void MaxMinClearanceOptimizationObjective::accept(const ObjectiveVisitor& visito
   visitor.visit(*this);
 }
 
+void MaxMinClearanceOptimizationObjective::setClearanceLipschitzConstant(double constant) {
+  clearanceLipschitzConstant_ = constant;
+}
+
 }  // namespace objectives
 
 }  // namespace pdt
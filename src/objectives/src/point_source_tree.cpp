@@ -0,0 +1,220 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/objectives/point_source_tree.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace pdt {
+
+namespace objectives {
+
+PointSourceTree::PointSourceTree(const std::vector<std::vector<double>>& sources,
+                                 double openingAngle) :
+    dimension_(sources.empty() ? 0u : sources.front().size()),
+    squaredOpeningAngle_(openingAngle * openingAngle),
+    coordinates_(dimension_) {
+  if (openingAngle < 0.0) {
+    throw std::invalid_argument("The opening angle of a point source tree must be nonnegative.");
+  }
+  for (const auto& source : sources) {
+    if (source.size() != dimension_) {
+      throw std::invalid_argument("Point sources have inconsistent dimensions.");
+    }
+  }
+  if (sources.empty()) {
+    return;
+  }
+
+  // Build the tree over a permutation of the sources.
+  std::vector<std::size_t> indices(sources.size());
+  for (std::size_t i = 0u; i < indices.size(); ++i) {
+    indices[i] = i;
+  }
+  build(sources, &indices, 0u, indices.size());
+
+  // Store the coordinates in tree order, such that the sources of every node are contiguous.
+  for (std::size_t dim = 0u; dim < dimension_; ++dim) {
+    coordinates_[dim].reserve(sources.size());
+    for (const auto index : indices) {
+      coordinates_[dim].push_back(sources[index][dim]);
+    }
+  }
+}
+
+double PointSourceTree::potential(const double* point) const {
+  if (nodes_.empty()) {
+    return 0.0;
+  }
+
+  // Without approximations, or if the root is a leaf, there is no need to traverse the tree.
+  if (squaredOpeningAngle_ == 0.0 || nodes_.front().left == 0u) {
+    return sumPotentials(point, 0u, size());
+  }
+  return potential(point, 0u);
+}
+
+double PointSourceTree::exactPotential(const double* point) const {
+  return sumPotentials(point, 0u, size());
+}
+
+std::size_t PointSourceTree::size() const {
+  return coordinates_.empty() ? 0u : coordinates_.front().size();
+}
+
+std::size_t PointSourceTree::build(const std::vector<std::vector<double>>& sources,
+                                   std::vector<std::size_t>* indices, std::size_t begin,
+                                   std::size_t end) {
+  const auto node = nodes_.size();
+  nodes_.emplace_back();
+  nodes_[node].begin = begin;
+  nodes_[node].end = end;
+
+  // Compute the centroid and the bounding box of the sources.
+  centroids_.resize(centroids_.size() + dimension_, 0.0);
+  lowerCorners_.resize(lowerCorners_.size() + dimension_, std::numeric_limits<double>::max());
+  upperCorners_.resize(upperCorners_.size() + dimension_, std::numeric_limits<double>::lowest());
+  double* centroid = &centroids_[node * dimension_];
+  double* lower = &lowerCorners_[node * dimension_];
+  double* upper = &upperCorners_[node * dimension_];
+  for (std::size_t i = begin; i < end; ++i) {
+    const auto& source = sources[(*indices)[i]];
+    for (std::size_t dim = 0u; dim < dimension_; ++dim) {
+      centroid[dim] += source[dim];
+      lower[dim] = std::min(lower[dim], source[dim]);
+      upper[dim] = std::max(upper[dim], source[dim]);
+    }
+  }
+  std::size_t widestDim = 0u;
+  for (std::size_t dim = 0u; dim < dimension_; ++dim) {
+    centroid[dim] /= static_cast<double>(end - begin);
+    nodes_[node].squaredSize += (upper[dim] - lower[dim]) * (upper[dim] - lower[dim]);
+    if (upper[dim] - lower[dim] > upper[widestDim] - lower[widestDim]) {
+      widestDim = dim;
+    }
+  }
+
+  if (end - begin <= LEAF_SIZE) {
+    return node;
+  }
+
+  // Split the sources at the median of the widest dimension of their bounding box.
+  const auto middle = begin + (end - begin) / 2u;
+  std::nth_element(indices->begin() + static_cast<long>(begin),
+                   indices->begin() + static_cast<long>(middle),
+                   indices->begin() + static_cast<long>(end),
+                   [&sources, widestDim](const std::size_t lhs, const std::size_t rhs) {
+                     return sources[lhs][widestDim] < sources[rhs][widestDim];
+                   });
+  const auto left = build(sources, indices, begin, middle);
+  const auto right = build(sources, indices, middle, end);
+  nodes_[node].left = left;
+  nodes_[node].right = right;
+  return node;
+}
+
+double PointSourceTree::potential(const double* point, std::size_t node) const {
+  const auto& current = nodes_[node];
+  if (current.left == 0u) {
+    return sumPotentials(point, current.begin, current.end);
+  }
+
+  // Compute the squared distances from the point to the centroid and to the bounding box.
+  const double* centroid = &centroids_[node * dimension_];
+  const double* lower = &lowerCorners_[node * dimension_];
+  const double* upper = &upperCorners_[node * dimension_];
+  double squaredDistanceToCentroid = 0.0;
+  double squaredDistanceToBox = 0.0;
+  for (std::size_t dim = 0u; dim < dimension_; ++dim) {
+    const auto toCentroid = point[dim] - centroid[dim];
+    squaredDistanceToCentroid += toCentroid * toCentroid;
+    const auto toBox = std::max({lower[dim] - point[dim], point[dim] - upper[dim], 0.0});
+    squaredDistanceToBox += toBox * toBox;
+  }
+
+  // A cluster is approximated by its centroid if it looks small from the point and none of its
+  // sources can be capped.
+  if (current.squaredSize < squaredOpeningAngle_ * squaredDistanceToCentroid &&
+      squaredDistanceToBox * MAX_POTENTIAL > 1.0) {
+    return static_cast<double>(current.end - current.begin) / squaredDistanceToCentroid;
+  }
+  return potential(point, current.left) + potential(point, current.right);
+}
+
+double PointSourceTree::sumPotentials(const double* point, std::size_t begin,
+                                      std::size_t end) const {
+  // Sum full blocks with one partial sum per lane, which keeps the loops free of dependencies
+  // between lanes.
+  double partialSums[LANE_WIDTH] = {};
+  std::size_t i = begin;
+  for (; i + LANE_WIDTH <= end; i += LANE_WIDTH) {
+    double squaredDistances[LANE_WIDTH] = {};
+    for (std::size_t dim = 0u; dim < dimension_; ++dim) {
+      const double* coordinates = &coordinates_[dim][i];
+      for (std::size_t lane = 0u; lane < LANE_WIDTH; ++lane) {
+        const auto difference = coordinates[lane] - point[dim];
+        squaredDistances[lane] += difference * difference;
+      }
+    }
+    // A source at the point has infinite potential before capping.
+    for (std::size_t lane = 0u; lane < LANE_WIDTH; ++lane) {
+      partialSums[lane] += std::min(1.0 / squaredDistances[lane], MAX_POTENTIAL);
+    }
+  }
+  double sum = 0.0;
+  for (std::size_t lane = 0u; lane < LANE_WIDTH; ++lane) {
+    sum += partialSums[lane];
+  }
+
+  // Sum the remaining sources one by one.
+  for (; i < end; ++i) {
+    double squaredDistance = 0.0;
+    for (std::size_t dim = 0u; dim < dimension_; ++dim) {
+      const auto difference = coordinates_[dim][i] - point[dim];
+      squaredDistance += difference * difference;
+    }
+    sum += std::min(1.0 / squaredDistance, MAX_POTENTIAL);
+  }
+
+  return sum;
+}
+
+}  // namespace objectives
+
+}  // namespace pdt
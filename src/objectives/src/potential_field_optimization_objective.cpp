@@ -62,48 +62,34 @@ PotentialFieldOptimizationObjective::PotentialFieldOptimizationObjective(
   description_ = "Potential Field";
 
   // Load the point sources as specified in the config.
-  for (const auto& point : config_->get<std::vector<std::vector<double>>>(
-           "objective/" +
-           config_->get<std::string>("context/" + config_->get<std::string>("experiment/context") +
-                                     "/objective") +
-           "/sources")) {
-    // allocate a state for each point source.
-    pointSources_.push_back(spaceInfo_->allocState());
-
+  const auto parentKey =
+      "objective/" +
+      config_->get<std::string>("context/" + config_->get<std::string>("experiment/context") +
+                                "/objective");
+  const auto sources = config_->get<std::vector<std::vector<double>>>(parentKey + "/sources");
+  for (const auto& point : sources) {
     // Ensure the point source has the correct dimension.
     if (point.size() != spaceInfo_->getStateDimension()) {
       std::cout << "point.size(): " << point.size()
                 << ", dimensions: " << spaceInfo_->getStateDimension() << '\n';
       throw std::runtime_error("Source in potential field objective has wrong dimensionality.");
     }
-
-    // Fill the state with the values from the config.
-    for (std::size_t i = 0u; i < point.size(); ++i) {
-      pointSources_.back()->as<ompl::base::RealVectorStateSpace::StateType>()->values[i] = point[i];
-    }
   }
 
+  // Far clusters of sources are only approximated if the config specifies an opening angle.
+  const auto openingAngle = config_->contains(parentKey + "/openingAngle")
+                                ? config_->get<double>(parentKey + "/openingAngle")
+                                : 0.0;
+  pointSources_ = std::make_unique<PointSourceTree>(sources, openingAngle);
+
   // // There is no good cost-to-go heuristic for this objective.
   // setCostToGoHeuristic(ompl::base::goalRegionCostToGo);
 }
 
-PotentialFieldOptimizationObjective::~PotentialFieldOptimizationObjective() {
-  // Free the point sources that were allocated in the constructor.
-  for (auto source : pointSources_) {
-    spaceInfo_->freeState(source);
-  }
-}
-
 ompl::base::Cost PotentialFieldOptimizationObjective::stateCost(
     const ompl::base::State* state) const {
-  // Sum up all cost of all sources, inversely proportional to the squared distance, capped at 1000.
-  ompl::base::Cost totalCost = identityCost();
-  for (const auto source : pointSources_) {
-    totalCost = combineCosts(
-        totalCost, ompl::base::Cost(
-                       std::min(1.0 / std::pow(spaceInfo_->distance(source, state), 2.0), 1000.0)));
-  }
-  return totalCost;
+  return ompl::base::Cost(pointSources_->potential(
+      state->as<ompl::base::RealVectorStateSpace::StateType>()->values));
 }
 
 ompl::base::Cost PotentialFieldOptimizationObjective::motionCostHeuristic(
@@ -37,61 +37,76 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
 #include <vector>
 
-// GCC complains about eigen when compiling with these warnings.
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Weffc++"
-#pragma GCC diagnostic ignored "-Wuninitialized"
-#include <Eigen/Core>
-#pragma GCC diagnostic pop
-
-#include <ompl/base/SpaceInformation.h>
-#include <ompl/base/StateValidityChecker.h>
-
-#include "pdt/obstacles/base_obstacle.h"
-
 namespace pdt {
 
 namespace obstacles {
 
-class BinaryMap : public BaseObstacle {
+// An occupancy grid that stores one bit per cell, packed into 64 bit words row by row. In cell
+// coordinates, the cell in row r and column c covers [c, c + 1) x [r, r + 1), i.e., points on the
+// boundary between two cells belong to the cell with the larger index. Points on the upper
+// boundary of the map belong to the last row or column.
+class BinaryMap {
  public:
-  BinaryMap(ompl::base::SpaceInformation* si, const double obsThreshold,
-            const std::string& fullCsvFileName, const bool plotCsv, const bool flipCsvRows = false,
-            const std::string& fullPngFileName = "");
-  BinaryMap(const ompl::base::SpaceInformationPtr& si, const double obsThreshold,
-            const std::string& fullFileName, const bool plotCsv, const bool flipCsvRows = false,
-            const std::string& fullPngFileName = "");
+  // Creates a map of free cells.
+  BinaryMap(std::size_t numRows, std::size_t numCols);
+
+  // Loads a map from a PGM image if the file has the extension .pgm and from a CSV file otherwise.
+  // Cells with values of at least the threshold are occupied. The file is streamed row by row.
+  BinaryMap(const std::string& filename, double threshold);
+
+  // Loads a map of the given size from a raw file with one byte per cell, row by row.
+  BinaryMap(const std::string& filename, std::size_t numRows, std::size_t numCols,
+            double threshold);
+
   ~BinaryMap() = default;
 
-  /** \brief Check for state validity */
-  virtual bool isValid(const ompl::base::State* state) const;
+  // Get the dimensions of the map.
+  std::size_t getNumRows() const;
+  std::size_t getNumCols() const;
+
+  // Get or set the occupancy of a cell.
+  bool isOccupied(std::size_t row, std::size_t col) const;
+  void setOccupied(std::size_t row, std::size_t col, bool occupied);
+
+  // Returns the occupancy of the cell that contains the point in cell coordinates.
+  bool isOccupied(const double* point) const;
 
-  /** \brief The obstacle map as a series of Matlab plot functions. (Discard arguments */
-  virtual std::string mfile(const std::string& /*obsColour*/,
-                            const std::string& /*spaceColour*/) const;
+  // Returns the number of occupied cells.
+  std::size_t countOccupied() const;
+
+  // Reverses the order of the rows.
+  void flipRows();
+
+  // Swaps occupied and free cells, e.g., for images in which obstacles are dark.
+  void invert();
+
+  // Returns the fraction of the segment between two points in cell coordinates at which it first
+  // enters an occupied cell, or infinity if all cells it crosses are free. The cells are visited
+  // with the traversal of Amanatides and Woo, which crosses cell corners diagonally, so every cell
+  // that contains a point of the segment is checked and no other cell is.
+  double findFirstOccupied(const double* from, const double* to) const;
 
- protected:
  private:
-  /// \brief A common constructor
-  void construct(const bool flipRows);
-  /// \brief Parse the csv
-  void parseCsv(unsigned int* numRows, unsigned int* numCols,
-                std::vector<std::vector<double> >* data);
-
-  // Variables
-  ompl::base::SpaceInformationPtr spaceInfo_;
-  /// \brief The cost threshold
-  double threshold_{0.0};
-  /// \brief The csv file of costs
-  std::string csvFile_{""};
-  /// \brief The (optional) image file to overlay in the plot
-  std::string pngFile_{""};
-  /// \brief Whether to plot the csv
-  bool plotCsv_{false};
-  /// \brief The obs data
-  Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> obsData_{0, 0};
+  // Appends a row of cells, which are occupied if their values are at least the threshold.
+  void appendRow(const std::vector<double>& values, double threshold);
+
+  // Returns the cell that contains the coordinate, clamped onto the map.
+  static std::size_t getCell(double coordinate, std::size_t numCells);
+
+  // The dimensions of the map.
+  std::size_t numRows_{0u};
+  std::size_t numCols_{0u};
+
+  // The number of words that store one row.
+  std::size_t wordsPerRow_{0u};
+
+  // The occupancy of all cells, row by row.
+  std::vector<std::uint64_t> words_{};
 };
 
 }  // namespace obstacles
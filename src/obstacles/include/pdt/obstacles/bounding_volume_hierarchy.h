@@ -0,0 +1,171 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace pdt {
+
+namespace obstacles {
+
+// A bounding volume hierarchy of axis-aligned boxes. The hierarchy is built in bulk by recursively
+// splitting the boxes at the median of their centers along the axis of largest extent, which keeps
+// it balanced regardless of the sizes of the boxes. Queries do not allocate.
+class BoundingVolumeHierarchy {
+ public:
+  explicit BoundingVolumeHierarchy(std::size_t dimension);
+  ~BoundingVolumeHierarchy() = default;
+
+  // Builds the hierarchy of the given boxes, replacing any previous boxes. The bounds of box i are
+  // stored at [i * dimension, (i + 1) * dimension) of the lower and upper bounds.
+  void build(const std::vector<double>& lowerBounds, const std::vector<double>& upperBounds);
+
+  // Calls visit(i) for the index i of every box that contains the point until visit returns true.
+  // Returns whether it did. Points on the boundary of a box are inside.
+  template <typename Visitor>
+  bool anyContaining(const double* point, const Visitor& visit) const;
+
+  // Calls visit(i) for the index i of every box that intersects the straight segment between the
+  // two points until visit returns true. Returns whether it did.
+  template <typename Visitor>
+  bool anyIntersecting(const double* from, const double* to, const Visitor& visit) const;
+
+  // Returns the number of boxes in the hierarchy.
+  std::size_t size() const;
+
+  // The maximum number of boxes in a leaf.
+  static constexpr std::size_t MAX_LEAF_SIZE{4u};
+
+ private:
+  // A node covers the boxes [begin, end) of the reordered boxes. The left child of an inner node
+  // directly follows it.
+  struct Node {
+    std::size_t begin{0u};
+    std::size_t end{0u};
+    std::size_t right{0u};
+  };
+
+  // Recursively builds the node covering the boxes [begin, end) and returns its index.
+  std::size_t buildNode(std::size_t begin, std::size_t end, const std::vector<double>& lowerBounds,
+                        const std::vector<double>& upperBounds);
+
+  // Returns whether the point is inside the given bounds, which hold the lower bounds of all
+  // dimensions followed by the upper bounds.
+  bool contains(const double* bounds, const double* point) const;
+
+  // Returns whether the segment intersects the given bounds.
+  bool intersects(const double* bounds, const double* from, const double* to) const;
+
+  // The dimension of the boxes.
+  const std::size_t dimension_;
+
+  // The nodes in depth first order and their bounds. The lower and upper bounds of a node are
+  // stored next to each other, such that testing a node touches as few cache lines as possible.
+  std::vector<Node> nodes_{};
+  std::vector<double> nodeBounds_{};
+
+  // The boxes, reordered such that every node covers a contiguous range of them, and their indices.
+  std::vector<std::size_t> indices_{};
+  std::vector<double> boxBounds_{};
+
+  // Balanced trees of any size that fits into memory are shallower than this.
+  static constexpr std::size_t MAX_DEPTH{64u};
+};
+
+template <typename Visitor>
+bool BoundingVolumeHierarchy::anyContaining(const double* point, const Visitor& visit) const {
+  if (nodes_.empty()) {
+    return false;
+  }
+  std::array<std::size_t, MAX_DEPTH> stack;
+  std::size_t stackSize = 0u;
+  stack[stackSize++] = 0u;
+  while (stackSize != 0u) {
+    const auto index = stack[--stackSize];
+    if (!contains(&nodeBounds_[2u * index * dimension_], point)) {
+      continue;
+    }
+    const auto& node = nodes_[index];
+    if (node.right == 0u) {
+      for (auto i = node.begin; i < node.end; ++i) {
+        if (contains(&boxBounds_[2u * i * dimension_], point) && visit(indices_[i])) {
+          return true;
+        }
+      }
+    } else {
+      stack[stackSize++] = node.right;
+      stack[stackSize++] = index + 1u;
+    }
+  }
+  return false;
+}
+
+template <typename Visitor>
+bool BoundingVolumeHierarchy::anyIntersecting(const double* from, const double* to,
+                                              const Visitor& visit) const {
+  if (nodes_.empty()) {
+    return false;
+  }
+  std::array<std::size_t, MAX_DEPTH> stack;
+  std::size_t stackSize = 0u;
+  stack[stackSize++] = 0u;
+  while (stackSize != 0u) {
+    const auto index = stack[--stackSize];
+    if (!intersects(&nodeBounds_[2u * index * dimension_], from, to)) {
+      continue;
+    }
+    const auto& node = nodes_[index];
+    if (node.right == 0u) {
+      for (auto i = node.begin; i < node.end; ++i) {
+        if (intersects(&boxBounds_[2u * i * dimension_], from, to) && visit(indices_[i])) {
+          return true;
+        }
+      }
+    } else {
+      stack[stackSize++] = node.right;
+      stack[stackSize++] = index + 1u;
+    }
+  }
+  return false;
+}
+
+}  // namespace obstacles
+
+}  // namespace pdt
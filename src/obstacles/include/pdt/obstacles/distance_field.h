@@ -0,0 +1,99 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <ompl/base/SpaceInformation.h>
+
+#include "pdt/obstacles/base_obstacle.h"
+
+namespace pdt {
+
+namespace obstacles {
+
+// A grid of the clearance to a set of obstacles that covers the bounds of a two or three
+// dimensional real vector space. The clearance is computed exactly at the vertices of the grid and
+// interpolated (bi- or trilinearly) in between. Because the clearance is 1-Lipschitz, the
+// interpolated clearance differs from the exact clearance by at most sqrt(dimension) / 2 times the
+// resolution. The interpolated clearance is sqrt(dimension)-Lipschitz.
+class DistanceField {
+ public:
+  // Computes the clearance at all vertices of the grid, distributed over the given number of
+  // threads.
+  DistanceField(const ompl::base::SpaceInformationPtr& spaceInfo,
+                const std::vector<std::shared_ptr<BaseObstacle>>& obstacles, double resolution,
+                std::size_t numThreads);
+  ~DistanceField() = default;
+
+  // Returns whether the field covers the point. A field of no obstacles covers no points.
+  bool covers(const double* point) const;
+
+  // Returns the interpolated clearance of a point the field covers.
+  double clearance(const double* point) const;
+
+  // Returns the maximum difference between the interpolated and the exact clearance.
+  double getErrorBound() const;
+
+  // Returns the Lipschitz constant of the interpolated clearance.
+  double getLipschitzConstant() const;
+
+  // Returns the maximum difference between the interpolated and the exact clearance of a field
+  // with the given dimension and resolution.
+  static double computeErrorBound(std::size_t dimension, double resolution);
+
+ private:
+  // The dimension of the field.
+  const std::size_t dimension_;
+
+  // The distance between neighbouring vertices.
+  const double resolution_;
+
+  // The coordinates of the first vertex and the number of vertices in every dimension.
+  std::vector<double> origin_{};
+  std::vector<std::size_t> numVertices_{};
+
+  // The clearance of every vertex, with the first dimension varying fastest.
+  std::vector<double> values_{};
+};
+
+}  // namespace obstacles
+
+}  // namespace pdt
@@ -0,0 +1,120 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace pdt {
+
+namespace obstacles {
+
+// A set of axis-aligned hyperrectangles that is compiled for fast point queries. The lower and
+// upper bounds of all hyperrectangles are stored in one contiguous array per dimension, such that
+// a point can be tested against several hyperrectangles at once with AVX-512 or AVX2 if the
+// library is compiled for them (see PDT_NATIVE_ARCH), and against one at a time otherwise.
+class HyperrectangleSet {
+ public:
+  explicit HyperrectangleSet(std::size_t dimension);
+  ~HyperrectangleSet() = default;
+
+  // Adds a hyperrectangle with the given center and widths. The bounds are widened by machine
+  // epsilon, which makes points on the boundary inside, just like for Hyperrectangle.
+  void add(const std::vector<double>& center, const std::vector<double>& widths);
+  void add(const double* center, const double* widths);
+
+  // Adds all hyperrectangles of another set of the same dimension.
+  void append(const HyperrectangleSet& other);
+
+  // Removes all hyperrectangles.
+  void clear();
+
+  // Returns whether the point is inside any of the hyperrectangles.
+  bool contains(const double* point) const;
+
+  // Returns whether any of the points is inside any of the hyperrectangles. Every block of
+  // hyperrectangles is loaded once and tested against all points, which is faster than testing
+  // the points one by one if the hyperrectangles do not fit into the cache.
+  bool containsAny(const double* const* points, std::size_t numPoints) const;
+
+  // Returns the Euclidean distance of the point to the closest hyperrectangle, which is zero inside
+  // a hyperrectangle and infinite if the set is empty. This is the clearance of Hyperrectangle.
+  double clearance(const double* point) const;
+
+  // Returns the center and widths of the i-th hyperrectangle as they were added.
+  const double* getCenter(std::size_t i) const;
+  const double* getWidths(std::size_t i) const;
+
+  // Returns the dimension of the hyperrectangles.
+  std::size_t getDimension() const;
+
+  // Returns the number of hyperrectangles in this set.
+  std::size_t size() const;
+
+  // Returns whether this set contains no hyperrectangles.
+  bool empty() const;
+
+  // The number of hyperrectangles that are tested at once. The bound arrays are padded to a
+  // multiple of this with hyperrectangles that contain no points.
+  static constexpr std::size_t LANE_WIDTH{8u};
+
+ private:
+  // Returns whether the point is inside any of the LANE_WIDTH hyperrectangles starting at first.
+  bool blockContains(std::size_t first, const double* point) const;
+
+  // Pads the bound arrays with empty hyperrectangles to a multiple of LANE_WIDTH.
+  void pad();
+
+  // The dimension of the hyperrectangles.
+  const std::size_t dimension_;
+
+  // The number of hyperrectangles.
+  std::size_t size_{0u};
+
+  // The lower and upper bounds of all hyperrectangles, one array per dimension.
+  std::vector<std::vector<double>> lowerBounds_;
+  std::vector<std::vector<double>> upperBounds_;
+
+  // The centers and widths of all hyperrectangles, one after the other.
+  std::vector<double> centers_{};
+  std::vector<double> widths_{};
+};
+
+}  // namespace obstacles
+
+}  // namespace pdt
@@ -0,0 +1,92 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace pdt {
+
+namespace obstacles {
+
+// A static kd-tree of points that answers whether any point lies inside an axis-aligned box. The
+// tree is built in bulk by recursively splitting the points at the median along the axis in which
+// they spread the most. The median point of a node is its splitting point, so the tree is stored
+// implicitly in the order of the points. Queries do not allocate.
+class PointKdTree {
+ public:
+  explicit PointKdTree(std::size_t dimension);
+  ~PointKdTree() = default;
+
+  // Builds the tree of the given points, replacing any previous points. Point i is stored at
+  // [i * dimension, (i + 1) * dimension).
+  void build(const std::vector<double>& points);
+
+  // Returns whether any point is inside the box with the given lower and upper bounds. Points on
+  // the boundary of the box are inside.
+  bool anyInside(const double* lowerBounds, const double* upperBounds) const;
+
+  // Returns the number of points in the tree.
+  std::size_t size() const;
+
+  // The maximum number of points in a leaf.
+  static constexpr std::size_t MAX_LEAF_SIZE{8u};
+
+ private:
+  // Recursively sorts the points [begin, end) into a subtree.
+  void buildNode(std::size_t begin, std::size_t end);
+
+  // Returns whether the point is inside the box.
+  bool contains(const double* point, const double* lowerBounds, const double* upperBounds) const;
+
+  // The dimension of the points.
+  const std::size_t dimension_;
+
+  // The points in the order of the tree.
+  std::vector<double> points_{};
+
+  // The splitting axis of the node whose splitting point is the point at the same index.
+  std::vector<std::size_t> axes_{};
+
+  // Balanced trees of any size that fits into memory are shallower than this.
+  static constexpr std::size_t MAX_DEPTH{64u};
+};
+
+}  // namespace obstacles
+
+}  // namespace pdt
@@ -0,0 +1,89 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace pdt {
+
+namespace obstacles {
+
+// A grid of values, such as costs or occupancies, stored row by row.
+struct Raster {
+  std::size_t numRows{0u};
+  std::size_t numCols{0u};
+  std::vector<double> values{};
+
+  // Returns the value in the given row and column.
+  double operator()(std::size_t row, std::size_t col) const;
+
+  // Reverses the order of the rows.
+  void flipRows();
+};
+
+// Streams the rows of a CSV file with one row of comma separated values per line to the callback,
+// one row at a time, such that large files never have to be held in memory as a whole.
+void streamCsvRows(const std::string& filename,
+                   const std::function<void(const std::vector<double>&)>& processRow);
+
+// Streams the rows of a binary (P5) or plain (P2) PGM image to the callback, one row of grey levels
+// at a time, starting with the top row of the image.
+void streamPgmRows(const std::string& filename,
+                   const std::function<void(const std::vector<double>&)>& processRow);
+
+// Streams the rows of a raw file with one byte per value and no header to the callback, one row at
+// a time, starting with the first row in the file.
+void streamRawRows(const std::string& filename, std::size_t numRows, std::size_t numCols,
+                   const std::function<void(const std::vector<double>&)>& processRow);
+
+// Loads a raster from a CSV file with one row of comma separated values per line.
+Raster loadCsvRaster(const std::string& filename);
+
+// Loads a raster from a binary (P5) or plain (P2) PGM image. The values are the grey levels, the
+// first row is the top row of the image.
+Raster loadPgmRaster(const std::string& filename);
+
+// Loads a raster from a PGM image if the file has the extension .pgm and from a CSV file otherwise.
+Raster loadRaster(const std::string& filename);
+
+}  // namespace obstacles
+
+}  // namespace pdt
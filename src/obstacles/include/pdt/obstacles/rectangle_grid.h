@@ -0,0 +1,116 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace pdt {
+
+namespace obstacles {
+
+// A set of axis-aligned rectangles in the plane that is compiled for fast collision checks against
+// oriented rectangles, such as a car. The rectangles are binned in a uniform grid, and the centers
+// and half widths of the rectangles in each cell are stored in one contiguous array each, such
+// that an oriented rectangle can be tested against several rectangles of a cell at once with
+// AVX-512 or AVX2 if the library is compiled for them (see PDT_NATIVE_ARCH).
+class RectangleGrid {
+ public:
+  // The cells of the grid have at least the given side length. Choosing the diameter of the
+  // circumcircle of the oriented rectangles makes a query touch at most four cells.
+  explicit RectangleGrid(double minCellSideLength);
+  ~RectangleGrid() = default;
+
+  // Adds rectangles with the given centers and widths and rebuilds the grid.
+  void add(const std::vector<std::array<double, 2u>>& centers,
+           const std::vector<std::array<double, 2u>>& widths);
+
+  // Returns whether the rectangle centered at (x, y) with the given half length along the
+  // direction (cosine, sine) and the given half width orthogonal to it intersects any of the
+  // rectangles. Touching rectangles intersect.
+  bool intersects(double x, double y, double cosine, double sine, double halfLength,
+                  double halfWidth) const;
+
+  // Returns the number of rectangles in this grid.
+  std::size_t size() const;
+
+  // Returns whether this grid contains no rectangles.
+  bool empty() const;
+
+  // The number of rectangles that are tested at once. The arrays of each cell are padded to a
+  // multiple of this with rectangles that intersect nothing.
+  static constexpr std::size_t LANE_WIDTH{8u};
+
+ private:
+  // Bins all rectangles into a grid that covers them.
+  void build();
+
+  // Returns the index of the column or row that contains the given coordinate, which may be
+  // outside the grid.
+  long getCellIndex(double coordinate, std::size_t dim) const;
+
+  // Returns whether the rectangle intersects any of the rectangles in the given range of the
+  // cell arrays, whose length is a multiple of the lane width.
+  bool intersects(std::size_t begin, std::size_t end, double x, double y, double cosine,
+                  double sine, double halfLength, double halfWidth) const;
+
+  // The minimum side length of the cells.
+  const double minCellSideLength_;
+
+  // The centers and widths of all rectangles, in the order they were added.
+  std::vector<std::array<double, 2u>> centers_{};
+  std::vector<std::array<double, 2u>> widths_{};
+
+  // The lower corner of the grid, its cell side length, and its number of columns and rows.
+  std::array<double, 2u> origin_{{0.0, 0.0}};
+  double cellSideLength_{0.0};
+  std::array<std::size_t, 2u> numCells_{{0u, 0u}};
+
+  // The rectangles of cell (column, row) are stored in [cellOffsets_[k], cellOffsets_[k + 1]) of
+  // the arrays below, with k = row * numCells_[0] + column.
+  std::vector<std::size_t> cellOffsets_{};
+  std::vector<double> centersX_{};
+  std::vector<double> centersY_{};
+  std::vector<double> halfWidthsX_{};
+  std::vector<double> halfWidthsY_{};
+};
+
+}  // namespace obstacles
+
+}  // namespace pdt
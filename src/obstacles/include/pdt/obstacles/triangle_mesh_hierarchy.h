@@ -0,0 +1,134 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "pdt/obstacles/triangle_mesh.h"
+
+namespace pdt {
+
+namespace obstacles {
+
+// A rigid transformation, which rotates points and then translates them.
+struct RigidTransform {
+  // The rotation matrix, row by row.
+  std::array<double, 9u> rotation{1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+
+  // The translation.
+  std::array<double, 3u> translation{};
+
+  // Returns the transformed point.
+  std::array<double, 3u> apply(const std::array<double, 3u>& point) const;
+
+  // Returns the transformation with the rotation of a unit quaternion and the given translation.
+  static RigidTransform fromQuaternion(double x, double y, double z, double w,
+                                       const std::array<double, 3u>& translation);
+};
+
+// A bounding volume hierarchy of the triangles of a mesh. The hierarchy is built once in the frame
+// of the mesh, by recursively splitting the triangles at the median of their centroids along the
+// axis of largest extent. Two hierarchies are checked against each other by descending both at
+// once, after transforming the boxes of one of them into the frame of the other. Queries do not
+// allocate and do not modify the hierarchy, so they can run in parallel.
+//
+// Only the surfaces of the meshes are checked, i.e., a mesh that is completely inside another one
+// does not collide with it.
+class TriangleMeshHierarchy {
+ public:
+  explicit TriangleMeshHierarchy(const TriangleMesh& mesh);
+  ~TriangleMeshHierarchy() = default;
+
+  // Returns whether any triangle of the other mesh, placed by the given pose in the frame of this
+  // mesh, intersects any triangle of this mesh.
+  bool collides(const TriangleMeshHierarchy& other, const RigidTransform& otherPose) const;
+
+  // Returns the distance between this mesh and the other mesh, placed by the given pose in the
+  // frame of this mesh. This is zero if they collide and infinity if either mesh is empty. Pairs of
+  // boxes that are farther apart than the closest pair of triangles found so far are skipped.
+  double computeDistance(const TriangleMeshHierarchy& other, const RigidTransform& otherPose) const;
+
+  // Returns the number of triangles.
+  std::size_t size() const;
+
+  // Returns the coordinates of the vertices of a triangle. The triangles are reordered when the
+  // hierarchy is built.
+  const std::array<double, 9u>& getTriangle(std::size_t index) const;
+
+  // The maximum number of triangles in a leaf.
+  static constexpr std::size_t MAX_LEAF_SIZE{4u};
+
+ private:
+  // A node covers the triangles [begin, end) and is bounded by the axis-aligned box with the given
+  // center and half extents. The left child of an inner node directly follows it.
+  struct Node {
+    std::array<double, 3u> center{};
+    std::array<double, 3u> halfExtents{};
+    std::size_t begin{0u};
+    std::size_t end{0u};
+    std::size_t right{0u};
+  };
+
+  // Recursively builds the node covering the triangles [begin, end) and returns its index.
+  std::size_t buildNode(std::size_t begin, std::size_t end,
+                        const std::vector<std::array<double, 3u>>& centroids,
+                        std::vector<std::size_t>* indices);
+
+  // Returns the box of a node of the other hierarchy, transformed by the pose into the frame of
+  // this hierarchy and enlarged such that it is axis aligned again.
+  static Node transformNode(const Node& node, const RigidTransform& pose,
+                            const std::array<double, 9u>& absoluteRotation);
+
+  // Returns the squared distance between two axis-aligned boxes.
+  static double computeSquaredDistance(const Node& node, const Node& otherNode);
+
+  // The nodes in depth first order.
+  std::vector<Node> nodes_{};
+
+  // The triangles, reordered such that every node covers a contiguous range of them.
+  std::vector<std::array<double, 9u>> triangles_{};
+
+  // Balanced trees of any size that fits into memory are shallower than this.
+  static constexpr std::size_t MAX_DEPTH{64u};
+};
+
+}  // namespace obstacles
+
+}  // namespace pdt
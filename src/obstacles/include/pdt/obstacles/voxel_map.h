@@ -0,0 +1,148 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace pdt {
+
+namespace obstacles {
+
+// A sparse three dimensional occupancy grid. The voxels are grouped into bricks of 8 x 8 x 8
+// voxels, which store one bit per voxel, and the bricks into nodes of 16 x 16 x 16 bricks. Bricks
+// and nodes that are completely free or completely occupied are stored as a single tile, so the
+// memory grows with the area of the obstacle surfaces rather than with the volume of the grid.
+// Queries look at the coarsest tile first and skip free tiles as a whole.
+//
+// In voxel coordinates, the voxel with indices (x, y, z) covers [x, x + 1) x [y, y + 1) x
+// [z, z + 1). Points on the upper boundary of the grid belong to the last voxel.
+class VoxelMap {
+ public:
+  // The number of voxels along the side of a brick and of a node.
+  static constexpr std::size_t BRICK_SIDE_LENGTH{8u};
+  static constexpr std::size_t NODE_SIDE_LENGTH{128u};
+
+  // Creates a grid of free voxels.
+  explicit VoxelMap(const std::array<std::size_t, 3u>& numVoxels);
+
+  // Loads a grid from a binvox file. Binvox files store run-length encoded voxels with the
+  // y index running fastest, then the z index, then the x index. Since the y axis of binvox files
+  // points up, it becomes the z axis of this grid and the z axis of the file becomes the y axis.
+  explicit VoxelMap(const std::string& filename);
+
+  ~VoxelMap() = default;
+
+  // Get the number of voxels along each axis.
+  const std::array<std::size_t, 3u>& getNumVoxels() const;
+
+  // Get or set the occupancy of a voxel.
+  bool isOccupied(const std::array<std::size_t, 3u>& voxel) const;
+  void setOccupied(const std::array<std::size_t, 3u>& voxel, bool occupied);
+
+  // Returns the occupancy of the voxel that contains the point in voxel coordinates.
+  bool isOccupied(const double* point) const;
+
+  // Returns the number of occupied voxels.
+  std::size_t countOccupied() const;
+
+  // Returns the number of bytes used to store the occupancy.
+  std::size_t getNumBytes() const;
+
+  // Replaces free and occupied bricks and nodes with tiles and releases the memory they used. This
+  // is done after loading and should be done after setting many voxels.
+  void compact();
+
+  // Calls the function with the lower corner and the side length in voxels of every occupied node
+  // tile and every brick that contains occupied voxels.
+  void forEachBlock(
+      const std::function<void(const std::array<std::size_t, 3u>&, std::size_t)>& function) const;
+
+  // Returns the fraction of the segment between two points in voxel coordinates at which it first
+  // enters an occupied voxel, or infinity if all voxels it crosses are free. The voxels are visited
+  // with the traversal of Amanatides and Woo, which jumps over free tiles.
+  double findFirstOccupied(const double* from, const double* to) const;
+
+  // Returns the distance of a point in voxel coordinates to the closest occupied voxel, which is
+  // zero in occupied voxels and infinity if no voxel is occupied. The side lengths of the voxels
+  // scale the distance along each axis. Tiles that are farther away than the closest occupied
+  // voxel found so far are skipped.
+  double computeClearance(const double* point, const double* voxelSideLengths) const;
+
+ private:
+  // Returns the side length of the largest free tile that contains the voxel, which is zero if
+  // the voxel is occupied.
+  std::size_t getFreeSideLength(const std::array<std::size_t, 3u>& voxel) const;
+
+  // Returns the index of the root entry of the node that contains a voxel.
+  std::size_t getRootIndex(const std::array<std::size_t, 3u>& voxel) const;
+
+  // Returns the index of the entry of the brick that contains a voxel within its node.
+  static std::size_t getNodeOffset(const std::array<std::size_t, 3u>& voxel);
+
+  // Returns the index of the bit of a voxel within its brick.
+  static std::size_t getBrickOffset(const std::array<std::size_t, 3u>& voxel);
+
+  // Appends a node or brick whose entries or voxels are all the given tile, and returns its index.
+  std::uint32_t appendNode(std::uint32_t tile);
+  std::uint32_t appendBrick(std::uint32_t tile);
+
+  // Returns the voxel that contains the coordinate, clamped onto the grid.
+  static std::size_t getVoxel(double coordinate, std::size_t numVoxels);
+
+  // The number of voxels and nodes along each axis.
+  std::array<std::size_t, 3u> numVoxels_{};
+  std::array<std::size_t, 3u> numNodes_{};
+
+  // For every node, the index of its entries or a tile.
+  std::vector<std::uint32_t> root_{};
+
+  // For every brick of every allocated node, the index of its words or a tile.
+  std::vector<std::uint32_t> nodeEntries_{};
+
+  // The occupancy of the voxels of all allocated bricks.
+  std::vector<std::uint64_t> brickWords_{};
+};
+
+}  // namespace obstacles
+
+}  // namespace pdt
@@ -37,171 +37,172 @@
 
 #include "pdt/obstacles/binary_map.h"
 
-#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
 
-#include <boost/lexical_cast.hpp>
-
-#include <ompl/base/spaces/RealVectorStateSpace.h>
-#include <ompl/util/Exception.h>
+#include "pdt/obstacles/raster.h"
 
 namespace pdt {
 
 namespace obstacles {
 
-BinaryMap::BinaryMap(const ompl::base::SpaceInformationPtr& si, const double obsThreshold,
-                     const std::string& fullCsvFileName, const bool plotCsv,
-                     const bool flipCsvRows /*= false*/,
-                     const std::string& fullPngFileName /*= ""*/) :
-    BaseObstacle(),
-    spaceInfo_(si),
-    threshold_(obsThreshold),
-    csvFile_(fullCsvFileName),
-    pngFile_(fullPngFileName),
-    plotCsv_(plotCsv) {
-  this->construct(flipCsvRows);
+namespace {
+
+constexpr std::size_t BITS_PER_WORD{64u};
+
+}  // namespace
+
+BinaryMap::BinaryMap(std::size_t numRows, std::size_t numCols) :
+    numRows_(numRows),
+    numCols_(numCols),
+    wordsPerRow_((numCols + BITS_PER_WORD - 1u) / BITS_PER_WORD),
+    words_(numRows * wordsPerRow_, 0u) {
 }
 
-void BinaryMap::construct(const bool flipRows) {
-  // Variable
-  // The number of rows
-  unsigned int numRows;
-  // The number of columns
-  unsigned numCols;
-  // The parsed CSV file:
-  std::vector<std::vector<double> > csvParsed;
-
-  // Parse the csv file
-  parseCsv(&numRows, &numCols, &csvParsed);
-
-  // Resize the eigen matrix
-  obsData_.resize(numRows, numCols);
-
-  // Iterate over rows
-  for (int r = 0u; r < obsData_.rows(); ++r) {
-    // and columns
-    for (unsigned int c = 0u; c < obsData_.cols(); ++c) {
-      // Storing data
-      obsData_(r, c) = (csvParsed.at(r).at(c) >= threshold_);
-    }
+BinaryMap::BinaryMap(const std::string& filename, double threshold) {
+  const auto appendRowAboveThreshold = [this, threshold](const std::vector<double>& values) {
+    appendRow(values, threshold);
+  };
+  const std::string extension{".pgm"};
+  if (filename.size() >= extension.size() &&
+      filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0) {
+    streamPgmRows(filename, appendRowAboveThreshold);
+  } else {
+    streamCsvRows(filename, appendRowAboveThreshold);
   }
+}
 
-  // Are we flipping the rows?
-  if (flipRows == true) {
-    obsData_ = obsData_.colwise().reverse().eval();
-  }
+BinaryMap::BinaryMap(const std::string& filename, std::size_t numRows, std::size_t numCols,
+                     double threshold) {
+  words_.reserve(numRows * ((numCols + BITS_PER_WORD - 1u) / BITS_PER_WORD));
+  streamRawRows(filename, numRows, numCols, [this, threshold](const std::vector<double>& values) {
+    appendRow(values, threshold);
+  });
 }
 
-// Adapted from http://stackoverflow.com/a/1120224
-void BinaryMap::parseCsv(unsigned int* numRows, unsigned int* numCols,
-                         std::vector<std::vector<double> >* data) {
-  // Variables
-  // The input csv file
-  std::ifstream csvStream;
-  // Each line of the csv as a string
-  std::string csvLine;
-
-  // Open the file
-  csvStream.open(csvFile_.c_str());
-
-  // Check
-  if (csvStream.is_open() == false) {
-    throw ompl::Exception("Could not open csv file");
-  }
+std::size_t BinaryMap::getNumRows() const {
+  return numRows_;
+}
 
-  // Initialize the number of rows and columns
-  *numRows = 0u;
-  *numCols = 0u;
-
-  // Load the csv file into the string by getting it one line at a time:
-  while (std::getline(csvStream, csvLine)) {
-    data->push_back(std::vector<double>());
-    // Variables
-    // A string stream of the line
-    std::stringstream lineStream(csvLine);
-    // The actual value
-    std::string cellValue;
-
-    // Iterate along the tokens
-    while (std::getline(lineStream, cellValue, ',')) {
-      data->back().push_back(boost::lexical_cast<double>(cellValue));
-    }
+std::size_t BinaryMap::getNumCols() const {
+  return numCols_;
+}
 
-    // If this is the first row, store the number of columns, otherwise check
-    if (data->size() == 1u) {
-      *numCols = data->back().size();
-    } else if (data->back().size() != *numCols) {
-      throw ompl::Exception("Found an inconsistent number of columns in the csv file.");
-    }
+bool BinaryMap::isOccupied(std::size_t row, std::size_t col) const {
+  return (words_[row * wordsPerRow_ + col / BITS_PER_WORD] >> (col % BITS_PER_WORD)) & 1u;
+}
+
+void BinaryMap::setOccupied(std::size_t row, std::size_t col, bool occupied) {
+  const auto mask = std::uint64_t{1u} << (col % BITS_PER_WORD);
+  auto& word = words_[row * wordsPerRow_ + col / BITS_PER_WORD];
+  word = occupied ? (word | mask) : (word & ~mask);
+}
+
+bool BinaryMap::isOccupied(const double* point) const {
+  return isOccupied(getCell(point[1u], numRows_), getCell(point[0u], numCols_));
+}
+
+std::size_t BinaryMap::countOccupied() const {
+  std::size_t count = 0u;
+  for (const auto word : words_) {
+    count += static_cast<std::size_t>(__builtin_popcountll(word));
   }
+  return count;
+}
 
-  // Store the number of rows:
-  *numRows = data->size();
+void BinaryMap::flipRows() {
+  for (std::size_t row = 0u; row < numRows_ / 2u; ++row) {
+    std::swap_ranges(words_.begin() + static_cast<long>(row * wordsPerRow_),
+                     words_.begin() + static_cast<long>((row + 1u) * wordsPerRow_),
+                     words_.begin() + static_cast<long>((numRows_ - row - 1u) * wordsPerRow_));
+  }
+}
 
-  // Close the file
-  csvStream.close();
+void BinaryMap::invert() {
+  // The unused bits of the last word of each row stay free.
+  const auto numUsedBits = numCols_ % BITS_PER_WORD;
+  const auto lastWordMask =
+      numUsedBits == 0u ? ~std::uint64_t{0u} : (std::uint64_t{1u} << numUsedBits) - 1u;
+  for (std::size_t row = 0u; row < numRows_; ++row) {
+    for (std::size_t word = 0u; word < wordsPerRow_; ++word) {
+      words_[row * wordsPerRow_ + word] = ~words_[row * wordsPerRow_ + word];
+    }
+    words_[(row + 1u) * wordsPerRow_ - 1u] &= lastWordMask;
+  }
 }
 
-bool BinaryMap::isValid(const ompl::base::State* state) const {
-  // Variable
-  // The return value
-  bool validState;
-
-  // Check if the state satisfies the bounds
-  validState = StateValidityChecker::si_->satisfiesBounds(state);
-
-  // If it does, compare it to the CSV data
-  if (validState == true) {
-    // Variables
-    // The indices of the state:
-    unsigned int rowIdx;
-    unsigned int colIdx;
-
-    // Get the indices, this will truncate the double
-    colIdx = static_cast<unsigned int>(
-        state->as<ompl::base::RealVectorStateSpace::StateType>()->values[0u]);
-    rowIdx = static_cast<unsigned int>(
-        state->as<ompl::base::RealVectorStateSpace::StateType>()->values[1u]);
-
-    // If both the column and row index are in range, use the data
-    if (rowIdx < obsData_.rows() && colIdx < obsData_.cols()) {
-      validState = !obsData_(rowIdx, colIdx);
-    } else {
-      // Return true
-      validState = true;
+double BinaryMap::findFirstOccupied(const double* from, const double* to) const {
+  auto col = getCell(from[0u], numCols_);
+  auto row = getCell(from[1u], numRows_);
+  if (isOccupied(row, col)) {
+    return 0.0;
+  }
+  const auto endCol = getCell(to[0u], numCols_);
+  const auto endRow = getCell(to[1u], numRows_);
+
+  // The fractions of the segment at which it crosses the next column and row boundaries, and the
+  // fractions between two consecutive boundaries.
+  const auto deltaX = to[0u] - from[0u];
+  const auto deltaY = to[1u] - from[1u];
+  const auto infinity = std::numeric_limits<double>::infinity();
+  const auto colStep = deltaX != 0.0 ? 1.0 / std::abs(deltaX) : infinity;
+  const auto rowStep = deltaY != 0.0 ? 1.0 / std::abs(deltaY) : infinity;
+  auto nextCol = deltaX > 0.0   ? (static_cast<double>(col + 1u) - from[0u]) / deltaX
+                 : deltaX < 0.0 ? (static_cast<double>(col) - from[0u]) / deltaX
+                                : infinity;
+  auto nextRow = deltaY > 0.0   ? (static_cast<double>(row + 1u) - from[1u]) / deltaY
+                 : deltaY < 0.0 ? (static_cast<double>(row) - from[1u]) / deltaY
+                                : infinity;
+
+  // Step into the next cell until the cell of the end point is reached. An axis that already
+  // reached the cell of the end point is not stepped along anymore, which keeps rounding errors
+  // from leaving the segment.
+  while (col != endCol || row != endRow) {
+    const bool stepCol = row == endRow || (col != endCol && nextCol <= nextRow);
+    const bool stepRow = col == endCol || (row != endRow && nextRow <= nextCol);
+    double fraction = 0.0;
+    if (stepCol) {
+      fraction = nextCol;
+      col = deltaX > 0.0 ? col + 1u : col - 1u;
+      nextCol += colStep;
+    }
+    if (stepRow) {
+      fraction = std::max(fraction, nextRow);
+      row = deltaY > 0.0 ? row + 1u : row - 1u;
+      nextRow += rowStep;
+    }
+    if (isOccupied(row, col)) {
+      return std::clamp(fraction, 0.0, 1.0);
     }
   }
-  // No else, we're done
 
-  return validState;
+  return infinity;
 }
 
-// Discard arguments
-std::string BinaryMap::mfile(const std::string& /*obsColour*/,
-                             const std::string& /*spaceColour*/) const {
-  // Variables
-  // The string stream:
-  std::stringstream rval;
-
-  // Output the csv if desired
-  if (plotCsv_ == true) {
-    rval << "obstacle_data = [" << obsData_ << "];" << std::endl;
-    rval << "surf(obstacle_data,'EdgeColor','None');" << std::endl;
-    rval << "view(2);" << std::endl;
-    rval << "colormap([1 1 1; 0 0 0]);" << std::endl;
+void BinaryMap::appendRow(const std::vector<double>& values, double threshold) {
+  // The first row determines the number of columns.
+  if (numRows_ == 0u) {
+    numCols_ = values.size();
+    wordsPerRow_ = (numCols_ + BITS_PER_WORD - 1u) / BITS_PER_WORD;
+  } else if (values.size() != numCols_) {
+    throw std::runtime_error("Binary map rows must have the same number of columns.");
   }
-
-  // and the overlay if present
-  if (pngFile_.empty() == false) {
-    rval << "isHeld = ishold();" << std::endl;
-    rval << "[img, map, alpha] = imread('" << pngFile_ << "');" << std::endl;
-    rval << "imgHndl = imshow(img, map);" << std::endl;
-    rval << "set(imgHndl, 'AlphaData', alpha);" << std::endl;
-    rval << "if isHeld" << std::endl;
-    rval << "    hold on;" << std::endl;
-    rval << "end" << std::endl;
+  words_.resize(words_.size() + wordsPerRow_, 0u);
+  ++numRows_;
+  for (std::size_t col = 0u; col < numCols_; ++col) {
+    if (values[col] >= threshold) {
+      setOccupied(numRows_ - 1u, col, true);
+    }
   }
+}
 
-  return rval.str();
+std::size_t BinaryMap::getCell(double coordinate, std::size_t numCells) {
+  if (!(coordinate > 0.0)) {
+    return 0u;
+  }
+  return static_cast<std::size_t>(std::min(coordinate, static_cast<double>(numCells - 1u)));
 }
 
 }  // namespace obstacles
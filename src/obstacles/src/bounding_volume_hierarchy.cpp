@@ -0,0 +1,180 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/obstacles/bounding_volume_hierarchy.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace pdt {
+
+namespace obstacles {
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(std::size_t dimension) : dimension_(dimension) {
+}
+
+void BoundingVolumeHierarchy::build(const std::vector<double>& lowerBounds,
+                                    const std::vector<double>& upperBounds) {
+  if (lowerBounds.size() != upperBounds.size() || lowerBounds.size() % dimension_ != 0u) {
+    throw std::invalid_argument("Bounds of the bounding volume hierarchy do not match.");
+  }
+  const auto numBoxes = lowerBounds.size() / dimension_;
+
+  nodes_.clear();
+  nodeBounds_.clear();
+  boxBounds_.clear();
+  indices_.resize(numBoxes);
+  std::iota(indices_.begin(), indices_.end(), 0u);
+  if (numBoxes == 0u) {
+    return;
+  }
+
+  // A median split halves the boxes, so the tree has fewer than 2n / MAX_LEAF_SIZE nodes.
+  nodes_.reserve(2u * (numBoxes / MAX_LEAF_SIZE + 1u));
+  buildNode(0u, numBoxes, lowerBounds, upperBounds);
+
+  // Store the boxes in the order of the leaves, such that leaves read contiguous memory.
+  boxBounds_.resize(2u * lowerBounds.size());
+  for (auto i = 0u; i < numBoxes; ++i) {
+    const auto box = indices_[i] * dimension_;
+    std::copy_n(&lowerBounds[box], dimension_, &boxBounds_[2u * i * dimension_]);
+    std::copy_n(&upperBounds[box], dimension_, &boxBounds_[(2u * i + 1u) * dimension_]);
+  }
+}
+
+std::size_t BoundingVolumeHierarchy::buildNode(std::size_t begin, std::size_t end,
+                                               const std::vector<double>& lowerBounds,
+                                               const std::vector<double>& upperBounds) {
+  const auto index = nodes_.size();
+  nodes_.push_back(Node{begin, end, 0u});
+
+  // Compute the bounds of this node and the bounds of the centers of its boxes.
+  std::vector<double> centerLowerBounds(dimension_, std::numeric_limits<double>::infinity());
+  std::vector<double> centerUpperBounds(dimension_, -std::numeric_limits<double>::infinity());
+  nodeBounds_.resize(nodeBounds_.size() + dimension_, std::numeric_limits<double>::infinity());
+  nodeBounds_.resize(nodeBounds_.size() + dimension_, -std::numeric_limits<double>::infinity());
+  double* nodeLowerBounds = &nodeBounds_[2u * index * dimension_];
+  double* nodeUpperBounds = nodeLowerBounds + dimension_;
+  for (auto i = begin; i < end; ++i) {
+    for (auto dim = 0u; dim < dimension_; ++dim) {
+      const auto lower = lowerBounds[indices_[i] * dimension_ + dim];
+      const auto upper = upperBounds[indices_[i] * dimension_ + dim];
+      const auto center = 0.5 * (lower + upper);
+      nodeLowerBounds[dim] = std::min(nodeLowerBounds[dim], lower);
+      nodeUpperBounds[dim] = std::max(nodeUpperBounds[dim], upper);
+      centerLowerBounds[dim] = std::min(centerLowerBounds[dim], center);
+      centerUpperBounds[dim] = std::max(centerUpperBounds[dim], center);
+    }
+  }
+
+  if (end - begin <= MAX_LEAF_SIZE) {
+    return index;
+  }
+
+  // Split at the median center along the axis in which the centers spread the most.
+  std::size_t axis = 0u;
+  for (auto dim = 1u; dim < dimension_; ++dim) {
+    if (centerUpperBounds[dim] - centerLowerBounds[dim] >
+        centerUpperBounds[axis] - centerLowerBounds[axis]) {
+      axis = dim;
+    }
+  }
+  const auto middle = begin + (end - begin) / 2u;
+  auto center = [&lowerBounds, &upperBounds, axis, this](std::size_t box) {
+    return lowerBounds[box * dimension_ + axis] + upperBounds[box * dimension_ + axis];
+  };
+  std::nth_element(indices_.begin() + static_cast<long>(begin),
+                   indices_.begin() + static_cast<long>(middle),
+                   indices_.begin() + static_cast<long>(end),
+                   [&center](std::size_t a, std::size_t b) { return center(a) < center(b); });
+
+  buildNode(begin, middle, lowerBounds, upperBounds);
+  const auto right = buildNode(middle, end, lowerBounds, upperBounds);
+  nodes_[index].right = right;
+  return index;
+}
+
+bool BoundingVolumeHierarchy::contains(const double* bounds, const double* point) const {
+  const double* lower = bounds;
+  const double* upper = bounds + dimension_;
+  for (auto dim = 0u; dim < dimension_; ++dim) {
+    if (point[dim] < lower[dim] || point[dim] > upper[dim]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool BoundingVolumeHierarchy::intersects(const double* bounds, const double* from,
+                                         const double* to) const {
+  const double* lower = bounds;
+  const double* upper = bounds + dimension_;
+
+  // Clip the segment parameter against the slab of every dimension.
+  double entry = 0.0;
+  double exit = 1.0;
+  for (auto dim = 0u; dim < dimension_; ++dim) {
+    const auto direction = to[dim] - from[dim];
+    if (direction == 0.0) {
+      if (from[dim] < lower[dim] || from[dim] > upper[dim]) {
+        return false;
+      }
+      continue;
+    }
+    auto near = (lower[dim] - from[dim]) / direction;
+    auto far = (upper[dim] - from[dim]) / direction;
+    if (near > far) {
+      std::swap(near, far);
+    }
+    entry = std::max(entry, near);
+    exit = std::min(exit, far);
+    if (entry > exit) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::size_t BoundingVolumeHierarchy::size() const {
+  return indices_.size();
+}
+
+}  // namespace obstacles
+
+}  // namespace pdt
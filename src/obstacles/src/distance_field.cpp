@@ -0,0 +1,180 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/obstacles/distance_field.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+#include <ompl/base/ScopedState.h>
+#include <ompl/base/StateSpaceTypes.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+
+namespace pdt {
+
+namespace obstacles {
+
+DistanceField::DistanceField(const ompl::base::SpaceInformationPtr& spaceInfo,
+                             const std::vector<std::shared_ptr<BaseObstacle>>& obstacles,
+                             double resolution, std::size_t numThreads) :
+    dimension_(spaceInfo->getStateDimension()),
+    resolution_(resolution) {
+  if (spaceInfo->getStateSpace()->getType() !=
+      ompl::base::StateSpaceType::STATE_SPACE_REAL_VECTOR) {
+    throw std::invalid_argument("Distance fields only support real vector spaces.");
+  }
+  if (dimension_ != 2u && dimension_ != 3u) {
+    throw std::invalid_argument("Distance fields only support two and three dimensions.");
+  }
+  if (!(resolution_ > 0.0)) {
+    throw std::invalid_argument("The resolution of a distance field must be positive.");
+  }
+
+  // The clearance to no obstacles is infinite everywhere and cannot be interpolated.
+  if (obstacles.empty()) {
+    return;
+  }
+
+  // Cover the bounds of the space with vertices.
+  const auto& bounds =
+      spaceInfo->getStateSpace()->as<ompl::base::RealVectorStateSpace>()->getBounds();
+  std::size_t numValues = 1u;
+  for (auto dim = 0u; dim < dimension_; ++dim) {
+    origin_.push_back(bounds.low[dim]);
+    numVertices_.push_back(
+        static_cast<std::size_t>(std::ceil((bounds.high[dim] - bounds.low[dim]) / resolution_)) +
+        1u);
+    numValues *= numVertices_.back();
+  }
+  values_.resize(numValues);
+
+  // Compute the exact clearance of every vertex. Every thread computes a contiguous range.
+  numThreads = std::max<std::size_t>(1u, std::min(numThreads, numValues));
+  auto computeRange = [this, &spaceInfo, &obstacles](std::size_t begin, std::size_t end) {
+    ompl::base::ScopedState<ompl::base::RealVectorStateSpace> state(spaceInfo);
+    for (auto i = begin; i < end; ++i) {
+      auto remainder = i;
+      for (auto dim = 0u; dim < dimension_; ++dim) {
+        const auto vertex = remainder % numVertices_[dim];
+        state[dim] = origin_[dim] + static_cast<double>(vertex) * resolution_;
+        remainder /= numVertices_[dim];
+      }
+      auto minClearance = std::numeric_limits<double>::infinity();
+      for (const auto& obstacle : obstacles) {
+        minClearance = std::min(minClearance, obstacle->clearance(state.get()));
+      }
+      values_[i] = minClearance;
+    }
+  };
+  std::vector<std::thread> threads;
+  const auto numValuesPerThread = (numValues + numThreads - 1u) / numThreads;
+  for (std::size_t begin = 0u; begin < numValues; begin += numValuesPerThread) {
+    threads.emplace_back(computeRange, begin, std::min(begin + numValuesPerThread, numValues));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+bool DistanceField::covers(const double* point) const {
+  if (values_.empty()) {
+    return false;
+  }
+  for (auto dim = 0u; dim < dimension_; ++dim) {
+    const auto extent = static_cast<double>(numVertices_[dim] - 1u) * resolution_;
+    if (!(point[dim] >= origin_[dim] && point[dim] <= origin_[dim] + extent)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+double DistanceField::clearance(const double* point) const {
+  // Find the cell of the point and its position within the cell.
+  std::size_t cellIndex = 0u;
+  std::size_t stride = 1u;
+  std::array<double, 3u> fractions{};
+  std::array<std::size_t, 3u> strides{};
+  for (auto dim = 0u; dim < dimension_; ++dim) {
+    const auto position = (point[dim] - origin_[dim]) / resolution_;
+    const auto cell = std::min(static_cast<std::size_t>(position), numVertices_[dim] - 2u);
+    fractions[dim] = position - static_cast<double>(cell);
+    strides[dim] = stride;
+    cellIndex += cell * stride;
+    stride *= numVertices_[dim];
+  }
+
+  // Interpolate between the corners of the cell.
+  double interpolated = 0.0;
+  for (std::size_t corner = 0u; corner < (1u << dimension_); ++corner) {
+    double weight = 1.0;
+    std::size_t index = cellIndex;
+    for (auto dim = 0u; dim < dimension_; ++dim) {
+      if (corner & (1u << dim)) {
+        weight *= fractions[dim];
+        index += strides[dim];
+      } else {
+        weight *= 1.0 - fractions[dim];
+      }
+    }
+    interpolated += weight * values_[index];
+  }
+  return interpolated;
+}
+
+double DistanceField::getErrorBound() const {
+  return computeErrorBound(dimension_, resolution_);
+}
+
+double DistanceField::getLipschitzConstant() const {
+  return std::sqrt(static_cast<double>(dimension_));
+}
+
+double DistanceField::computeErrorBound(std::size_t dimension, double resolution) {
+  // The interpolated clearance is a weighted mean of the clearances of the corners, each of which
+  // differs from the exact clearance by at most the distance to the corner. The weighted mean of
+  // these distances is largest in the middle of a cell.
+  return std::sqrt(static_cast<double>(dimension)) / 2.0 * resolution;
+}
+
+}  // namespace obstacles
+
+}  // namespace pdt
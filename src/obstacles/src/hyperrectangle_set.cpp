@@ -0,0 +1,236 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/obstacles/hyperrectangle_set.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace pdt {
+
+namespace obstacles {
+
+HyperrectangleSet::HyperrectangleSet(std::size_t dimension) :
+    dimension_(dimension),
+    lowerBounds_(dimension),
+    upperBounds_(dimension) {
+}
+
+void HyperrectangleSet::add(const std::vector<double>& center, const std::vector<double>& widths) {
+  if (center.size() < dimension_ || widths.size() < dimension_) {
+    throw std::invalid_argument("Hyperrectangle has fewer dimensions than the set.");
+  }
+  add(center.data(), widths.data());
+}
+
+void HyperrectangleSet::add(const double* center, const double* widths) {
+  // These are the bounds Hyperrectangle::isInside computes, such that both agree on all points.
+  for (auto dim = 0u; dim < dimension_; ++dim) {
+    lowerBounds_[dim].resize(size_);
+    lowerBounds_[dim].push_back(center[dim] - widths[dim] / 2.0 -
+                                std::numeric_limits<double>::epsilon());
+    upperBounds_[dim].resize(size_);
+    upperBounds_[dim].push_back(center[dim] + widths[dim] / 2.0 +
+                                std::numeric_limits<double>::epsilon());
+  }
+  centers_.insert(centers_.end(), center, center + dimension_);
+  widths_.insert(widths_.end(), widths, widths + dimension_);
+  ++size_;
+  pad();
+}
+
+void HyperrectangleSet::append(const HyperrectangleSet& other) {
+  if (other.dimension_ != dimension_) {
+    throw std::invalid_argument("Cannot append hyperrectangles of a different dimension.");
+  }
+
+  // The bounds are copied as they are, without the padding of either set.
+  const auto numAdded = static_cast<std::ptrdiff_t>(other.size_);
+  for (auto dim = 0u; dim < dimension_; ++dim) {
+    lowerBounds_[dim].resize(size_);
+    lowerBounds_[dim].insert(lowerBounds_[dim].end(), other.lowerBounds_[dim].begin(),
+                             other.lowerBounds_[dim].begin() + numAdded);
+    upperBounds_[dim].resize(size_);
+    upperBounds_[dim].insert(upperBounds_[dim].end(), other.upperBounds_[dim].begin(),
+                             other.upperBounds_[dim].begin() + numAdded);
+  }
+  centers_.insert(centers_.end(), other.centers_.begin(), other.centers_.end());
+  widths_.insert(widths_.end(), other.widths_.begin(), other.widths_.end());
+  size_ += other.size_;
+  pad();
+}
+
+void HyperrectangleSet::clear() {
+  for (auto dim = 0u; dim < dimension_; ++dim) {
+    lowerBounds_[dim].clear();
+    upperBounds_[dim].clear();
+  }
+  centers_.clear();
+  widths_.clear();
+  size_ = 0u;
+}
+
+void HyperrectangleSet::pad() {
+  // Empty hyperrectangles have their lower bounds above their upper bounds.
+  const auto paddedSize = (size_ + LANE_WIDTH - 1u) / LANE_WIDTH * LANE_WIDTH;
+  for (auto dim = 0u; dim < dimension_; ++dim) {
+    lowerBounds_[dim].resize(paddedSize, std::numeric_limits<double>::infinity());
+    upperBounds_[dim].resize(paddedSize, -std::numeric_limits<double>::infinity());
+  }
+}
+
+bool HyperrectangleSet::contains(const double* point) const {
+  const std::size_t paddedSize = size_ == 0u ? 0u : lowerBounds_[0u].size();
+  for (std::size_t i = 0u; i < paddedSize; i += LANE_WIDTH) {
+    if (blockContains(i, point)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool HyperrectangleSet::containsAny(const double* const* points, std::size_t numPoints) const {
+  const std::size_t paddedSize = size_ == 0u ? 0u : lowerBounds_[0u].size();
+  for (std::size_t i = 0u; i < paddedSize; i += LANE_WIDTH) {
+    for (std::size_t point = 0u; point < numPoints; ++point) {
+      if (blockContains(i, points[point])) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool HyperrectangleSet::blockContains(std::size_t first, const double* point) const {
+#if defined(__AVX512F__)
+  // A lane stays set while the point is inside the bounds of all dimensions checked so far.
+  __mmask8 inside = 0xFF;
+  for (std::size_t dim = 0u; dim < dimension_ && inside != 0u; ++dim) {
+    const __m512d coordinate = _mm512_set1_pd(point[dim]);
+    inside = _mm512_mask_cmp_pd_mask(inside, coordinate,
+                                     _mm512_loadu_pd(&lowerBounds_[dim][first]), _CMP_NLT_UQ);
+    inside = _mm512_mask_cmp_pd_mask(inside, coordinate,
+                                     _mm512_loadu_pd(&upperBounds_[dim][first]), _CMP_NGT_UQ);
+  }
+  return inside != 0u;
+#elif defined(__AVX2__)
+  for (std::size_t i = first; i < first + LANE_WIDTH; i += 4u) {
+    // A lane stays set while the point is inside the bounds of all dimensions checked so far.
+    __m256d inside = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    for (std::size_t dim = 0u; dim < dimension_; ++dim) {
+      const __m256d coordinate = _mm256_set1_pd(point[dim]);
+      inside = _mm256_and_pd(
+          inside, _mm256_cmp_pd(coordinate, _mm256_loadu_pd(&lowerBounds_[dim][i]), _CMP_NLT_UQ));
+      inside = _mm256_and_pd(
+          inside, _mm256_cmp_pd(coordinate, _mm256_loadu_pd(&upperBounds_[dim][i]), _CMP_NGT_UQ));
+      if (_mm256_movemask_pd(inside) == 0) {
+        break;
+      }
+    }
+    if (_mm256_movemask_pd(inside) != 0) {
+      return true;
+    }
+  }
+  return false;
+#else
+  // Without vector instructions, the block is tested without branches per hyperrectangle, which
+  // lets the compiler vectorize with whatever instructions it may use.
+  bool inside[LANE_WIDTH];
+  for (std::size_t lane = 0u; lane < LANE_WIDTH; ++lane) {
+    inside[lane] = true;
+  }
+  for (std::size_t dim = 0u; dim < dimension_; ++dim) {
+    const double* lower = &lowerBounds_[dim][first];
+    const double* upper = &upperBounds_[dim][first];
+    bool any = false;
+    for (std::size_t lane = 0u; lane < LANE_WIDTH; ++lane) {
+      inside[lane] = inside[lane] & !(point[dim] < lower[lane]) & !(point[dim] > upper[lane]);
+      any = any | inside[lane];
+    }
+    if (!any) {
+      return false;
+    }
+  }
+  return dimension_ != 0u;
+#endif
+}
+
+double HyperrectangleSet::clearance(const double* point) const {
+  double minSumOfSquares = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0u; i < size_; ++i) {
+    double sumOfSquares = 0.0;
+    const double* center = &centers_[i * dimension_];
+    const double* widths = &widths_[i * dimension_];
+    for (std::size_t dim = 0u; dim < dimension_; ++dim) {
+      const double delta = std::max(std::abs(point[dim] - center[dim]) - widths[dim] / 2.0, 0.0);
+      sumOfSquares += delta * delta;
+    }
+    minSumOfSquares = std::min(minSumOfSquares, sumOfSquares);
+  }
+  return std::sqrt(minSumOfSquares);
+}
+
+const double* HyperrectangleSet::getCenter(std::size_t i) const {
+  return &centers_.at(i * dimension_);
+}
+
+const double* HyperrectangleSet::getWidths(std::size_t i) const {
+  return &widths_.at(i * dimension_);
+}
+
+std::size_t HyperrectangleSet::getDimension() const {
+  return dimension_;
+}
+
+std::size_t HyperrectangleSet::size() const {
+  return size_;
+}
+
+bool HyperrectangleSet::empty() const {
+  return size_ == 0u;
+}
+
+}  // namespace obstacles
+
+}  // namespace pdt
@@ -0,0 +1,154 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/obstacles/point_kd_tree.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace pdt {
+
+namespace obstacles {
+
+PointKdTree::PointKdTree(std::size_t dimension) : dimension_(dimension) {
+}
+
+void PointKdTree::build(const std::vector<double>& points) {
+  if (points.size() % dimension_ != 0u) {
+    throw std::invalid_argument("Points of the kd-tree do not match its dimension.");
+  }
+  points_ = points;
+  axes_.assign(points.size() / dimension_, 0u);
+  buildNode(0u, axes_.size());
+}
+
+void PointKdTree::buildNode(std::size_t begin, std::size_t end) {
+  if (end - begin <= MAX_LEAF_SIZE) {
+    return;
+  }
+
+  // Split at the median along the axis in which the points spread the most.
+  std::vector<double> lowerBounds(dimension_, std::numeric_limits<double>::infinity());
+  std::vector<double> upperBounds(dimension_, -std::numeric_limits<double>::infinity());
+  for (auto i = begin; i < end; ++i) {
+    for (auto dim = 0u; dim < dimension_; ++dim) {
+      lowerBounds[dim] = std::min(lowerBounds[dim], points_[i * dimension_ + dim]);
+      upperBounds[dim] = std::max(upperBounds[dim], points_[i * dimension_ + dim]);
+    }
+  }
+  std::size_t axis = 0u;
+  for (auto dim = 1u; dim < dimension_; ++dim) {
+    if (upperBounds[dim] - lowerBounds[dim] > upperBounds[axis] - lowerBounds[axis]) {
+      axis = dim;
+    }
+  }
+
+  // The points are moved as a whole, so select the median on an index and reorder afterwards.
+  std::vector<std::size_t> order(end - begin);
+  std::iota(order.begin(), order.end(), begin);
+  const auto middle = begin + (end - begin) / 2u;
+  std::nth_element(order.begin(), order.begin() + static_cast<long>(middle - begin), order.end(),
+                   [axis, this](std::size_t a, std::size_t b) {
+                     return points_[a * dimension_ + axis] < points_[b * dimension_ + axis];
+                   });
+  std::vector<double> reordered(order.size() * dimension_);
+  for (auto i = 0u; i < order.size(); ++i) {
+    std::copy_n(&points_[order[i] * dimension_], dimension_, &reordered[i * dimension_]);
+  }
+  std::copy(reordered.begin(), reordered.end(), &points_[begin * dimension_]);
+  axes_[middle] = axis;
+
+  buildNode(begin, middle);
+  buildNode(middle + 1u, end);
+}
+
+bool PointKdTree::anyInside(const double* lowerBounds, const double* upperBounds) const {
+  if (axes_.empty()) {
+    return false;
+  }
+  std::array<std::pair<std::size_t, std::size_t>, MAX_DEPTH> stack;
+  std::size_t stackSize = 0u;
+  stack[stackSize++] = {0u, axes_.size()};
+  while (stackSize != 0u) {
+    const auto [begin, end] = stack[--stackSize];
+    if (end - begin <= MAX_LEAF_SIZE) {
+      for (auto i = begin; i < end; ++i) {
+        if (contains(&points_[i * dimension_], lowerBounds, upperBounds)) {
+          return true;
+        }
+      }
+      continue;
+    }
+
+    // The points before the splitting point are not above it and the ones after are not below it.
+    const auto middle = begin + (end - begin) / 2u;
+    const double* point = &points_[middle * dimension_];
+    if (contains(point, lowerBounds, upperBounds)) {
+      return true;
+    }
+    const auto axis = axes_[middle];
+    if (upperBounds[axis] >= point[axis]) {
+      stack[stackSize++] = {middle + 1u, end};
+    }
+    if (lowerBounds[axis] <= point[axis]) {
+      stack[stackSize++] = {begin, middle};
+    }
+  }
+  return false;
+}
+
+bool PointKdTree::contains(const double* point, const double* lowerBounds,
+                           const double* upperBounds) const {
+  for (auto dim = 0u; dim < dimension_; ++dim) {
+    if (point[dim] < lowerBounds[dim] || point[dim] > upperBounds[dim]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::size_t PointKdTree::size() const {
+  return axes_.size();
+}
+
+}  // namespace obstacles
+
+}  // namespace pdt
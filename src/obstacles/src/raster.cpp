@@ -0,0 +1,231 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/obstacles/raster.h"
+
+#include <algorithm>
+#include <fstream>
+#include <ios>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace pdt {
+
+namespace obstacles {
+
+namespace {
+
+// Reads the next token of a PGM header, skipping whitespace and comments.
+std::size_t readPgmHeaderValue(std::istream& stream) {
+  stream >> std::ws;
+  while (stream.peek() == '#') {
+    std::string comment;
+    std::getline(stream, comment);
+    stream >> std::ws;
+  }
+  std::size_t value = 0u;
+  if (!(stream >> value)) {
+    throw std::runtime_error("Could not read the header of the PGM image.");
+  }
+  return value;
+}
+
+// Appends the rows of a file to a raster.
+std::function<void(const std::vector<double>&)> appendTo(Raster* raster) {
+  return [raster](const std::vector<double>& row) {
+    raster->numCols = row.size();
+    raster->values.insert(raster->values.end(), row.begin(), row.end());
+    ++raster->numRows;
+  };
+}
+
+}  // namespace
+
+double Raster::operator()(std::size_t row, std::size_t col) const {
+  return values[row * numCols + col];
+}
+
+void Raster::flipRows() {
+  for (std::size_t row = 0u; row < numRows / 2u; ++row) {
+    std::swap_ranges(values.begin() + static_cast<long>(row * numCols),
+                     values.begin() + static_cast<long>((row + 1u) * numCols),
+                     values.begin() + static_cast<long>((numRows - row - 1u) * numCols));
+  }
+}
+
+void streamCsvRows(const std::string& filename,
+                   const std::function<void(const std::vector<double>&)>& processRow) {
+  std::ifstream csvStream(filename);
+  if (!csvStream.is_open()) {
+    throw std::ios_base::failure("Could not open csv file '" + filename + "'.");
+  }
+
+  // Load the csv file one line at a time.
+  std::vector<double> row;
+  std::size_t numCols = 0u;
+  std::string csvLine;
+  while (std::getline(csvStream, csvLine)) {
+    // Skip empty lines, such as a trailing newline.
+    if (csvLine.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+
+    // Parse the values in place, which is much faster than tokenizing the line first.
+    row.clear();
+    const char* begin = csvLine.c_str();
+    while (true) {
+      char* end = nullptr;
+      row.push_back(std::strtod(begin, &end));
+      if (end == begin) {
+        throw std::runtime_error("Could not parse a value in the csv file '" + filename + "'.");
+      }
+      while (*end == ' ' || *end == '\t' || *end == '\r') {
+        ++end;
+      }
+      if (*end != ',') {
+        if (*end != '\0') {
+          throw std::runtime_error("Could not parse a value in the csv file '" + filename + "'.");
+        }
+        break;
+      }
+      begin = end + 1;
+    }
+
+    // If this is the first row, store the number of columns, otherwise check it.
+    if (numCols == 0u) {
+      numCols = row.size();
+    } else if (row.size() != numCols) {
+      throw std::runtime_error("Found an inconsistent number of columns in the csv file.");
+    }
+    processRow(row);
+  }
+}
+
+void streamPgmRows(const std::string& filename,
+                   const std::function<void(const std::vector<double>&)>& processRow) {
+  std::ifstream pgmStream(filename, std::ios::binary);
+  if (!pgmStream.is_open()) {
+    throw std::ios_base::failure("Could not open pgm file '" + filename + "'.");
+  }
+
+  // Read the header.
+  std::string magic;
+  pgmStream >> magic;
+  if (magic != "P5" && magic != "P2") {
+    throw std::runtime_error("Only binary (P5) and plain (P2) PGM images are supported.");
+  }
+  const auto numCols = readPgmHeaderValue(pgmStream);
+  const auto numRows = readPgmHeaderValue(pgmStream);
+  const auto maxValue = readPgmHeaderValue(pgmStream);
+  if (maxValue == 0u || maxValue > 65535u) {
+    throw std::runtime_error("The maximum grey level of a PGM image must be in [1, 65535].");
+  }
+
+  // Exactly one whitespace character separates the header from binary data.
+  if (magic == "P5") {
+    pgmStream.get();
+  }
+
+  // Read the grey levels row by row.
+  const std::size_t bytesPerValue = maxValue < 256u ? 1u : 2u;
+  std::vector<unsigned char> bytes(numCols * bytesPerValue);
+  std::vector<double> row(numCols);
+  for (std::size_t r = 0u; r < numRows; ++r) {
+    if (magic == "P2") {
+      for (auto& value : row) {
+        value = static_cast<double>(readPgmHeaderValue(pgmStream));
+      }
+    } else {
+      if (!pgmStream.read(reinterpret_cast<char*>(bytes.data()),
+                          static_cast<std::streamsize>(bytes.size()))) {
+        throw std::runtime_error("The PGM image '" + filename + "' is truncated.");
+      }
+      for (std::size_t c = 0u; c < numCols; ++c) {
+        // Two byte grey levels are stored most significant byte first.
+        row[c] = bytesPerValue == 1u
+                     ? static_cast<double>(bytes[c])
+                     : static_cast<double>(256u * bytes[2u * c] + bytes[2u * c + 1u]);
+      }
+    }
+    processRow(row);
+  }
+}
+
+void streamRawRows(const std::string& filename, std::size_t numRows, std::size_t numCols,
+                   const std::function<void(const std::vector<double>&)>& processRow) {
+  std::ifstream rawStream(filename, std::ios::binary);
+  if (!rawStream.is_open()) {
+    throw std::ios_base::failure("Could not open raw file '" + filename + "'.");
+  }
+
+  // Read the values row by row.
+  std::vector<unsigned char> bytes(numCols);
+  std::vector<double> row(numCols);
+  for (std::size_t r = 0u; r < numRows; ++r) {
+    if (!rawStream.read(reinterpret_cast<char*>(bytes.data()),
+                        static_cast<std::streamsize>(bytes.size()))) {
+      throw std::runtime_error("The raw file '" + filename + "' is truncated.");
+    }
+    std::copy(bytes.begin(), bytes.end(), row.begin());
+    processRow(row);
+  }
+}
+
+Raster loadCsvRaster(const std::string& filename) {
+  Raster raster;
+  streamCsvRows(filename, appendTo(&raster));
+  return raster;
+}
+
+Raster loadPgmRaster(const std::string& filename) {
+  Raster raster;
+  streamPgmRows(filename, appendTo(&raster));
+  return raster;
+}
+
+Raster loadRaster(const std::string& filename) {
+  const std::string extension{".pgm"};
+  if (filename.size() >= extension.size() &&
+      filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0) {
+    return loadPgmRaster(filename);
+  }
+  return loadCsvRaster(filename);
+}
+
+}  // namespace obstacles
+
+}  // namespace pdt
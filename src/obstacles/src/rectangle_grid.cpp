@@ -0,0 +1,324 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/obstacles/rectangle_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace pdt {
+
+namespace obstacles {
+
+RectangleGrid::RectangleGrid(double minCellSideLength) :
+    minCellSideLength_(minCellSideLength),
+    cellOffsets_(1u, 0u) {
+  if (!(minCellSideLength > 0.0)) {
+    throw std::invalid_argument("Cells of a rectangle grid must have a positive side length.");
+  }
+}
+
+void RectangleGrid::add(const std::vector<std::array<double, 2u>>& centers,
+                        const std::vector<std::array<double, 2u>>& widths) {
+  if (centers.size() != widths.size()) {
+    throw std::invalid_argument("Rectangles need as many centers as widths.");
+  }
+  centers_.insert(centers_.end(), centers.begin(), centers.end());
+  widths_.insert(widths_.end(), widths.begin(), widths.end());
+  build();
+}
+
+bool RectangleGrid::intersects(double x, double y, double cosine, double sine, double halfLength,
+                               double halfWidth) const {
+  if (centers_.empty()) {
+    return false;
+  }
+
+  // Only the cells that overlap the bounding box of the oriented rectangle need to be checked.
+  const auto extentX = halfLength * std::abs(cosine) + halfWidth * std::abs(sine);
+  const auto extentY = halfLength * std::abs(sine) + halfWidth * std::abs(cosine);
+  const auto lastColumn = static_cast<long>(numCells_[0u]) - 1;
+  const auto lastRow = static_cast<long>(numCells_[1u]) - 1;
+  const auto minColumn = std::max(getCellIndex(x - extentX, 0u), 0l);
+  const auto maxColumn = std::min(getCellIndex(x + extentX, 0u), lastColumn);
+  const auto minRow = std::max(getCellIndex(y - extentY, 1u), 0l);
+  const auto maxRow = std::min(getCellIndex(y + extentY, 1u), lastRow);
+
+  for (auto row = minRow; row <= maxRow; ++row) {
+    for (auto column = minColumn; column <= maxColumn; ++column) {
+      const auto cell = static_cast<std::size_t>(row) * numCells_[0u] +
+                        static_cast<std::size_t>(column);
+      if (intersects(cellOffsets_[cell], cellOffsets_[cell + 1u], x, y, cosine, sine, halfLength,
+                     halfWidth)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+std::size_t RectangleGrid::size() const {
+  return centers_.size();
+}
+
+bool RectangleGrid::empty() const {
+  return centers_.empty();
+}
+
+void RectangleGrid::build() {
+  const auto numRectangles = centers_.size();
+  if (numRectangles == 0u) {
+    return;
+  }
+
+  // The grid covers the bounding boxes of all rectangles.
+  std::array<double, 2u> lower{{std::numeric_limits<double>::infinity(),
+                                std::numeric_limits<double>::infinity()}};
+  std::array<double, 2u> upper{{-std::numeric_limits<double>::infinity(),
+                                -std::numeric_limits<double>::infinity()}};
+  double sumSideLengths = 0.0;
+  for (std::size_t i = 0u; i < numRectangles; ++i) {
+    for (auto dim = 0u; dim < 2u; ++dim) {
+      lower[dim] = std::min(lower[dim], centers_[i][dim] - widths_[i][dim] / 2.0);
+      upper[dim] = std::max(upper[dim], centers_[i][dim] + widths_[i][dim] / 2.0);
+    }
+    sumSideLengths += std::max(widths_[i][0u], widths_[i][1u]);
+  }
+
+  // Cells about as large as a typical rectangle keep the number of cells a rectangle is binned in
+  // small. The cells are coarsened until there are not many more cells than rectangles.
+  cellSideLength_ =
+      std::max(minCellSideLength_, sumSideLengths / static_cast<double>(numRectangles));
+  const auto maxNumCells = 4u * numRectangles + 16u;
+  while (true) {
+    for (auto dim = 0u; dim < 2u; ++dim) {
+      numCells_[dim] = std::max(
+          static_cast<std::size_t>(std::ceil((upper[dim] - lower[dim]) / cellSideLength_)),
+          std::size_t{1u});
+    }
+    if (numCells_[0u] * numCells_[1u] <= maxNumCells) {
+      break;
+    }
+    cellSideLength_ *= 2.0;
+  }
+  origin_ = lower;
+
+  // Count the rectangles in each cell, and pad the count of each cell to a multiple of the lane
+  // width. The upper edge of the grid falls on the index past the last cell if the extent is a
+  // multiple of the cell side length, so the indices are clamped like those of queries.
+  const auto numCells = numCells_[0u] * numCells_[1u];
+  const auto lastColumn = static_cast<long>(numCells_[0u]) - 1;
+  const auto lastRow = static_cast<long>(numCells_[1u]) - 1;
+  const auto forEachCell = [this, lastColumn, lastRow](std::size_t i, const auto& function) {
+    const auto minColumn = std::max(getCellIndex(centers_[i][0u] - widths_[i][0u] / 2.0, 0u), 0l);
+    const auto maxColumn =
+        std::min(getCellIndex(centers_[i][0u] + widths_[i][0u] / 2.0, 0u), lastColumn);
+    const auto minRow = std::max(getCellIndex(centers_[i][1u] - widths_[i][1u] / 2.0, 1u), 0l);
+    const auto maxRow = std::min(getCellIndex(centers_[i][1u] + widths_[i][1u] / 2.0, 1u), lastRow);
+    for (auto row = minRow; row <= maxRow; ++row) {
+      for (auto column = minColumn; column <= maxColumn; ++column) {
+        function(static_cast<std::size_t>(row) * numCells_[0u] + static_cast<std::size_t>(column));
+      }
+    }
+  };
+  std::vector<std::size_t> counts(numCells, 0u);
+  for (std::size_t i = 0u; i < numRectangles; ++i) {
+    forEachCell(i, [&counts](std::size_t cell) { ++counts[cell]; });
+  }
+  cellOffsets_.assign(numCells + 1u, 0u);
+  for (std::size_t cell = 0u; cell < numCells; ++cell) {
+    const auto paddedCount = (counts[cell] + LANE_WIDTH - 1u) / LANE_WIDTH * LANE_WIDTH;
+    cellOffsets_[cell + 1u] = cellOffsets_[cell] + paddedCount;
+  }
+
+  // Padding rectangles have negative infinite half widths, which intersect nothing.
+  const auto numEntries = cellOffsets_.back();
+  centersX_.assign(numEntries, 0.0);
+  centersY_.assign(numEntries, 0.0);
+  halfWidthsX_.assign(numEntries, -std::numeric_limits<double>::infinity());
+  halfWidthsY_.assign(numEntries, -std::numeric_limits<double>::infinity());
+  std::vector<std::size_t> cursors(cellOffsets_.begin(), cellOffsets_.end() - 1);
+  for (std::size_t i = 0u; i < numRectangles; ++i) {
+    forEachCell(i, [this, &cursors, i](std::size_t cell) {
+      const auto entry = cursors[cell]++;
+      centersX_[entry] = centers_[i][0u];
+      centersY_[entry] = centers_[i][1u];
+      halfWidthsX_[entry] = widths_[i][0u] / 2.0;
+      halfWidthsY_[entry] = widths_[i][1u] / 2.0;
+    });
+  }
+}
+
+long RectangleGrid::getCellIndex(double coordinate, std::size_t dim) const {
+  // Clamping before the conversion keeps coordinates far outside the grid representable.
+  const auto index = std::clamp(std::floor((coordinate - origin_[dim]) / cellSideLength_), -1.0,
+                                static_cast<double>(numCells_[dim]));
+  return static_cast<long>(index);
+}
+
+// The rectangles are tested with the separating axis theorem. The axes are the two axes of the
+// grid and the two axes of the oriented rectangle, and the rectangles intersect if their
+// projections overlap on all four. With d the difference of the centers, (c, s) the orientation,
+// (l, w) the half length and width of the oriented rectangle and (a, b) the half widths of the
+// axis-aligned rectangle, the projections overlap if
+//   |d_x| <= a + l |c| + w |s|,
+//   |d_y| <= b + l |s| + w |c|,
+//   |d_x c + d_y s| <= l + a |c| + b |s|, and
+//   |d_y c - d_x s| <= w + a |s| + b |c|.
+bool RectangleGrid::intersects(std::size_t begin, std::size_t end, double x, double y,
+                               double cosine, double sine, double halfLength,
+                               double halfWidth) const {
+  const auto absCosine = std::abs(cosine);
+  const auto absSine = std::abs(sine);
+  const auto extentX = halfLength * absCosine + halfWidth * absSine;
+  const auto extentY = halfLength * absSine + halfWidth * absCosine;
+
+#if defined(__AVX512F__)
+  const __m512d vx = _mm512_set1_pd(x);
+  const __m512d vy = _mm512_set1_pd(y);
+  const __m512d vCosine = _mm512_set1_pd(cosine);
+  const __m512d vSine = _mm512_set1_pd(sine);
+  const __m512d vAbsCosine = _mm512_set1_pd(absCosine);
+  const __m512d vAbsSine = _mm512_set1_pd(absSine);
+  const __m512d vHalfLength = _mm512_set1_pd(halfLength);
+  const __m512d vHalfWidth = _mm512_set1_pd(halfWidth);
+  const __m512d vExtentX = _mm512_set1_pd(extentX);
+  const __m512d vExtentY = _mm512_set1_pd(extentY);
+  for (std::size_t i = begin; i < end; i += 8u) {
+    const __m512d a = _mm512_loadu_pd(&halfWidthsX_[i]);
+    const __m512d b = _mm512_loadu_pd(&halfWidthsY_[i]);
+    const __m512d dx = _mm512_sub_pd(_mm512_loadu_pd(&centersX_[i]), vx);
+    const __m512d dy = _mm512_sub_pd(_mm512_loadu_pd(&centersY_[i]), vy);
+    __mmask8 overlaps = _mm512_cmp_pd_mask(_mm512_abs_pd(dx), _mm512_add_pd(a, vExtentX),
+                                           _CMP_LE_OQ);
+    overlaps = _mm512_mask_cmp_pd_mask(overlaps, _mm512_abs_pd(dy), _mm512_add_pd(b, vExtentY),
+                                       _CMP_LE_OQ);
+    if (overlaps == 0u) {
+      continue;
+    }
+    const __m512d along = _mm512_add_pd(_mm512_mul_pd(dx, vCosine), _mm512_mul_pd(dy, vSine));
+    const __m512d across = _mm512_sub_pd(_mm512_mul_pd(dy, vCosine), _mm512_mul_pd(dx, vSine));
+    overlaps = _mm512_mask_cmp_pd_mask(
+        overlaps, _mm512_abs_pd(along),
+        _mm512_add_pd(vHalfLength,
+                      _mm512_add_pd(_mm512_mul_pd(a, vAbsCosine), _mm512_mul_pd(b, vAbsSine))),
+        _CMP_LE_OQ);
+    overlaps = _mm512_mask_cmp_pd_mask(
+        overlaps, _mm512_abs_pd(across),
+        _mm512_add_pd(vHalfWidth,
+                      _mm512_add_pd(_mm512_mul_pd(a, vAbsSine), _mm512_mul_pd(b, vAbsCosine))),
+        _CMP_LE_OQ);
+    if (overlaps != 0u) {
+      return true;
+    }
+  }
+#elif defined(__AVX2__)
+  const __m256d signMask = _mm256_set1_pd(-0.0);
+  const __m256d vx = _mm256_set1_pd(x);
+  const __m256d vy = _mm256_set1_pd(y);
+  const __m256d vCosine = _mm256_set1_pd(cosine);
+  const __m256d vSine = _mm256_set1_pd(sine);
+  const __m256d vAbsCosine = _mm256_set1_pd(absCosine);
+  const __m256d vAbsSine = _mm256_set1_pd(absSine);
+  const __m256d vHalfLength = _mm256_set1_pd(halfLength);
+  const __m256d vHalfWidth = _mm256_set1_pd(halfWidth);
+  const __m256d vExtentX = _mm256_set1_pd(extentX);
+  const __m256d vExtentY = _mm256_set1_pd(extentY);
+  for (std::size_t i = begin; i < end; i += 4u) {
+    const __m256d a = _mm256_loadu_pd(&halfWidthsX_[i]);
+    const __m256d b = _mm256_loadu_pd(&halfWidthsY_[i]);
+    const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(&centersX_[i]), vx);
+    const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(&centersY_[i]), vy);
+    __m256d overlaps = _mm256_and_pd(
+        _mm256_cmp_pd(_mm256_andnot_pd(signMask, dx), _mm256_add_pd(a, vExtentX), _CMP_LE_OQ),
+        _mm256_cmp_pd(_mm256_andnot_pd(signMask, dy), _mm256_add_pd(b, vExtentY), _CMP_LE_OQ));
+    if (_mm256_movemask_pd(overlaps) == 0) {
+      continue;
+    }
+    const __m256d along = _mm256_add_pd(_mm256_mul_pd(dx, vCosine), _mm256_mul_pd(dy, vSine));
+    const __m256d across = _mm256_sub_pd(_mm256_mul_pd(dy, vCosine), _mm256_mul_pd(dx, vSine));
+    overlaps = _mm256_and_pd(
+        overlaps,
+        _mm256_cmp_pd(_mm256_andnot_pd(signMask, along),
+                      _mm256_add_pd(vHalfLength, _mm256_add_pd(_mm256_mul_pd(a, vAbsCosine),
+                                                               _mm256_mul_pd(b, vAbsSine))),
+                      _CMP_LE_OQ));
+    overlaps = _mm256_and_pd(
+        overlaps,
+        _mm256_cmp_pd(_mm256_andnot_pd(signMask, across),
+                      _mm256_add_pd(vHalfWidth, _mm256_add_pd(_mm256_mul_pd(a, vAbsSine),
+                                                              _mm256_mul_pd(b, vAbsCosine))),
+                      _CMP_LE_OQ));
+    if (_mm256_movemask_pd(overlaps) != 0) {
+      return true;
+    }
+  }
+#else
+  // Without vector instructions, the blocks are tested without branches per rectangle, which lets
+  // the compiler vectorize with whatever instructions it may use.
+  for (std::size_t i = begin; i < end; i += LANE_WIDTH) {
+    bool any = false;
+    for (std::size_t lane = 0u; lane < LANE_WIDTH; ++lane) {
+      const auto a = halfWidthsX_[i + lane];
+      const auto b = halfWidthsY_[i + lane];
+      const auto dx = centersX_[i + lane] - x;
+      const auto dy = centersY_[i + lane] - y;
+      const bool overlaps = (std::abs(dx) <= a + extentX) & (std::abs(dy) <= b + extentY) &
+                            (std::abs(dx * cosine + dy * sine) <=
+                             halfLength + (a * absCosine + b * absSine)) &
+                            (std::abs(dy * cosine - dx * sine) <=
+                             halfWidth + (a * absSine + b * absCosine));
+      any = any | overlaps;
+    }
+    if (any) {
+      return true;
+    }
+  }
+#endif
+
+  return false;
+}
+
+}  // namespace obstacles
+
+}  // namespace pdt
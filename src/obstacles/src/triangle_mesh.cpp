@@ -0,0 +1,183 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/obstacles/triangle_mesh.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace pdt {
+
+namespace obstacles {
+
+namespace {
+
+// Returns whether the string ends with the given suffix.
+bool endsWith(const std::string& string, const std::string& suffix) {
+  return string.size() >= suffix.size() &&
+         string.compare(string.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Reads the vertex index of an OBJ face element, which may be followed by texture and normal
+// indices and may be negative to count from the last vertex.
+std::size_t parseObjIndex(const std::string& element, std::size_t numVertices) {
+  const auto index = std::stol(element.substr(0u, element.find('/')));
+  const auto vertex = index < 0 ? static_cast<long>(numVertices) + index : index - 1;
+  if (vertex < 0 || vertex >= static_cast<long>(numVertices)) {
+    throw std::runtime_error("OBJ face refers to vertex " + element + ", which does not exist.");
+  }
+  return static_cast<std::size_t>(vertex);
+}
+
+TriangleMesh loadBinaryStlMesh(std::ifstream& file, std::uint32_t numTriangles) {
+  TriangleMesh mesh;
+  mesh.vertices.reserve(3u * numTriangles);
+  mesh.triangles.reserve(numTriangles);
+
+  // Every triangle is a normal, three vertices, and an attribute byte count. STL files store
+  // little endian 32 bit floats.
+  char record[50u];
+  for (std::uint32_t i = 0u; i < numTriangles; ++i) {
+    if (!file.read(record, sizeof(record))) {
+      throw std::runtime_error("Binary STL file ends before all triangles are read.");
+    }
+    const auto first = mesh.vertices.size();
+    for (std::size_t vertex = 0u; vertex < 3u; ++vertex) {
+      std::array<double, 3u> coordinates{};
+      for (std::size_t dim = 0u; dim < 3u; ++dim) {
+        float value = 0.0f;
+        std::memcpy(&value, record + 12u + 12u * vertex + 4u * dim, sizeof(value));
+        coordinates[dim] = static_cast<double>(value);
+      }
+      mesh.vertices.push_back(coordinates);
+    }
+    mesh.triangles.push_back({first, first + 1u, first + 2u});
+  }
+  return mesh;
+}
+
+TriangleMesh loadAsciiStlMesh(std::ifstream& file) {
+  TriangleMesh mesh;
+  std::string keyword;
+  while (file >> keyword) {
+    if (keyword != "vertex") {
+      continue;
+    }
+    std::array<double, 3u> coordinates{};
+    if (!(file >> coordinates[0u] >> coordinates[1u] >> coordinates[2u])) {
+      throw std::runtime_error("Could not read a vertex of an ASCII STL file.");
+    }
+    mesh.vertices.push_back(coordinates);
+    if (mesh.vertices.size() % 3u == 0u) {
+      const auto first = mesh.vertices.size() - 3u;
+      mesh.triangles.push_back({first, first + 1u, first + 2u});
+    }
+  }
+  return mesh;
+}
+
+}  // namespace
+
+TriangleMesh loadObjMesh(const std::string& filename) {
+  std::ifstream file(filename);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open OBJ file '" + filename + "'.");
+  }
+
+  TriangleMesh mesh;
+  std::string line;
+  std::vector<std::size_t> face;
+  while (std::getline(file, line)) {
+    std::istringstream stream(line);
+    std::string keyword;
+    stream >> keyword;
+    if (keyword == "v") {
+      std::array<double, 3u> vertex{};
+      if (!(stream >> vertex[0u] >> vertex[1u] >> vertex[2u])) {
+        throw std::runtime_error("Could not read vertex '" + line + "' of '" + filename + "'.");
+      }
+      mesh.vertices.push_back(vertex);
+    } else if (keyword == "f") {
+      face.clear();
+      std::string element;
+      while (stream >> element) {
+        face.push_back(parseObjIndex(element, mesh.vertices.size()));
+      }
+      for (std::size_t i = 2u; i < face.size(); ++i) {
+        mesh.triangles.push_back({face[0u], face[i - 1u], face[i]});
+      }
+    }
+  }
+  return mesh;
+}
+
+TriangleMesh loadStlMesh(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open STL file '" + filename + "'.");
+  }
+
+  // Binary files have an 80 byte header, the number of triangles, and 50 bytes per triangle.
+  // ASCII files can start with the same header, so the size is what tells them apart.
+  const auto size = static_cast<std::size_t>(file.tellg());
+  file.seekg(0);
+  if (size >= 84u) {
+    char header[84u];
+    file.read(header, sizeof(header));
+    std::uint32_t numTriangles = 0u;
+    std::memcpy(&numTriangles, header + 80u, sizeof(numTriangles));
+    if (size == 84u + 50u * static_cast<std::size_t>(numTriangles)) {
+      return loadBinaryStlMesh(file, numTriangles);
+    }
+    file.seekg(0);
+  }
+  return loadAsciiStlMesh(file);
+}
+
+TriangleMesh loadMesh(const std::string& filename) {
+  if (endsWith(filename, ".stl") || endsWith(filename, ".STL")) {
+    return loadStlMesh(filename);
+  }
+  return loadObjMesh(filename);
+}
+
+}  // namespace obstacles
+
+}  // namespace pdt
@@ -0,0 +1,598 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/obstacles/triangle_mesh_hierarchy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace pdt {
+
+namespace obstacles {
+
+namespace {
+
+using Vector = std::array<double, 3u>;
+
+Vector subtract(const Vector& a, const Vector& b) {
+  return {a[0u] - b[0u], a[1u] - b[1u], a[2u] - b[2u]};
+}
+
+Vector add(const Vector& a, const Vector& b) {
+  return {a[0u] + b[0u], a[1u] + b[1u], a[2u] + b[2u]};
+}
+
+Vector scale(const Vector& a, double factor) {
+  return {factor * a[0u], factor * a[1u], factor * a[2u]};
+}
+
+double dot(const Vector& a, const Vector& b) {
+  return a[0u] * b[0u] + a[1u] * b[1u] + a[2u] * b[2u];
+}
+
+Vector cross(const Vector& a, const Vector& b) {
+  return {a[1u] * b[2u] - a[2u] * b[1u], a[2u] * b[0u] - a[0u] * b[2u],
+          a[0u] * b[1u] - a[1u] * b[0u]};
+}
+
+Vector getVertex(const std::array<double, 9u>& triangle, std::size_t vertex) {
+  return {triangle[3u * vertex], triangle[3u * vertex + 1u], triangle[3u * vertex + 2u]};
+}
+
+// Returns six times the signed volume of the tetrahedron abcd, which is positive if d is on the
+// side of the plane through a, b, and c that its normal (b - a) x (c - a) points to.
+double orient(const Vector& a, const Vector& b, const Vector& c, const Vector& d) {
+  return dot(cross(subtract(b, a), subtract(c, a)), subtract(d, a));
+}
+
+// Returns twice the signed area of the triangle abc in the plane of the two given axes.
+double orient2D(const Vector& a, const Vector& b, const Vector& c, std::size_t u, std::size_t v) {
+  return (b[u] - a[u]) * (c[v] - a[v]) - (b[v] - a[v]) * (c[u] - a[u]);
+}
+
+// Returns whether the projections of the segments pq and ab onto the plane of the two given axes
+// intersect, including when they are collinear and overlap.
+bool intersectSegments2D(const Vector& p, const Vector& q, const Vector& a, const Vector& b,
+                         std::size_t u, std::size_t v) {
+  const auto pqa = orient2D(p, q, a, u, v);
+  const auto pqb = orient2D(p, q, b, u, v);
+  const auto abp = orient2D(a, b, p, u, v);
+  const auto abq = orient2D(a, b, q, u, v);
+  if (pqa != 0.0 || pqb != 0.0) {
+    return pqa * pqb <= 0.0 && abp * abq <= 0.0;
+  }
+  // The segments are collinear, so they intersect if their extents overlap on both axes.
+  for (const auto axis : {u, v}) {
+    if (std::max(p[axis], q[axis]) < std::min(a[axis], b[axis]) ||
+        std::max(a[axis], b[axis]) < std::min(p[axis], q[axis])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns whether the projection of the triangle abc onto the plane of the two given axes contains
+// the projection of the point p, including its boundary.
+bool contains2D(const Vector& a, const Vector& b, const Vector& c, const Vector& p, std::size_t u,
+                std::size_t v) {
+  const auto s0 = orient2D(a, b, p, u, v);
+  const auto s1 = orient2D(b, c, p, u, v);
+  const auto s2 = orient2D(c, a, p, u, v);
+  return (s0 >= 0.0 && s1 >= 0.0 && s2 >= 0.0) || (s0 <= 0.0 && s1 <= 0.0 && s2 <= 0.0);
+}
+
+// Returns the axis along which the given normal has its largest component. Projecting along this
+// axis preserves the most area of a triangle with this normal.
+std::size_t getDominantAxis(const Vector& normal) {
+  std::size_t dominant = 0u;
+  for (std::size_t dim = 1u; dim < 3u; ++dim) {
+    if (std::abs(normal[dim]) > std::abs(normal[dominant])) {
+      dominant = dim;
+    }
+  }
+  return dominant;
+}
+
+// Returns whether the segment pq crosses the triangle abc. The segment crosses the triangle if its
+// end points are not strictly on the same side of the plane of the triangle, and the line through
+// it passes all edges of the triangle on the same side. A segment in the plane of the triangle is
+// checked in the projection onto that plane instead.
+bool crosses(const Vector& p, const Vector& q, const Vector& a, const Vector& b, const Vector& c) {
+  const auto sideP = orient(a, b, c, p);
+  const auto sideQ = orient(a, b, c, q);
+  if ((sideP > 0.0 && sideQ > 0.0) || (sideP < 0.0 && sideQ < 0.0)) {
+    return false;
+  }
+  if (sideP == 0.0 && sideQ == 0.0) {
+    const auto drop = getDominantAxis(cross(subtract(b, a), subtract(c, a)));
+    const auto u = (drop + 1u) % 3u;
+    const auto v = (drop + 2u) % 3u;
+    return contains2D(a, b, c, p, u, v) || intersectSegments2D(p, q, a, b, u, v) ||
+           intersectSegments2D(p, q, b, c, u, v) || intersectSegments2D(p, q, c, a, u, v);
+  }
+  const auto ab = orient(p, q, a, b);
+  const auto bc = orient(p, q, b, c);
+  const auto ca = orient(p, q, c, a);
+  return (ab >= 0.0 && bc >= 0.0 && ca >= 0.0) || (ab <= 0.0 && bc <= 0.0 && ca <= 0.0);
+}
+
+// Returns whether two coplanar triangles intersect, by checking their projections onto the plane
+// of the two given axes. They intersect if any of their edges intersect or one contains the other.
+bool intersectCoplanar(const std::array<Vector, 3u>& first, const std::array<Vector, 3u>& second,
+                       std::size_t u, std::size_t v) {
+  for (std::size_t i = 0u; i < 3u; ++i) {
+    for (std::size_t j = 0u; j < 3u; ++j) {
+      if (intersectSegments2D(first[i], first[(i + 1u) % 3u], second[j], second[(j + 1u) % 3u], u,
+                              v)) {
+        return true;
+      }
+    }
+  }
+  return contains2D(second[0u], second[1u], second[2u], first[0u], u, v) ||
+         contains2D(first[0u], first[1u], first[2u], second[0u], u, v);
+}
+
+bool intersect(const std::array<Vector, 3u>& first, const std::array<Vector, 3u>& second) {
+  // Triangles with all vertices strictly on one side of the plane of the other do not intersect.
+  const auto isSeparatedBy = [](const std::array<Vector, 3u>& plane,
+                                const std::array<Vector, 3u>& triangle) {
+    const auto normal = cross(subtract(plane[1u], plane[0u]), subtract(plane[2u], plane[0u]));
+    std::array<double, 3u> sides{};
+    for (std::size_t i = 0u; i < 3u; ++i) {
+      sides[i] = dot(normal, subtract(triangle[i], plane[0u]));
+    }
+    return (sides[0u] > 0.0 && sides[1u] > 0.0 && sides[2u] > 0.0) ||
+           (sides[0u] < 0.0 && sides[1u] < 0.0 && sides[2u] < 0.0);
+  };
+  if (isSeparatedBy(second, first) || isSeparatedBy(first, second)) {
+    return false;
+  }
+
+  const auto normal = cross(subtract(second[1u], second[0u]), subtract(second[2u], second[0u]));
+  if (orient(second[0u], second[1u], second[2u], first[0u]) == 0.0 &&
+      orient(second[0u], second[1u], second[2u], first[1u]) == 0.0 &&
+      orient(second[0u], second[1u], second[2u], first[2u]) == 0.0) {
+    // Project onto the axis-aligned plane in which the triangles have the largest area.
+    const auto drop = getDominantAxis(normal);
+    return intersectCoplanar(first, second, (drop + 1u) % 3u, (drop + 2u) % 3u);
+  }
+
+  for (std::size_t i = 0u; i < 3u; ++i) {
+    if (crosses(first[i], first[(i + 1u) % 3u], second[0u], second[1u], second[2u]) ||
+        crosses(second[i], second[(i + 1u) % 3u], first[0u], first[1u], first[2u])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the point of the triangle abc that is closest to p, as described in Ericson, Real-Time
+// Collision Detection, 2005, Section 5.1.5.
+Vector findClosestPoint(const Vector& p, const Vector& a, const Vector& b, const Vector& c) {
+  const auto ab = subtract(b, a);
+  const auto ac = subtract(c, a);
+  const auto ap = subtract(p, a);
+  const auto d1 = dot(ab, ap);
+  const auto d2 = dot(ac, ap);
+  if (d1 <= 0.0 && d2 <= 0.0) {
+    return a;
+  }
+  const auto bp = subtract(p, b);
+  const auto d3 = dot(ab, bp);
+  const auto d4 = dot(ac, bp);
+  if (d3 >= 0.0 && d4 <= d3) {
+    return b;
+  }
+  const auto vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+    return add(a, scale(ab, d1 / (d1 - d3)));
+  }
+  const auto cp = subtract(p, c);
+  const auto d5 = dot(ab, cp);
+  const auto d6 = dot(ac, cp);
+  if (d6 >= 0.0 && d5 <= d6) {
+    return c;
+  }
+  const auto vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+    return add(a, scale(ac, d2 / (d2 - d6)));
+  }
+  const auto va = d3 * d6 - d5 * d4;
+  if (va <= 0.0 && d4 - d3 >= 0.0 && d5 - d6 >= 0.0) {
+    return add(b, scale(subtract(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6))));
+  }
+  const auto denominator = 1.0 / (va + vb + vc);
+  return add(a, add(scale(ab, vb * denominator), scale(ac, vc * denominator)));
+}
+
+// Returns the squared distance between the segments p1q1 and p2q2, as described in Ericson,
+// Real-Time Collision Detection, 2005, Section 5.1.9.
+double computeSquaredSegmentDistance(const Vector& p1, const Vector& q1, const Vector& p2,
+                                     const Vector& q2) {
+  const auto d1 = subtract(q1, p1);
+  const auto d2 = subtract(q2, p2);
+  const auto r = subtract(p1, p2);
+  const auto a = dot(d1, d1);
+  const auto e = dot(d2, d2);
+  const auto f = dot(d2, r);
+  double s = 0.0;
+  double t = 0.0;
+  if (a <= std::numeric_limits<double>::epsilon() && e <= std::numeric_limits<double>::epsilon()) {
+    return dot(r, r);
+  }
+  if (a <= std::numeric_limits<double>::epsilon()) {
+    t = std::clamp(f / e, 0.0, 1.0);
+  } else {
+    const auto c = dot(d1, r);
+    if (e <= std::numeric_limits<double>::epsilon()) {
+      s = std::clamp(-c / a, 0.0, 1.0);
+    } else {
+      const auto b = dot(d1, d2);
+      const auto denominator = a * e - b * b;
+      s = denominator != 0.0 ? std::clamp((b * f - c * e) / denominator, 0.0, 1.0) : 0.0;
+      t = (b * s + f) / e;
+      if (t < 0.0) {
+        t = 0.0;
+        s = std::clamp(-c / a, 0.0, 1.0);
+      } else if (t > 1.0) {
+        t = 1.0;
+        s = std::clamp((b - c) / a, 0.0, 1.0);
+      }
+    }
+  }
+  const auto difference = subtract(add(p1, scale(d1, s)), add(p2, scale(d2, t)));
+  return dot(difference, difference);
+}
+
+// Returns the squared distance between two triangles. If they do not intersect, the closest points
+// are on the boundary of at least one of them, so they are found among the vertex to triangle and
+// edge to edge pairs.
+double computeSquaredTriangleDistance(const std::array<Vector, 3u>& first,
+                                      const std::array<Vector, 3u>& second) {
+  if (intersect(first, second)) {
+    return 0.0;
+  }
+  auto minSquaredDistance = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0u; i < 3u; ++i) {
+    const auto toSecond =
+        subtract(first[i], findClosestPoint(first[i], second[0u], second[1u], second[2u]));
+    const auto toFirst =
+        subtract(second[i], findClosestPoint(second[i], first[0u], first[1u], first[2u]));
+    minSquaredDistance = std::min({minSquaredDistance, dot(toSecond, toSecond),
+                                   dot(toFirst, toFirst)});
+    for (std::size_t j = 0u; j < 3u; ++j) {
+      minSquaredDistance = std::min(
+          minSquaredDistance,
+          computeSquaredSegmentDistance(first[i], first[(i + 1u) % 3u], second[j],
+                                        second[(j + 1u) % 3u]));
+    }
+  }
+  return minSquaredDistance;
+}
+
+}  // namespace
+
+std::array<double, 3u> RigidTransform::apply(const std::array<double, 3u>& point) const {
+  return {rotation[0u] * point[0u] + rotation[1u] * point[1u] + rotation[2u] * point[2u] +
+              translation[0u],
+          rotation[3u] * point[0u] + rotation[4u] * point[1u] + rotation[5u] * point[2u] +
+              translation[1u],
+          rotation[6u] * point[0u] + rotation[7u] * point[1u] + rotation[8u] * point[2u] +
+              translation[2u]};
+}
+
+RigidTransform RigidTransform::fromQuaternion(double x, double y, double z, double w,
+                                              const std::array<double, 3u>& translation) {
+  RigidTransform transform;
+  transform.rotation = {1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y - z * w),
+                        2.0 * (x * z + y * w),       2.0 * (x * y + z * w),
+                        1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z - x * w),
+                        2.0 * (x * z - y * w),       2.0 * (y * z + x * w),
+                        1.0 - 2.0 * (x * x + y * y)};
+  transform.translation = translation;
+  return transform;
+}
+
+TriangleMeshHierarchy::TriangleMeshHierarchy(const TriangleMesh& mesh) {
+  const auto numTriangles = mesh.triangles.size();
+  std::vector<std::array<double, 3u>> centroids(numTriangles);
+  for (std::size_t i = 0u; i < numTriangles; ++i) {
+    for (const auto vertex : mesh.triangles[i]) {
+      if (vertex >= mesh.vertices.size()) {
+        throw std::invalid_argument("Triangle refers to a vertex that does not exist.");
+      }
+      centroids[i] = add(centroids[i], scale(mesh.vertices[vertex], 1.0 / 3.0));
+    }
+  }
+  if (numTriangles == 0u) {
+    return;
+  }
+
+  // Store the vertices of every triangle, such that the hierarchy can build the boxes and the
+  // queries read contiguous memory.
+  triangles_.resize(numTriangles);
+  for (std::size_t i = 0u; i < numTriangles; ++i) {
+    for (std::size_t vertex = 0u; vertex < 3u; ++vertex) {
+      std::copy_n(mesh.vertices[mesh.triangles[i][vertex]].cbegin(), 3u,
+                  triangles_[i].begin() + static_cast<long>(3u * vertex));
+    }
+  }
+
+  // A median split halves the triangles, so the tree has fewer than 2n / MAX_LEAF_SIZE nodes.
+  std::vector<std::size_t> indices(numTriangles);
+  std::iota(indices.begin(), indices.end(), 0u);
+  nodes_.reserve(2u * (numTriangles / MAX_LEAF_SIZE + 1u));
+  buildNode(0u, numTriangles, centroids, &indices);
+
+  // Store the triangles in the order of the leaves.
+  std::vector<std::array<double, 9u>> triangles(numTriangles);
+  for (std::size_t i = 0u; i < numTriangles; ++i) {
+    triangles[i] = triangles_[indices[i]];
+  }
+  triangles_ = std::move(triangles);
+}
+
+bool TriangleMeshHierarchy::collides(const TriangleMeshHierarchy& other,
+                                     const RigidTransform& otherPose) const {
+  if (nodes_.empty() || other.nodes_.empty()) {
+    return false;
+  }
+  std::array<double, 9u> absoluteRotation{};
+  std::transform(otherPose.rotation.cbegin(), otherPose.rotation.cend(),
+                 absoluteRotation.begin(), [](double value) { return std::abs(value); });
+
+  // Every step replaces a pair of nodes with at most two pairs of their children, so the stack is
+  // never deeper than the two trees together.
+  std::array<std::pair<std::size_t, std::size_t>, 2u * MAX_DEPTH> stack;
+  std::size_t stackSize = 0u;
+  stack[stackSize++] = {0u, 0u};
+  while (stackSize != 0u) {
+    const auto [index, otherIndex] = stack[--stackSize];
+    const auto& node = nodes_[index];
+    const auto& otherNode = other.nodes_[otherIndex];
+    if (computeSquaredDistance(node, transformNode(otherNode, otherPose, absoluteRotation)) > 0.0) {
+      continue;
+    }
+
+    // Descend into the larger of the two nodes, until both are leaves.
+    const bool isLeaf = node.right == 0u;
+    const bool isOtherLeaf = otherNode.right == 0u;
+    if (isLeaf && isOtherLeaf) {
+      for (auto j = otherNode.begin; j < otherNode.end; ++j) {
+        const auto& otherTriangle = other.triangles_[j];
+        const std::array<Vector, 3u> transformed{otherPose.apply(getVertex(otherTriangle, 0u)),
+                                                 otherPose.apply(getVertex(otherTriangle, 1u)),
+                                                 otherPose.apply(getVertex(otherTriangle, 2u))};
+        for (auto i = node.begin; i < node.end; ++i) {
+          if (intersect({getVertex(triangles_[i], 0u), getVertex(triangles_[i], 1u),
+                         getVertex(triangles_[i], 2u)},
+                        transformed)) {
+            return true;
+          }
+        }
+      }
+    } else if (isOtherLeaf ||
+               (!isLeaf && *std::max_element(node.halfExtents.cbegin(), node.halfExtents.cend()) >=
+                               *std::max_element(otherNode.halfExtents.cbegin(),
+                                                 otherNode.halfExtents.cend()))) {
+      stack[stackSize++] = {node.right, otherIndex};
+      stack[stackSize++] = {index + 1u, otherIndex};
+    } else {
+      stack[stackSize++] = {index, otherNode.right};
+      stack[stackSize++] = {index, otherIndex + 1u};
+    }
+  }
+  return false;
+}
+
+double TriangleMeshHierarchy::computeDistance(const TriangleMeshHierarchy& other,
+                                              const RigidTransform& otherPose) const {
+  if (nodes_.empty() || other.nodes_.empty()) {
+    return std::numeric_limits<double>::infinity();
+  }
+  std::array<double, 9u> absoluteRotation{};
+  std::transform(otherPose.rotation.cbegin(), otherPose.rotation.cend(),
+                 absoluteRotation.begin(), [](double value) { return std::abs(value); });
+
+  // The stack holds pairs of nodes with the squared distance between their boxes, which bounds the
+  // squared distance between their triangles from below.
+  struct Pair {
+    double squaredDistance;
+    std::size_t index;
+    std::size_t otherIndex;
+  };
+  std::array<Pair, 2u * MAX_DEPTH> stack;
+  std::size_t stackSize = 0u;
+  stack[stackSize++] = {
+      computeSquaredDistance(nodes_[0u], transformNode(other.nodes_[0u], otherPose,
+                                                       absoluteRotation)),
+      0u, 0u};
+  auto minSquaredDistance = std::numeric_limits<double>::infinity();
+  while (stackSize != 0u) {
+    const auto pair = stack[--stackSize];
+    if (pair.squaredDistance >= minSquaredDistance) {
+      continue;
+    }
+    const auto& node = nodes_[pair.index];
+    const auto& otherNode = other.nodes_[pair.otherIndex];
+    const bool isLeaf = node.right == 0u;
+    const bool isOtherLeaf = otherNode.right == 0u;
+    if (isLeaf && isOtherLeaf) {
+      for (auto j = otherNode.begin; j < otherNode.end; ++j) {
+        const auto& otherTriangle = other.triangles_[j];
+        const std::array<Vector, 3u> transformed{otherPose.apply(getVertex(otherTriangle, 0u)),
+                                                 otherPose.apply(getVertex(otherTriangle, 1u)),
+                                                 otherPose.apply(getVertex(otherTriangle, 2u))};
+        for (auto i = node.begin; i < node.end; ++i) {
+          minSquaredDistance = std::min(
+              minSquaredDistance,
+              computeSquaredTriangleDistance({getVertex(triangles_[i], 0u),
+                                              getVertex(triangles_[i], 1u),
+                                              getVertex(triangles_[i], 2u)},
+                                             transformed));
+        }
+      }
+      if (minSquaredDistance == 0.0) {
+        return 0.0;
+      }
+      continue;
+    }
+
+    // Descend into the larger of the two nodes and visit the closer child first.
+    std::array<Pair, 2u> children;
+    if (isOtherLeaf ||
+        (!isLeaf && *std::max_element(node.halfExtents.cbegin(), node.halfExtents.cend()) >=
+                        *std::max_element(otherNode.halfExtents.cbegin(),
+                                          otherNode.halfExtents.cend()))) {
+      const auto transformed = transformNode(otherNode, otherPose, absoluteRotation);
+      children = {Pair{computeSquaredDistance(nodes_[pair.index + 1u], transformed),
+                       pair.index + 1u, pair.otherIndex},
+                  Pair{computeSquaredDistance(nodes_[node.right], transformed), node.right,
+                       pair.otherIndex}};
+    } else {
+      children = {
+          Pair{computeSquaredDistance(node, transformNode(other.nodes_[pair.otherIndex + 1u],
+                                                          otherPose, absoluteRotation)),
+               pair.index, pair.otherIndex + 1u},
+          Pair{computeSquaredDistance(
+                   node, transformNode(other.nodes_[otherNode.right], otherPose, absoluteRotation)),
+               pair.index, otherNode.right}};
+    }
+    if (children[0u].squaredDistance < children[1u].squaredDistance) {
+      std::swap(children[0u], children[1u]);
+    }
+    for (const auto& child : children) {
+      if (child.squaredDistance < minSquaredDistance) {
+        stack[stackSize++] = child;
+      }
+    }
+  }
+  return std::sqrt(minSquaredDistance);
+}
+
+std::size_t TriangleMeshHierarchy::size() const {
+  return triangles_.size();
+}
+
+const std::array<double, 9u>& TriangleMeshHierarchy::getTriangle(std::size_t index) const {
+  return triangles_[index];
+}
+
+std::size_t TriangleMeshHierarchy::buildNode(std::size_t begin, std::size_t end,
+                                             const std::vector<std::array<double, 3u>>& centroids,
+                                             std::vector<std::size_t>* indices) {
+  const auto index = nodes_.size();
+  nodes_.push_back(Node{});
+
+  // Compute the bounds of the triangles of this node and the bounds of their centroids.
+  const auto infinity = std::numeric_limits<double>::infinity();
+  Vector lower{infinity, infinity, infinity};
+  Vector upper{-infinity, -infinity, -infinity};
+  Vector centroidLower{infinity, infinity, infinity};
+  Vector centroidUpper{-infinity, -infinity, -infinity};
+  for (auto i = begin; i < end; ++i) {
+    const auto triangle = (*indices)[i];
+    for (std::size_t dim = 0u; dim < 3u; ++dim) {
+      for (std::size_t vertex = 0u; vertex < 3u; ++vertex) {
+        lower[dim] = std::min(lower[dim], triangles_[triangle][3u * vertex + dim]);
+        upper[dim] = std::max(upper[dim], triangles_[triangle][3u * vertex + dim]);
+      }
+      centroidLower[dim] = std::min(centroidLower[dim], centroids[triangle][dim]);
+      centroidUpper[dim] = std::max(centroidUpper[dim], centroids[triangle][dim]);
+    }
+  }
+  nodes_[index].center = scale(add(lower, upper), 0.5);
+  nodes_[index].halfExtents = scale(subtract(upper, lower), 0.5);
+  nodes_[index].begin = begin;
+  nodes_[index].end = end;
+
+  if (end - begin <= MAX_LEAF_SIZE) {
+    return index;
+  }
+
+  // Split at the median centroid along the axis in which the centroids spread the most.
+  std::size_t axis = 0u;
+  for (std::size_t dim = 1u; dim < 3u; ++dim) {
+    if (centroidUpper[dim] - centroidLower[dim] > centroidUpper[axis] - centroidLower[axis]) {
+      axis = dim;
+    }
+  }
+  const auto middle = begin + (end - begin) / 2u;
+  std::nth_element(indices->begin() + static_cast<long>(begin),
+                   indices->begin() + static_cast<long>(middle),
+                   indices->begin() + static_cast<long>(end),
+                   [&centroids, axis](std::size_t a, std::size_t b) {
+                     return centroids[a][axis] < centroids[b][axis];
+                   });
+
+  buildNode(begin, middle, centroids, indices);
+  const auto right = buildNode(middle, end, centroids, indices);
+  nodes_[index].right = right;
+  return index;
+}
+
+TriangleMeshHierarchy::Node TriangleMeshHierarchy::transformNode(
+    const Node& node, const RigidTransform& pose, const std::array<double, 9u>& absoluteRotation) {
+  Node transformed;
+  transformed.center = pose.apply(node.center);
+  for (std::size_t row = 0u; row < 3u; ++row) {
+    transformed.halfExtents[row] = absoluteRotation[3u * row] * node.halfExtents[0u] +
+                                   absoluteRotation[3u * row + 1u] * node.halfExtents[1u] +
+                                   absoluteRotation[3u * row + 2u] * node.halfExtents[2u];
+  }
+  return transformed;
+}
+
+double TriangleMeshHierarchy::computeSquaredDistance(const Node& node, const Node& otherNode) {
+  double squaredDistance = 0.0;
+  for (std::size_t dim = 0u; dim < 3u; ++dim) {
+    const auto gap = std::abs(node.center[dim] - otherNode.center[dim]) - node.halfExtents[dim] -
+                     otherNode.halfExtents[dim];
+    if (gap > 0.0) {
+      squaredDistance += gap * gap;
+    }
+  }
+  return squaredDistance;
+}
+
+}  // namespace obstacles
+
+}  // namespace pdt
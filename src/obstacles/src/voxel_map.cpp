@@ -0,0 +1,519 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/obstacles/voxel_map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace pdt {
+
+namespace obstacles {
+
+namespace {
+
+constexpr std::size_t BITS_PER_WORD{64u};
+constexpr std::size_t WORDS_PER_BRICK{8u};
+constexpr std::size_t BRICKS_PER_NODE_SIDE{16u};
+constexpr std::size_t ENTRIES_PER_NODE{4096u};
+
+// The entries of the root and the nodes that are tiles rather than indices.
+constexpr std::uint32_t FREE_TILE{std::numeric_limits<std::uint32_t>::max()};
+constexpr std::uint32_t OCCUPIED_TILE{FREE_TILE - 1u};
+
+bool isTile(std::uint32_t entry) {
+  return entry >= OCCUPIED_TILE;
+}
+
+}  // namespace
+
+VoxelMap::VoxelMap(const std::array<std::size_t, 3u>& numVoxels) : numVoxels_(numVoxels) {
+  for (auto dim = 0u; dim < 3u; ++dim) {
+    numNodes_[dim] = (numVoxels_[dim] + NODE_SIDE_LENGTH - 1u) / NODE_SIDE_LENGTH;
+  }
+  root_.assign(numNodes_[0u] * numNodes_[1u] * numNodes_[2u], FREE_TILE);
+}
+
+VoxelMap::VoxelMap(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open binvox file '" + filename + "'.");
+  }
+  std::string line;
+  if (!std::getline(file, line) || line.rfind("#binvox", 0u) != 0u) {
+    throw std::runtime_error("'" + filename + "' is not a binvox file.");
+  }
+
+  // The header ends with the data keyword. The translation and scale are not needed, because the
+  // grid is placed by the context that uses it.
+  std::array<std::size_t, 3u> dimensions{};
+  bool hasDimensions = false;
+  while (std::getline(file, line) && line != "data") {
+    std::istringstream stream(line);
+    std::string keyword;
+    stream >> keyword;
+    if (keyword == "dim") {
+      hasDimensions =
+          static_cast<bool>(stream >> dimensions[0u] >> dimensions[1u] >> dimensions[2u]);
+    }
+  }
+  if (!hasDimensions || line != "data") {
+    throw std::runtime_error("Binvox file '" + filename + "' has no dimensions or no data.");
+  }
+
+  // The dimensions of the file are its depth (x), height (z), and width (y).
+  *this = VoxelMap(dimensions);
+  const auto height = dimensions[1u];
+  const auto width = dimensions[2u];
+  const auto numVoxels = dimensions[0u] * height * width;
+
+  // The data are pairs of a value and the number of consecutive voxels with this value.
+  std::size_t index = 0u;
+  char run[2u];
+  while (index < numVoxels && file.read(run, 2)) {
+    const auto count = static_cast<std::size_t>(static_cast<unsigned char>(run[1u]));
+    if (run[0u] != 0) {
+      for (auto i = index; i < std::min(index + count, numVoxels); ++i) {
+        setOccupied({i / (width * height), (i / width) % height, i % width}, true);
+      }
+    }
+    index += count;
+  }
+  if (index < numVoxels) {
+    throw std::runtime_error("Binvox file '" + filename + "' ends before all voxels are read.");
+  }
+
+  compact();
+}
+
+const std::array<std::size_t, 3u>& VoxelMap::getNumVoxels() const {
+  return numVoxels_;
+}
+
+bool VoxelMap::isOccupied(const std::array<std::size_t, 3u>& voxel) const {
+  return getFreeSideLength(voxel) == 0u;
+}
+
+void VoxelMap::setOccupied(const std::array<std::size_t, 3u>& voxel, bool occupied) {
+  const auto tile = occupied ? OCCUPIED_TILE : FREE_TILE;
+
+  // Tiles that do not already have the occupancy are split into a node and a brick.
+  const auto rootIndex = getRootIndex(voxel);
+  if (root_[rootIndex] == tile) {
+    return;
+  }
+  if (isTile(root_[rootIndex])) {
+    root_[rootIndex] = appendNode(root_[rootIndex]);
+  }
+  const auto entryIndex = root_[rootIndex] * ENTRIES_PER_NODE + getNodeOffset(voxel);
+  if (nodeEntries_[entryIndex] == tile) {
+    return;
+  }
+  if (isTile(nodeEntries_[entryIndex])) {
+    nodeEntries_[entryIndex] = appendBrick(nodeEntries_[entryIndex]);
+  }
+
+  const auto bit = getBrickOffset(voxel);
+  const auto mask = std::uint64_t{1u} << (bit % BITS_PER_WORD);
+  auto& word = brickWords_[nodeEntries_[entryIndex] * WORDS_PER_BRICK + bit / BITS_PER_WORD];
+  word = occupied ? (word | mask) : (word & ~mask);
+}
+
+bool VoxelMap::isOccupied(const double* point) const {
+  return isOccupied({getVoxel(point[0u], numVoxels_[0u]), getVoxel(point[1u], numVoxels_[1u]),
+                     getVoxel(point[2u], numVoxels_[2u])});
+}
+
+std::size_t VoxelMap::countOccupied() const {
+  std::size_t count = 0u;
+  for (const auto node : root_) {
+    if (node == OCCUPIED_TILE) {
+      count += NODE_SIDE_LENGTH * NODE_SIDE_LENGTH * NODE_SIDE_LENGTH;
+    } else if (!isTile(node)) {
+      for (auto entry = node * ENTRIES_PER_NODE; entry < (node + 1u) * ENTRIES_PER_NODE; ++entry) {
+        if (nodeEntries_[entry] == OCCUPIED_TILE) {
+          count += BRICK_SIDE_LENGTH * BRICK_SIDE_LENGTH * BRICK_SIDE_LENGTH;
+        } else if (!isTile(nodeEntries_[entry])) {
+          for (auto word = 0u; word < WORDS_PER_BRICK; ++word) {
+            count += static_cast<std::size_t>(__builtin_popcountll(
+                brickWords_[nodeEntries_[entry] * WORDS_PER_BRICK + word]));
+          }
+        }
+      }
+    }
+  }
+  return count;
+}
+
+std::size_t VoxelMap::getNumBytes() const {
+  return root_.capacity() * sizeof(std::uint32_t) +
+         nodeEntries_.capacity() * sizeof(std::uint32_t) +
+         brickWords_.capacity() * sizeof(std::uint64_t);
+}
+
+void VoxelMap::compact() {
+  std::vector<std::uint32_t> nodeEntries;
+  std::vector<std::uint64_t> brickWords;
+  std::vector<std::uint32_t> entries(ENTRIES_PER_NODE);
+  for (auto& node : root_) {
+    if (isTile(node)) {
+      continue;
+    }
+
+    // Bricks whose voxels are all free or all occupied become tiles. Bricks on the upper
+    // boundary of the grid are never occupied tiles, because their voxels outside the grid are
+    // never set.
+    bool isFree = true;
+    bool isOccupied = true;
+    for (std::size_t entry = 0u; entry < ENTRIES_PER_NODE; ++entry) {
+      auto brick = nodeEntries_[node * ENTRIES_PER_NODE + entry];
+      if (!isTile(brick)) {
+        const auto begin = brickWords_.cbegin() + static_cast<long>(brick * WORDS_PER_BRICK);
+        const auto end = begin + static_cast<long>(WORDS_PER_BRICK);
+        if (std::all_of(begin, end, [](std::uint64_t word) { return word == 0u; })) {
+          brick = FREE_TILE;
+        } else if (std::all_of(begin, end, [](std::uint64_t word) { return ~word == 0u; })) {
+          brick = OCCUPIED_TILE;
+        } else {
+          const auto index = static_cast<std::uint32_t>(brickWords.size() / WORDS_PER_BRICK);
+          brickWords.insert(brickWords.end(), begin, end);
+          brick = index;
+        }
+      }
+      entries[entry] = brick;
+      isFree &= brick == FREE_TILE;
+      isOccupied &= brick == OCCUPIED_TILE;
+    }
+
+    // Nodes whose bricks are all free or all occupied become tiles.
+    if (isFree) {
+      node = FREE_TILE;
+    } else if (isOccupied) {
+      node = OCCUPIED_TILE;
+    } else {
+      node = static_cast<std::uint32_t>(nodeEntries.size() / ENTRIES_PER_NODE);
+      nodeEntries.insert(nodeEntries.end(), entries.cbegin(), entries.cend());
+    }
+  }
+
+  // The new storage is only as large as it needs to be.
+  nodeEntries.shrink_to_fit();
+  brickWords.shrink_to_fit();
+  nodeEntries_ = std::move(nodeEntries);
+  brickWords_ = std::move(brickWords);
+}
+
+void VoxelMap::forEachBlock(
+    const std::function<void(const std::array<std::size_t, 3u>&, std::size_t)>& function) const {
+  for (std::size_t rootIndex = 0u; rootIndex < root_.size(); ++rootIndex) {
+    const auto node = root_[rootIndex];
+    if (node == FREE_TILE) {
+      continue;
+    }
+    const std::array<std::size_t, 3u> nodeLower{
+        (rootIndex % numNodes_[0u]) * NODE_SIDE_LENGTH,
+        (rootIndex / numNodes_[0u] % numNodes_[1u]) * NODE_SIDE_LENGTH,
+        (rootIndex / (numNodes_[0u] * numNodes_[1u])) * NODE_SIDE_LENGTH};
+    if (node == OCCUPIED_TILE) {
+      function(nodeLower, NODE_SIDE_LENGTH);
+      continue;
+    }
+    for (std::size_t entry = 0u; entry < ENTRIES_PER_NODE; ++entry) {
+      if (nodeEntries_[node * ENTRIES_PER_NODE + entry] != FREE_TILE) {
+        function({nodeLower[0u] + (entry % BRICKS_PER_NODE_SIDE) * BRICK_SIDE_LENGTH,
+                  nodeLower[1u] + (entry / BRICKS_PER_NODE_SIDE % BRICKS_PER_NODE_SIDE) *
+                                      BRICK_SIDE_LENGTH,
+                  nodeLower[2u] +
+                      (entry / (BRICKS_PER_NODE_SIDE * BRICKS_PER_NODE_SIDE)) * BRICK_SIDE_LENGTH},
+                 BRICK_SIDE_LENGTH);
+      }
+    }
+  }
+}
+
+double VoxelMap::findFirstOccupied(const double* from, const double* to) const {
+  const auto infinity = std::numeric_limits<double>::infinity();
+  std::array<std::size_t, 3u> voxel{};
+  std::array<std::size_t, 3u> end{};
+  std::array<double, 3u> delta{};
+  std::array<double, 3u> step{};
+  std::array<double, 3u> next{};
+  for (auto dim = 0u; dim < 3u; ++dim) {
+    voxel[dim] = getVoxel(from[dim], numVoxels_[dim]);
+    end[dim] = getVoxel(to[dim], numVoxels_[dim]);
+    delta[dim] = to[dim] - from[dim];
+    step[dim] = delta[dim] != 0.0 ? 1.0 / std::abs(delta[dim]) : infinity;
+  }
+
+  // The fractions of the segment at which it crosses the next voxel boundary along each axis.
+  const auto computeNext = [&](unsigned dim) {
+    return delta[dim] > 0.0   ? (static_cast<double>(voxel[dim] + 1u) - from[dim]) / delta[dim]
+           : delta[dim] < 0.0 ? (static_cast<double>(voxel[dim]) - from[dim]) / delta[dim]
+                              : infinity;
+  };
+  for (auto dim = 0u; dim < 3u; ++dim) {
+    next[dim] = computeNext(dim);
+  }
+
+  double fraction = 0.0;
+  while (true) {
+    const auto sideLength = getFreeSideLength(voxel);
+    if (sideLength == 0u) {
+      return std::clamp(fraction, 0.0, 1.0);
+    }
+    if (voxel == end) {
+      return infinity;
+    }
+
+    // Jump over a free tile to the first voxel after it. The segment leaves the tile through the
+    // face it reaches first. Along the other axes, the voxel after the tile is the voxel that
+    // contains the exit point, but never beyond the voxel of the end point.
+    if (sideLength > 1u) {
+      std::array<double, 3u> faces{};
+      auto exit = infinity;
+      for (auto dim = 0u; dim < 3u; ++dim) {
+        const auto lower = static_cast<double>(voxel[dim] / sideLength * sideLength);
+        faces[dim] = delta[dim] > 0.0
+                         ? (lower + static_cast<double>(sideLength) - from[dim]) / delta[dim]
+                     : delta[dim] < 0.0 ? (lower - from[dim]) / delta[dim]
+                                        : infinity;
+        exit = std::min(exit, faces[dim]);
+      }
+      if (exit >= 1.0) {
+        return infinity;
+      }
+      auto jumped = voxel;
+      for (auto dim = 0u; dim < 3u; ++dim) {
+        if (voxel[dim] == end[dim]) {
+          continue;
+        }
+        const auto lower = static_cast<double>(voxel[dim] / sideLength * sideLength);
+        const auto coordinate = from[dim] + exit * delta[dim];
+        if (delta[dim] > 0.0) {
+          const auto upper = std::min(lower + static_cast<double>(sideLength),
+                                      static_cast<double>(end[dim]));
+          jumped[dim] = faces[dim] == exit
+                            ? static_cast<std::size_t>(upper)
+                            : static_cast<std::size_t>(std::clamp(
+                                  std::floor(coordinate), static_cast<double>(voxel[dim]), upper));
+        } else {
+          const auto lowest = std::max(lower - 1.0, static_cast<double>(end[dim]));
+          jumped[dim] = faces[dim] == exit
+                            ? static_cast<std::size_t>(lowest)
+                            : static_cast<std::size_t>(std::clamp(std::ceil(coordinate) - 1.0,
+                                                                  lowest,
+                                                                  static_cast<double>(voxel[dim])));
+        }
+      }
+      if (jumped != voxel) {
+        voxel = jumped;
+        fraction = exit;
+        for (auto dim = 0u; dim < 3u; ++dim) {
+          next[dim] = computeNext(dim);
+        }
+        continue;
+      }
+    }
+
+    // Step into the next voxel. An axis that already reached the voxel of the end point is not
+    // stepped along anymore, which keeps rounding errors from leaving the segment.
+    auto minNext = infinity;
+    for (auto dim = 0u; dim < 3u; ++dim) {
+      if (voxel[dim] != end[dim]) {
+        minNext = std::min(minNext, next[dim]);
+      }
+    }
+    for (auto dim = 0u; dim < 3u; ++dim) {
+      if (voxel[dim] != end[dim] && next[dim] <= minNext) {
+        voxel[dim] = delta[dim] > 0.0 ? voxel[dim] + 1u : voxel[dim] - 1u;
+        next[dim] += step[dim];
+      }
+    }
+    fraction = minNext;
+  }
+}
+
+double VoxelMap::computeClearance(const double* point, const double* voxelSideLengths) const {
+  // The squared distance of the point to a block of voxels, clipped to the grid.
+  const auto computeSquaredDistance = [&](const std::array<std::size_t, 3u>& lower,
+                                          std::size_t sideLength) {
+    double squaredDistance = 0.0;
+    for (auto dim = 0u; dim < 3u; ++dim) {
+      const auto low = static_cast<double>(lower[dim]);
+      const auto high = static_cast<double>(std::min(lower[dim] + sideLength, numVoxels_[dim]));
+      const auto gap = std::max({low - point[dim], 0.0, point[dim] - high});
+      squaredDistance += gap * gap * voxelSideLengths[dim] * voxelSideLengths[dim];
+    }
+    return squaredDistance;
+  };
+
+  // Visit the nodes from the closest to the farthest, such that the farther ones can be skipped.
+  auto minSquaredDistance = std::numeric_limits<double>::infinity();
+  std::vector<std::pair<double, std::size_t>> nodes;
+  for (std::size_t rootIndex = 0u; rootIndex < root_.size(); ++rootIndex) {
+    if (root_[rootIndex] == FREE_TILE) {
+      continue;
+    }
+    const auto squaredDistance = computeSquaredDistance(
+        {(rootIndex % numNodes_[0u]) * NODE_SIDE_LENGTH,
+         (rootIndex / numNodes_[0u] % numNodes_[1u]) * NODE_SIDE_LENGTH,
+         (rootIndex / (numNodes_[0u] * numNodes_[1u])) * NODE_SIDE_LENGTH},
+        NODE_SIDE_LENGTH);
+    if (root_[rootIndex] == OCCUPIED_TILE) {
+      minSquaredDistance = std::min(minSquaredDistance, squaredDistance);
+    } else {
+      nodes.emplace_back(squaredDistance, rootIndex);
+    }
+  }
+  std::sort(nodes.begin(), nodes.end());
+
+  for (const auto& [nodeSquaredDistance, rootIndex] : nodes) {
+    if (nodeSquaredDistance >= minSquaredDistance) {
+      break;
+    }
+    const auto node = root_[rootIndex];
+    const std::array<std::size_t, 3u> nodeLower{
+        (rootIndex % numNodes_[0u]) * NODE_SIDE_LENGTH,
+        (rootIndex / numNodes_[0u] % numNodes_[1u]) * NODE_SIDE_LENGTH,
+        (rootIndex / (numNodes_[0u] * numNodes_[1u])) * NODE_SIDE_LENGTH};
+    for (std::size_t entry = 0u; entry < ENTRIES_PER_NODE; ++entry) {
+      const auto brick = nodeEntries_[node * ENTRIES_PER_NODE + entry];
+      if (brick == FREE_TILE) {
+        continue;
+      }
+      const std::array<std::size_t, 3u> brickLower{
+          nodeLower[0u] + (entry % BRICKS_PER_NODE_SIDE) * BRICK_SIDE_LENGTH,
+          nodeLower[1u] + (entry / BRICKS_PER_NODE_SIDE % BRICKS_PER_NODE_SIDE) * BRICK_SIDE_LENGTH,
+          nodeLower[2u] +
+              (entry / (BRICKS_PER_NODE_SIDE * BRICKS_PER_NODE_SIDE)) * BRICK_SIDE_LENGTH};
+      const auto brickSquaredDistance = computeSquaredDistance(brickLower, BRICK_SIDE_LENGTH);
+      if (brickSquaredDistance >= minSquaredDistance) {
+        continue;
+      }
+      if (brick == OCCUPIED_TILE) {
+        minSquaredDistance = brickSquaredDistance;
+        continue;
+      }
+
+      // Visit the occupied voxels of the brick.
+      for (std::size_t word = 0u; word < WORDS_PER_BRICK; ++word) {
+        auto bits = brickWords_[brick * WORDS_PER_BRICK + word];
+        while (bits != 0u) {
+          const auto bit = word * BITS_PER_WORD + static_cast<std::size_t>(__builtin_ctzll(bits));
+          bits &= bits - 1u;
+          minSquaredDistance = std::min(
+              minSquaredDistance,
+              computeSquaredDistance(
+                  {brickLower[0u] + bit % BRICK_SIDE_LENGTH,
+                   brickLower[1u] + bit / BRICK_SIDE_LENGTH % BRICK_SIDE_LENGTH,
+                   brickLower[2u] + bit / (BRICK_SIDE_LENGTH * BRICK_SIDE_LENGTH)},
+                  1u));
+        }
+      }
+    }
+  }
+
+  return std::sqrt(minSquaredDistance);
+}
+
+std::size_t VoxelMap::getFreeSideLength(const std::array<std::size_t, 3u>& voxel) const {
+  const auto node = root_[getRootIndex(voxel)];
+  if (node == FREE_TILE) {
+    return NODE_SIDE_LENGTH;
+  } else if (node == OCCUPIED_TILE) {
+    return 0u;
+  }
+  const auto brick = nodeEntries_[node * ENTRIES_PER_NODE + getNodeOffset(voxel)];
+  if (brick == FREE_TILE) {
+    return BRICK_SIDE_LENGTH;
+  } else if (brick == OCCUPIED_TILE) {
+    return 0u;
+  }
+  const auto bit = getBrickOffset(voxel);
+  return ((brickWords_[brick * WORDS_PER_BRICK + bit / BITS_PER_WORD] >> (bit % BITS_PER_WORD)) &
+          1u)
+             ? 0u
+             : 1u;
+}
+
+std::size_t VoxelMap::getRootIndex(const std::array<std::size_t, 3u>& voxel) const {
+  return voxel[0u] / NODE_SIDE_LENGTH +
+         numNodes_[0u] *
+             (voxel[1u] / NODE_SIDE_LENGTH + numNodes_[1u] * (voxel[2u] / NODE_SIDE_LENGTH));
+}
+
+std::size_t VoxelMap::getNodeOffset(const std::array<std::size_t, 3u>& voxel) {
+  return voxel[0u] / BRICK_SIDE_LENGTH % BRICKS_PER_NODE_SIDE +
+         BRICKS_PER_NODE_SIDE * (voxel[1u] / BRICK_SIDE_LENGTH % BRICKS_PER_NODE_SIDE +
+                                 BRICKS_PER_NODE_SIDE *
+                                     (voxel[2u] / BRICK_SIDE_LENGTH % BRICKS_PER_NODE_SIDE));
+}
+
+std::size_t VoxelMap::getBrickOffset(const std::array<std::size_t, 3u>& voxel) {
+  return voxel[0u] % BRICK_SIDE_LENGTH +
+         BRICK_SIDE_LENGTH *
+             (voxel[1u] % BRICK_SIDE_LENGTH + BRICK_SIDE_LENGTH * (voxel[2u] % BRICK_SIDE_LENGTH));
+}
+
+std::uint32_t VoxelMap::appendNode(std::uint32_t tile) {
+  const auto index = static_cast<std::uint32_t>(nodeEntries_.size() / ENTRIES_PER_NODE);
+  nodeEntries_.resize(nodeEntries_.size() + ENTRIES_PER_NODE, tile);
+  return index;
+}
+
+std::uint32_t VoxelMap::appendBrick(std::uint32_t tile) {
+  const auto index = static_cast<std::uint32_t>(brickWords_.size() / WORDS_PER_BRICK);
+  brickWords_.resize(brickWords_.size() + WORDS_PER_BRICK,
+                     tile == OCCUPIED_TILE ? ~std::uint64_t{0u} : std::uint64_t{0u});
+  return index;
+}
+
+std::size_t VoxelMap::getVoxel(double coordinate, std::size_t numVoxels) {
+  if (!(coordinate > 0.0)) {
+    return 0u;
+  }
+  return static_cast<std::size_t>(std::min(coordinate, static_cast<double>(numVoxels - 1u)));
+}
+
+}  // namespace obstacles
+
+}  // namespace pdt
@@ -53,6 +53,7 @@
 #pragma GCC diagnostic pop
 
 #include "pdt/config/configuration.h"
+#include "pdt/open_rave/open_rave_base_validity_checker.h"
 #include "pdt/planning_contexts/base_context.h"
 #include "pdt/planning_contexts/context_visitor.h"
 
@@ -80,6 +81,13 @@ class OpenRaveBaseContext : public planning_contexts::BaseContext {
 
   /** \brief Create a new goal. */
   virtual std::shared_ptr<ompl::base::Goal> createGoal() const override;
+
+ protected:
+  /** \brief Approximates the clearance of the validity checker with spheres if the context
+   * specifies their radius. */
+  void configureClearanceApproximation(
+      const OpenRAVE::EnvironmentBasePtr& environment, const OpenRAVE::RobotBasePtr& robot,
+      const std::shared_ptr<OpenRaveBaseValidityChecker>& validityChecker) const;
 };
 
 }  // namespace open_rave
@@ -37,13 +37,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <boost/smart_ptr.hpp>
 
 #include <ompl/base/SpaceInformation.h>
 #include <ompl/base/State.h>
-#include <ompl/base/StateValidityChecker.h>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
@@ -58,12 +60,14 @@
 #include "pdt/obstacles/base_obstacle.h"
 #include "pdt/obstacles/hyperrectangle.h"
 #include "pdt/obstacles/obstacle_visitor.h"
+#include "pdt/open_rave/open_rave_sphere_model.h"
+#include "pdt/planning_contexts/batch_validity_checker.h"
 
 namespace pdt {
 
 namespace open_rave {
 
-class OpenRaveBaseValidityChecker : public ompl::base::StateValidityChecker {
+class OpenRaveBaseValidityChecker : public planning_contexts::BatchValidityChecker {
  public:
   /** \brief The constructor. */
   OpenRaveBaseValidityChecker(const ompl::base::SpaceInformationPtr& spaceInfo,
@@ -71,16 +75,62 @@ class OpenRaveBaseValidityChecker : public ompl::base::StateValidityChecker {
                               const OpenRAVE::RobotBasePtr& robot,
                               const std::shared_ptr<const config::Configuration>& config);
 
-  /** \brief The destructor. */
+  /** \brief The destructor. The environments cloned for other threads are released with it. */
   virtual ~OpenRaveBaseValidityChecker() = default;
 
   /** \brief Check if a state is valid. */
   virtual bool isValid(const ompl::base::State* state) const override = 0;
 
+  /** \brief Check if all states of a batch are valid, locking the environment at most once. */
+  virtual bool isValid(const ompl::base::State* const* states,
+                       std::size_t numStates) const override;
+
   /** \brief Returns a pointer to the rave environment. */
   virtual OpenRAVE::EnvironmentBasePtr getOpenRaveEnvironment() const;
 
+  /** \brief Approximates the clearance of states with the sphere model. States with an approximate
+   * clearance below the margin fall back to exact distance queries. */
+  void setClearanceApproximation(const std::shared_ptr<const OpenRaveSphereModel>& sphereModel,
+                                 double margin);
+
  protected:
+  /** \brief The rave environment, robot, and scratch space a thread checks states with. The first
+   * thread that checks a state uses the original environment, which it must lock because the
+   * visualization may read it. All other threads use clones that no other thread touches, so they
+   * check states without any locks. */
+  struct ThreadEnvironment {
+    /** \brief The environment of this thread. */
+    OpenRAVE::EnvironmentBasePtr environment{};
+
+    /** \brief The robot in the environment of this thread. */
+    OpenRAVE::RobotBasePtr robot{};
+
+    /** \brief Whether this is the original environment, which needs to be locked. */
+    bool isShared{false};
+
+    /** \brief The collision options the collision checker of the environment is set to. */
+    int collisionOptions{-1};
+
+    /** \brief The collision check report to store the clearance of a state. */
+    OpenRAVE::CollisionReportPtr collisionReport{};
+
+    /** \brief The active DOF values of a state in a format that rave can check. */
+    std::vector<double> dofValues{};
+  };
+
+  /** \brief Returns the environment of the calling thread, cloning it on the first call. */
+  ThreadEnvironment& getThreadEnvironment() const;
+
+  /** \brief Sets the collision options of the environment, if they are not set already. */
+  void setCollisionOptions(ThreadEnvironment& threadEnvironment, int options) const;
+
+  /** \brief Returns a lock of the environment, which holds the mutex only for the original. */
+  OpenRAVE::EnvironmentMutex::scoped_lock lock(const ThreadEnvironment& threadEnvironment) const;
+
+  /** \brief Returns the clearance of the robot of the thread environment in its current state. The
+   * caller must hold the lock of the environment. */
+  double computeClearance(ThreadEnvironment& threadEnvironment) const;
+
   /** \brief The rave environment. */
   OpenRAVE::EnvironmentBasePtr environment_;
 
@@ -90,11 +140,25 @@ class OpenRaveBaseValidityChecker : public ompl::base::StateValidityChecker {
   /** \brief The state space we are checking states of. */
   const std::shared_ptr<const ompl::base::StateSpace> stateSpace_;
 
-  /** \brief The collision check report to store the clearance of a state. */
-  mutable boost::shared_ptr<OpenRAVE::CollisionReport> collisionReport_;
-
   /** \brief The configuration. */
   const std::shared_ptr<const config::Configuration> config_;
+
+ private:
+  /** \brief The unique identifier of this checker, which keys the environments of each thread. */
+  const std::size_t id_;
+
+  /** \brief Whether a thread is using the original environment. */
+  mutable std::atomic<bool> isOriginalClaimed_{false};
+
+  /** \brief The environments of all threads that checked states, and the mutex to add to them. */
+  mutable std::vector<std::unique_ptr<ThreadEnvironment>> threadEnvironments_{};
+  mutable std::mutex threadEnvironmentsMutex_{};
+
+  /** \brief The sphere model that approximates the clearance, if any. */
+  std::shared_ptr<const OpenRaveSphereModel> sphereModel_{};
+
+  /** \brief The approximate clearance below which the exact clearance is computed. */
+  double clearanceMargin_{0.0};
 };
 
 }  // namespace open_rave
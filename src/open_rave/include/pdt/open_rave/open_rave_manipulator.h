@@ -67,7 +67,7 @@ class OpenRaveManipulator : public OpenRaveBaseContext {
   OpenRaveManipulator(const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
                       const std::shared_ptr<const config::Configuration>& config,
                       const std::string& name);
-  virtual ~OpenRaveManipulator();
+  virtual ~OpenRaveManipulator() = default;
 
   /** \brief Accepts a context visitor. */
   virtual void accept(const planning_contexts::ContextVisitor& visitor) const override final;
@@ -77,10 +77,6 @@ class OpenRaveManipulatorValidityChecker : public OpenRaveBaseValidityChecker {
 
   /** \brief Returns the clearance of a state. */
   virtual double clearance(const ompl::base::State* state) const override;
-
- private:
-  /** \brief The state in a format that rave can check. */
-  mutable std::vector<double> raveState_;
 };
 
 }  // namespace open_rave
@@ -66,7 +66,7 @@ class OpenRaveR3 : public OpenRaveBaseContext {
  public:
   OpenRaveR3(const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
              const std::shared_ptr<const config::Configuration>& config, const std::string& name);
-  virtual ~OpenRaveR3();
+  virtual ~OpenRaveR3() = default;
 
   /** \brief Accepts a context visitor. */
   virtual void accept(const planning_contexts::ContextVisitor& visitor) const override final;
@@ -69,7 +69,7 @@ class OpenRaveR3xSO2 : public OpenRaveBaseContext {
   OpenRaveR3xSO2(const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
                  const std::shared_ptr<const config::Configuration>& config,
                  const std::string& name);
-  virtual ~OpenRaveR3xSO2();
+  virtual ~OpenRaveR3xSO2() = default;
 
   /** \brief Accepts a context visitor. */
   virtual void accept(const planning_contexts::ContextVisitor& visitor) const override final;
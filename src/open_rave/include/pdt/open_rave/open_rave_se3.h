@@ -68,7 +68,7 @@ class OpenRaveSE3 : public OpenRaveBaseContext {
  public:
   OpenRaveSE3(const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
               const std::shared_ptr<const config::Configuration>& config, const std::string& name);
-  virtual ~OpenRaveSE3();
+  virtual ~OpenRaveSE3() = default;
 
   /** \brief Accepts a context visitor. */
   virtual void accept(const planning_contexts::ContextVisitor& visitor) const override final;
@@ -79,10 +79,6 @@ class OpenRaveSE3ValidityChecker : public OpenRaveBaseValidityChecker {
 
   /** \brief Returns the clearance of a state. */
   virtual double clearance(const ompl::base::State* state) const override;
-
- private:
-  /** \brief The state in a format that rave can check. */
-  mutable OpenRAVE::Transform raveState_;
 };
 
 }  // namespace open_rave
@@ -0,0 +1,121 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Woverflow"
+#pragma GCC diagnostic ignored "-Wconversion"
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#include <openrave-core.h>
+#pragma GCC diagnostic pop
+
+namespace pdt {
+
+namespace open_rave {
+
+/** \brief Approximates the links of a robot and the bodies of its environment with spheres that
+ * contain their collision geometry. The spheres of the links are stored in the frames of the
+ * links, such that forward kinematics place them, and the spheres of the environment are stored
+ * in a bounding volume hierarchy. Because the spheres contain the geometry, the distance between
+ * them never overestimates the clearance of the robot, and underestimates it by at most four
+ * times the sphere radius. The model is immutable after construction, so any number of threads
+ * can query it concurrently. */
+class OpenRaveSphereModel {
+ public:
+  /** \brief A sphere, which contains a part of the collision geometry. */
+  struct Sphere {
+    std::array<double, 3u> center{};
+    double radius{0.0};
+  };
+
+  /** \brief Approximates the robot and all other enabled bodies of the environment with spheres
+   * that have at most the given radius. The environment is assumed to be static. */
+  OpenRaveSphereModel(const OpenRAVE::EnvironmentBasePtr& environment,
+                      const OpenRAVE::RobotBasePtr& robot, double maxSphereRadius);
+
+  /** \brief The destructor. */
+  ~OpenRaveSphereModel() = default;
+
+  /** \brief Returns a lower bound on the clearance of the robot in its current configuration. The
+   * robot must be the one this model was created for, or a clone of it. Returns early with a value
+   * below the threshold as soon as the clearance is known to be below it. */
+  double clearance(const OpenRAVE::RobotBasePtr& robot, double threshold) const;
+
+  /** \brief Returns the number of spheres that approximate the robot. */
+  std::size_t getNumRobotSpheres() const;
+
+  /** \brief Returns the number of spheres that approximate the environment. */
+  std::size_t getNumEnvironmentSpheres() const;
+
+ private:
+  /** \brief A node of the hierarchy of the environment spheres. The spheres of a node are
+   * contiguous, its left child directly follows it, and its right child is at the given index. */
+  struct Node {
+    std::array<double, 3u> lowerCorner{};
+    std::array<double, 3u> upperCorner{};
+    double maxRadius{0.0};
+    std::size_t begin{0u};
+    std::size_t end{0u};
+    std::size_t right{0u};
+  };
+
+  /** \brief Builds the subtree for the given range of environment spheres. */
+  void buildNode(std::size_t begin, std::size_t end);
+
+  /** \brief Lowers the given clearance to the distance between the sphere and the environment, if
+   * that is smaller. */
+  void updateClearance(const Sphere& sphere, double* clearance) const;
+
+  /** \brief The spheres of each link in the frame of the link, indexed by link index. */
+  std::vector<std::vector<Sphere>> linkSpheres_{};
+
+  /** \brief The spheres of the environment in the world frame, ordered by the hierarchy. */
+  std::vector<Sphere> environmentSpheres_{};
+
+  /** \brief The nodes of the hierarchy. The first node is the root. */
+  std::vector<Node> nodes_{};
+};
+
+}  // namespace open_rave
+
+}  // namespace pdt
@@ -48,6 +48,7 @@
 #include <openrave/environment.h>
 
 #include "pdt/open_rave/open_rave_manipulator_validity_checker.h"
+#include "pdt/open_rave/open_rave_sphere_model.h"
 
 using namespace std::string_literals;
 
@@ -74,6 +75,18 @@ std::shared_ptr<ompl::base::Goal> OpenRaveBaseContext::createGoal() const {
   return std::make_shared<ompl::base::GoalState>(spaceInfo_);
 }
 
+void OpenRaveBaseContext::configureClearanceApproximation(
+    const OpenRAVE::EnvironmentBasePtr& environment, const OpenRAVE::RobotBasePtr& robot,
+    const std::shared_ptr<OpenRaveBaseValidityChecker>& validityChecker) const {
+  if (!config_->contains("context/" + name_ + "/clearanceSphereRadius")) {
+    return;
+  }
+  validityChecker->setClearanceApproximation(
+      std::make_shared<const OpenRaveSphereModel>(
+          environment, robot, config_->get<double>("context/" + name_ + "/clearanceSphereRadius")),
+      config_->get<double>("context/" + name_ + "/clearanceMargin"));
+}
+
 }  // namespace open_rave
 
 }  // namespace pdt
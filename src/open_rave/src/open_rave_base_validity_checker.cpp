@@ -37,26 +37,131 @@
 
 #include "pdt/open_rave/open_rave_base_validity_checker.h"
 
+#include <stdexcept>
+#include <unordered_map>
+
 namespace pdt {
 
 namespace open_rave {
 
+namespace {
+
+// The identifier of the next validity checker. Identifiers are never reused, such that the
+// environments a thread has cached for destroyed checkers are never looked up again.
+std::atomic<std::size_t> nextCheckerId{0u};
+
+}  // namespace
+
 OpenRaveBaseValidityChecker::OpenRaveBaseValidityChecker(
     const ompl::base::SpaceInformationPtr& spaceInfo,
     const OpenRAVE::EnvironmentBasePtr& environment, const OpenRAVE::RobotBasePtr& robot,
     const std::shared_ptr<const config::Configuration>& config) :
-    ompl::base::StateValidityChecker(spaceInfo),
+    planning_contexts::BatchValidityChecker(spaceInfo),
     environment_(environment),
     robot_(robot),
     stateSpace_(spaceInfo->getStateSpace()),
-    collisionReport_(boost::make_shared<OpenRAVE::CollisionReport>()),
-    config_(config) {
+    config_(config),
+    id_(nextCheckerId++) {
+}
+
+bool OpenRaveBaseValidityChecker::isValid(const ompl::base::State* const* states,
+                                          std::size_t numStates) const {
+  // Checking the bounds is much cheaper than checking for collisions.
+  for (std::size_t i = 0u; i < numStates; ++i) {
+    if (!stateSpace_->satisfiesBounds(states[i])) {
+      return false;
+    }
+  }
+
+  // Lock the environment mutex once for the whole batch if this thread uses the original
+  // environment. It is recursive, so checking the individual states only increments the lock count.
+  const auto batchLock = lock(getThreadEnvironment());
+  for (std::size_t i = 0u; i < numStates; ++i) {
+    if (!isValid(states[i])) {
+      return false;
+    }
+  }
+  return true;
 }
 
 OpenRAVE::EnvironmentBasePtr OpenRaveBaseValidityChecker::getOpenRaveEnvironment() const {
   return environment_;
 }
 
+void OpenRaveBaseValidityChecker::setClearanceApproximation(
+    const std::shared_ptr<const OpenRaveSphereModel>& sphereModel, double margin) {
+  sphereModel_ = sphereModel;
+  clearanceMargin_ = margin;
+}
+
+OpenRaveBaseValidityChecker::ThreadEnvironment& OpenRaveBaseValidityChecker::getThreadEnvironment()
+    const {
+  // Each thread caches pointers to its environments, so only the first check of a thread needs to
+  // synchronize with other threads.
+  thread_local std::unordered_map<std::size_t, ThreadEnvironment*> cachedEnvironments;
+  const auto cached = cachedEnvironments.find(id_);
+  if (cached != cachedEnvironments.end()) {
+    return *cached->second;
+  }
+
+  auto threadEnvironment = std::make_unique<ThreadEnvironment>();
+  if (!isOriginalClaimed_.exchange(true)) {
+    threadEnvironment->environment = environment_;
+    threadEnvironment->robot = robot_;
+    threadEnvironment->isShared = true;
+  } else {
+    // Cloning reads the original environment, which another thread might be modifying.
+    OpenRAVE::EnvironmentMutex::scoped_lock originalLock(environment_->GetMutex());
+    threadEnvironment->environment = environment_->CloneSelf(OpenRAVE::Clone_Bodies);
+    threadEnvironment->robot = threadEnvironment->environment->GetRobot(robot_->GetName());
+    if (!threadEnvironment->robot || !threadEnvironment->environment->GetCollisionChecker()) {
+      throw std::runtime_error("Could not clone the OpenRAVE environment for another thread.");
+    }
+  }
+  threadEnvironment->collisionReport = boost::make_shared<OpenRAVE::CollisionReport>();
+  threadEnvironment->dofValues.resize(static_cast<std::size_t>(robot_->GetActiveDOF()));
+
+  std::scoped_lock threadEnvironmentsLock(threadEnvironmentsMutex_);
+  threadEnvironments_.push_back(std::move(threadEnvironment));
+  cachedEnvironments[id_] = threadEnvironments_.back().get();
+  return *threadEnvironments_.back();
+}
+
+void OpenRaveBaseValidityChecker::setCollisionOptions(ThreadEnvironment& threadEnvironment,
+                                                      int options) const {
+  // Setting the options can be expensive, and checkers mostly check many states with the same ones.
+  if (threadEnvironment.collisionOptions != options) {
+    threadEnvironment.environment->GetCollisionChecker()->SetCollisionOptions(options);
+    threadEnvironment.collisionOptions = options;
+  }
+}
+
+double OpenRaveBaseValidityChecker::computeClearance(ThreadEnvironment& threadEnvironment) const {
+  // The approximation never overestimates the clearance, so it is only inaccurate far enough from
+  // the obstacles for most objectives not to care.
+  if (sphereModel_) {
+    const auto approximateClearance =
+        sphereModel_->clearance(threadEnvironment.robot, clearanceMargin_);
+    if (approximateClearance >= clearanceMargin_) {
+      return approximateClearance;
+    }
+  }
+
+  // Compute the exact distance.
+  setCollisionOptions(threadEnvironment, OpenRAVE::CO_Distance);
+  threadEnvironment.environment->CheckCollision(threadEnvironment.robot,
+                                                threadEnvironment.collisionReport);
+  return threadEnvironment.collisionReport->minDistance;
+}
+
+OpenRAVE::EnvironmentMutex::scoped_lock OpenRaveBaseValidityChecker::lock(
+    const ThreadEnvironment& threadEnvironment) const {
+  if (threadEnvironment.isShared) {
+    return OpenRAVE::EnvironmentMutex::scoped_lock(threadEnvironment.environment->GetMutex());
+  }
+  return OpenRAVE::EnvironmentMutex::scoped_lock();
+}
+
 }  // namespace open_rave
 
 }  // namespace pdt
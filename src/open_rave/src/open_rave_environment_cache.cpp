@@ -0,0 +1,92 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/open_rave/open_rave_environment_cache.h"
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#include <ompl/util/Console.h>
+
+#include "pdt/time/time.h"
+
+namespace pdt {
+
+namespace open_rave {
+
+namespace {
+
+// The mutex that protects the templates.
+std::mutex templatesMutex;
+
+// Returns the templates, keyed by the file they are loaded from. The templates are never destroyed,
+// because they must not outlive the globals of OpenRAVE, which destroys all environments itself.
+std::map<std::string, OpenRAVE::EnvironmentBasePtr>& getTemplates() {
+  static auto* templates = new std::map<std::string, OpenRAVE::EnvironmentBasePtr>();
+  return *templates;
+}
+
+}  // namespace
+
+OpenRAVE::EnvironmentBasePtr cloneEnvironmentTemplate(const std::string& environmentFile) {
+  // Initialize rave. This does nothing if rave is initialized already.
+  OpenRAVE::RaveInitialize(true, OpenRAVE::Level_Warn);
+
+  std::scoped_lock templatesLock(templatesMutex);
+  auto& templates = getTemplates();
+  auto environmentTemplate = templates.find(environmentFile);
+  if (environmentTemplate == templates.end()) {
+    const auto start = time::Clock::now();
+    auto environment = OpenRAVE::RaveCreateEnvironment();
+    if (!environment->Load(environmentFile)) {
+      throw std::runtime_error("Could not load the OpenRAVE environment '" + environmentFile +
+                               "'.");
+    }
+    OMPL_INFORM("Loaded the OpenRAVE environment '%s' in %.3f s.", environmentFile.c_str(),
+                time::seconds(time::Clock::now() - start));
+    environmentTemplate = templates.emplace(environmentFile, environment).first;
+  }
+
+  // Cloning reads the template, which is otherwise never touched.
+  OpenRAVE::EnvironmentMutex::scoped_lock environmentLock(environmentTemplate->second->GetMutex());
+  return environmentTemplate->second->CloneSelf(OpenRAVE::Clone_Bodies);
+}
+
+}  // namespace open_rave
+
+}  // namespace pdt
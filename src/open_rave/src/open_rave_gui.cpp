@@ -532,5 +532,8 @@ int main(const int argc, const char** argv) {
     throw std::runtime_error("Cannot process non-openrave context.");
   }
 
+  // The contexts leave the environments to rave, because later contexts clone them.
+  OpenRAVE::RaveDestroy();
+
   return 0;
 }
@@ -48,6 +48,7 @@
 #include <openrave/environment.h>
 
 #include "pdt/config/directory.h"
+#include "pdt/open_rave/open_rave_environment_cache.h"
 #include "pdt/open_rave/open_rave_manipulator_validity_checker.h"
 
 using namespace std::string_literals;
@@ -60,11 +61,10 @@ OpenRaveManipulator::OpenRaveManipulator(
     const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
     const std::shared_ptr<const config::Configuration>& config, const std::string& name) :
     OpenRaveBaseContext(spaceInfo, config, name) {
-  // Initialize rave.
-  OpenRAVE::RaveInitialize(true, OpenRAVE::Level_Warn);
-
-  // Create a rave environment.
-  auto environment = OpenRAVE::RaveCreateEnvironment();
+  // Clone the environment. Its file is only loaded for the first context of this scene.
+  auto environment = cloneEnvironmentTemplate(
+      std::string(config::Directory::SOURCE) + "/"s +
+      config_->get<std::string>("context/" + name + "/environment"));
 
   // Create a collision checker.
   OpenRAVE::CollisionCheckerBasePtr collisionChecker = OpenRAVE::RaveCreateCollisionChecker(
@@ -76,11 +76,7 @@ OpenRaveManipulator::OpenRaveManipulator(
   collisionChecker->SendCommand(bhv, cmd);
   environment->SetCollisionChecker(collisionChecker);
 
-  // Load the specified environment.
-  environment->Load(std::string(config::Directory::SOURCE) + "/"s +
-                    config_->get<std::string>("context/" + name + "/environment"));
-
-  // Load the robot.
+  // Get the robot.
   auto robot = environment->GetRobot(config_->get<std::string>("context/" + name + "/robot"));
 
   // Set the active dimensions.
@@ -100,6 +96,9 @@ OpenRaveManipulator::OpenRaveManipulator(
   auto validityChecker =
       std::make_shared<OpenRaveManipulatorValidityChecker>(spaceInfo_, environment, robot, config_);
 
+  // Approximate its clearance with spheres if requested.
+  configureClearanceApproximation(environment, robot, validityChecker);
+
   // Set the validity checker and check resolution.
   spaceInfo_->setStateValidityChecker(validityChecker);
   spaceInfo_->setStateValidityCheckingResolution(
@@ -111,10 +110,6 @@ OpenRaveManipulator::OpenRaveManipulator(
   startGoalPairs_ = makeStartGoalPair();
 }
 
-OpenRaveManipulator::~OpenRaveManipulator() {
-  OpenRAVE::RaveDestroy();
-}
-
 std::vector<planning_contexts::StartGoalPair> OpenRaveManipulator::makeStartGoalPair() const {
   if (config_->contains("context/" + name_ + "/starts")) {
     OMPL_ERROR("OpenRaveManipulator context does not support multiple queries.");
@@ -47,8 +47,7 @@ OpenRaveManipulatorValidityChecker::OpenRaveManipulatorValidityChecker(
     const ompl::base::SpaceInformationPtr& spaceInfo,
     const OpenRAVE::EnvironmentBasePtr& environment, const OpenRAVE::RobotBasePtr& robot,
     const std::shared_ptr<const config::Configuration>& config) :
-    OpenRaveBaseValidityChecker(spaceInfo, environment, robot, config),
-    raveState_(static_cast<std::size_t>(robot->GetDOF())) {
+    OpenRaveBaseValidityChecker(spaceInfo, environment, robot, config) {
 }
 
 bool OpenRaveManipulatorValidityChecker::isValid(const ompl::base::State* state) const {
@@ -57,46 +56,46 @@ bool OpenRaveManipulatorValidityChecker::isValid(const ompl::base::State* state)
     return false;
   }
 
+  // Get the environment of this thread.
+  auto& thread = getThreadEnvironment();
+
   // Fill the rave state with the ompl state values.
   auto realVectorState = state->as<ompl::base::RealVectorStateSpace::StateType>();
   for (auto i = 0u; i < stateSpace_->getDimension(); ++i) {
-    raveState_[i] = realVectorState->operator[](i);
+    thread.dofValues[i] = realVectorState->operator[](i);
   }
 
-  // Lock the environment mutex.
-  OpenRAVE::EnvironmentMutex::scoped_lock lock(environment_->GetMutex());
+  // Lock the environment mutex if this thread shares the environment.
+  const auto environmentLock = lock(thread);
 
   // Set the robot to the requested state.
-  robot_->SetActiveDOFValues(raveState_);
+  thread.robot->SetActiveDOFValues(thread.dofValues);
 
-  // Set the option to measure distance.
-  environment_->GetCollisionChecker()->SetCollisionOptions(OpenRAVE::CO_Contacts);
+  // Set the option to check for contacts.
+  setCollisionOptions(thread, OpenRAVE::CO_Contacts);
 
   // Check for collisions.
-  return !(environment_->CheckCollision(robot_) || robot_->CheckSelfCollision());
+  return !(thread.environment->CheckCollision(thread.robot) || thread.robot->CheckSelfCollision());
 }
 
 double OpenRaveManipulatorValidityChecker::clearance(const ompl::base::State* state) const {
+  // Get the environment of this thread.
+  auto& thread = getThreadEnvironment();
+
   // Fill the rave state with the ompl state values.
   auto realVectorState = state->as<ompl::base::RealVectorStateSpace::StateType>();
   for (auto i = 0u; i < stateSpace_->getDimension(); ++i) {
-    raveState_[i] = realVectorState->operator[](i);
+    thread.dofValues[i] = realVectorState->operator[](i);
   }
 
-  // Lock the environment mutex.
-  OpenRAVE::EnvironmentMutex::scoped_lock lock(environment_->GetMutex());
+  // Lock the environment mutex if this thread shares the environment.
+  const auto environmentLock = lock(thread);
 
   // Set the robot to the requested state.
-  robot_->SetActiveDOFValues(raveState_);
-
-  // Set the option to measure distance.
-  environment_->GetCollisionChecker()->SetCollisionOptions(OpenRAVE::CO_Distance);
-
-  // Compute the distance.
-  environment_->CheckCollision(robot_, collisionReport_);
+  thread.robot->SetActiveDOFValues(thread.dofValues);
 
-  // Report the distance.
-  return collisionReport_->minDistance;
+  // Compute the clearance.
+  return computeClearance(thread);
 }
 
 }  // namespace open_rave
@@ -48,6 +48,7 @@
 #include <openrave/environment.h>
 
 #include "pdt/config/directory.h"
+#include "pdt/open_rave/open_rave_environment_cache.h"
 #include "pdt/open_rave/open_rave_r3_validity_checker.h"
 
 using namespace std::string_literals;
@@ -60,11 +61,10 @@ OpenRaveR3::OpenRaveR3(const std::shared_ptr<ompl::base::SpaceInformation>& spac
                        const std::shared_ptr<const config::Configuration>& config,
                        const std::string& name) :
     OpenRaveBaseContext(spaceInfo, config, name) {
-  // Initialize rave.
-  OpenRAVE::RaveInitialize(true, OpenRAVE::Level_Warn);
-
-  // Create a rave environment.
-  auto environment = OpenRAVE::RaveCreateEnvironment();
+  // Clone the environment. Its file is only loaded for the first context of this scene.
+  auto environment = cloneEnvironmentTemplate(
+      std::string(config::Directory::SOURCE) + "/"s +
+      config_->get<std::string>("context/" + name + "/environment"));
 
   // Create a collision checker.
   OpenRAVE::CollisionCheckerBasePtr collisionChecker = OpenRAVE::RaveCreateCollisionChecker(
@@ -76,11 +76,7 @@ OpenRaveR3::OpenRaveR3(const std::shared_ptr<ompl::base::SpaceInformation>& spac
   collisionChecker->SendCommand(output, input);
   environment->SetCollisionChecker(collisionChecker);
 
-  // Load the specified environment.
-  environment->Load(std::string(config::Directory::SOURCE) + "/"s +
-                    config_->get<std::string>("context/" + name + "/environment"));
-
-  // Load the robot.
+  // Get the robot.
   auto robot = environment->GetRobot(config_->get<std::string>("context/" + name + "/robot"));
 
   // In this context, there are no active dimensions.
@@ -97,6 +93,9 @@ OpenRaveR3::OpenRaveR3(const std::shared_ptr<ompl::base::SpaceInformation>& spac
   auto validityChecker =
       std::make_shared<OpenRaveR3ValidityChecker>(spaceInfo_, environment, robot, config_);
 
+  // Approximate its clearance with spheres if requested.
+  configureClearanceApproximation(environment, robot, validityChecker);
+
   OpenRAVE::Transform raveState;
   raveState.identity();
 
@@ -111,10 +110,6 @@ OpenRaveR3::OpenRaveR3(const std::shared_ptr<ompl::base::SpaceInformation>& spac
   startGoalPairs_ = makeStartGoalPair();
 }
 
-OpenRaveR3::~OpenRaveR3() {
-  OpenRAVE::RaveDestroy();
-}
-
 std::vector<planning_contexts::StartGoalPair> OpenRaveR3::makeStartGoalPair() const {
   if (config_->contains("context/" + name_ +
                         "/starts")) {  // if a 'starts' spec is given, read that
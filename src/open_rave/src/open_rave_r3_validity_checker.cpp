@@ -49,9 +49,7 @@ OpenRaveR3ValidityChecker::OpenRaveR3ValidityChecker(
     const ompl::base::SpaceInformationPtr& spaceInfo,
     const OpenRAVE::EnvironmentBasePtr& environment, const OpenRAVE::RobotBasePtr& robot,
     const std::shared_ptr<const config::Configuration>& config) :
-    OpenRaveBaseValidityChecker(spaceInfo, environment, robot, config),
-    raveState_() {
-  raveState_.identity();
+    OpenRaveBaseValidityChecker(spaceInfo, environment, robot, config) {
 }
 
 bool OpenRaveR3ValidityChecker::isValid(const ompl::base::State* state) const {
@@ -60,42 +58,46 @@ bool OpenRaveR3ValidityChecker::isValid(const ompl::base::State* state) const {
     return false;
   }
 
+  // Get the environment of this thread.
+  auto& thread = getThreadEnvironment();
+
   // Fill the rave state with the ompl state values.
   auto r3State = state->as<ompl::base::RealVectorStateSpace::StateType>();
-  raveState_.trans.Set3((*r3State)[0u], (*r3State)[1u], (*r3State)[2u]);
+  OpenRAVE::Transform raveState;
+  raveState.identity();
+  raveState.trans.Set3((*r3State)[0u], (*r3State)[1u], (*r3State)[2u]);
 
-  // Lock the environment mutex.
-  OpenRAVE::EnvironmentMutex::scoped_lock lock(environment_->GetMutex());
+  // Lock the environment mutex if this thread shares the environment.
+  const auto environmentLock = lock(thread);
 
   // Set the robot to the requested state.
-  robot_->SetTransform(raveState_);
+  thread.robot->SetTransform(raveState);
 
-  // Set the option to measure distance.
-  environment_->GetCollisionChecker()->SetCollisionOptions(OpenRAVE::CO_Contacts);
+  // Set the option to check for contacts.
+  setCollisionOptions(thread, OpenRAVE::CO_Contacts);
 
   // Check for collisions.
-  return !environment_->CheckCollision(robot_);
+  return !thread.environment->CheckCollision(thread.robot);
 }
 
 double OpenRaveR3ValidityChecker::clearance(const ompl::base::State* state) const {
+  // Get the environment of this thread.
+  auto& thread = getThreadEnvironment();
+
   // Fill the rave state with the ompl state values.
   auto r3State = state->as<ompl::base::RealVectorStateSpace::StateType>();
-  raveState_.trans.Set3((*r3State)[0u], (*r3State)[1u], (*r3State)[2u]);
+  OpenRAVE::Transform raveState;
+  raveState.identity();
+  raveState.trans.Set3((*r3State)[0u], (*r3State)[1u], (*r3State)[2u]);
 
-  // Lock the environment mutex.
-  OpenRAVE::EnvironmentMutex::scoped_lock lock(environment_->GetMutex());
+  // Lock the environment mutex if this thread shares the environment.
+  const auto environmentLock = lock(thread);
 
   // Set the robot to the requested state.
-  robot_->SetTransform(raveState_);
-
-  // Set the option to measure distance.
-  environment_->GetCollisionChecker()->SetCollisionOptions(OpenRAVE::CO_Distance);
-
-  // Compute the distance.
-  environment_->CheckCollision(robot_, collisionReport_);
+  thread.robot->SetTransform(raveState);
 
-  // Report the distance.
-  return collisionReport_->minDistance;
+  // Compute the clearance.
+  return computeClearance(thread);
 }
 
 }  // namespace open_rave
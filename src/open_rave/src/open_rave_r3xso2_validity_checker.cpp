@@ -50,9 +50,7 @@ OpenRaveR3xSO2ValidityChecker::OpenRaveR3xSO2ValidityChecker(
     const ompl::base::SpaceInformationPtr& spaceInfo,
     const OpenRAVE::EnvironmentBasePtr& environment, const OpenRAVE::RobotBasePtr& robot,
     const std::shared_ptr<const config::Configuration>& config) :
-    OpenRaveBaseValidityChecker(spaceInfo, environment, robot, config),
-    raveState_() {
-  raveState_.identity();
+    OpenRaveBaseValidityChecker(spaceInfo, environment, robot, config) {
 }
 
 bool OpenRaveR3xSO2ValidityChecker::isValid(const ompl::base::State* state) const {
@@ -61,54 +59,56 @@ bool OpenRaveR3xSO2ValidityChecker::isValid(const ompl::base::State* state) cons
     return false;
   }
 
+  // Get the environment of this thread.
+  auto& thread = getThreadEnvironment();
+
   // Fill the R3 part of the state.
   auto r3State = state->as<ompl::base::CompoundStateSpace::StateType>()
                      ->as<ompl::base::RealVectorStateSpace::StateType>(0u);
-  raveState_.trans.Set3((*r3State)[0u], (*r3State)[1u], (*r3State)[2u]);
+  OpenRAVE::Transform raveState;
+  raveState.trans.Set3((*r3State)[0u], (*r3State)[1u], (*r3State)[2u]);
 
   // Fill the SO2 part of the state
   auto so2State = state->as<ompl::base::CompoundStateSpace::StateType>()
                       ->as<ompl::base::SO2StateSpace::StateType>(1u);
-  raveState_.rot.Set4(std::sin(so2State->value / 2.0), 0.0, 0.0, std::cos(so2State->value / 2.0));
+  raveState.rot.Set4(std::sin(so2State->value / 2.0), 0.0, 0.0, std::cos(so2State->value / 2.0));
 
-  // Lock the environment mutex.
-  OpenRAVE::EnvironmentMutex::scoped_lock lock(environment_->GetMutex());
+  // Lock the environment mutex if this thread shares the environment.
+  const auto environmentLock = lock(thread);
 
   // Set the robot to the requested state.
-  robot_->SetTransform(raveState_);
+  thread.robot->SetTransform(raveState);
 
-  // Set the option to only check for collision.
-  environment_->GetCollisionChecker()->SetCollisionOptions(OpenRAVE::CO_Contacts);
+  // Set the option to check for contacts.
+  setCollisionOptions(thread, OpenRAVE::CO_Contacts);
 
   // Check for collisions.
-  return !environment_->CheckCollision(robot_);
+  return !thread.environment->CheckCollision(thread.robot);
 }
 
 double OpenRaveR3xSO2ValidityChecker::clearance(const ompl::base::State* state) const {
+  // Get the environment of this thread.
+  auto& thread = getThreadEnvironment();
+
   // Fill the R3 part of the state.
   auto r3State = state->as<ompl::base::CompoundStateSpace::StateType>()
                      ->as<ompl::base::RealVectorStateSpace::StateType>(0u);
-  raveState_.trans.Set3((*r3State)[0u], (*r3State)[1u], (*r3State)[2u]);
+  OpenRAVE::Transform raveState;
+  raveState.trans.Set3((*r3State)[0u], (*r3State)[1u], (*r3State)[2u]);
 
   // Fill the SO2 part of the state
   auto so2State = state->as<ompl::base::CompoundStateSpace::StateType>()
                       ->as<ompl::base::SO2StateSpace::StateType>(1u);
-  raveState_.rot.Set4(std::sin(so2State->value / 2.0), 0.0, 0.0, std::cos(so2State->value / 2.0));
+  raveState.rot.Set4(std::sin(so2State->value / 2.0), 0.0, 0.0, std::cos(so2State->value / 2.0));
 
-  // Lock the environment mutex.
-  OpenRAVE::EnvironmentMutex::scoped_lock lock(environment_->GetMutex());
+  // Lock the environment mutex if this thread shares the environment.
+  const auto environmentLock = lock(thread);
 
   // Set the robot to the requested state.
-  robot_->SetTransform(raveState_);
-
-  // Set the option to measure distance.
-  environment_->GetCollisionChecker()->SetCollisionOptions(OpenRAVE::CO_Distance);
-
-  // Compute the distance.
-  environment_->CheckCollision(robot_, collisionReport_);
+  thread.robot->SetTransform(raveState);
 
-  // Report the distance.
-  return collisionReport_->minDistance;
+  // Compute the clearance.
+  return computeClearance(thread);
 }
 
 }  // namespace open_rave
@@ -49,6 +49,7 @@
 #include <openrave/environment.h>
 
 #include "pdt/config/directory.h"
+#include "pdt/open_rave/open_rave_environment_cache.h"
 #include "pdt/open_rave/open_rave_knee_goal.h"
 #include "pdt/open_rave/open_rave_se3_validity_checker.h"
 
@@ -62,11 +63,10 @@ OpenRaveSE3::OpenRaveSE3(const std::shared_ptr<ompl::base::SpaceInformation>& sp
                          const std::shared_ptr<const config::Configuration>& config,
                          const std::string& name) :
     OpenRaveBaseContext(spaceInfo, config, name) {
-  // Initialize rave.
-  OpenRAVE::RaveInitialize(true, OpenRAVE::Level_Warn);
-
-  // Create a rave environment.
-  auto environment = OpenRAVE::RaveCreateEnvironment();
+  // Clone the environment. Its file is only loaded for the first context of this scene.
+  auto environment = cloneEnvironmentTemplate(
+      std::string(config::Directory::SOURCE) + "/"s +
+      config_->get<std::string>("context/" + name + "/environment"));
 
   // Create a collision checker.
   OpenRAVE::CollisionCheckerBasePtr collisionChecker = OpenRAVE::RaveCreateCollisionChecker(
@@ -78,11 +78,7 @@ OpenRaveSE3::OpenRaveSE3(const std::shared_ptr<ompl::base::SpaceInformation>& sp
   collisionChecker->SendCommand(output, input);
   environment->SetCollisionChecker(collisionChecker);
 
-  // Load the specified environment.
-  environment->Load(std::string(config::Directory::SOURCE) + "/"s +
-                    config_->get<std::string>("context/" + name + "/environment"));
-
-  // Load the robot.
+  // Get the robot.
   auto robot = environment->GetRobot(config_->get<std::string>("context/" + name + "/robot"));
 
   // In this context, there are no active dimensions.
@@ -98,6 +94,9 @@ OpenRaveSE3::OpenRaveSE3(const std::shared_ptr<ompl::base::SpaceInformation>& sp
   auto validityChecker =
       std::make_shared<OpenRaveSE3ValidityChecker>(spaceInfo_, environment, robot, config_);
 
+  // Approximate its clearance with spheres if requested.
+  configureClearanceApproximation(environment, robot, validityChecker);
+
   OpenRAVE::Transform raveState;
   raveState.identity();
 
@@ -112,10 +111,6 @@ OpenRaveSE3::OpenRaveSE3(const std::shared_ptr<ompl::base::SpaceInformation>& sp
   startGoalPairs_ = makeStartGoalPair();
 }
 
-OpenRaveSE3::~OpenRaveSE3() {
-  OpenRAVE::RaveDestroy();
-}
-
 std::vector<planning_contexts::StartGoalPair> OpenRaveSE3::makeStartGoalPair() const {
   if (config_->contains("context/" + name_ + "/starts")) {
     OMPL_ERROR("OpenRaveSE3 context does not support multiple queries.");
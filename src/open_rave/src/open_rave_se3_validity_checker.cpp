@@ -49,9 +49,7 @@ OpenRaveSE3ValidityChecker::OpenRaveSE3ValidityChecker(
     const ompl::base::SpaceInformationPtr& spaceInfo,
     const OpenRAVE::EnvironmentBasePtr& environment, const OpenRAVE::RobotBasePtr& robot,
     const std::shared_ptr<const config::Configuration>& config) :
-    OpenRaveBaseValidityChecker(spaceInfo, environment, robot, config),
-    raveState_() {
-  raveState_.identity();
+    OpenRaveBaseValidityChecker(spaceInfo, environment, robot, config) {
 }
 
 bool OpenRaveSE3ValidityChecker::isValid(const ompl::base::State* state) const {
@@ -60,50 +58,52 @@ bool OpenRaveSE3ValidityChecker::isValid(const ompl::base::State* state) const {
     return false;
   }
 
+  // Get the environment of this thread.
+  auto& thread = getThreadEnvironment();
+
   // Fill the rave state with the ompl state values.
   auto se3State = state->as<ompl::base::SE3StateSpace::StateType>();
-  raveState_.trans.Set3(se3State->getX(), se3State->getY(), se3State->getZ());
-  raveState_.rot.x = se3State->rotation().x;
-  raveState_.rot.y = se3State->rotation().y;
-  raveState_.rot.z = se3State->rotation().z;
-  raveState_.rot.w = se3State->rotation().w;
+  OpenRAVE::Transform raveState;
+  raveState.trans.Set3(se3State->getX(), se3State->getY(), se3State->getZ());
+  raveState.rot.x = se3State->rotation().x;
+  raveState.rot.y = se3State->rotation().y;
+  raveState.rot.z = se3State->rotation().z;
+  raveState.rot.w = se3State->rotation().w;
 
-  // Lock the environment mutex.
-  OpenRAVE::EnvironmentMutex::scoped_lock lock(environment_->GetMutex());
+  // Lock the environment mutex if this thread shares the environment.
+  const auto environmentLock = lock(thread);
 
   // Set the robot to the requested state.
-  robot_->SetTransform(raveState_);
+  thread.robot->SetTransform(raveState);
 
-  // Set the option to measure distance.
-  environment_->GetCollisionChecker()->SetCollisionOptions(OpenRAVE::CO_Contacts);
+  // Set the option to check for contacts.
+  setCollisionOptions(thread, OpenRAVE::CO_Contacts);
 
   // Check for collisions.
-  return !environment_->CheckCollision(robot_);
+  return !thread.environment->CheckCollision(thread.robot);
 }
 
 double OpenRaveSE3ValidityChecker::clearance(const ompl::base::State* state) const {
+  // Get the environment of this thread.
+  auto& thread = getThreadEnvironment();
+
   // Fill the rave state with the ompl state values.
   auto se3State = state->as<ompl::base::SE3StateSpace::StateType>();
-  raveState_.trans.Set3(se3State->getX(), se3State->getY(), se3State->getZ());
-  raveState_.rot.x = se3State->rotation().x;
-  raveState_.rot.y = se3State->rotation().y;
-  raveState_.rot.z = se3State->rotation().z;
-  raveState_.rot.w = se3State->rotation().w;
+  OpenRAVE::Transform raveState;
+  raveState.trans.Set3(se3State->getX(), se3State->getY(), se3State->getZ());
+  raveState.rot.x = se3State->rotation().x;
+  raveState.rot.y = se3State->rotation().y;
+  raveState.rot.z = se3State->rotation().z;
+  raveState.rot.w = se3State->rotation().w;
 
-  // Lock the environment mutex.
-  OpenRAVE::EnvironmentMutex::scoped_lock lock(environment_->GetMutex());
+  // Lock the environment mutex if this thread shares the environment.
+  const auto environmentLock = lock(thread);
 
   // Set the robot to the requested state.
-  robot_->SetTransform(raveState_);
-
-  // Set the option to measure distance.
-  environment_->GetCollisionChecker()->SetCollisionOptions(OpenRAVE::CO_Distance);
-
-  // Compute the distance.
-  environment_->CheckCollision(robot_, collisionReport_);
+  thread.robot->SetTransform(raveState);
 
-  // Report the distance.
-  return collisionReport_->minDistance;
+  // Compute the clearance.
+  return computeClearance(thread);
 }
 
 }  // namespace open_rave
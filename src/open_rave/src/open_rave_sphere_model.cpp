@@ -0,0 +1,354 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/open_rave/open_rave_sphere_model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace pdt {
+
+namespace open_rave {
+
+namespace {
+
+using Point = std::array<double, 3u>;
+using Triangle = std::array<Point, 3u>;
+
+// The maximum number of spheres in a leaf of the hierarchy.
+constexpr std::size_t LEAF_SIZE = 8u;
+
+// The maximum depth of the hierarchy. Median splits keep it logarithmic in the number of spheres.
+constexpr std::size_t MAX_DEPTH = 64u;
+
+double squaredDistance(const Point& lhs, const Point& rhs) {
+  const auto dx = lhs[0u] - rhs[0u];
+  const auto dy = lhs[1u] - rhs[1u];
+  const auto dz = lhs[2u] - rhs[2u];
+  return dx * dx + dy * dy + dz * dz;
+}
+
+Point transformPoint(const OpenRAVE::Transform& transform, const OpenRAVE::Vector& point) {
+  const auto transformed = transform * point;
+  return {transformed.x, transformed.y, transformed.z};
+}
+
+Point transformPoint(const OpenRAVE::Transform& transform, const Point& point) {
+  return transformPoint(transform, OpenRAVE::Vector(point[0u], point[1u], point[2u]));
+}
+
+Point midpoint(const Point& lhs, const Point& rhs) {
+  return {0.5 * (lhs[0u] + rhs[0u]), 0.5 * (lhs[1u] + rhs[1u]), 0.5 * (lhs[2u] + rhs[2u])};
+}
+
+Point centroid(const Triangle& triangle) {
+  Point centroid{};
+  for (std::size_t i = 0u; i < 3u; ++i) {
+    centroid[i] = (triangle[0u][i] + triangle[1u][i] + triangle[2u][i]) / 3.0;
+  }
+  return centroid;
+}
+
+// Returns the sphere around the centroid of the triangle that contains the triangle.
+OpenRaveSphereModel::Sphere getBoundingSphere(const Triangle& triangle) {
+  OpenRaveSphereModel::Sphere sphere{centroid(triangle), 0.0};
+  for (const auto& vertex : triangle) {
+    sphere.radius = std::max(sphere.radius, squaredDistance(sphere.center, vertex));
+  }
+  sphere.radius = std::sqrt(sphere.radius);
+  return sphere;
+}
+
+// Splits the triangle at the midpoints of its edges until the bounding sphere of every part has at
+// most the given radius.
+void subdivide(const Triangle& triangle, double maxRadius, std::vector<Triangle>* triangles) {
+  if (getBoundingSphere(triangle).radius <= maxRadius) {
+    triangles->push_back(triangle);
+    return;
+  }
+  const auto m01 = midpoint(triangle[0u], triangle[1u]);
+  const auto m12 = midpoint(triangle[1u], triangle[2u]);
+  const auto m20 = midpoint(triangle[2u], triangle[0u]);
+  subdivide({triangle[0u], m01, m20}, maxRadius, triangles);
+  subdivide({m01, triangle[1u], m12}, maxRadius, triangles);
+  subdivide({m20, m12, triangle[2u]}, maxRadius, triangles);
+  subdivide({m01, m12, m20}, maxRadius, triangles);
+}
+
+// Covers the triangles with spheres of at most the given radius. Neighbouring triangles share a
+// sphere if it is small enough, otherwise the triangles are split at their median along the
+// longest extent of their centroids.
+void cluster(std::vector<Triangle>::iterator begin, std::vector<Triangle>::iterator end,
+             double maxRadius, std::vector<OpenRaveSphereModel::Sphere>* spheres) {
+  if (end - begin == 1) {
+    spheres->push_back(getBoundingSphere(*begin));
+    return;
+  }
+
+  // Compute the bounding boxes of the vertices and of the centroids.
+  Point lowerCorner, upperCorner, lowerCentroid, upperCentroid;
+  lowerCorner.fill(std::numeric_limits<double>::infinity());
+  upperCorner.fill(-std::numeric_limits<double>::infinity());
+  lowerCentroid = lowerCorner;
+  upperCentroid = upperCorner;
+  for (auto triangle = begin; triangle != end; ++triangle) {
+    const auto center = centroid(*triangle);
+    for (std::size_t i = 0u; i < 3u; ++i) {
+      lowerCentroid[i] = std::min(lowerCentroid[i], center[i]);
+      upperCentroid[i] = std::max(upperCentroid[i], center[i]);
+      for (const auto& vertex : *triangle) {
+        lowerCorner[i] = std::min(lowerCorner[i], vertex[i]);
+        upperCorner[i] = std::max(upperCorner[i], vertex[i]);
+      }
+    }
+  }
+
+  // Use one sphere around the center of the box if it is small enough.
+  OpenRaveSphereModel::Sphere sphere{midpoint(lowerCorner, upperCorner), 0.0};
+  for (auto triangle = begin; triangle != end; ++triangle) {
+    for (const auto& vertex : *triangle) {
+      sphere.radius = std::max(sphere.radius, squaredDistance(sphere.center, vertex));
+    }
+  }
+  sphere.radius = std::sqrt(sphere.radius);
+  if (sphere.radius <= maxRadius) {
+    spheres->push_back(sphere);
+    return;
+  }
+
+  // Otherwise split the triangles.
+  std::size_t axis = 0u;
+  for (std::size_t i = 1u; i < 3u; ++i) {
+    if (upperCentroid[i] - lowerCentroid[i] > upperCentroid[axis] - lowerCentroid[axis]) {
+      axis = i;
+    }
+  }
+  const auto middle = begin + (end - begin) / 2;
+  std::nth_element(begin, middle, end, [axis](const Triangle& lhs, const Triangle& rhs) {
+    return centroid(lhs)[axis] < centroid(rhs)[axis];
+  });
+  cluster(begin, middle, maxRadius, spheres);
+  cluster(middle, end, maxRadius, spheres);
+}
+
+// Covers the transformed mesh with spheres of at most the given radius.
+void approximate(const OpenRAVE::TriMesh& mesh, const OpenRAVE::Transform& transform,
+                 double maxRadius, std::vector<OpenRaveSphereModel::Sphere>* spheres) {
+  std::vector<Triangle> triangles;
+  for (std::size_t i = 0u; i + 2u < mesh.indices.size(); i += 3u) {
+    const Triangle triangle{
+        transformPoint(transform, mesh.vertices.at(static_cast<std::size_t>(mesh.indices[i]))),
+        transformPoint(transform, mesh.vertices.at(static_cast<std::size_t>(mesh.indices[i + 1u]))),
+        transformPoint(transform,
+                       mesh.vertices.at(static_cast<std::size_t>(mesh.indices[i + 2u])))};
+    subdivide(triangle, maxRadius, &triangles);
+  }
+  if (!triangles.empty()) {
+    cluster(triangles.begin(), triangles.end(), maxRadius, spheres);
+  }
+}
+
+}  // namespace
+
+OpenRaveSphereModel::OpenRaveSphereModel(const OpenRAVE::EnvironmentBasePtr& environment,
+                                         const OpenRAVE::RobotBasePtr& robot,
+                                         double maxSphereRadius) {
+  if (!(maxSphereRadius > 0.0)) {
+    throw std::invalid_argument("The radius of the clearance spheres must be positive.");
+  }
+
+  OpenRAVE::EnvironmentMutex::scoped_lock lock(environment->GetMutex());
+
+  // Approximate the links of the robot in their own frames, such that any configuration can reuse
+  // the spheres.
+  const auto& links = robot->GetLinks();
+  linkSpheres_.resize(links.size());
+  for (const auto& link : links) {
+    approximate(link->GetCollisionData(), OpenRAVE::Transform(), maxSphereRadius,
+                &linkSpheres_.at(static_cast<std::size_t>(link->GetIndex())));
+  }
+
+  // Approximate all other bodies in the world frame.
+  std::vector<OpenRAVE::KinBodyPtr> bodies;
+  environment->GetBodies(bodies);
+  for (const auto& body : bodies) {
+    if (body->GetName() == robot->GetName() || !body->IsEnabled()) {
+      continue;
+    }
+    for (const auto& link : body->GetLinks()) {
+      if (link->IsEnabled()) {
+        approximate(link->GetCollisionData(), link->GetTransform(), maxSphereRadius,
+                    &environmentSpheres_);
+      }
+    }
+  }
+
+  if (!environmentSpheres_.empty()) {
+    nodes_.reserve(2u * environmentSpheres_.size() / LEAF_SIZE + 1u);
+    buildNode(0u, environmentSpheres_.size());
+  }
+}
+
+double OpenRaveSphereModel::clearance(const OpenRAVE::RobotBasePtr& robot,
+                                      double threshold) const {
+  auto clearance = std::numeric_limits<double>::infinity();
+  if (nodes_.empty()) {
+    return clearance;
+  }
+
+  for (const auto& link : robot->GetLinks()) {
+    const auto& spheres = linkSpheres_.at(static_cast<std::size_t>(link->GetIndex()));
+    if (spheres.empty()) {
+      continue;
+    }
+    const auto transform = link->GetTransform();
+    for (const auto& sphere : spheres) {
+      updateClearance({transformPoint(transform, sphere.center), sphere.radius}, &clearance);
+      if (clearance < threshold) {
+        return clearance;
+      }
+    }
+  }
+
+  return clearance;
+}
+
+std::size_t OpenRaveSphereModel::getNumRobotSpheres() const {
+  std::size_t numSpheres = 0u;
+  for (const auto& spheres : linkSpheres_) {
+    numSpheres += spheres.size();
+  }
+  return numSpheres;
+}
+
+std::size_t OpenRaveSphereModel::getNumEnvironmentSpheres() const {
+  return environmentSpheres_.size();
+}
+
+void OpenRaveSphereModel::buildNode(std::size_t begin, std::size_t end) {
+  const auto index = nodes_.size();
+  nodes_.emplace_back();
+
+  Node node;
+  node.begin = begin;
+  node.end = end;
+  node.lowerCorner.fill(std::numeric_limits<double>::infinity());
+  node.upperCorner.fill(-std::numeric_limits<double>::infinity());
+  for (auto i = begin; i < end; ++i) {
+    const auto& sphere = environmentSpheres_[i];
+    for (std::size_t j = 0u; j < 3u; ++j) {
+      node.lowerCorner[j] = std::min(node.lowerCorner[j], sphere.center[j]);
+      node.upperCorner[j] = std::max(node.upperCorner[j], sphere.center[j]);
+    }
+    node.maxRadius = std::max(node.maxRadius, sphere.radius);
+  }
+
+  // Split the spheres at their median along the longest extent of the node. The root is never a
+  // right child, so leaves mark their right child with zero.
+  if (end - begin > LEAF_SIZE) {
+    std::size_t axis = 0u;
+    for (std::size_t i = 1u; i < 3u; ++i) {
+      if (node.upperCorner[i] - node.lowerCorner[i] >
+          node.upperCorner[axis] - node.lowerCorner[axis]) {
+        axis = i;
+      }
+    }
+    const auto middle = begin + (end - begin) / 2u;
+    std::nth_element(environmentSpheres_.begin() + static_cast<std::ptrdiff_t>(begin),
+                     environmentSpheres_.begin() + static_cast<std::ptrdiff_t>(middle),
+                     environmentSpheres_.begin() + static_cast<std::ptrdiff_t>(end),
+                     [axis](const Sphere& lhs, const Sphere& rhs) {
+                       return lhs.center[axis] < rhs.center[axis];
+                     });
+    buildNode(begin, middle);
+    node.right = nodes_.size();
+    buildNode(middle, end);
+  }
+
+  nodes_[index] = node;
+}
+
+void OpenRaveSphereModel::updateClearance(const Sphere& sphere, double* clearance) const {
+  // Returns a lower bound on the distance between the sphere and the spheres of a node.
+  auto getLowerBound = [this, &sphere](std::size_t index) {
+    const auto& node = nodes_[index];
+    double squaredNodeDistance = 0.0;
+    for (std::size_t i = 0u; i < 3u; ++i) {
+      const auto excess = std::max({node.lowerCorner[i] - sphere.center[i], 0.0,
+                                    sphere.center[i] - node.upperCorner[i]});
+      squaredNodeDistance += excess * excess;
+    }
+    return std::sqrt(squaredNodeDistance) - sphere.radius - node.maxRadius;
+  };
+
+  // Search the hierarchy depth first, visiting the closer child first.
+  std::array<std::pair<std::size_t, double>, MAX_DEPTH + 1u> stack;
+  std::size_t stackSize = 0u;
+  stack[stackSize++] = {0u, getLowerBound(0u)};
+  while (stackSize > 0u) {
+    const auto [index, lowerBound] = stack[--stackSize];
+    if (lowerBound >= *clearance) {
+      continue;
+    }
+
+    const auto& node = nodes_[index];
+    if (node.right == 0u) {
+      for (auto i = node.begin; i < node.end; ++i) {
+        const auto& other = environmentSpheres_[i];
+        *clearance = std::min(*clearance, std::sqrt(squaredDistance(sphere.center, other.center)) -
+                                              sphere.radius - other.radius);
+      }
+      continue;
+    }
+
+    const auto leftBound = getLowerBound(index + 1u);
+    const auto rightBound = getLowerBound(node.right);
+    if (leftBound < rightBound) {
+      stack[stackSize++] = {node.right, rightBound};
+      stack[stackSize++] = {index + 1u, leftBound};
+    } else {
+      stack[stackSize++] = {index + 1u, leftBound};
+      stack[stackSize++] = {node.right, rightBound};
+    }
+  }
+}
+
+}  // namespace open_rave
+
+}  // namespace pdt
@@ -0,0 +1,177 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ompl/base/ScopedState.h>
+#include <ompl/base/SpaceInformation.h>
+
+#include "pdt/config/configuration.h"
+#include "pdt/factories/context_factory.h"
+#include "pdt/planning_contexts/all_contexts.h"
+#include "pdt/time/time.h"
+
+using namespace std::string_literals;
+
+namespace {
+
+// The results of checking all states with a number of threads.
+struct ScalingTiming {
+  double validityDuration{0.0};
+  double clearanceDuration{0.0};
+  std::size_t numInvalid{0u};
+};
+
+// Checks the validity and the clearance of all states, split evenly among the threads. Each thread
+// checks one state before the timing starts, such that the environment clones are not timed.
+ScalingTiming timeThreads(const ompl::base::SpaceInformationPtr& spaceInfo,
+                          const std::vector<ompl::base::ScopedState<>>& states,
+                          std::size_t numThreads) {
+  std::atomic<std::size_t> numReadyThreads{0u};
+  std::atomic<std::size_t> numInvalid{0u};
+  std::atomic<bool> startValidity{false};
+  std::atomic<bool> startClearance{false};
+  std::atomic<std::size_t> numValidityDone{0u};
+
+  auto check = [&](std::size_t thread) {
+    const auto begin = thread * states.size() / numThreads;
+    const auto end = (thread + 1u) * states.size() / numThreads;
+    spaceInfo->isValid(states.at(begin).get());
+    spaceInfo->getStateValidityChecker()->clearance(states.at(begin).get());
+    ++numReadyThreads;
+    while (!startValidity) {
+      std::this_thread::yield();
+    }
+    std::size_t numThreadInvalid = 0u;
+    for (auto i = begin; i < end; ++i) {
+      if (!spaceInfo->isValid(states[i].get())) {
+        ++numThreadInvalid;
+      }
+    }
+    numInvalid += numThreadInvalid;
+    ++numValidityDone;
+    while (!startClearance) {
+      std::this_thread::yield();
+    }
+    for (auto i = begin; i < end; ++i) {
+      spaceInfo->getStateValidityChecker()->clearance(states[i].get());
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  for (std::size_t thread = 0u; thread < numThreads; ++thread) {
+    threads.emplace_back(check, thread);
+  }
+  while (numReadyThreads < numThreads) {
+    std::this_thread::yield();
+  }
+
+  ScalingTiming timing;
+  auto start = pdt::time::Clock::now();
+  startValidity = true;
+  while (numValidityDone < numThreads) {
+    std::this_thread::yield();
+  }
+  timing.validityDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+
+  start = pdt::time::Clock::now();
+  startClearance = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  timing.clearanceDuration = pdt::time::seconds(pdt::time::Clock::now() - start);
+  timing.numInvalid = numInvalid;
+  return timing;
+}
+
+}  // namespace
+
+int main(const int argc, const char** argv) {
+  // Read the config files.
+  auto config = std::make_shared<pdt::config::Configuration>(argc, argv);
+  config->registerAsExperiment();
+
+  const auto threadCounts = config->get<std::vector<std::size_t>>("experiment/threadCounts");
+  const auto numStates = config->get<std::size_t>("experiment/numStates");
+
+  std::cout << "seed: " << config->get<std::size_t>("experiment/seed") << std::endl;
+
+  // Create the context.
+  pdt::factories::ContextFactory contextFactory(config);
+  auto context = contextFactory.create(config->get<std::string>("experiment/context"));
+  auto spaceInfo = context->getSpaceInformation();
+
+  // Sample the states that all thread counts check.
+  std::vector<ompl::base::ScopedState<>> states(numStates, ompl::base::ScopedState<>(spaceInfo));
+  for (auto& state : states) {
+    state.random();
+  }
+
+  std::cout << "Checking " << numStates << " states of context '" << context->getName() << "'.\n";
+  double singleThreadValidityDuration = 0.0;
+  double singleThreadClearanceDuration = 0.0;
+  for (const auto numThreads : threadCounts) {
+    if (numThreads == 0u || numThreads > numStates) {
+      throw std::invalid_argument("Thread counts must be between one and the number of states.");
+    }
+    const auto timing = timeThreads(spaceInfo, states, numThreads);
+    if (numThreads == 1u) {
+      singleThreadValidityDuration = timing.validityDuration;
+      singleThreadClearanceDuration = timing.clearanceDuration;
+    }
+
+    std::cout << "  Threads: " << numThreads << std::fixed
+              << "\tValidity [states/s]: " << numStates / timing.validityDuration
+              << "\tClearance [states/s]: " << numStates / timing.clearanceDuration;
+    if (singleThreadValidityDuration > 0.0) {
+      std::cout << "\tSpeedup: " << singleThreadValidityDuration / timing.validityDuration
+                << " / " << singleThreadClearanceDuration / timing.clearanceDuration;
+    }
+    std::cout << "\tInvalid: " << timing.numInvalid << " / " << numStates << "\n";
+  }
+
+  config->dumpAccessed();
+
+  return 0;
+}
@@ -4,8 +4,11 @@
 #include "pdt/planning_contexts/flanking_gap.h"
 #include "pdt/planning_contexts/four_rooms.h"
 #include "pdt/planning_contexts/goal_enclosure.h"
+#include "pdt/planning_contexts/mesh_r3.h"
+#include "pdt/planning_contexts/mesh_se3.h"
 #include "pdt/planning_contexts/narrow_passage.h"
 #include "pdt/planning_contexts/obstacle_free.h"
+#include "pdt/planning_contexts/occupancy_grid.h"
 #include "pdt/planning_contexts/random_rectangles.h"
 #include "pdt/planning_contexts/random_rectangles_multi_start_goal.h"
 #include "pdt/planning_contexts/real_vector_geometric_context.h"
@@ -13,4 +16,5 @@
 #include "pdt/planning_contexts/repeating_rectangles.h"
 // #include "pdt/planning_contexts/spiral.h"
 #include "pdt/planning_contexts/start_enclosure.h"
+#include "pdt/planning_contexts/voxel_grid.h"
 #include "pdt/planning_contexts/wall_gap.h"
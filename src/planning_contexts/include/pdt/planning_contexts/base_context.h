@@ -52,6 +52,7 @@
 #include "pdt/obstacles/base_obstacle.h"
 #include "pdt/planning_contexts/context_visitor.h"
 #include "pdt/time/time.h"
+#include "pdt/utilities/call_counter.h"
 
 namespace pdt {
 
@@ -117,6 +118,16 @@ class BaseContext {
    * queries.*/
   void regenerateQueries();
 
+  /** \brief Replaces the start/goal pairs, e.g., with the ones of a run that is resumed. */
+  void setStartGoalPairs(const std::vector<StartGoalPair>& startGoalPairs);
+
+  /** \brief Wraps the validity checker, motion validator, and objective of this context such that
+   * calls to isValid, clearance, checkMotion, and motionCost are counted and timed. */
+  void instrument();
+
+  /** \brief Returns the call counters of this context, or nullptr if it is not instrumented. */
+  std::shared_ptr<utilities::CallCounters> getCallCounters() const;
+
  protected:
   /** \brief Loads the specified or randomly generates the start/goal pairs (depending on the config
    * file). */
@@ -155,6 +166,9 @@ class BaseContext {
 
   /** \brief The configuration. */
   const std::shared_ptr<const config::Configuration> config_;
+
+  /** \brief The call counters, if this context is instrumented. */
+  std::shared_ptr<utilities::CallCounters> callCounters_{};
 };
 
 }  // namespace planning_contexts
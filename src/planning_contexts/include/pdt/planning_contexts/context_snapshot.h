@@ -0,0 +1,160 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <experimental/filesystem>
+
+#include "pdt/config/configuration.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+class RealVectorGeometricContext;
+
+/** \brief A context snapshot stores everything that is randomly generated when a context with
+ * hyperrectangular obstacles is created: A header with the hash of the context's configuration and
+ * the seed, followed by the bounds, the obstacles and antiobstacles (anchor and widths), one entry
+ * per query, and the start and goal states of all queries. All offsets are in bytes from the
+ * beginning of the file and all arrays are aligned to eight bytes, such that the file can be memory
+ * mapped and read in place. */
+namespace context_snapshot {
+
+/** \brief The magic bytes at the beginning of every context snapshot. */
+constexpr char MAGIC[8] = {'P', 'D', 'T', 'C', 'T', 'X', '\0', '\0'};
+
+/** \brief The version of the format. It is also bumped when the generation of contexts changes,
+ * such that snapshots always hold what a context would generate. */
+constexpr std::uint64_t VERSION = 2u;
+
+/** \brief The header at the beginning of the file. */
+struct Header {
+  char magic[8];
+  std::uint64_t version;
+  std::uint64_t configHash;
+  std::uint64_t seed;
+  std::uint64_t dimension;
+  std::uint64_t numObstacles;
+  std::uint64_t numAntiObstacles;
+  std::uint64_t numQueries;
+  std::uint64_t boundsOffset;
+  std::uint64_t obstaclesOffset;
+  std::uint64_t antiObstaclesOffset;
+  std::uint64_t queriesOffset;
+};
+
+/** \brief An entry per query. The goal states are empty if the goal is not made of states. */
+struct QueryEntry {
+  std::uint64_t numStarts;
+  std::uint64_t numGoals;
+  std::uint64_t statesOffset;
+};
+
+/** \brief Computes the hash that ties a snapshot to the configuration of its context and the seed.
+ * The hash is stable across processes and builds. */
+std::uint64_t computeConfigHash(const config::Configuration& config,
+                                const std::string& contextName);
+
+/** \brief Writes a snapshot of the context. The file is replaced atomically, such that processes
+ * that read it concurrently see either the old or the new snapshot. Throws if the context has
+ * obstacles that are not hyperrectangles. */
+void write(const std::experimental::filesystem::path& path,
+           const RealVectorGeometricContext& context, std::uint64_t configHash);
+
+/** \brief A read-only, memory mapped view of a context snapshot. */
+class Reader {
+ public:
+  Reader(const std::experimental::filesystem::path& path);
+  ~Reader();
+
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+
+  /** \brief The hash of the configuration the snapshot was created with. */
+  std::uint64_t getConfigHash() const;
+
+  /** \brief The seed the snapshot was created with. */
+  std::uint64_t getSeed() const;
+
+  /** \brief The dimension of the states. */
+  std::size_t getDimension() const;
+
+  /** \brief The bounds of the state space. */
+  const double* getLowerBounds() const;
+  const double* getUpperBounds() const;
+
+  /** \brief Access to the i-th obstacle or antiobstacle. The pointers are valid for the lifetime of
+   * the reader. */
+  std::size_t getNumObstacles() const;
+  const double* getObstacleAnchor(std::size_t i) const;
+  const double* getObstacleWidths(std::size_t i) const;
+  std::size_t getNumAntiObstacles() const;
+  const double* getAntiObstacleAnchor(std::size_t i) const;
+  const double* getAntiObstacleWidths(std::size_t i) const;
+
+  /** \brief Access to the start and goal states of the q-th query. The pointers are valid for the
+   * lifetime of the reader. */
+  std::size_t getNumQueries() const;
+  std::size_t getNumStarts(std::size_t q) const;
+  const double* getStart(std::size_t q, std::size_t i) const;
+  std::size_t getNumGoals(std::size_t q) const;
+  const double* getGoal(std::size_t q, std::size_t i) const;
+
+ private:
+  const QueryEntry& getQuery(std::size_t q) const;
+
+  /** \brief The mapped file. */
+  const char* data_{nullptr};
+  std::size_t size_{0u};
+
+  /** \brief The header and the arrays within the mapped file. */
+  const Header* header_{nullptr};
+  const double* bounds_{nullptr};
+  const double* obstacles_{nullptr};
+  const double* antiObstacles_{nullptr};
+  const QueryEntry* queries_{nullptr};
+};
+
+}  // namespace context_snapshot
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
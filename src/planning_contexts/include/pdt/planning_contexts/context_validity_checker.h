@@ -45,14 +45,17 @@
 #include <ompl/datastructures/NearestNeighborsGNAT.h>
 
 #include "pdt/obstacles/base_obstacle.h"
+#include "pdt/obstacles/distance_field.h"
 #include "pdt/obstacles/hyperrectangle.h"
+#include "pdt/obstacles/hyperrectangle_set.h"
 #include "pdt/obstacles/obstacle_visitor.h"
+#include "pdt/planning_contexts/batch_validity_checker.h"
 
 namespace pdt {
 
 namespace planning_contexts {
 
-class ContextValidityChecker : public ompl::base::StateValidityChecker {
+class ContextValidityChecker : public BatchValidityChecker {
  public:
   ContextValidityChecker(const ompl::base::SpaceInformationPtr& spaceInfo);
   virtual ~ContextValidityChecker() = default;
@@ -60,25 +63,70 @@ class ContextValidityChecker : public ompl::base::StateValidityChecker {
   // Check if a state is valid.
   virtual bool isValid(const ompl::base::State* state) const override;
 
-  // Return the minimum distance of a point to any obstacle.
+  // Check if all states of a batch are valid. The bounds of all states are checked before any
+  // state is checked for collisions, and the states are checked for collisions together.
+  virtual bool isValid(const ompl::base::State* const* states,
+                       std::size_t numStates) const override;
+
+  // Return the minimum distance of a point to any obstacle. This is looked up in the distance
+  // field if one is set and covers the state.
   virtual double clearance(const ompl::base::State* state) const override;
 
+  // Return the exact minimum distance of a point to any obstacle.
+  double computeExactClearance(const ompl::base::State* state) const;
+
+  // Set the distance field that approximates the clearance.
+  void setDistanceField(const std::shared_ptr<const obstacles::DistanceField>& field);
+
+  // Get the distance field that approximates the clearance, which is null if there is none.
+  std::shared_ptr<const obstacles::DistanceField> getDistanceField() const;
+
   // Add obstacles.
   virtual void addObstacle(const std::shared_ptr<obstacles::BaseObstacle>& obstacle);
   virtual void addObstacles(const std::vector<std::shared_ptr<obstacles::BaseObstacle>>& obstacles);
 
+  // Add hyperrectangular obstacles that are stored compactly, without creating obstacle objects.
+  // Only real vector state spaces are supported.
+  virtual void addHyperrectangles(const obstacles::HyperrectangleSet& hyperrectangles);
+
   // Add antiobstacles.
   virtual void addAntiObstacle(const std::shared_ptr<obstacles::BaseAntiObstacle>& anti);
   virtual void addAntiObstacles(
       const std::vector<std::shared_ptr<obstacles::BaseAntiObstacle>>& antis);
 
-  // Make obstacles accessible.
+  // Make obstacles accessible. The compactly stored hyperrectangles are not among them.
   virtual std::vector<std::shared_ptr<obstacles::BaseObstacle>> getObstacles() const;
   virtual std::vector<std::shared_ptr<obstacles::BaseAntiObstacle>> getAntiObstacles() const;
 
  protected:
+  // Returns whether a state that satisfies the bounds is inside an antiobstacle or outside all
+  // obstacles.
+  virtual bool isCollisionFree(const ompl::base::State* state) const;
+
+  // Returns whether all states of a batch that satisfy the bounds are inside an antiobstacle or
+  // outside all obstacles. Without antiobstacles, the states are tested against the compiled
+  // hyperrectangles all at once.
+  virtual bool isCollisionFree(const ompl::base::State* const* states, std::size_t numStates) const;
+
   std::vector<std::shared_ptr<obstacles::BaseObstacle>> obstacles_{};
   std::vector<std::shared_ptr<obstacles::BaseAntiObstacle>> antiObstacles_{};
+
+  // The hyperrectangles that were added without obstacle objects.
+  obstacles::HyperrectangleSet addedHyperrectangles_;
+
+ private:
+  // Adds an obstacle to the compiled hyperrectangles if it is one, and to the other obstacles
+  // otherwise. Obstacles must not be moved after they are added.
+  void compileObstacle(const std::shared_ptr<obstacles::BaseObstacle>& obstacle);
+
+  // The distance field that approximates the clearance.
+  std::shared_ptr<const obstacles::DistanceField> distanceField_{};
+
+  // The hyperrectangular obstacles of real vector state spaces, compiled for fast checks.
+  obstacles::HyperrectangleSet hyperrectangles_;
+
+  // All obstacles that are not in the compiled hyperrectangles.
+  std::vector<std::shared_ptr<obstacles::BaseObstacle>> otherObstacles_{};
 };
 
 }  // namespace planning_contexts
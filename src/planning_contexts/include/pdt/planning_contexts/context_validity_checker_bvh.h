@@ -0,0 +1,110 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <ompl/base/SpaceInformation.h>
+
+#include "pdt/obstacles/base_obstacle.h"
+#include "pdt/obstacles/bounding_volume_hierarchy.h"
+#include "pdt/obstacles/hyperrectangle_set.h"
+#include "pdt/planning_contexts/context_validity_checker.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+// A validity checker that finds the obstacles and antiobstacles that might contain a state with
+// bounding volume hierarchies of their axis-aligned bounding boxes. The boxes of hyperrectangles
+// are exact, all other shapes are bounded by the box around their circumsphere. Adding obstacles
+// rebuilds the hierarchy, so obstacles should be added in bulk. Only real vector state spaces are
+// supported.
+class ContextValidityCheckerBVH : public ContextValidityChecker {
+ public:
+  ContextValidityCheckerBVH(const ompl::base::SpaceInformationPtr& spaceInfo);
+  ~ContextValidityCheckerBVH() = default;
+
+  // Add obstacles.
+  virtual void addObstacle(const std::shared_ptr<obstacles::BaseObstacle>& obstacle) override;
+  virtual void addObstacles(
+      const std::vector<std::shared_ptr<obstacles::BaseObstacle>>& obstacles) override;
+
+  // Add hyperrectangular obstacles that are stored compactly. Their boxes follow the ones of the
+  // obstacle objects in the hierarchy.
+  virtual void addHyperrectangles(const obstacles::HyperrectangleSet& hyperrectangles) override;
+
+  // Add antiobstacles.
+  virtual void addAntiObstacle(const std::shared_ptr<obstacles::BaseAntiObstacle>& anti) override;
+  virtual void addAntiObstacles(
+      const std::vector<std::shared_ptr<obstacles::BaseAntiObstacle>>& antis) override;
+
+  // Returns whether the straight segment between two states intersects the bounding box of any
+  // obstacle. If it does not, the segment is not in collision.
+  bool mayCollide(const ompl::base::State* state1, const ompl::base::State* state2) const;
+
+ protected:
+  // Check if a state that satisfies the bounds is inside an antiobstacle or outside all obstacles.
+  virtual bool isCollisionFree(const ompl::base::State* state) const override;
+
+  // Check the states of a batch one by one.
+  virtual bool isCollisionFree(const ompl::base::State* const* states,
+                               std::size_t numStates) const override;
+
+ private:
+  // Rebuilds a hierarchy from the bounding boxes of the given shapes, followed by the boxes of the
+  // given compactly stored hyperrectangles, and records which boxes are exact.
+  template <typename Shape>
+  void build(const std::vector<std::shared_ptr<Shape>>& shapes,
+             const obstacles::HyperrectangleSet* hyperrectangles,
+             obstacles::BoundingVolumeHierarchy* hierarchy, std::vector<bool>* isExact) const;
+
+  // The hierarchies of obstacles and antiobstacles.
+  obstacles::BoundingVolumeHierarchy obstacleHierarchy_;
+  obstacles::BoundingVolumeHierarchy antiObstacleHierarchy_;
+
+  // Whether the bounding box of an obstacle or antiobstacle is the shape itself. The boxes of the
+  // compactly stored hyperrectangles are not included and always exact.
+  std::vector<bool> isExactObstacle_{};
+  std::vector<bool> isExactAntiObstacle_{};
+};
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
@@ -55,9 +55,6 @@ class ContextValidityCheckerGNAT : public ContextValidityChecker {
   ContextValidityCheckerGNAT(const ompl::base::SpaceInformationPtr& spaceInfo);
   ~ContextValidityCheckerGNAT() = default;
 
-  // Check if a state is valid.
-  virtual bool isValid(const ompl::base::State* state) const override;
-
   // Add obstacles.
   virtual void addObstacle(const std::shared_ptr<obstacles::BaseObstacle>& obstacle) override;
   virtual void addObstacles(
@@ -68,6 +65,14 @@ class ContextValidityCheckerGNAT : public ContextValidityChecker {
   virtual void addAntiObstacles(
       const std::vector<std::shared_ptr<obstacles::BaseAntiObstacle>>& antis) override;
 
+ protected:
+  // Check if a state that satisfies the bounds is inside an antiobstacle or outside all obstacles.
+  virtual bool isCollisionFree(const ompl::base::State* state) const override;
+
+  // Check the states of a batch one by one.
+  virtual bool isCollisionFree(const ompl::base::State* const* states,
+                               std::size_t numStates) const override;
+
  private:
   double maxObstacleRadius_{0.0};
   double maxAntiObstacleRadius_{0.0};
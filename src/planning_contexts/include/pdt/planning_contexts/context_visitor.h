@@ -48,8 +48,11 @@ class DoubleEnclosure;
 class FlankingGap;
 class FourRooms;
 class GoalEnclosure;
+class MeshR3;
+class MeshSE3;
 class NarrowPassage;
 class ObstacleFree;
+class OccupancyGrid;
 class OpenRaveManipulator;
 class OpenRaveSE3;
 class RandomRectangles;
@@ -58,6 +61,7 @@ class ReedsSheppRandomRectangles;
 class RepeatingRectangles;
 class Spiral;
 class StartEnclosure;
+class VoxelGrid;
 class WallGap;
 
 class ContextVisitor {
@@ -72,14 +76,18 @@ class ContextVisitor {
   virtual void visit(const FlankingGap &context) const = 0;
   virtual void visit(const FourRooms &context) const = 0;
   virtual void visit(const GoalEnclosure &context) const = 0;
+  virtual void visit(const MeshR3 &context) const = 0;
+  virtual void visit(const MeshSE3 &context) const = 0;
   virtual void visit(const NarrowPassage &context) const = 0;
   virtual void visit(const ObstacleFree &context) const = 0;
+  virtual void visit(const OccupancyGrid &context) const = 0;
   virtual void visit(const RandomRectangles &context) const = 0;
   virtual void visit(const RandomRectanglesMultiStartGoal &context) const = 0;
   virtual void visit(const ReedsSheppRandomRectangles &context) const = 0;
   virtual void visit(const RepeatingRectangles &context) const = 0;
   // virtual void visit(const Spiral &context) const = 0;
   virtual void visit(const StartEnclosure &context) const = 0;
+  virtual void visit(const VoxelGrid &context) const = 0;
   virtual void visit(const WallGap &context) const = 0;
 
   // This is only needed until all other contexts are implemented.
@@ -0,0 +1,81 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <memory>
+
+#include <ompl/base/SpaceInformation.h>
+
+#include "pdt/planning_contexts/batch_validity_checker.h"
+#include "pdt/utilities/call_counter.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+// A validity checker that forwards all calls to another validity checker, while counting and
+// timing the calls to isValid and clearance. A batch that is forwarded to a batch validity checker
+// counts as a single call, as the checker may stop before it checks all states of the batch.
+class CountingValidityChecker : public BatchValidityChecker {
+ public:
+  CountingValidityChecker(const ompl::base::SpaceInformationPtr& spaceInfo,
+                          const ompl::base::StateValidityCheckerPtr& checker,
+                          const std::shared_ptr<utilities::CallCounters>& counters);
+  virtual ~CountingValidityChecker() = default;
+
+  // Check if a state is valid.
+  virtual bool isValid(const ompl::base::State* state) const override;
+
+  // Check if all states of a batch are valid.
+  virtual bool isValid(const ompl::base::State* const* states,
+                       std::size_t numStates) const override;
+
+  // Return the minimum distance of a point to any obstacle.
+  virtual double clearance(const ompl::base::State* state) const override;
+
+  // Returns the wrapped validity checker.
+  ompl::base::StateValidityCheckerPtr getValidityChecker() const;
+
+ private:
+  const ompl::base::StateValidityCheckerPtr checker_;
+  const std::shared_ptr<utilities::CallCounters> counters_;
+};
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
@@ -0,0 +1,101 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <ompl/base/MotionValidator.h>
+#include <ompl/base/SpaceInformation.h>
+
+#include "pdt/obstacles/base_obstacle.h"
+#include "pdt/obstacles/bounding_volume_hierarchy.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+// A motion validator that checks straight motions in real vector spaces exactly against
+// hyperrectangular obstacles and antiobstacles. A motion is valid if it stays within the bounds of
+// the space and every part of it that is inside an obstacle is also inside an antiobstacle. This
+// is the same notion of validity as the one of the ContextValidityChecker, applied to every state
+// on the motion instead of to states at the collision checking resolution.
+class HyperrectangleMotionValidator : public ompl::base::MotionValidator {
+ public:
+  HyperrectangleMotionValidator(
+      const ompl::base::SpaceInformationPtr& spaceInfo,
+      const std::vector<std::shared_ptr<obstacles::BaseObstacle>>& obstacles,
+      const std::vector<std::shared_ptr<obstacles::BaseAntiObstacle>>& antiObstacles);
+  virtual ~HyperrectangleMotionValidator() = default;
+
+  // Check if the motion between two states is valid.
+  bool checkMotion(const ompl::base::State* state1,
+                   const ompl::base::State* state2) const override;
+
+  // Check if the motion between two states is valid and report the last valid state.
+  bool checkMotion(const ompl::base::State* state1, const ompl::base::State* state2,
+                   std::pair<ompl::base::State*, double>& lastValid) const override;
+
+ private:
+  // Returns the smallest fraction of the motion at which it is invalid, or infinity if it is
+  // valid. If firstOnly is true, this returns as soon as any invalid fraction is found.
+  double computeInvalidFraction(const double* from, const double* to, bool firstOnly) const;
+
+  // Computes the fractions at which the motion enters and exits the given box. Returns false if
+  // it does not intersect the box.
+  bool clip(const std::vector<double>& bounds, std::size_t index, const double* from,
+            const double* to, double* entry, double* exit) const;
+
+  // The dimension of the state space.
+  const std::size_t dimension_;
+
+  // The bounds of the state space, including the tolerance of satisfiesBounds, as [lower, upper].
+  std::vector<double> spaceBounds_{};
+
+  // The bounds of the obstacles and antiobstacles as [lower, upper] per box, and their
+  // hierarchies.
+  std::vector<double> obstacleBounds_{};
+  std::vector<double> antiObstacleBounds_{};
+  obstacles::BoundingVolumeHierarchy obstacleHierarchy_;
+  obstacles::BoundingVolumeHierarchy antiObstacleHierarchy_;
+};
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
@@ -0,0 +1,100 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ompl/base/Goal.h>
+#include <ompl/base/SpaceInformation.h>
+
+#include "pdt/config/configuration.h"
+#include "pdt/obstacles/triangle_mesh_hierarchy.h"
+#include "pdt/planning_contexts/base_context.h"
+#include "pdt/planning_contexts/context_visitor.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+/** \brief An experiment in which a rigid robot mesh is moved in SE(3) among the triangles of an
+ * environment mesh. Both meshes are loaded from OBJ or STL files. */
+class MeshSE3 : public BaseContext {
+ public:
+  MeshSE3(const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
+          const std::shared_ptr<const config::Configuration>& config, const std::string& name);
+  virtual ~MeshSE3() = default;
+
+  /** \brief Accepts a context visitor. */
+  virtual void accept(const ContextVisitor& visitor) const override;
+
+  /** \brief Mesh contexts have no primitive obstacles. */
+  virtual std::vector<std::shared_ptr<obstacles::BaseObstacle>> getObstacles() const override;
+
+  /** \brief Mesh contexts have no primitive antiobstacles. */
+  virtual std::vector<std::shared_ptr<obstacles::BaseAntiObstacle>> getAntiObstacles()
+      const override;
+
+  /** \brief Create a new goal. */
+  virtual std::shared_ptr<ompl::base::Goal> createGoal() const override;
+
+  /** \brief Get the bounds of the translational part of the state space. */
+  const ompl::base::RealVectorBounds& getBoundaries() const;
+
+  /** \brief Get the hierarchy of the environment mesh. */
+  std::shared_ptr<const obstacles::TriangleMeshHierarchy> getEnvironment() const;
+
+  /** \brief Get the hierarchy of the robot mesh. */
+  std::shared_ptr<const obstacles::TriangleMeshHierarchy> getRobot() const;
+
+ private:
+  /** \brief Return a start/goal pair. */
+  virtual std::vector<StartGoalPair> makeStartGoalPair() const override;
+
+  /** \brief The bounds of the translational part of the state space. */
+  ompl::base::RealVectorBounds bounds_;
+
+  /** \brief The hierarchies of the environment and the robot. */
+  std::shared_ptr<const obstacles::TriangleMeshHierarchy> environment_{};
+  std::shared_ptr<const obstacles::TriangleMeshHierarchy> robot_{};
+};
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
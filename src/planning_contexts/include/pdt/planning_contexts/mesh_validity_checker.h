@@ -0,0 +1,87 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <memory>
+
+#include <ompl/base/SpaceInformation.h>
+
+#include "pdt/obstacles/triangle_mesh_hierarchy.h"
+#include "pdt/planning_contexts/batch_validity_checker.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+// A validity checker for a rigid robot mesh among the triangles of an environment mesh. States of
+// three dimensional real vector spaces translate the robot, and states of SE(3) spaces (including
+// SE3WAxisAngleBoundStateSpace) translate and rotate it. A state is valid if it is within the
+// bounds and the surfaces of the robot and the environment do not intersect. The checker holds no
+// mutable state, so it can be used from several threads at once.
+class MeshValidityChecker : public BatchValidityChecker {
+ public:
+  MeshValidityChecker(const ompl::base::SpaceInformationPtr& spaceInfo,
+                      const std::shared_ptr<const obstacles::TriangleMeshHierarchy>& environment,
+                      const std::shared_ptr<const obstacles::TriangleMeshHierarchy>& robot);
+  virtual ~MeshValidityChecker() = default;
+
+  // Check if a state is valid.
+  bool isValid(const ompl::base::State* state) const override;
+
+  // Return the distance between the robot and the environment.
+  double clearance(const ompl::base::State* state) const override;
+
+  // Get the pose of the robot in a state.
+  obstacles::RigidTransform getPose(const ompl::base::State* state) const;
+
+  // Get the hierarchies of the environment and the robot.
+  std::shared_ptr<const obstacles::TriangleMeshHierarchy> getEnvironment() const;
+  std::shared_ptr<const obstacles::TriangleMeshHierarchy> getRobot() const;
+
+ private:
+  // The hierarchies of the environment and the robot.
+  const std::shared_ptr<const obstacles::TriangleMeshHierarchy> environment_;
+  const std::shared_ptr<const obstacles::TriangleMeshHierarchy> robot_;
+
+  // Whether the state space is SE(3).
+  bool isSE3_{false};
+};
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
@@ -0,0 +1,81 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <ompl/base/SpaceInformation.h>
+
+#include "pdt/config/configuration.h"
+#include "pdt/obstacles/binary_map.h"
+#include "pdt/planning_contexts/context_visitor.h"
+#include "pdt/planning_contexts/real_vector_geometric_context.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+/** \brief A two dimensional experiment whose obstacles are the occupied cells of a map that is
+ * loaded from a CSV file, a PGM image, or a raw file with one byte per cell. The cells evenly
+ * divide the boundaries of the context. Motions are validated exactly by visiting the cells they
+ * cross. */
+class OccupancyGrid : public RealVectorGeometricContext {
+ public:
+  OccupancyGrid(const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
+                const std::shared_ptr<const config::Configuration>& config,
+                const std::string& name);
+  virtual ~OccupancyGrid() = default;
+
+  /** \brief Accepts a context visitor. */
+  virtual void accept(const ContextVisitor& visitor) const override;
+
+  /** \brief Validate motions exactly against the cells of the map, which is the default. */
+  void useExactMotionValidation() override;
+
+  /** \brief Get the map. */
+  std::shared_ptr<const obstacles::BinaryMap> getMap() const;
+
+ private:
+  /** \brief The map. */
+  std::shared_ptr<obstacles::BinaryMap> map_{};
+};
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
@@ -0,0 +1,81 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include <ompl/base/MotionValidator.h>
+#include <ompl/base/SpaceInformation.h>
+
+#include "pdt/planning_contexts/occupancy_grid_validity_checker.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+// A motion validator that checks straight motions exactly against the cells of an occupancy grid.
+// A motion is valid if it stays within the bounds of the space and does not cross any occupied
+// cell, which is checked by visiting exactly the cells the motion crosses.
+class OccupancyGridMotionValidator : public ompl::base::MotionValidator {
+ public:
+  OccupancyGridMotionValidator(const ompl::base::SpaceInformationPtr& spaceInfo,
+                               const std::shared_ptr<const OccupancyGridValidityChecker>& checker);
+  virtual ~OccupancyGridMotionValidator() = default;
+
+  // Check if the motion between two states is valid.
+  bool checkMotion(const ompl::base::State* state1,
+                   const ompl::base::State* state2) const override;
+
+  // Check if the motion between two states is valid and report the last valid state.
+  bool checkMotion(const ompl::base::State* state1, const ompl::base::State* state2,
+                   std::pair<ompl::base::State*, double>& lastValid) const override;
+
+ private:
+  // Returns the smallest fraction of the motion at which it is invalid, or infinity if it is
+  // valid.
+  double computeInvalidFraction(const ompl::base::State* state1,
+                                const ompl::base::State* state2) const;
+
+  // The validity checker that knows the map and its placement in the space.
+  const std::shared_ptr<const OccupancyGridValidityChecker> checker_;
+};
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
@@ -0,0 +1,81 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include <ompl/base/SpaceInformation.h>
+
+#include "pdt/obstacles/binary_map.h"
+#include "pdt/planning_contexts/batch_validity_checker.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+// A validity checker for two dimensional real vector spaces whose obstacles are the occupied cells
+// of a binary map. The cells evenly divide the bounds of the space, the first row spans the lowest
+// y values and the first column the lowest x values.
+class OccupancyGridValidityChecker : public BatchValidityChecker {
+ public:
+  OccupancyGridValidityChecker(const ompl::base::SpaceInformationPtr& spaceInfo,
+                               const std::shared_ptr<const obstacles::BinaryMap>& map);
+  virtual ~OccupancyGridValidityChecker() = default;
+
+  // Check if a state is within the bounds and not in an occupied cell.
+  bool isValid(const ompl::base::State* state) const override;
+
+  // Get the map.
+  std::shared_ptr<const obstacles::BinaryMap> getMap() const;
+
+  // Get the coordinates of a state in units of cells.
+  std::array<double, 2u> getCellCoordinates(const ompl::base::State* state) const;
+
+ private:
+  // The map.
+  const std::shared_ptr<const obstacles::BinaryMap> map_;
+
+  // The lower bounds of the space and the number of cells per unit length.
+  std::array<double, 2u> origin_{};
+  std::array<double, 2u> cellsPerUnit_{};
+};
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
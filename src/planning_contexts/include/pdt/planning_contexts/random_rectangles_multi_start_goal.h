@@ -47,6 +47,7 @@
 #include <ompl/util/RandomNumbers.h>
 
 #include "pdt/config/configuration.h"
+#include "pdt/planning_contexts/context_snapshot.h"
 #include "pdt/planning_contexts/context_visitor.h"
 #include "pdt/planning_contexts/real_vector_geometric_context.h"
 
@@ -62,6 +63,14 @@ class RandomRectanglesMultiStartGoal : public RealVectorGeometricContext {
                                  const std::shared_ptr<const config::Configuration>& config,
                                  const std::string& name);
 
+  /** \brief Restores the obstacles and queries from a snapshot instead of generating them. The
+   * random numbers of generating them are drawn nonetheless, so regenerated queries do not depend
+   * on whether the context was restored. */
+  RandomRectanglesMultiStartGoal(const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
+                                 const std::shared_ptr<const config::Configuration>& config,
+                                 const std::string& name,
+                                 const context_snapshot::Reader& snapshot);
+
   /** \brief The destructor. */
   virtual ~RandomRectanglesMultiStartGoal() = default;
 
@@ -75,6 +84,9 @@ class RandomRectanglesMultiStartGoal : public RealVectorGeometricContext {
   /** \brief Create the obstacles. */
   void createObstacles();
 
+  /** \brief Create the validity checker for the obstacles and set up the space info. */
+  void setupValidityChecker();
+
   /** \brief The number of hyper rectangles. */
   std::size_t numRectangles_{};
 
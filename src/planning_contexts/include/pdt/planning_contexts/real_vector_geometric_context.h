@@ -37,7 +37,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -50,7 +52,9 @@
 
 #include "pdt/config/configuration.h"
 #include "pdt/obstacles/base_obstacle.h"
+#include "pdt/obstacles/hyperrectangle_set.h"
 #include "pdt/planning_contexts/base_context.h"
+#include "pdt/planning_contexts/context_snapshot.h"
 #include "pdt/planning_contexts/context_visitor.h"
 #include "pdt/time/time.h"
 
@@ -71,19 +75,47 @@ class RealVectorGeometricContext : public BaseContext {
   /** \brief Get the state-space limit */
   const ompl::base::RealVectorBounds& getBoundaries() const;
 
-  // Get the obstacles.
+  // Get the obstacles. The compactly stored hyperrectangles are turned into obstacle objects on the
+  // first call.
   std::vector<std::shared_ptr<obstacles::BaseObstacle>> getObstacles() const override;
 
   // Get the antiobstacles.
   std::vector<std::shared_ptr<obstacles::BaseAntiObstacle>> getAntiObstacles() const override;
 
+  // Get the obstacles that are not stored compactly.
+  const std::vector<std::shared_ptr<obstacles::BaseObstacle>>& getObstacleObjects() const;
+
+  // Get the compactly stored hyperrectangular obstacles.
+  const obstacles::HyperrectangleSet& getHyperrectangles() const;
+
   // Accept a visitor.
   virtual void accept(const ContextVisitor& visitor) const override;
 
   /** \brief Create a new goal. */
   std::shared_ptr<ompl::base::Goal> createGoal() const override;
 
+  /** \brief Validate motions exactly against the obstacles instead of at the collision checking
+   * resolution. Requires all obstacles and antiobstacles to be hyperrectangles. */
+  virtual void useExactMotionValidation();
+
+  /** \brief Approximate the clearance with a distance field of the given resolution, which is
+   * computed on all available cores. Requires a two or three dimensional context. */
+  void useDistanceField(double resolution);
+
  protected:
+  /** \brief Replaces the obstacles, antiobstacles, and start/goal pairs with the ones of the
+   * snapshot. The obstacles are stored compactly as hyperrectangles. Goals that are not made of
+   * states are created anew. */
+  void restore(const context_snapshot::Reader& snapshot);
+
+  /** \brief Appends random axis-aligned hyperrectangles with uniform side lengths in
+   * [minSideLength, maxSideLength] to the compactly stored hyperrectangles, skipping the ones that
+   * invalidate an existing start or goal state. The candidates are drawn in chunks on all
+   * available cores, with one random number generator per chunk seeded from the given seed, such
+   * that the obstacles do not depend on the number of cores. */
+  void createRandomRectangles(std::size_t numRectangles, double minSideLength,
+                              double maxSideLength, std::uint_fast32_t seed);
+
   /** \brief The state space bounds. */
   ompl::base::RealVectorBounds bounds_;
 
@@ -92,6 +124,16 @@ class RealVectorGeometricContext : public BaseContext {
 
   /** \brief The anti obstacles. */
   std::vector<std::shared_ptr<obstacles::BaseAntiObstacle>> antiObstacles_{};
+
+  /** \brief Hyperrectangular obstacles that are stored compactly, e.g., random rectangles. They
+   * are handed to validity checkers as they are and are not among obstacles_. */
+  obstacles::HyperrectangleSet hyperrectangles_;
+
+ private:
+  /** \brief The obstacle objects of the compactly stored hyperrectangles, which are only created
+   * when the obstacles are requested. */
+  mutable std::vector<std::shared_ptr<obstacles::BaseObstacle>> hyperrectangleObstacles_{};
+  mutable std::mutex hyperrectangleObstaclesMutex_{};
 };
 
 }  // namespace planning_contexts
@@ -48,12 +48,14 @@
 #include "pdt/obstacles/base_obstacle.h"
 #include "pdt/obstacles/hyperrectangle.h"
 #include "pdt/obstacles/obstacle_visitor.h"
+#include "pdt/obstacles/rectangle_grid.h"
+#include "pdt/planning_contexts/batch_validity_checker.h"
 
 namespace pdt {
 
 namespace planning_contexts {
 
-class ReedsSheppValidityChecker : public ompl::base::StateValidityChecker {
+class ReedsSheppValidityChecker : public BatchValidityChecker {
  public:
   explicit ReedsSheppValidityChecker(const ompl::base::SpaceInformationPtr& spaceInfo);
   virtual ~ReedsSheppValidityChecker() = default;
@@ -61,10 +63,15 @@ class ReedsSheppValidityChecker : public ompl::base::StateValidityChecker {
   // Check if a state is valid.
   virtual bool isValid(const ompl::base::State* state) const override;
 
+  // Check if all states of a batch are valid. The bounds of all states are checked before any
+  // state is checked for collisions.
+  virtual bool isValid(const ompl::base::State* const* states,
+                       std::size_t numStates) const override;
+
   // Return the minimum distance of a point to any obstacle.
   virtual double clearance(const ompl::base::State* state) const override;
 
-  // Add obstacles.
+  // Add obstacles. All obstacles must be axis-aligned rectangles.
   virtual void addObstacle(const std::shared_ptr<obstacles::BaseObstacle>& obstacle);
   virtual void addObstacles(const std::vector<std::shared_ptr<obstacles::BaseObstacle>>& obstacles);
 
@@ -77,16 +84,13 @@ class ReedsSheppValidityChecker : public ompl::base::StateValidityChecker {
   double length_{0.04};
   double circumradius_;
 
-  using Point = std::array<double, 2u>;
-  using Axis = std::array<double, 2u>;
-
-  Point project(const Point& point, const Axis& axis) const;
-  double dotProduct(const Point& point, const Axis& axis) const;
-
   ompl::base::RealVectorStateSpace* vectorSpace_{};
   ompl::base::SO2StateSpace* so2Space_{};
 
   std::vector<std::shared_ptr<obstacles::BaseObstacle>> obstacles_{};
+
+  // The obstacles, binned in a grid with cells as large as the circumcircle of the car.
+  obstacles::RectangleGrid grid_;
 };
 
 }  // namespace planning_contexts
@@ -58,8 +58,13 @@ class ContextValidityCheckerRepeatingRectangles : public ContextValidityChecker
                                             const std::size_t numObsPerDim, const double obsWidth);
   ~ContextValidityCheckerRepeatingRectangles() = default;
 
-  /** \brief Check if a state is valid. */
-  virtual bool isValid(const ompl::base::State* state) const override;
+ protected:
+  /** \brief Check if a state that satisfies the bounds is outside all obstacles. */
+  virtual bool isCollisionFree(const ompl::base::State* state) const override;
+
+  /** \brief Check the states of a batch one by one. */
+  virtual bool isCollisionFree(const ompl::base::State* const* states,
+                               std::size_t numStates) const override;
 
  private:
   /** \brief The centers of the obstacles. */
@@ -0,0 +1,107 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <ompl/base/SpaceInformation.h>
+
+#include "pdt/obstacles/voxel_map.h"
+#include "pdt/planning_contexts/batch_validity_checker.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+// A validity checker for three dimensional real vector spaces and SE(3) whose obstacles are the
+// occupied voxels of a voxel map. The voxels evenly divide the bounds of the space (or of the
+// translational part of SE(3)). The robot is a set of points in its body frame, which are
+// translated by the state and, in SE(3), rotated by it. A state is valid if it is within the
+// bounds and all points of the robot are in free voxels.
+class VoxelGridValidityChecker : public BatchValidityChecker {
+ public:
+  VoxelGridValidityChecker(
+      const ompl::base::SpaceInformationPtr& spaceInfo,
+      const std::shared_ptr<const obstacles::VoxelMap>& map,
+      const std::vector<std::array<double, 3u>>& robotPoints = {std::array<double, 3u>{}});
+  virtual ~VoxelGridValidityChecker() = default;
+
+  // Check if a state is valid.
+  bool isValid(const ompl::base::State* state) const override;
+
+  // Return the minimum distance of any point of the robot to an occupied voxel.
+  double clearance(const ompl::base::State* state) const override;
+
+  // Get the map.
+  std::shared_ptr<const obstacles::VoxelMap> getMap() const;
+
+  // Returns whether the robot is a single point at the origin of its body frame.
+  bool isPointRobot() const;
+
+  // Get the coordinates of a point of the world in units of voxels.
+  std::array<double, 3u> getVoxelCoordinates(const std::array<double, 3u>& point) const;
+
+  // Get the position of a state in the world.
+  std::array<double, 3u> getPosition(const ompl::base::State* state) const;
+
+ private:
+  // Returns the position of a point of the robot in the world.
+  std::array<double, 3u> transform(const ompl::base::State* state,
+                                   const std::array<double, 3u>& robotPoint) const;
+
+  // The map.
+  const std::shared_ptr<const obstacles::VoxelMap> map_;
+
+  // The points of the robot in its body frame.
+  const std::vector<std::array<double, 3u>> robotPoints_;
+
+  // Whether the state space is SE(3).
+  bool isSE3_{false};
+
+  // The lower bounds of the space, the number of voxels per unit length, and the side lengths of
+  // the voxels.
+  std::array<double, 3u> origin_{};
+  std::array<double, 3u> voxelsPerUnit_{};
+  std::array<double, 3u> voxelSideLengths_{};
+};
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
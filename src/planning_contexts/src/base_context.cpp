@@ -46,9 +46,15 @@
 
 #include "pdt/common/goal_type.h"
 #include "pdt/common/objective_type.h"
+#include "pdt/config/directory.h"
+#include "pdt/objectives/costmap_optimization_objective.h"
+#include "pdt/objectives/counting_optimization_objective.h"
 #include "pdt/objectives/max_min_clearance_optimization_objective.h"
 #include "pdt/objectives/potential_field_optimization_objective.h"
 #include "pdt/objectives/reciprocal_clearance_optimization_objective.h"
+#include "pdt/obstacles/raster.h"
+#include "pdt/planning_contexts/counting_motion_validator.h"
+#include "pdt/planning_contexts/counting_validity_checker.h"
 
 using namespace std::string_literals;
 
@@ -71,7 +77,15 @@ BaseContext::BaseContext(const std::shared_ptr<ompl::base::SpaceInformation> &sp
   // Get the optimization objective.
   switch (config_->get<common::OBJECTIVE_TYPE>(parentKey + "/type")) {
     case common::OBJECTIVE_TYPE::COSTMAP: {
-      throw std::runtime_error("CostMap objective is not yet implemented.");
+      // The cost map file is relative to the source directory.
+      auto costMap = obstacles::loadRaster(std::string(config::Directory::SOURCE) + "/"s +
+                                           config_->get<std::string>(parentKey + "/costMap"));
+      if (config_->get<bool>(parentKey + "/flipRows")) {
+        costMap.flipRows();
+      }
+      objective_ = std::make_shared<objectives::CostMapOptimizationObjective>(spaceInfo_, costMap);
+      objective_->setCostThreshold(
+          ompl::base::Cost(config_->get<double>(parentKey + "/solvedCost")));
       break;
     }
     case common::OBJECTIVE_TYPE::MAXMINCLEARANCE: {
@@ -414,6 +428,34 @@ void BaseContext::regenerateQueries() {
   startGoalPairs_ = makeStartGoalPair();
 }
 
+void BaseContext::setStartGoalPairs(const std::vector<StartGoalPair> &startGoalPairs) {
+  startGoalPairs_ = startGoalPairs;
+}
+
+void BaseContext::instrument() {
+  // Instrumenting twice would count every call twice.
+  if (callCounters_) {
+    return;
+  }
+  callCounters_ = std::make_shared<utilities::CallCounters>();
+
+  // The default motion validators check states through the space information, which means the
+  // validity checks of motion validation are counted as well.
+  spaceInfo_->setStateValidityChecker(std::make_shared<CountingValidityChecker>(
+      spaceInfo_, spaceInfo_->getStateValidityChecker(), callCounters_));
+  spaceInfo_->setMotionValidator(std::make_shared<CountingMotionValidator>(
+      spaceInfo_, spaceInfo_->getMotionValidator(), callCounters_));
+  spaceInfo_->setup();
+
+  // Problem definitions instantiated from now on get the counting objective.
+  objective_ =
+      std::make_shared<objectives::CountingOptimizationObjective>(objective_, callCounters_);
+}
+
+std::shared_ptr<utilities::CallCounters> BaseContext::getCallCounters() const {
+  return callCounters_;
+}
+
 }  // namespace planning_contexts
 
 }  // namespace pdt
@@ -0,0 +1,215 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/planning_contexts/bisection_motion_validator.h"
+
+#include <vector>
+
+#include "pdt/planning_contexts/batch_validity_checker.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+namespace {
+
+// The scratch data of motion checks. It belongs to the calling thread, which makes motions safe to
+// check from multiple threads without allocating states per motion.
+struct Scratch {
+  ~Scratch() {
+    for (auto state : states) {
+      space->freeState(state);
+    }
+  }
+
+  // The space of the scratch states.
+  ompl::base::StateSpacePtr space{};
+
+  // The scratch states the levels are interpolated into.
+  std::vector<ompl::base::State*> states{};
+
+  // The indices of the interpolated states in bisection order, and where each level ends.
+  unsigned orderNumSegments{0u};
+  std::vector<unsigned> order{};
+  std::vector<std::size_t> levelEnds{};
+
+  // The ranges of indices that are still to be bisected.
+  std::vector<std::pair<unsigned, unsigned>> ranges{};
+  std::vector<std::pair<unsigned, unsigned>> nextRanges{};
+};
+
+// Returns the scratch data of the calling thread with at least the given number of states of the
+// given space.
+Scratch& getScratch(const ompl::base::StateSpacePtr& space, std::size_t numStates) {
+  thread_local Scratch scratch;
+  if (scratch.space != space) {
+    for (auto state : scratch.states) {
+      scratch.space->freeState(state);
+    }
+    scratch.states.clear();
+    scratch.space = space;
+  }
+  while (scratch.states.size() < numStates) {
+    scratch.states.push_back(space->allocState());
+  }
+  return scratch;
+}
+
+// Computes the bisection order of the interpolated states of a motion with the given number of
+// segments.
+void computeOrder(unsigned numSegments, Scratch* scratch) {
+  if (numSegments == scratch->orderNumSegments) {
+    return;
+  }
+  scratch->orderNumSegments = numSegments;
+  scratch->order.clear();
+  scratch->levelEnds.clear();
+  scratch->ranges.clear();
+
+  // The interpolated states have the indices 1 to numSegments - 1. Every level checks the middle
+  // of each range of the previous level.
+  if (numSegments >= 2u) {
+    scratch->ranges.emplace_back(1u, numSegments - 1u);
+  }
+  while (!scratch->ranges.empty()) {
+    scratch->nextRanges.clear();
+    for (const auto& range : scratch->ranges) {
+      const auto middle = (range.first + range.second) / 2u;
+      scratch->order.push_back(middle);
+      if (range.first < middle) {
+        scratch->nextRanges.emplace_back(range.first, middle - 1u);
+      }
+      if (range.second > middle) {
+        scratch->nextRanges.emplace_back(middle + 1u, range.second);
+      }
+    }
+    scratch->levelEnds.push_back(scratch->order.size());
+    std::swap(scratch->ranges, scratch->nextRanges);
+  }
+}
+
+}  // namespace
+
+BisectionMotionValidator::BisectionMotionValidator(
+    const ompl::base::SpaceInformationPtr& spaceInfo) :
+    ompl::base::MotionValidator(spaceInfo) {
+}
+
+bool BisectionMotionValidator::checkMotion(const ompl::base::State* state1,
+                                           const ompl::base::State* state2) const {
+  // Like the discrete motion validator, assume the first state is valid and check the last state
+  // before any interpolated state.
+  if (!si_->isValid(state2)) {
+    ++invalid_;
+    return false;
+  }
+
+  // Check the interpolated states one level of the bisection at a time.
+  const auto& space = si_->getStateSpace();
+  const auto numSegments = space->validSegmentCount(state1, state2);
+  auto& scratch = getScratch(space, 0u);
+  computeOrder(numSegments, &scratch);
+  std::size_t begin = 0u;
+  for (const auto end : scratch.levelEnds) {
+    getScratch(space, end - begin);
+    for (auto i = begin; i < end; ++i) {
+      space->interpolate(state1, state2,
+                         static_cast<double>(scratch.order[i]) / static_cast<double>(numSegments),
+                         scratch.states[i - begin]);
+    }
+    if (!isValid(scratch.states.data(), end - begin)) {
+      ++invalid_;
+      return false;
+    }
+    begin = end;
+  }
+
+  ++valid_;
+  return true;
+}
+
+bool BisectionMotionValidator::checkMotion(
+    const ompl::base::State* state1, const ompl::base::State* state2,
+    std::pair<ompl::base::State*, double>& lastValid) const {
+  const auto& space = si_->getStateSpace();
+  auto state = getScratch(space, 1u).states[0u];
+
+  // Check the interpolated states in order, like the discrete motion validator.
+  const auto numSegments = space->validSegmentCount(state1, state2);
+  for (auto j = 1u; j < numSegments; ++j) {
+    space->interpolate(state1, state2, static_cast<double>(j) / static_cast<double>(numSegments),
+                       state);
+    if (!si_->isValid(state)) {
+      lastValid.second = static_cast<double>(j - 1u) / static_cast<double>(numSegments);
+      if (lastValid.first != nullptr) {
+        space->interpolate(state1, state2, lastValid.second, lastValid.first);
+      }
+      ++invalid_;
+      return false;
+    }
+  }
+
+  if (!si_->isValid(state2)) {
+    lastValid.second = static_cast<double>(numSegments - 1u) / static_cast<double>(numSegments);
+    if (lastValid.first != nullptr) {
+      space->interpolate(state1, state2, lastValid.second, lastValid.first);
+    }
+    ++invalid_;
+    return false;
+  }
+
+  ++valid_;
+  return true;
+}
+
+bool BisectionMotionValidator::isValid(const ompl::base::State* const* states,
+                                       std::size_t numStates) const {
+  const auto& checker = si_->getStateValidityChecker();
+  if (auto batchChecker = dynamic_cast<const BatchValidityChecker*>(checker.get())) {
+    return batchChecker->isValid(states, numStates);
+  }
+  for (std::size_t i = 0u; i < numStates; ++i) {
+    if (!checker->isValid(states[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
@@ -0,0 +1,349 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/planning_contexts/context_snapshot.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <ompl/base/goals/GoalState.h>
+#include <ompl/base/goals/GoalStates.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+#include <ompl/util/RandomNumbers.h>
+
+#include "pdt/obstacles/base_obstacle.h"
+#include "pdt/obstacles/hyperrectangle.h"
+#include "pdt/planning_contexts/real_vector_geometric_context.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+namespace context_snapshot {
+
+namespace fs = std::experimental::filesystem;
+using namespace std::string_literals;
+
+namespace {
+
+// Appends the anchors and widths of hyperrectangles to the values.
+template <typename T>
+void appendHyperrectangles(const std::vector<std::shared_ptr<T>>& shapes,
+                           std::vector<double>* values) {
+  for (const auto& shape : shapes) {
+    const auto hyperrectangle = std::dynamic_pointer_cast<obstacles::Hyperrectangle<T>>(shape);
+    if (!hyperrectangle) {
+      throw std::invalid_argument("Context snapshots only support hyperrectangular obstacles.");
+    }
+    const auto anchor = hyperrectangle->getAnchorCoordinates();
+    values->insert(values->end(), anchor.begin(), anchor.end());
+    const auto& widths = hyperrectangle->getWidths();
+    values->insert(values->end(), widths.begin(), widths.end());
+  }
+}
+
+// Appends the coordinates of a real vector state to the values.
+void appendState(const ompl::base::State* state, std::size_t dimension,
+                 std::vector<double>* values) {
+  const auto realVectorState = state->as<ompl::base::RealVectorStateSpace::StateType>();
+  values->insert(values->end(), realVectorState->values, realVectorState->values + dimension);
+}
+
+}  // namespace
+
+std::uint64_t computeConfigHash(const config::Configuration& config,
+                                const std::string& contextName) {
+  // FNV-1a, which unlike std::hash is the same in every build.
+  std::uint64_t hash = 14695981039346656037u;
+  const auto hashString = [&hash](const std::string& string) {
+    for (const auto character : string) {
+      hash ^= static_cast<unsigned char>(character);
+      hash *= 1099511628211u;
+    }
+  };
+  hashString(config.dump("context/" + contextName));
+  hashString(std::to_string(ompl::RNG::getSeed()));
+  hashString(std::to_string(VERSION));
+  return hash;
+}
+
+void write(const fs::path& path, const RealVectorGeometricContext& context,
+           std::uint64_t configHash) {
+  const auto dimension = context.getDimension();
+
+  // Collect all arrays. They consist of doubles only, so they stay aligned.
+  std::vector<double> bounds = context.getBoundaries().low;
+  bounds.insert(bounds.end(), context.getBoundaries().high.begin(),
+                context.getBoundaries().high.end());
+  // The obstacle objects come first, as in the obstacles of the context. The compactly stored
+  // hyperrectangles are written as they are, without creating obstacle objects for them.
+  const auto& obstacleObjects = context.getObstacleObjects();
+  const auto& hyperrectangles = context.getHyperrectangles();
+  std::vector<double> obstacles;
+  appendHyperrectangles(obstacleObjects, &obstacles);
+  for (std::size_t i = 0u; i < hyperrectangles.size(); ++i) {
+    obstacles.insert(obstacles.end(), hyperrectangles.getCenter(i),
+                     hyperrectangles.getCenter(i) + dimension);
+    obstacles.insert(obstacles.end(), hyperrectangles.getWidths(i),
+                     hyperrectangles.getWidths(i) + dimension);
+  }
+  const auto antiObstacleShapes = context.getAntiObstacles();
+  std::vector<double> antiObstacles;
+  appendHyperrectangles(antiObstacleShapes, &antiObstacles);
+
+  Header header{};
+  std::copy(std::begin(MAGIC), std::end(MAGIC), std::begin(header.magic));
+  header.version = VERSION;
+  header.configHash = configHash;
+  header.seed = ompl::RNG::getSeed();
+  header.dimension = dimension;
+  header.numObstacles = obstacleObjects.size() + hyperrectangles.size();
+  header.numAntiObstacles = antiObstacleShapes.size();
+  header.numQueries = context.getNumQueries();
+  header.boundsOffset = sizeof(Header);
+  header.obstaclesOffset = header.boundsOffset + bounds.size() * sizeof(double);
+  header.antiObstaclesOffset = header.obstaclesOffset + obstacles.size() * sizeof(double);
+  header.queriesOffset = header.antiObstaclesOffset + antiObstacles.size() * sizeof(double);
+
+  // Collect the states of all queries. Goals that are not made of states are recreated from the
+  // configuration.
+  std::vector<QueryEntry> queries;
+  std::vector<double> states;
+  const auto statesOffset = header.queriesOffset + header.numQueries * sizeof(QueryEntry);
+  for (std::size_t q = 0u; q < header.numQueries; ++q) {
+    const auto pair = context.getNthStartGoalPair(q);
+    QueryEntry query{};
+    query.statesOffset = statesOffset + states.size() * sizeof(double);
+    query.numStarts = pair.start.size();
+    for (const auto& start : pair.start) {
+      appendState(start.get(), dimension, &states);
+    }
+    if (const auto goalState = std::dynamic_pointer_cast<ompl::base::GoalState>(pair.goal)) {
+      query.numGoals = 1u;
+      appendState(goalState->getState(), dimension, &states);
+    } else if (const auto goalStates =
+                   std::dynamic_pointer_cast<ompl::base::GoalStates>(pair.goal)) {
+      query.numGoals = goalStates->getStateCount();
+      for (std::size_t i = 0u; i < query.numGoals; ++i) {
+        appendState(goalStates->getState(static_cast<unsigned>(i)), dimension, &states);
+      }
+    }
+    queries.push_back(query);
+  }
+
+  // Write to a temporary file first and then replace the snapshot with it.
+  const auto temporaryPath = fs::path(path.string() + ".tmp"s + std::to_string(getpid()));
+  {
+    std::ofstream file(temporaryPath.string(), std::ios::out | std::ios::binary | std::ios::trunc);
+    const auto writeDoubles = [&file](const std::vector<double>& values) {
+      file.write(reinterpret_cast<const char*>(values.data()),
+                 static_cast<std::streamsize>(values.size() * sizeof(double)));
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    writeDoubles(bounds);
+    writeDoubles(obstacles);
+    writeDoubles(antiObstacles);
+    file.write(reinterpret_cast<const char*>(queries.data()),
+               static_cast<std::streamsize>(queries.size() * sizeof(QueryEntry)));
+    writeDoubles(states);
+    if (!file) {
+      throw std::ios_base::failure("Could not write context snapshot to "s +
+                                   temporaryPath.string() + "."s);
+    }
+  }
+  fs::rename(temporaryPath, path);
+}
+
+Reader::Reader(const fs::path& path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::ios_base::failure("Could not open context snapshot at "s + path.string() + "."s);
+  }
+
+  struct stat status;
+  if (fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(Header)) {
+    close(fd);
+    throw std::ios_base::failure("'"s + path.string() + "' is not a context snapshot."s);
+  }
+  size_ = static_cast<std::size_t>(status.st_size);
+
+  // The mapping stays valid after the file descriptor is closed.
+  void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw std::ios_base::failure("Could not map context snapshot at "s + path.string() + "."s);
+  }
+  data_ = static_cast<const char*>(data);
+
+  // Validate the header and the arrays.
+  header_ = reinterpret_cast<const Header*>(data_);
+  const auto shapeSize = 2u * header_->dimension * sizeof(double);
+  const auto obstaclesSize = header_->numObstacles * shapeSize;
+  const auto antiObstaclesSize = header_->numAntiObstacles * shapeSize;
+  if (std::memcmp(header_->magic, MAGIC, sizeof(MAGIC)) != 0 || header_->version != VERSION ||
+      header_->boundsOffset != sizeof(Header) ||
+      header_->obstaclesOffset != header_->boundsOffset + shapeSize ||
+      header_->antiObstaclesOffset != header_->obstaclesOffset + obstaclesSize ||
+      header_->queriesOffset != header_->antiObstaclesOffset + antiObstaclesSize ||
+      header_->queriesOffset + header_->numQueries * sizeof(QueryEntry) > size_) {
+    munmap(const_cast<char*>(data_), size_);
+    throw std::ios_base::failure("'"s + path.string() + "' is not a valid context snapshot."s);
+  }
+  bounds_ = reinterpret_cast<const double*>(data_ + header_->boundsOffset);
+  obstacles_ = reinterpret_cast<const double*>(data_ + header_->obstaclesOffset);
+  antiObstacles_ = reinterpret_cast<const double*>(data_ + header_->antiObstaclesOffset);
+  queries_ = reinterpret_cast<const QueryEntry*>(data_ + header_->queriesOffset);
+  for (std::size_t q = 0u; q < header_->numQueries; ++q) {
+    if (queries_[q].statesOffset % alignof(double) != 0u ||
+        queries_[q].statesOffset + (queries_[q].numStarts + queries_[q].numGoals) *
+                                       header_->dimension * sizeof(double) >
+            size_) {
+      munmap(const_cast<char*>(data_), size_);
+      throw std::ios_base::failure("'"s + path.string() + "' is truncated."s);
+    }
+  }
+}
+
+Reader::~Reader() {
+  munmap(const_cast<char*>(data_), size_);
+}
+
+std::uint64_t Reader::getConfigHash() const {
+  return header_->configHash;
+}
+
+std::uint64_t Reader::getSeed() const {
+  return header_->seed;
+}
+
+std::size_t Reader::getDimension() const {
+  return header_->dimension;
+}
+
+const double* Reader::getLowerBounds() const {
+  return bounds_;
+}
+
+const double* Reader::getUpperBounds() const {
+  return bounds_ + header_->dimension;
+}
+
+std::size_t Reader::getNumObstacles() const {
+  return header_->numObstacles;
+}
+
+const double* Reader::getObstacleAnchor(std::size_t i) const {
+  if (i >= header_->numObstacles) {
+    throw std::out_of_range("Requested obstacle "s + std::to_string(i) + " of a snapshot with "s +
+                            std::to_string(header_->numObstacles) + " obstacles."s);
+  }
+  return obstacles_ + 2u * header_->dimension * i;
+}
+
+const double* Reader::getObstacleWidths(std::size_t i) const {
+  return getObstacleAnchor(i) + header_->dimension;
+}
+
+std::size_t Reader::getNumAntiObstacles() const {
+  return header_->numAntiObstacles;
+}
+
+const double* Reader::getAntiObstacleAnchor(std::size_t i) const {
+  if (i >= header_->numAntiObstacles) {
+    throw std::out_of_range("Requested antiobstacle "s + std::to_string(i) +
+                            " of a snapshot with "s + std::to_string(header_->numAntiObstacles) +
+                            " antiobstacles."s);
+  }
+  return antiObstacles_ + 2u * header_->dimension * i;
+}
+
+const double* Reader::getAntiObstacleWidths(std::size_t i) const {
+  return getAntiObstacleAnchor(i) + header_->dimension;
+}
+
+std::size_t Reader::getNumQueries() const {
+  return header_->numQueries;
+}
+
+std::size_t Reader::getNumStarts(std::size_t q) const {
+  return getQuery(q).numStarts;
+}
+
+const double* Reader::getStart(std::size_t q, std::size_t i) const {
+  const auto& query = getQuery(q);
+  if (i >= query.numStarts) {
+    throw std::out_of_range("Requested start "s + std::to_string(i) + " of a query with "s +
+                            std::to_string(query.numStarts) + " starts."s);
+  }
+  return reinterpret_cast<const double*>(data_ + query.statesOffset) + header_->dimension * i;
+}
+
+std::size_t Reader::getNumGoals(std::size_t q) const {
+  return getQuery(q).numGoals;
+}
+
+const double* Reader::getGoal(std::size_t q, std::size_t i) const {
+  const auto& query = getQuery(q);
+  if (i >= query.numGoals) {
+    throw std::out_of_range("Requested goal "s + std::to_string(i) + " of a query with "s +
+                            std::to_string(query.numGoals) + " goals."s);
+  }
+  return reinterpret_cast<const double*>(data_ + query.statesOffset) +
+         header_->dimension * (query.numStarts + i);
+}
+
+const QueryEntry& Reader::getQuery(std::size_t q) const {
+  if (q >= header_->numQueries) {
+    throw std::out_of_range("Requested query "s + std::to_string(q) + " of a snapshot with "s +
+                            std::to_string(header_->numQueries) + " queries."s);
+  }
+  return queries_[q];
+}
+
+}  // namespace context_snapshot
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
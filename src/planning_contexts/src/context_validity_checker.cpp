@@ -37,20 +37,40 @@
 
 #include "pdt/planning_contexts/context_validity_checker.h"
 
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <ompl/base/StateSpaceTypes.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+
 namespace pdt {
 
 namespace planning_contexts {
 
 ContextValidityChecker::ContextValidityChecker(const ompl::base::SpaceInformationPtr& spaceInfo) :
-    ompl::base::StateValidityChecker(spaceInfo) {
+    BatchValidityChecker(spaceInfo),
+    addedHyperrectangles_(spaceInfo->getStateDimension()),
+    hyperrectangles_(spaceInfo->getStateDimension()) {
 }
 
 bool ContextValidityChecker::isValid(const ompl::base::State* state) const {
   // If the state does not satisfy the space bounds, it is not valid.
-  if (!si_->satisfiesBounds(state)) {
-    return false;
+  return si_->satisfiesBounds(state) && isCollisionFree(state);
+}
+
+bool ContextValidityChecker::isValid(const ompl::base::State* const* states,
+                                     std::size_t numStates) const {
+  // Checking the bounds is much cheaper than checking for collisions.
+  for (std::size_t i = 0u; i < numStates; ++i) {
+    if (!si_->satisfiesBounds(states[i])) {
+      return false;
+    }
   }
+  return isCollisionFree(states, numStates);
+}
 
+bool ContextValidityChecker::isCollisionFree(const ompl::base::State* state) const {
   // A state is valid if it collides with an anti obstacle. This overrides collisions with
   // obstacles.
   for (const auto& anti : antiObstacles_) {
@@ -60,19 +80,73 @@ bool ContextValidityChecker::isValid(const ompl::base::State* state) const {
   }
 
   // A state is not valid if it collides with an obstacle.
-  for (const auto& obs : obstacles_) {
+  if (!hyperrectangles_.empty() || !addedHyperrectangles_.empty()) {
+    const auto values = state->as<ompl::base::RealVectorStateSpace::StateType>()->values;
+    if (hyperrectangles_.contains(values) || addedHyperrectangles_.contains(values)) {
+      return false;
+    }
+  }
+  for (const auto& obs : otherObstacles_) {
     if (obs->invalidates(state)) {
       return false;
     }
   }
 
-  // The state satisfies the bounds and is not invalidated by any obstacles.
+  // The state is not invalidated by any obstacles.
+  return true;
+}
+
+bool ContextValidityChecker::isCollisionFree(const ompl::base::State* const* states,
+                                             std::size_t numStates) const {
+  // Antiobstacles override obstacles per state, so such batches are checked state by state.
+  if (!antiObstacles_.empty()) {
+    for (std::size_t i = 0u; i < numStates; ++i) {
+      if (!isCollisionFree(states[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Test all states against every block of compiled hyperrectangles at once.
+  if (!hyperrectangles_.empty() || !addedHyperrectangles_.empty()) {
+    thread_local std::vector<const double*> points;
+    points.resize(numStates);
+    for (std::size_t i = 0u; i < numStates; ++i) {
+      points[i] = states[i]->as<ompl::base::RealVectorStateSpace::StateType>()->values;
+    }
+    if (hyperrectangles_.containsAny(points.data(), numStates) ||
+        addedHyperrectangles_.containsAny(points.data(), numStates)) {
+      return false;
+    }
+  }
+  for (std::size_t i = 0u; i < numStates; ++i) {
+    for (const auto& obs : otherObstacles_) {
+      if (obs->invalidates(states[i])) {
+        return false;
+      }
+    }
+  }
   return true;
 }
 
 double ContextValidityChecker::clearance(const ompl::base::State* state) const {
+  if (distanceField_) {
+    const auto values = state->as<ompl::base::RealVectorStateSpace::StateType>()->values;
+    if (distanceField_->covers(values)) {
+      return distanceField_->clearance(values);
+    }
+  }
+  return computeExactClearance(state);
+}
+
+double ContextValidityChecker::computeExactClearance(const ompl::base::State* state) const {
   // Compute the distance to all obstacles and take the minimum.
-  double minDistance = std::numeric_limits<double>::infinity();
+  double minDistance =
+      addedHyperrectangles_.empty()
+          ? std::numeric_limits<double>::infinity()
+          : addedHyperrectangles_.clearance(
+                state->as<ompl::base::RealVectorStateSpace::StateType>()->values);
   for (const auto& obstacle : obstacles_) {
     double distance = obstacle->clearance(state);
     minDistance = distance < minDistance ? distance : minDistance;
@@ -80,13 +154,48 @@ double ContextValidityChecker::clearance(const ompl::base::State* state) const {
   return minDistance;
 }
 
+void ContextValidityChecker::setDistanceField(
+    const std::shared_ptr<const obstacles::DistanceField>& field) {
+  distanceField_ = field;
+}
+
+std::shared_ptr<const obstacles::DistanceField> ContextValidityChecker::getDistanceField() const {
+  return distanceField_;
+}
+
 void ContextValidityChecker::addObstacle(const std::shared_ptr<obstacles::BaseObstacle>& obstacle) {
   obstacles_.push_back(obstacle);
+  compileObstacle(obstacle);
 }
 
 void ContextValidityChecker::addObstacles(
     const std::vector<std::shared_ptr<obstacles::BaseObstacle>>& obstacles) {
   obstacles_.insert(obstacles_.end(), obstacles.begin(), obstacles.end());
+  for (const auto& obstacle : obstacles) {
+    compileObstacle(obstacle);
+  }
+}
+
+void ContextValidityChecker::addHyperrectangles(
+    const obstacles::HyperrectangleSet& hyperrectangles) {
+  if (si_->getStateSpace()->getType() != ompl::base::StateSpaceType::STATE_SPACE_REAL_VECTOR) {
+    throw std::invalid_argument("Compactly stored hyperrectangles need a real vector space.");
+  }
+  addedHyperrectangles_.append(hyperrectangles);
+}
+
+void ContextValidityChecker::compileObstacle(
+    const std::shared_ptr<obstacles::BaseObstacle>& obstacle) {
+  // Hyperrectangles in other spaces, e.g., SE2, are not axis aligned in the coordinates of states.
+  if (si_->getStateSpace()->getType() == ompl::base::StateSpaceType::STATE_SPACE_REAL_VECTOR) {
+    if (auto hyperrectangle =
+            std::dynamic_pointer_cast<obstacles::Hyperrectangle<obstacles::BaseObstacle>>(
+                obstacle)) {
+      hyperrectangles_.add(hyperrectangle->getAnchorCoordinates(), hyperrectangle->getWidths());
+      return;
+    }
+  }
+  otherObstacles_.push_back(obstacle);
 }
 
 void ContextValidityChecker::addAntiObstacle(
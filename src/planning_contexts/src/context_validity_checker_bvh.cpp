@@ -0,0 +1,180 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/planning_contexts/context_validity_checker_bvh.h"
+
+#include <limits>
+#include <stdexcept>
+
+#include <ompl/base/StateSpaceTypes.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+
+#include "pdt/obstacles/hyperrectangle.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+ContextValidityCheckerBVH::ContextValidityCheckerBVH(
+    const ompl::base::SpaceInformationPtr& spaceInfo) :
+    ContextValidityChecker(spaceInfo),
+    obstacleHierarchy_(spaceInfo->getStateDimension()),
+    antiObstacleHierarchy_(spaceInfo->getStateDimension()) {
+  if (spaceInfo->getStateSpace()->getType() !=
+      ompl::base::StateSpaceType::STATE_SPACE_REAL_VECTOR) {
+    throw std::invalid_argument("ContextValidityCheckerBVH only supports real vector spaces.");
+  }
+}
+
+bool ContextValidityCheckerBVH::isCollisionFree(const ompl::base::State* state) const {
+  const auto values = state->as<ompl::base::RealVectorStateSpace::StateType>()->values;
+
+  // A state is valid if it collides with an anti obstacle. This overrides collisions with
+  // obstacles.
+  if (antiObstacleHierarchy_.anyContaining(values, [this, state](std::size_t i) {
+        return isExactAntiObstacle_[i] || antiObstacles_[i]->validates(state);
+      })) {
+    return true;
+  }
+
+  // A state is not valid if it collides with an obstacle. The boxes behind the obstacle objects
+  // are the compactly stored hyperrectangles.
+  return !obstacleHierarchy_.anyContaining(values, [this, state](std::size_t i) {
+    return i >= obstacles_.size() || isExactObstacle_[i] || obstacles_[i]->invalidates(state);
+  });
+}
+
+bool ContextValidityCheckerBVH::isCollisionFree(const ompl::base::State* const* states,
+                                                std::size_t numStates) const {
+  for (std::size_t i = 0u; i < numStates; ++i) {
+    if (!isCollisionFree(states[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ContextValidityCheckerBVH::mayCollide(const ompl::base::State* state1,
+                                           const ompl::base::State* state2) const {
+  return obstacleHierarchy_.anyIntersecting(
+      state1->as<ompl::base::RealVectorStateSpace::StateType>()->values,
+      state2->as<ompl::base::RealVectorStateSpace::StateType>()->values,
+      [](std::size_t) { return true; });
+}
+
+void ContextValidityCheckerBVH::addObstacle(
+    const std::shared_ptr<obstacles::BaseObstacle>& obstacle) {
+  obstacles_.push_back(obstacle);
+  build(obstacles_, &addedHyperrectangles_, &obstacleHierarchy_, &isExactObstacle_);
+}
+
+void ContextValidityCheckerBVH::addObstacles(
+    const std::vector<std::shared_ptr<obstacles::BaseObstacle>>& obstacles) {
+  obstacles_.insert(obstacles_.end(), obstacles.begin(), obstacles.end());
+  build(obstacles_, &addedHyperrectangles_, &obstacleHierarchy_, &isExactObstacle_);
+}
+
+void ContextValidityCheckerBVH::addHyperrectangles(
+    const obstacles::HyperrectangleSet& hyperrectangles) {
+  addedHyperrectangles_.append(hyperrectangles);
+  build(obstacles_, &addedHyperrectangles_, &obstacleHierarchy_, &isExactObstacle_);
+}
+
+void ContextValidityCheckerBVH::addAntiObstacle(
+    const std::shared_ptr<obstacles::BaseAntiObstacle>& anti) {
+  antiObstacles_.push_back(anti);
+  build(antiObstacles_, nullptr, &antiObstacleHierarchy_, &isExactAntiObstacle_);
+}
+
+void ContextValidityCheckerBVH::addAntiObstacles(
+    const std::vector<std::shared_ptr<obstacles::BaseAntiObstacle>>& antis) {
+  antiObstacles_.insert(antiObstacles_.end(), antis.begin(), antis.end());
+  build(antiObstacles_, nullptr, &antiObstacleHierarchy_, &isExactAntiObstacle_);
+}
+
+template <typename Shape>
+void ContextValidityCheckerBVH::build(const std::vector<std::shared_ptr<Shape>>& shapes,
+                                      const obstacles::HyperrectangleSet* hyperrectangles,
+                                      obstacles::BoundingVolumeHierarchy* hierarchy,
+                                      std::vector<bool>* isExact) const {
+  const auto dimension = si_->getStateDimension();
+  const auto numBoxes = shapes.size() + (hyperrectangles ? hyperrectangles->size() : 0u);
+  std::vector<double> lowerBounds;
+  std::vector<double> upperBounds;
+  lowerBounds.reserve(numBoxes * dimension);
+  upperBounds.reserve(numBoxes * dimension);
+  isExact->clear();
+  isExact->reserve(shapes.size());
+  for (const auto& shape : shapes) {
+    const auto anchor = shape->getAnchorCoordinates();
+    if (auto hyperrectangle = std::dynamic_pointer_cast<obstacles::Hyperrectangle<Shape>>(shape)) {
+      // These are the bounds Hyperrectangle::isInside computes, so the box is the shape.
+      const auto& widths = hyperrectangle->getWidths();
+      for (auto dim = 0u; dim < dimension; ++dim) {
+        lowerBounds.push_back(anchor[dim] - widths[dim] / 2.0 -
+                              std::numeric_limits<double>::epsilon());
+        upperBounds.push_back(anchor[dim] + widths[dim] / 2.0 +
+                              std::numeric_limits<double>::epsilon());
+      }
+      isExact->push_back(true);
+    } else {
+      const auto radius = shape->getCircumradius();
+      for (auto dim = 0u; dim < dimension; ++dim) {
+        lowerBounds.push_back(anchor[dim] - radius);
+        upperBounds.push_back(anchor[dim] + radius);
+      }
+      isExact->push_back(false);
+    }
+  }
+  if (hyperrectangles) {
+    for (std::size_t i = 0u; i < hyperrectangles->size(); ++i) {
+      const auto center = hyperrectangles->getCenter(i);
+      const auto widths = hyperrectangles->getWidths(i);
+      for (auto dim = 0u; dim < dimension; ++dim) {
+        lowerBounds.push_back(center[dim] - widths[dim] / 2.0 -
+                              std::numeric_limits<double>::epsilon());
+        upperBounds.push_back(center[dim] + widths[dim] / 2.0 +
+                              std::numeric_limits<double>::epsilon());
+      }
+    }
+  }
+  hierarchy->build(lowerBounds, upperBounds);
+}
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
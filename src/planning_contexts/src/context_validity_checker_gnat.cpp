@@ -37,6 +37,8 @@
 
 #include "pdt/planning_contexts/context_validity_checker_gnat.h"
 
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+
 namespace pdt {
 
 namespace planning_contexts {
@@ -58,15 +60,7 @@ ContextValidityCheckerGNAT::ContextValidityCheckerGNAT(
       });
 }
 
-bool ContextValidityCheckerGNAT::isValid(const ompl::base::State* state) const {
-  if (!state) {
-    throw std::runtime_error("ContextValidityCheckerGNAT recieved nullptr state.");
-  }
-  // If the state does not satisfy the space bounds, it is not valid.
-  if (!si_->satisfiesBounds(state)) {
-    return false;
-  }
-
+bool ContextValidityCheckerGNAT::isCollisionFree(const ompl::base::State* state) const {
   // Convert this state to an indexed state for nearest neighbour lookup.
   auto indexedState = std::make_pair(0u, state);
 
@@ -100,7 +94,19 @@ bool ContextValidityCheckerGNAT::isValid(const ompl::base::State* state) const {
     }
   }
 
-  // The state satisfies the bounds and is not invalidated by any obstacles.
+  // The compactly stored hyperrectangles are not indexed and are checked all at once.
+  return addedHyperrectangles_.empty() ||
+         !addedHyperrectangles_.contains(
+             state->as<ompl::base::RealVectorStateSpace::StateType>()->values);
+}
+
+bool ContextValidityCheckerGNAT::isCollisionFree(const ompl::base::State* const* states,
+                                                 std::size_t numStates) const {
+  for (std::size_t i = 0u; i < numStates; ++i) {
+    if (!isCollisionFree(states[i])) {
+      return false;
+    }
+  }
   return true;
 }
 
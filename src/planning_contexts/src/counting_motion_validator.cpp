@@ -0,0 +1,84 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/planning_contexts/counting_motion_validator.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+CountingMotionValidator::CountingMotionValidator(
+    const ompl::base::SpaceInformationPtr& spaceInfo,
+    const ompl::base::MotionValidatorPtr& validator,
+    const std::shared_ptr<utilities::CallCounters>& counters) :
+    ompl::base::MotionValidator(spaceInfo),
+    validator_(validator),
+    counters_(counters) {
+}
+
+bool CountingMotionValidator::checkMotion(const ompl::base::State* state1,
+                                          const ompl::base::State* state2) const {
+  utilities::ScopedCall call(&counters_->checkMotion);
+  const bool isValid = validator_->checkMotion(state1, state2);
+  if (isValid) {
+    ++valid_;
+  } else {
+    ++invalid_;
+  }
+  return isValid;
+}
+
+bool CountingMotionValidator::checkMotion(
+    const ompl::base::State* state1, const ompl::base::State* state2,
+    std::pair<ompl::base::State*, double>& lastValid) const {
+  utilities::ScopedCall call(&counters_->checkMotion);
+  const bool isValid = validator_->checkMotion(state1, state2, lastValid);
+  if (isValid) {
+    ++valid_;
+  } else {
+    ++invalid_;
+  }
+  return isValid;
+}
+
+ompl::base::MotionValidatorPtr CountingMotionValidator::getMotionValidator() const {
+  return validator_;
+}
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
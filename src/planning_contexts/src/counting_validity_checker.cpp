@@ -0,0 +1,79 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/planning_contexts/counting_validity_checker.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+CountingValidityChecker::CountingValidityChecker(
+    const ompl::base::SpaceInformationPtr& spaceInfo,
+    const ompl::base::StateValidityCheckerPtr& checker,
+    const std::shared_ptr<utilities::CallCounters>& counters) :
+    BatchValidityChecker(spaceInfo),
+    checker_(checker),
+    counters_(counters) {
+  specs_ = checker_->getSpecs();
+}
+
+bool CountingValidityChecker::isValid(const ompl::base::State* state) const {
+  utilities::ScopedCall call(&counters_->isValid);
+  return checker_->isValid(state);
+}
+
+bool CountingValidityChecker::isValid(const ompl::base::State* const* states,
+                                      std::size_t numStates) const {
+  if (auto batchChecker = dynamic_cast<const BatchValidityChecker*>(checker_.get())) {
+    utilities::ScopedCall call(&counters_->isValid);
+    return batchChecker->isValid(states, numStates);
+  }
+  return BatchValidityChecker::isValid(states, numStates);
+}
+
+double CountingValidityChecker::clearance(const ompl::base::State* state) const {
+  utilities::ScopedCall call(&counters_->clearance);
+  return checker_->clearance(state);
+}
+
+ompl::base::StateValidityCheckerPtr CountingValidityChecker::getValidityChecker() const {
+  return checker_;
+}
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
@@ -0,0 +1,249 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/planning_contexts/hyperrectangle_motion_validator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <ompl/base/StateSpaceTypes.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+
+#include "pdt/obstacles/hyperrectangle.h"
+
+namespace pdt {
+
+namespace planning_contexts {
+
+namespace {
+
+// Appends the bounds of hyperrectangles as [lower, upper] per box and builds their hierarchy.
+template <typename T>
+void compileHyperrectangles(const std::vector<std::shared_ptr<T>>& shapes, std::size_t dimension,
+                            std::vector<double>* bounds,
+                            obstacles::BoundingVolumeHierarchy* hierarchy) {
+  std::vector<double> lowerBounds;
+  std::vector<double> upperBounds;
+  for (const auto& shape : shapes) {
+    auto hyperrectangle = std::dynamic_pointer_cast<obstacles::Hyperrectangle<T>>(shape);
+    if (!hyperrectangle) {
+      throw std::invalid_argument(
+          "HyperrectangleMotionValidator only supports hyperrectangular obstacles.");
+    }
+    // These are the bounds Hyperrectangle::isInside computes.
+    const auto anchor = hyperrectangle->getAnchorCoordinates();
+    const auto& widths = hyperrectangle->getWidths();
+    for (auto dim = 0u; dim < dimension; ++dim) {
+      lowerBounds.push_back(anchor[dim] - widths[dim] / 2.0 -
+                            std::numeric_limits<double>::epsilon());
+      upperBounds.push_back(anchor[dim] + widths[dim] / 2.0 +
+                            std::numeric_limits<double>::epsilon());
+    }
+  }
+  for (std::size_t i = 0u; i < shapes.size(); ++i) {
+    const double* lower = lowerBounds.data() + i * dimension;
+    const double* upper = upperBounds.data() + i * dimension;
+    bounds->insert(bounds->end(), lower, lower + dimension);
+    bounds->insert(bounds->end(), upper, upper + dimension);
+  }
+  hierarchy->build(lowerBounds, upperBounds);
+}
+
+}  // namespace
+
+HyperrectangleMotionValidator::HyperrectangleMotionValidator(
+    const ompl::base::SpaceInformationPtr& spaceInfo,
+    const std::vector<std::shared_ptr<obstacles::BaseObstacle>>& obstacles,
+    const std::vector<std::shared_ptr<obstacles::BaseAntiObstacle>>& antiObstacles) :
+    ompl::base::MotionValidator(spaceInfo),
+    dimension_(spaceInfo->getStateDimension()),
+    obstacleHierarchy_(dimension_),
+    antiObstacleHierarchy_(dimension_) {
+  if (spaceInfo->getStateSpace()->getType() !=
+      ompl::base::StateSpaceType::STATE_SPACE_REAL_VECTOR) {
+    throw std::invalid_argument("HyperrectangleMotionValidator only supports real vector spaces.");
+  }
+
+  // These are the bounds RealVectorStateSpace::satisfiesBounds checks.
+  const auto& bounds =
+      spaceInfo->getStateSpace()->as<ompl::base::RealVectorStateSpace>()->getBounds();
+  for (const auto low : bounds.low) {
+    spaceBounds_.push_back(low - std::numeric_limits<double>::epsilon());
+  }
+  for (const auto high : bounds.high) {
+    spaceBounds_.push_back(high + std::numeric_limits<double>::epsilon());
+  }
+
+  compileHyperrectangles(obstacles, dimension_, &obstacleBounds_, &obstacleHierarchy_);
+  compileHyperrectangles(antiObstacles, dimension_, &antiObstacleBounds_,
+                         &antiObstacleHierarchy_);
+}
+
+bool HyperrectangleMotionValidator::checkMotion(const ompl::base::State* state1,
+                                                const ompl::base::State* state2) const {
+  const bool isValid = std::isinf(computeInvalidFraction(
+      state1->as<ompl::base::RealVectorStateSpace::StateType>()->values,
+      state2->as<ompl::base::RealVectorStateSpace::StateType>()->values, true));
+  if (isValid) {
+    ++valid_;
+  } else {
+    ++invalid_;
+  }
+  return isValid;
+}
+
+bool HyperrectangleMotionValidator::checkMotion(
+    const ompl::base::State* state1, const ompl::base::State* state2,
+    std::pair<ompl::base::State*, double>& lastValid) const {
+  const auto fraction = computeInvalidFraction(
+      state1->as<ompl::base::RealVectorStateSpace::StateType>()->values,
+      state2->as<ompl::base::RealVectorStateSpace::StateType>()->values, false);
+  if (std::isinf(fraction)) {
+    ++valid_;
+    return true;
+  }
+
+  // Report the state one collision checking step before the motion becomes invalid, which is
+  // what the discrete motion validator would have reported at best.
+  const auto numSegments =
+      std::max(1u, si_->getStateSpace()->validSegmentCount(state1, state2));
+  lastValid.second = std::max(0.0, fraction - 1.0 / static_cast<double>(numSegments));
+  if (lastValid.first != nullptr) {
+    si_->getStateSpace()->interpolate(state1, state2, lastValid.second, lastValid.first);
+  }
+  ++invalid_;
+  return false;
+}
+
+double HyperrectangleMotionValidator::computeInvalidFraction(const double* from, const double* to,
+                                                             bool firstOnly) const {
+  // The motion is invalid from where it leaves the bounds of the space.
+  double entry = 0.0;
+  double exit = 1.0;
+  if (!clip(spaceBounds_, 0u, from, to, &entry, &exit) || entry > 0.0) {
+    return 0.0;
+  }
+  auto invalidFraction = std::numeric_limits<double>::infinity();
+  if (exit < 1.0) {
+    if (firstOnly) {
+      return exit;
+    }
+    invalidFraction = exit;
+  }
+
+  // Collect the parts of the motion that are inside antiobstacles as sorted, disjoint intervals.
+  thread_local std::vector<std::pair<double, double>> covered;
+  covered.clear();
+  antiObstacleHierarchy_.anyIntersecting(from, to, [&](std::size_t i) {
+    if (clip(antiObstacleBounds_, i, from, to, &entry, &exit)) {
+      covered.emplace_back(entry, exit);
+    }
+    return false;
+  });
+  std::sort(covered.begin(), covered.end());
+  std::size_t numCovered = 0u;
+  for (const auto& interval : covered) {
+    if (numCovered != 0u && interval.first <= covered[numCovered - 1u].second) {
+      covered[numCovered - 1u].second = std::max(covered[numCovered - 1u].second, interval.second);
+    } else {
+      covered[numCovered++] = interval;
+    }
+  }
+  covered.resize(numCovered);
+
+  // The motion is invalid where it is inside an obstacle but not inside an antiobstacle.
+  obstacleHierarchy_.anyIntersecting(from, to, [&](std::size_t i) {
+    double begin = 0.0;
+    double end = 1.0;
+    if (!clip(obstacleBounds_, i, from, to, &begin, &end)) {
+      return false;
+    }
+    for (const auto& interval : covered) {
+      if (interval.second < begin) {
+        continue;
+      }
+      if (interval.first > begin) {
+        break;
+      }
+      begin = interval.second;
+      if (begin >= end) {
+        return false;
+      }
+    }
+    invalidFraction = std::min(invalidFraction, begin);
+    return firstOnly;
+  });
+
+  return invalidFraction;
+}
+
+bool HyperrectangleMotionValidator::clip(const std::vector<double>& bounds, std::size_t index,
+                                         const double* from, const double* to, double* entry,
+                                         double* exit) const {
+  const double* lower = &bounds[2u * index * dimension_];
+  const double* upper = lower + dimension_;
+
+  // Clip the motion against the slab of every dimension.
+  *entry = 0.0;
+  *exit = 1.0;
+  for (auto dim = 0u; dim < dimension_; ++dim) {
+    const auto direction = to[dim] - from[dim];
+    if (direction == 0.0) {
+      if (from[dim] < lower[dim] || from[dim] > upper[dim]) {
+        return false;
+      }
+      continue;
+    }
+    auto near = (lower[dim] - from[dim]) / direction;
+    auto far = (upper[dim] - from[dim]) / direction;
+    if (near > far) {
+      std::swap(near, far);
+    }
+    *entry = std::max(*entry, near);
+    *exit = std::min(*exit, far);
+    if (*entry > *exit) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
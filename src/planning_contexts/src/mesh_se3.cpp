@@ -0,0 +1,192 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/planning_contexts/mesh_se3.h"
+
+#include <ompl/base/goals/GoalSpace.h>
+#include <ompl/base/goals/GoalState.h>
+#include <ompl/base/goals/GoalStates.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+#include <ompl/base/spaces/SE3StateSpace.h>
+
+#include "pdt/config/directory.h"
+#include "pdt/obstacles/triangle_mesh.h"
+#include "pdt/planning_contexts/mesh_validity_checker.h"
+
+using namespace std::string_literals;
+
+namespace pdt {
+
+namespace planning_contexts {
+
+MeshSE3::MeshSE3(const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
+                 const std::shared_ptr<const config::Configuration>& config,
+                 const std::string& name) :
+    BaseContext(spaceInfo, config, name),
+    bounds_(3u) {
+  // Set the bounds of the translational part of the state space.
+  bounds_.low = config_->get<std::vector<double>>("context/"s + name + "/lowerBounds"s);   // x y z
+  bounds_.high = config_->get<std::vector<double>>("context/"s + name + "/upperBounds"s);  // x y z
+  spaceInfo_->getStateSpace()
+      ->as<ompl::base::CompoundStateSpace>()
+      ->as<ompl::base::RealVectorStateSpace>(0u)
+      ->setBounds(bounds_);
+
+  // Load the meshes, which are relative to the source directory, and build their hierarchies.
+  environment_ = std::make_shared<const obstacles::TriangleMeshHierarchy>(
+      obstacles::loadMesh(std::string(config::Directory::SOURCE) + "/"s +
+                          config_->get<std::string>("context/" + name + "/environmentMesh")));
+  robot_ = std::make_shared<const obstacles::TriangleMeshHierarchy>(
+      obstacles::loadMesh(std::string(config::Directory::SOURCE) + "/"s +
+                          config_->get<std::string>("context/" + name + "/robotMesh")));
+
+  // Set the validity checker and the check resolution.
+  spaceInfo_->setStateValidityChecker(
+      std::make_shared<MeshValidityChecker>(spaceInfo_, environment_, robot_));
+  spaceInfo_->setStateValidityCheckingResolution(
+      config_->get<double>("context/" + name + "/collisionCheckResolution"));
+  spaceInfo_->setup();
+
+  startGoalPairs_ = makeStartGoalPair();
+}
+
+void MeshSE3::accept(const ContextVisitor& visitor) const {
+  visitor.visit(*this);
+}
+
+std::vector<std::shared_ptr<obstacles::BaseObstacle>> MeshSE3::getObstacles() const {
+  return {};
+}
+
+std::vector<std::shared_ptr<obstacles::BaseAntiObstacle>> MeshSE3::getAntiObstacles() const {
+  return {};
+}
+
+const ompl::base::RealVectorBounds& MeshSE3::getBoundaries() const {
+  return bounds_;
+}
+
+std::shared_ptr<const obstacles::TriangleMeshHierarchy> MeshSE3::getEnvironment() const {
+  return environment_;
+}
+
+std::shared_ptr<const obstacles::TriangleMeshHierarchy> MeshSE3::getRobot() const {
+  return robot_;
+}
+
+std::vector<StartGoalPair> MeshSE3::makeStartGoalPair() const {
+  if (config_->contains("context/" + name_ + "/starts")) {
+    OMPL_ERROR("%s: Mesh contexts in SE3 do not support multiple queries.", name_.c_str());
+    throw std::runtime_error("Context error.");
+  }
+
+  // The start is given as position and unit quaternion (x y z qx qy qz qw).
+  const auto startPose = config_->get<std::vector<double>>("context/" + name_ + "/start");
+  if (startPose.size() != 7u) {
+    OMPL_ERROR("%s: Start must be specified as position and quaternion.", name_.c_str());
+    throw std::runtime_error("Context error.");
+  }
+
+  ompl::base::ScopedState<ompl::base::SE3StateSpace> startState(spaceInfo_);
+  startState->setXYZ(startPose.at(0u), startPose.at(1u), startPose.at(2u));
+  startState->rotation().x = startPose.at(3u);
+  startState->rotation().y = startPose.at(4u);
+  startState->rotation().z = startPose.at(5u);
+  startState->rotation().w = startPose.at(6u);
+
+  StartGoalPair pair;
+  pair.start = {startState};
+  pair.goal = createGoal();
+
+  return {pair};
+}
+
+std::shared_ptr<ompl::base::Goal> MeshSE3::createGoal() const {
+  switch (goalType_) {
+    case ompl::base::GoalType::GOAL_STATE: {
+      // The goal is given as position and unit quaternion (x y z qx qy qz qw).
+      const auto goalPose = config_->get<std::vector<double>>("context/" + name_ + "/goal");
+      if (goalPose.size() != 7u) {
+        OMPL_ERROR("%s: Goal must be specified as position and quaternion.", name_.c_str());
+        throw std::runtime_error("Context error.");
+      }
+
+      ompl::base::ScopedState<ompl::base::SE3StateSpace> goalState(spaceInfo_);
+      goalState->setXYZ(goalPose.at(0u), goalPose.at(1u), goalPose.at(2u));
+      goalState->rotation().x = goalPose.at(3u);
+      goalState->rotation().y = goalPose.at(4u);
+      goalState->rotation().z = goalPose.at(5u);
+      goalState->rotation().w = goalPose.at(6u);
+
+      auto goal = std::make_shared<ompl::base::GoalState>(spaceInfo_);
+      goal->setState(goalState);
+      return goal;
+    }
+    case ompl::base::GoalType::GOAL_STATES: {
+      const auto numGoals = config_->get<unsigned>("context/" + name_ + "/numGoals");
+      ompl::base::ScopedState<ompl::base::SE3StateSpace> goalState(spaceInfo_);
+      auto goal = std::make_shared<ompl::base::GoalStates>(spaceInfo_);
+      for (auto i = 0u; i < numGoals; ++i) {
+        do {
+          goalState.random();
+        } while (!spaceInfo_->isValid(goalState.get()));
+        goal->addState(goalState);
+      }
+      return goal;
+    }
+    case ompl::base::GoalType::GOAL_SPACE: {
+      ompl::base::RealVectorBounds goalBounds(3u);
+      goalBounds.low = config_->get<std::vector<double>>("context/" + name_ + "/goalLowerBounds");
+      goalBounds.high = config_->get<std::vector<double>>("context/" + name_ + "/goalUpperBounds");
+
+      auto goalSpace = std::make_shared<ompl::base::SE3StateSpace>();
+      goalSpace->setBounds(goalBounds);
+
+      auto goal = std::make_shared<ompl::base::GoalSpace>(spaceInfo_);
+      goal->setSpace(goalSpace);
+      return goal;
+    }
+    default: {
+      OMPL_ERROR("%s: Goal type not implemented.", name_.c_str());
+      throw std::runtime_error("Context error.");
+    }
+  }
+}
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
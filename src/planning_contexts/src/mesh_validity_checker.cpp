@@ -0,0 +1,105 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/planning_contexts/mesh_validity_checker.h"
+
+#include <stdexcept>
+
+#include <ompl/base/StateSpaceTypes.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+#include <ompl/base/spaces/SO3StateSpace.h>
+
+namespace pdt {
+
+namespace planning_contexts {
+
+MeshValidityChecker::MeshValidityChecker(
+    const ompl::base::SpaceInformationPtr& spaceInfo,
+    const std::shared_ptr<const obstacles::TriangleMeshHierarchy>& environment,
+    const std::shared_ptr<const obstacles::TriangleMeshHierarchy>& robot) :
+    BatchValidityChecker(spaceInfo),
+    environment_(environment),
+    robot_(robot) {
+  const auto type = spaceInfo->getStateSpace()->getType();
+  isSE3_ = type == ompl::base::StateSpaceType::STATE_SPACE_SE3;
+  if (!isSE3_ && (type != ompl::base::StateSpaceType::STATE_SPACE_REAL_VECTOR ||
+                  spaceInfo->getStateDimension() != 3u)) {
+    throw std::invalid_argument(
+        "MeshValidityChecker only supports three dimensional real vector spaces and SE(3).");
+  }
+}
+
+bool MeshValidityChecker::isValid(const ompl::base::State* state) const {
+  if (!si_->satisfiesBounds(state)) {
+    return false;
+  }
+  return !environment_->collides(*robot_, getPose(state));
+}
+
+double MeshValidityChecker::clearance(const ompl::base::State* state) const {
+  return environment_->computeDistance(*robot_, getPose(state));
+}
+
+obstacles::RigidTransform MeshValidityChecker::getPose(const ompl::base::State* state) const {
+  if (!isSE3_) {
+    const auto values = state->as<ompl::base::RealVectorStateSpace::StateType>()->values;
+    obstacles::RigidTransform pose;
+    pose.translation = {values[0u], values[1u], values[2u]};
+    return pose;
+  }
+
+  // Both SE(3) spaces are compounds of the position and an SO(3) rotation.
+  const auto compound = state->as<ompl::base::CompoundState>();
+  const auto position = compound->as<ompl::base::RealVectorStateSpace::StateType>(0u)->values;
+  const auto rotation = compound->as<ompl::base::SO3StateSpace::StateType>(1u);
+  return obstacles::RigidTransform::fromQuaternion(rotation->x, rotation->y, rotation->z,
+                                                   rotation->w,
+                                                   {position[0u], position[1u], position[2u]});
+}
+
+std::shared_ptr<const obstacles::TriangleMeshHierarchy> MeshValidityChecker::getEnvironment()
+    const {
+  return environment_;
+}
+
+std::shared_ptr<const obstacles::TriangleMeshHierarchy> MeshValidityChecker::getRobot() const {
+  return robot_;
+}
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
@@ -0,0 +1,117 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/planning_contexts/occupancy_grid.h"
+
+#include "pdt/config/directory.h"
+#include "pdt/planning_contexts/occupancy_grid_motion_validator.h"
+#include "pdt/planning_contexts/occupancy_grid_validity_checker.h"
+
+using namespace std::string_literals;
+
+namespace pdt {
+
+namespace planning_contexts {
+
+OccupancyGrid::OccupancyGrid(const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
+                             const std::shared_ptr<const config::Configuration>& config,
+                             const std::string& name) :
+    RealVectorGeometricContext(spaceInfo, config, name) {
+  if (dimensionality_ != 2u) {
+    OMPL_ERROR("%s: Occupancy grids are two dimensional.", name.c_str());
+    throw std::runtime_error("Context error.");
+  }
+
+  // Load the map, which is relative to the source directory. Raw files do not know their size.
+  const auto filename = config->get<std::string>("context/" + name + "/map");
+  const auto path = std::string(config::Directory::SOURCE) + "/"s + filename;
+  const auto threshold = config->get<double>("context/" + name + "/occupancyThreshold");
+  const std::string rawExtension{".raw"};
+  if (filename.size() >= rawExtension.size() &&
+      filename.compare(filename.size() - rawExtension.size(), rawExtension.size(),
+                       rawExtension) == 0) {
+    map_ = std::make_shared<obstacles::BinaryMap>(
+        path, config->get<std::size_t>("context/" + name + "/mapRows"),
+        config->get<std::size_t>("context/" + name + "/mapCols"), threshold);
+  } else {
+    map_ = std::make_shared<obstacles::BinaryMap>(path, threshold);
+  }
+
+  // The first row of the map spans the lowest y values, which is the last row of an image.
+  if (config->get<bool>("context/" + name + "/flipRows")) {
+    map_->flipRows();
+  }
+
+  // Obstacles are dark in most images.
+  if (config->get<bool>("context/" + name + "/invertMap")) {
+    map_->invert();
+  }
+
+  // Set the validity checker and the check resolution. The motion validator is chosen by the
+  // context factory.
+  spaceInfo_->setStateValidityChecker(
+      std::make_shared<OccupancyGridValidityChecker>(spaceInfo_, map_));
+  spaceInfo_->setStateValidityCheckingResolution(
+      config->get<double>("context/" + name + "/collisionCheckResolution"));
+
+  startGoalPairs_ = makeStartGoalPair();
+}
+
+void OccupancyGrid::accept(const ContextVisitor& visitor) const {
+  visitor.visit(*this);
+}
+
+void OccupancyGrid::useExactMotionValidation() {
+  auto checker = std::dynamic_pointer_cast<OccupancyGridValidityChecker>(
+      spaceInfo_->getStateValidityChecker());
+  if (!checker) {
+    OMPL_ERROR("%s: Exact motion validation requires an occupancy grid validity checker.",
+               name_.c_str());
+    throw std::runtime_error("Context error.");
+  }
+  spaceInfo_->setMotionValidator(
+      std::make_shared<OccupancyGridMotionValidator>(spaceInfo_, checker));
+  spaceInfo_->setup();
+}
+
+std::shared_ptr<const obstacles::BinaryMap> OccupancyGrid::getMap() const {
+  return map_;
+}
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
@@ -0,0 +1,121 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/planning_contexts/occupancy_grid_motion_validator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace pdt {
+
+namespace planning_contexts {
+
+OccupancyGridMotionValidator::OccupancyGridMotionValidator(
+    const ompl::base::SpaceInformationPtr& spaceInfo,
+    const std::shared_ptr<const OccupancyGridValidityChecker>& checker) :
+    ompl::base::MotionValidator(spaceInfo),
+    checker_(checker) {
+}
+
+bool OccupancyGridMotionValidator::checkMotion(const ompl::base::State* state1,
+                                               const ompl::base::State* state2) const {
+  const bool isValid = std::isinf(computeInvalidFraction(state1, state2));
+  if (isValid) {
+    ++valid_;
+  } else {
+    ++invalid_;
+  }
+  return isValid;
+}
+
+bool OccupancyGridMotionValidator::checkMotion(
+    const ompl::base::State* state1, const ompl::base::State* state2,
+    std::pair<ompl::base::State*, double>& lastValid) const {
+  const auto fraction = computeInvalidFraction(state1, state2);
+  if (std::isinf(fraction)) {
+    ++valid_;
+    return true;
+  }
+
+  // Report the state one collision checking step before the motion becomes invalid, which is
+  // what the discrete motion validator would have reported at best.
+  const auto numSegments =
+      std::max(1u, si_->getStateSpace()->validSegmentCount(state1, state2));
+  lastValid.second = std::max(0.0, fraction - 1.0 / static_cast<double>(numSegments));
+  if (lastValid.first != nullptr) {
+    si_->getStateSpace()->interpolate(state1, state2, lastValid.second, lastValid.first);
+  }
+  ++invalid_;
+  return false;
+}
+
+double OccupancyGridMotionValidator::computeInvalidFraction(
+    const ompl::base::State* state1, const ompl::base::State* state2) const {
+  if (!si_->satisfiesBounds(state1)) {
+    return 0.0;
+  }
+
+  // The bounds are convex, so the motion stays within them if both states do. Otherwise only the
+  // part of the motion up to where it leaves the bounds is checked against the map.
+  const auto from = checker_->getCellCoordinates(state1);
+  auto to = checker_->getCellCoordinates(state2);
+  auto exit = std::numeric_limits<double>::infinity();
+  if (!si_->satisfiesBounds(state2)) {
+    const auto& map = *checker_->getMap();
+    const double numCells[2u] = {static_cast<double>(map.getNumCols()),
+                                 static_cast<double>(map.getNumRows())};
+    exit = 1.0;
+    for (auto dim = 0u; dim < 2u; ++dim) {
+      if (to[dim] < 0.0) {
+        exit = std::min(exit, from[dim] / (from[dim] - to[dim]));
+      } else if (to[dim] > numCells[dim]) {
+        exit = std::min(exit, (numCells[dim] - from[dim]) / (to[dim] - from[dim]));
+      }
+    }
+    for (auto dim = 0u; dim < 2u; ++dim) {
+      to[dim] = from[dim] + exit * (to[dim] - from[dim]);
+    }
+  }
+
+  const auto occupied = checker_->getMap()->findFirstOccupied(from.data(), to.data());
+  return std::isinf(occupied) ? exit : occupied * exit;
+}
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
@@ -0,0 +1,93 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/planning_contexts/occupancy_grid_validity_checker.h"
+
+#include <stdexcept>
+
+#include <ompl/base/StateSpaceTypes.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+
+namespace pdt {
+
+namespace planning_contexts {
+
+OccupancyGridValidityChecker::OccupancyGridValidityChecker(
+    const ompl::base::SpaceInformationPtr& spaceInfo,
+    const std::shared_ptr<const obstacles::BinaryMap>& map) :
+    BatchValidityChecker(spaceInfo),
+    map_(map) {
+  if (spaceInfo->getStateSpace()->getType() !=
+          ompl::base::StateSpaceType::STATE_SPACE_REAL_VECTOR ||
+      spaceInfo->getStateDimension() != 2u) {
+    throw std::invalid_argument(
+        "OccupancyGridValidityChecker only supports two dimensional real vector spaces.");
+  }
+  if (map_->getNumRows() == 0u || map_->getNumCols() == 0u) {
+    throw std::invalid_argument("OccupancyGridValidityChecker needs a nonempty map.");
+  }
+
+  // The cells evenly divide the bounds of the space.
+  const auto& bounds =
+      spaceInfo->getStateSpace()->as<ompl::base::RealVectorStateSpace>()->getBounds();
+  origin_ = {bounds.low.at(0u), bounds.low.at(1u)};
+  cellsPerUnit_ = {
+      static_cast<double>(map_->getNumCols()) / (bounds.high.at(0u) - bounds.low.at(0u)),
+      static_cast<double>(map_->getNumRows()) / (bounds.high.at(1u) - bounds.low.at(1u))};
+}
+
+bool OccupancyGridValidityChecker::isValid(const ompl::base::State* state) const {
+  if (!si_->satisfiesBounds(state)) {
+    return false;
+  }
+  return !map_->isOccupied(getCellCoordinates(state).data());
+}
+
+std::shared_ptr<const obstacles::BinaryMap> OccupancyGridValidityChecker::getMap() const {
+  return map_;
+}
+
+std::array<double, 2u> OccupancyGridValidityChecker::getCellCoordinates(
+    const ompl::base::State* state) const {
+  const auto values = state->as<ompl::base::RealVectorStateSpace::StateType>()->values;
+  return {(values[0u] - origin_[0u]) * cellsPerUnit_[0u],
+          (values[1u] - origin_[1u]) * cellsPerUnit_[1u]};
+}
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
@@ -37,6 +37,7 @@
 
 #include "pdt/planning_contexts/random_rectangles.h"
 
+#include <limits>
 #include <vector>
 
 #include <ompl/base/StateValidityChecker.h>
@@ -46,7 +47,7 @@
 
 #include "pdt/obstacles/base_obstacle.h"
 #include "pdt/obstacles/hyperrectangle.h"
-#include "pdt/planning_contexts/context_validity_checker_gnat.h"
+#include "pdt/planning_contexts/context_validity_checker_bvh.h"
 
 using namespace std::string_literals;
 
@@ -99,92 +100,61 @@ RandomRectangles::RandomRectangles(const std::shared_ptr<ompl::base::SpaceInform
 
   // Create the obstacles and add them to the validity checker.
   createObstacles();
+  setupValidityChecker();
 
+  if (!generateQueriesBeforeObstacles) {
+    startGoalPairs_ = makeStartGoalPair();
+  }
+}
+
+RandomRectangles::RandomRectangles(const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
+                                   const std::shared_ptr<const config::Configuration>& config,
+                                   const std::string& name,
+                                   const context_snapshot::Reader& snapshot) :
+    RealVectorGeometricContext(spaceInfo, config, name),
+    numRectangles_(config->get<std::size_t>("context/" + name + "/numObstacles")),
+    minSideLength_(config->get<double>("context/" + name + "/minSideLength")),
+    maxSideLength_(config->get<double>("context/" + name + "/maxSideLength")) {
+  restore(snapshot);
+  setupValidityChecker();
+
+  // Draw the random numbers that generating the obstacles and queries draws, such that queries
+  // that are regenerated later are the ones of a context that is generated anew.
+  rng_.uniformInt(0, std::numeric_limits<int>::max());
+  makeStartGoalPair();
+}
+
+void RandomRectangles::accept(const ContextVisitor& visitor) const {
+  visitor.visit(*this);
+}
+
+void RandomRectangles::setupValidityChecker() {
   // Create the validity checker.
   std::shared_ptr<ContextValidityChecker> validityChecker;
   if (numRectangles_ < 500) {
     validityChecker = std::make_shared<ContextValidityChecker>(spaceInfo_);
   } else {
-    validityChecker = std::make_shared<ContextValidityCheckerGNAT>(spaceInfo_);
+    validityChecker = std::make_shared<ContextValidityCheckerBVH>(spaceInfo_);
   }
 
   // Add the obstacles to the validity checker.
   validityChecker->addObstacles(obstacles_);
+  validityChecker->addHyperrectangles(hyperrectangles_);
 
   // Set the validity checker and the check resolution.
   spaceInfo_->setStateValidityChecker(validityChecker);
   spaceInfo_->setStateValidityCheckingResolution(
-      config->get<double>("context/" + name + "/collisionCheckResolution"));
+      config_->get<double>("context/" + name_ + "/collisionCheckResolution"));
 
   // Set up the space info.
   spaceInfo_->setup();
-
-  if (!generateQueriesBeforeObstacles) {
-    startGoalPairs_ = makeStartGoalPair();
-  }
-}
-
-void RandomRectangles::accept(const ContextVisitor& visitor) const {
-  visitor.visit(*this);
 }
 
 void RandomRectangles::createObstacles() {
-  // Instantiate obstacles.
-  while (obstacles_.size() < numRectangles_) {
-    // Create a random anchor (uniform).
-    ompl::base::ScopedState<> anchor(spaceInfo_);
-    anchor.random();
-
-    // Create random widths (uniform).
-    std::vector<double> widths(dimensionality_, 0.0);
-    for (std::size_t j = 0; j < dimensionality_; ++j) {
-      widths[j] = rng_.uniformReal(minSideLength_, maxSideLength_);
-    }
-
-    auto obstacle = std::make_shared<obstacles::Hyperrectangle<obstacles::BaseObstacle>>(
-        spaceInfo_, anchor, widths);
-
-    // Add this to the obstacles if it doesn't invalidate the start or goal state.
-    bool invalidates = false;
-    for (const auto& startGoalPair : startGoalPairs_) {
-      for (const auto& start : startGoalPair.start) {
-        if (obstacle->invalidates(start)) {
-          invalidates = true;
-          // Break out of inner for loop over starts
-          break;
-        }
-      }
-      if (invalidates) {
-        // Break out of outer for loop over start-goal pairs
-        break;
-      }
-
-      if (goalType_ == ompl::base::GoalType::GOAL_STATE) {
-        if (obstacle->invalidates(startGoalPair.goal->as<ompl::base::GoalState>()->getState())) {
-          invalidates = true;
-        }
-      } else if (goalType_ == ompl::base::GoalType::GOAL_STATES) {
-        for (auto i = 0u; i < startGoalPair.goal->as<ompl::base::GoalStates>()->getStateCount();
-             ++i) {
-          if (obstacle->invalidates(
-                  startGoalPair.goal->as<ompl::base::GoalStates>()->getState(i))) {
-            invalidates = true;
-            // Break out of inner for loop over goals
-            break;
-          }
-        }
-      }
-
-      if (invalidates) {
-        // Break out of outer for loop over start-goal pairs
-        break;
-      }
-    }
-
-    if (!invalidates) {
-      obstacles_.push_back(obstacle);
-    }
-  }
+  // The obstacles must not invalidate the start and goal states that have been created so far.
+  createRandomRectangles(numRectangles_, minSideLength_, maxSideLength_,
+                         static_cast<std::uint_fast32_t>(
+                             rng_.uniformInt(0, std::numeric_limits<int>::max())));
 }
 
 }  // namespace planning_contexts
@@ -37,6 +37,7 @@
 
 #include "pdt/planning_contexts/random_rectangles_multi_start_goal.h"
 
+#include <limits>
 #include <vector>
 
 #include <ompl/base/GoalTypes.h>
@@ -46,7 +47,7 @@
 
 #include "pdt/obstacles/base_obstacle.h"
 #include "pdt/obstacles/hyperrectangle.h"
-#include "pdt/planning_contexts/context_validity_checker_gnat.h"
+#include "pdt/planning_contexts/context_validity_checker_bvh.h"
 
 namespace pdt {
 
@@ -78,17 +79,39 @@ RandomRectanglesMultiStartGoal::RandomRectanglesMultiStartGoal(
     throw std::runtime_error("Context error.");
   }
 
-  // Create the validity checker.
-  auto validityChecker = std::make_shared<ContextValidityCheckerGNAT>(spaceInfo_);
-
   // Create the obstacles and add them to the validity checker.
   createObstacles();
+  setupValidityChecker();
+}
+
+RandomRectanglesMultiStartGoal::RandomRectanglesMultiStartGoal(
+    const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
+    const std::shared_ptr<const config::Configuration>& config, const std::string& name,
+    const context_snapshot::Reader& snapshot) :
+    RealVectorGeometricContext(spaceInfo, config, name),
+    numRectangles_(config->get<std::size_t>("context/" + name + "/numObstacles")),
+    minSideLength_(config->get<double>("context/" + name + "/minSideLength")),
+    maxSideLength_(config->get<double>("context/" + name + "/maxSideLength")),
+    numStarts_(config->get<std::size_t>("context/" + name + "/numStarts")),
+    numGoals_(config->get<std::size_t>("context/" + name + "/numGoals")) {
+  restore(snapshot);
+  setupValidityChecker();
+
+  // Advance the random number generators as if the queries and obstacles had been generated.
+  rng_.uniformInt(0, std::numeric_limits<int>::max());
+  makeStartGoalPair();
+}
+
+void RandomRectanglesMultiStartGoal::setupValidityChecker() {
+  // Create the validity checker and add the obstacles to it.
+  auto validityChecker = std::make_shared<ContextValidityCheckerBVH>(spaceInfo_);
   validityChecker->addObstacles(obstacles_);
+  validityChecker->addHyperrectangles(hyperrectangles_);
 
   // Set the validity checker and the check resolution.
   spaceInfo_->setStateValidityChecker(validityChecker);
   spaceInfo_->setStateValidityCheckingResolution(
-      config->get<double>("context/" + name + "/collisionCheckResolution"));
+      config_->get<double>("context/" + name_ + "/collisionCheckResolution"));
 
   // Set up the space info.
   spaceInfo_->setup();
@@ -121,48 +144,10 @@ void RandomRectanglesMultiStartGoal::accept(const ContextVisitor& visitor) const
 }
 
 void RandomRectanglesMultiStartGoal::createObstacles() {
-  // Instantiate obstacles.
-  for (int i = 0; i < static_cast<int>(numRectangles_); ++i) {
-    // Create a random anchor (uniform).
-    ompl::base::ScopedState<> anchor(spaceInfo_);
-    anchor.random();
-    // Create random widths (uniform).
-    std::vector<double> widths(dimensionality_, 0.0);
-    for (std::size_t j = 0; j < dimensionality_; ++j) {
-      widths[j] = rng_.uniformReal(minSideLength_, maxSideLength_);
-    }
-    bool invalidates = false;
-    auto obstacle = std::make_shared<obstacles::Hyperrectangle<obstacles::BaseObstacle>>(
-        spaceInfo_, anchor, widths);
-    // Add this to the obstacles if it doesn't invalidate the start or goal states.
-    for (const auto& start : startGoalPairs_[0].start) {
-      if (obstacle->invalidates(start)) {
-        invalidates = true;
-        break;
-      }
-    }
-    if (!invalidates && (goalType_ == ompl::base::GoalType::GOAL_STATE ||
-                         goalType_ == ompl::base::GoalType::GOAL_STATES)) {
-      const auto& goal = startGoalPairs_[0].goal;
-      if (goalType_ == ompl::base::GoalType::GOAL_STATE) {
-        invalidates = obstacle->invalidates(goal->as<ompl::base::GoalState>()->getState());
-        break;
-      }
-      if (goalType_ == ompl::base::GoalType::GOAL_STATES) {
-        for (auto i = 0u; i < goal->as<ompl::base::GoalStates>()->getStateCount(); ++i) {
-          if (obstacle->invalidates(goal->as<ompl::base::GoalStates>()->getState(i))) {
-            invalidates = true;
-            break;
-          }
-        }
-      }
-    }
-    if (!invalidates) {
-      obstacles_.push_back(obstacle);
-    } else {
-      --i;
-    }
-  }
+  // The obstacles must not invalidate the start and goal states that have been created so far.
+  createRandomRectangles(numRectangles_, minSideLength_, maxSideLength_,
+                         static_cast<std::uint_fast32_t>(
+                             rng_.uniformInt(0, std::numeric_limits<int>::max())));
 }
 
 }  // namespace planning_contexts
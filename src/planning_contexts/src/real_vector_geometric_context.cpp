@@ -37,10 +37,25 @@
 
 #include "pdt/planning_contexts/real_vector_geometric_context.h"
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <thread>
+
 #include <ompl/base/goals/GoalSpace.h>
 #include <ompl/base/goals/GoalState.h>
 #include <ompl/base/goals/GoalStates.h>
 #include <ompl/base/spaces/RealVectorStateSpace.h>
+#include <ompl/util/RandomNumbers.h>
+
+#include "pdt/objectives/max_min_clearance_optimization_objective.h"
+#include "pdt/obstacles/distance_field.h"
+#include "pdt/obstacles/hyperrectangle.h"
+#include "pdt/obstacles/point_kd_tree.h"
+#include "pdt/planning_contexts/context_validity_checker.h"
+#include "pdt/planning_contexts/hyperrectangle_motion_validator.h"
+#include "pdt/utilities/thread_affinity.h"
 
 namespace pdt {
 
@@ -50,7 +65,8 @@ RealVectorGeometricContext::RealVectorGeometricContext(
     const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
     const std::shared_ptr<const config::Configuration>& config, const std::string& name) :
     BaseContext(spaceInfo, config, name),
-    bounds_(static_cast<unsigned int>(dimensionality_)) {
+    bounds_(static_cast<unsigned int>(dimensionality_)),
+    hyperrectangles_(dimensionality_) {
   // Fill the state space bounds.
   auto sideLengths = config->get<std::vector<double>>("context/" + name + "/boundarySideLengths");
   assert(sideLengths.size() == dimensionality_);
@@ -58,11 +74,36 @@ RealVectorGeometricContext::RealVectorGeometricContext(
     bounds_.low.at(dim) = -0.5 * sideLengths.at(dim);
     bounds_.high.at(dim) = 0.5 * sideLengths.at(dim);
   }
+
+  // The clearance of the obstacles is the Euclidean distance to them.
+  if (auto clearanceObjective =
+          std::dynamic_pointer_cast<objectives::MaxMinClearanceOptimizationObjective>(
+              objective_)) {
+    clearanceObjective->setClearanceLipschitzConstant(1.0);
+  }
 }
 
 std::vector<std::shared_ptr<obstacles::BaseObstacle>> RealVectorGeometricContext::getObstacles()
     const {
-  return obstacles_;
+  std::lock_guard<std::mutex> lock(hyperrectangleObstaclesMutex_);
+
+  // Hyperrectangles are only ever appended, so only the new ones need obstacle objects.
+  ompl::base::ScopedState<> anchor(spaceInfo_);
+  for (auto i = hyperrectangleObstacles_.size(); i < hyperrectangles_.size(); ++i) {
+    const auto center = hyperrectangles_.getCenter(i);
+    const auto widths = hyperrectangles_.getWidths(i);
+    for (auto dim = 0u; dim < dimensionality_; ++dim) {
+      anchor[dim] = center[dim];
+    }
+    hyperrectangleObstacles_.push_back(
+        std::make_shared<obstacles::Hyperrectangle<obstacles::BaseObstacle>>(
+            spaceInfo_, anchor, std::vector<double>(widths, widths + dimensionality_)));
+  }
+
+  auto obstacles = obstacles_;
+  obstacles.insert(obstacles.end(), hyperrectangleObstacles_.begin(),
+                   hyperrectangleObstacles_.end());
+  return obstacles;
 }
 
 std::vector<std::shared_ptr<obstacles::BaseAntiObstacle>>
@@ -70,6 +111,15 @@ RealVectorGeometricContext::getAntiObstacles() const {
   return antiObstacles_;
 }
 
+const std::vector<std::shared_ptr<obstacles::BaseObstacle>>&
+RealVectorGeometricContext::getObstacleObjects() const {
+  return obstacles_;
+}
+
+const obstacles::HyperrectangleSet& RealVectorGeometricContext::getHyperrectangles() const {
+  return hyperrectangles_;
+}
+
 const ompl::base::RealVectorBounds& RealVectorGeometricContext::getBoundaries() const {
   return bounds_;
 }
@@ -78,6 +128,31 @@ void RealVectorGeometricContext::accept(const ContextVisitor& visitor) const {
   visitor.visit(*this);
 }
 
+void RealVectorGeometricContext::useExactMotionValidation() {
+  spaceInfo_->setMotionValidator(
+      std::make_shared<HyperrectangleMotionValidator>(spaceInfo_, getObstacles(), antiObstacles_));
+  spaceInfo_->setup();
+}
+
+void RealVectorGeometricContext::useDistanceField(double resolution) {
+  auto checker =
+      std::dynamic_pointer_cast<ContextValidityChecker>(spaceInfo_->getStateValidityChecker());
+  if (!checker) {
+    OMPL_ERROR("%s: Distance fields require a context validity checker.", name_.c_str());
+    throw std::runtime_error("Context error.");
+  }
+  auto field = std::make_shared<obstacles::DistanceField>(spaceInfo_, getObstacles(), resolution,
+                                                          utilities::getNumAvailableCores());
+  checker->setDistanceField(field);
+
+  // The interpolated clearance changes faster than the exact clearance.
+  if (auto clearanceObjective =
+          std::dynamic_pointer_cast<objectives::MaxMinClearanceOptimizationObjective>(
+              objective_)) {
+    clearanceObjective->setClearanceLipschitzConstant(field->getLipschitzConstant());
+  }
+}
+
 std::shared_ptr<ompl::base::Goal> RealVectorGeometricContext::createGoal() const {
   // Instantiate the goal.
   switch (goalType_) {
@@ -138,6 +213,156 @@ std::shared_ptr<ompl::base::Goal> RealVectorGeometricContext::createGoal() const
   }
 }
 
+void RealVectorGeometricContext::restore(const context_snapshot::Reader& snapshot) {
+  if (snapshot.getDimension() != dimensionality_) {
+    OMPL_ERROR("%s: Dimensionality of problem and of snapshot does not match.", name_.c_str());
+    throw std::runtime_error("Context error.");
+  }
+  for (std::size_t dim = 0u; dim < dimensionality_; ++dim) {
+    if (snapshot.getLowerBounds()[dim] != bounds_.low.at(dim) ||
+        snapshot.getUpperBounds()[dim] != bounds_.high.at(dim)) {
+      OMPL_ERROR("%s: Bounds of problem and of snapshot do not match.", name_.c_str());
+      throw std::runtime_error("Context error.");
+    }
+  }
+
+  auto makeState = [this](const double* values) {
+    ompl::base::ScopedState<> state(spaceInfo_);
+    for (auto i = 0u; i < dimensionality_; ++i) {
+      state[i] = values[i];
+    }
+    return state;
+  };
+
+  // Restore the obstacles and antiobstacles. The obstacles are all hyperrectangles.
+  obstacles_.clear();
+  hyperrectangles_.clear();
+  hyperrectangleObstacles_.clear();
+  for (std::size_t i = 0u; i < snapshot.getNumObstacles(); ++i) {
+    hyperrectangles_.add(snapshot.getObstacleAnchor(i), snapshot.getObstacleWidths(i));
+  }
+  antiObstacles_.clear();
+  antiObstacles_.reserve(snapshot.getNumAntiObstacles());
+  for (std::size_t i = 0u; i < snapshot.getNumAntiObstacles(); ++i) {
+    const auto widths = snapshot.getAntiObstacleWidths(i);
+    antiObstacles_.push_back(
+        std::make_shared<obstacles::Hyperrectangle<obstacles::BaseAntiObstacle>>(
+            spaceInfo_, makeState(snapshot.getAntiObstacleAnchor(i)),
+            std::vector<double>(widths, widths + dimensionality_)));
+  }
+
+  // Restore the queries.
+  startGoalPairs_.clear();
+  for (std::size_t q = 0u; q < snapshot.getNumQueries(); ++q) {
+    StartGoalPair pair;
+    for (std::size_t i = 0u; i < snapshot.getNumStarts(q); ++i) {
+      pair.start.push_back(makeState(snapshot.getStart(q, i)));
+    }
+    if (snapshot.getNumGoals(q) == 0u) {
+      pair.goal = createGoal();
+    } else if (goalType_ == ompl::base::GoalType::GOAL_STATE) {
+      auto goal = std::make_shared<ompl::base::GoalState>(spaceInfo_);
+      goal->setState(makeState(snapshot.getGoal(q, 0u)));
+      pair.goal = goal;
+    } else {
+      auto goal = std::make_shared<ompl::base::GoalStates>(spaceInfo_);
+      for (std::size_t i = 0u; i < snapshot.getNumGoals(q); ++i) {
+        goal->addState(makeState(snapshot.getGoal(q, i)));
+      }
+      pair.goal = goal;
+    }
+    startGoalPairs_.push_back(pair);
+  }
+}
+
+void RealVectorGeometricContext::createRandomRectangles(std::size_t numRectangles,
+                                                        double minSideLength,
+                                                        double maxSideLength,
+                                                        std::uint_fast32_t seed) {
+  // Index the start and goal states, such that a candidate is only tested against nearby states.
+  std::vector<double> states;
+  auto addState = [&states, this](const ompl::base::State* state) {
+    const auto values = state->as<ompl::base::RealVectorStateSpace::StateType>()->values;
+    states.insert(states.end(), values, values + dimensionality_);
+  };
+  for (const auto& startGoalPair : startGoalPairs_) {
+    for (const auto& start : startGoalPair.start) {
+      addState(start.get());
+    }
+    if (goalType_ == ompl::base::GoalType::GOAL_STATE) {
+      addState(startGoalPair.goal->as<ompl::base::GoalState>()->getState());
+    } else if (goalType_ == ompl::base::GoalType::GOAL_STATES) {
+      const auto goal = startGoalPair.goal->as<ompl::base::GoalStates>();
+      for (auto i = 0u; i < goal->getStateCount(); ++i) {
+        addState(goal->getState(i));
+      }
+    }
+  }
+  obstacles::PointKdTree stateTree(dimensionality_);
+  stateTree.build(states);
+
+  // Draws the candidates of a chunk and keeps the centers and widths of the valid ones. The
+  // bounds are widened like the ones of Hyperrectangle::isInside, so both reject the same states.
+  constexpr std::size_t chunkSize = 1024u;
+  auto drawChunk = [&, this](std::size_t chunk, std::vector<double>* centers,
+                             std::vector<double>* widths) {
+    ompl::RNG rng(static_cast<std::uint_fast32_t>(seed + chunk));
+    std::vector<double> center(dimensionality_), width(dimensionality_);
+    std::vector<double> lowerBounds(dimensionality_), upperBounds(dimensionality_);
+    for (auto candidate = 0u; candidate < chunkSize; ++candidate) {
+      for (auto dim = 0u; dim < dimensionality_; ++dim) {
+        center[dim] = rng.uniformReal(bounds_.low[dim], bounds_.high[dim]);
+      }
+      for (auto dim = 0u; dim < dimensionality_; ++dim) {
+        width[dim] = rng.uniformReal(minSideLength, maxSideLength);
+        lowerBounds[dim] =
+            center[dim] - width[dim] / 2.0 - std::numeric_limits<double>::epsilon();
+        upperBounds[dim] =
+            center[dim] + width[dim] / 2.0 + std::numeric_limits<double>::epsilon();
+      }
+      if (!stateTree.anyInside(lowerBounds.data(), upperBounds.data())) {
+        centers->insert(centers->end(), center.begin(), center.end());
+        widths->insert(widths->end(), width.begin(), width.end());
+      }
+    }
+  };
+
+  // Draw rounds of chunks until enough candidates are valid. The valid candidates are taken in the
+  // order of their chunks, so the rounds and the threads that drew them do not matter. They are
+  // added to the compactly stored hyperrectangles as they are, without creating obstacle objects.
+  const auto numThreads = std::max<std::size_t>(1u, utilities::getNumAvailableCores());
+  const auto targetSize = hyperrectangles_.size() + numRectangles;
+  std::size_t firstChunk = 0u;
+  while (hyperrectangles_.size() < targetSize) {
+    const auto numMissing = targetSize - hyperrectangles_.size();
+    const auto numChunks = std::max(numThreads, (numMissing + chunkSize - 1u) / chunkSize);
+    std::vector<std::vector<double>> chunkCenters(numChunks), chunkWidths(numChunks);
+    std::atomic<std::size_t> nextChunk{0u};
+    auto drawChunks = [&]() {
+      for (auto chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++) {
+        drawChunk(firstChunk + chunk, &chunkCenters[chunk], &chunkWidths[chunk]);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (auto i = 1u; i < std::min(numThreads, numChunks); ++i) {
+      threads.emplace_back(drawChunks);
+    }
+    drawChunks();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (auto chunk = 0u; chunk < numChunks; ++chunk) {
+      for (std::size_t i = 0u; i < chunkCenters[chunk].size(); i += dimensionality_) {
+        if (hyperrectangles_.size() == targetSize) {
+          break;
+        }
+        hyperrectangles_.add(&chunkCenters[chunk][i], &chunkWidths[chunk][i]);
+      }
+    }
+    firstChunk += numChunks;
+  }
+}
+
 }  // namespace planning_contexts
 
 }  // namespace pdt
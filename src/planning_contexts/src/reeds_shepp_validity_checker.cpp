@@ -37,6 +37,9 @@
 
 #include "pdt/planning_contexts/reeds_shepp_validity_checker.h"
 
+#include <cmath>
+#include <stdexcept>
+
 #include <ompl/base/spaces/SE2StateSpace.h>
 
 namespace pdt {
@@ -45,14 +48,15 @@ namespace planning_contexts {
 
 ReedsSheppValidityChecker::ReedsSheppValidityChecker(
     const ompl::base::SpaceInformationPtr& spaceInfo) :
-    ompl::base::StateValidityChecker(spaceInfo),
+    BatchValidityChecker(spaceInfo),
     circumradius_(std::sqrt(std::pow(width_, 2.0) + std::pow(length_, 2.0)) / 2.0),
     vectorSpace_(spaceInfo->getStateSpace()
                      ->as<ompl::base::CompoundStateSpace>()
                      ->as<ompl::base::RealVectorStateSpace>(0u)),
     so2Space_(spaceInfo->getStateSpace()
                   ->as<ompl::base::CompoundStateSpace>()
-                  ->as<ompl::base::SO2StateSpace>(1u)) {
+                  ->as<ompl::base::SO2StateSpace>(1u)),
+    grid_(2.0 * circumradius_) {
 }
 
 bool ReedsSheppValidityChecker::isValid(const ompl::base::State* state) const {
@@ -65,87 +69,31 @@ bool ReedsSheppValidityChecker::isValid(const ompl::base::State* state) const {
   const auto carVecState = carSE2State->as<ompl::base::RealVectorStateSpace::StateType>(0u);
   const auto carSO2State = carSE2State->as<ompl::base::SO2StateSpace::StateType>(1u);
 
-  // A state is invalid if it collides with an obstacle.
-  for (const auto& obstacle : obstacles_) {
-    const auto obs =
-        dynamic_cast<obstacles::Hyperrectangle<obstacles::BaseObstacle>*>(obstacle.get());
-
-    // This is a tiny optimization: If the distance between the centers of both rectangles is larger
-    // then the sum of the  circumscribing radii, then the orientation of the rectangles doesn't
-    // matter.
-    const auto obsState = obs->getAnchor();
-    const auto obsCircumradius = obs->getCircumradius();
-    if (vectorSpace_->distance(obsState->as<ompl::base::RealVectorStateSpace::StateType>(),
-                               carVecState) >= obsCircumradius + circumradius_) {
-      continue;
-    }
+  // The orientation of the car is needed once per state, not once per corner and obstacle. The
+  // sine and cosine of the same angle are computed together by the compiler.
+  const auto cosine = std::cos(carSO2State->value);
+  const auto sine = std::sin(carSO2State->value);
 
-    // We need to do a bit more work if this is not the case. We're using the separation axis
-    // theorem, as described here:
-    // https://www.gamedev.net/tutorials/_/technical/game-programming/2d-rotated-rectangle-collision-r2604/
-
-    // Get the width and height of the obstacle.
-    const auto obsWidth = obs->getWidths().at(0u);
-    const auto obsHeight = obs->getWidths().at(1u);
-
-    // Compute the corners of the obstacle in world coordinates and clockwise order, starting from
-    // upper left: upper left, upper right, lower right, lower left.
-    const std::vector<Point> obsCornersWorld{
-        {obsState[0u] - (obsWidth / 2.0), obsState[1u] + (obsHeight / 2.0)},
-        {obsState[0u] + (obsWidth / 2.0), obsState[1u] + (obsHeight / 2.0)},
-        {obsState[0u] + (obsWidth / 2.0), obsState[1u] - (obsHeight / 2.0)},
-        {obsState[0u] - (obsWidth / 2.0), obsState[1u] - (obsHeight / 2.0)}};
-
-    // Compute the corners of the car in car coordinates:
-    // front left, front right, rear right, rear left.
-    const std::vector<Point> carCornersCar{{length_ / 2.0, -width_ / 2.0},
-                                           {length_ / 2.0, width_ / 2.0},
-                                           {-length_ / 2.0, width_ / 2.0},
-                                           {-length_ / 2.0, -width_ / 2.0}};
-
-    // Compute the corners of the car in world coordinates.
-    std::vector<Point> carCornersWorld{{0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}};
-    for (auto i = 0u; i < 4u; ++i) {
-      const auto psi = std::atan2(carCornersCar[i][1u], carCornersCar[i][0u]);
-      const auto rad =
-          std::sqrt(std::pow(carCornersCar[i][0u], 2.0) + std::pow(carCornersCar[i][1u], 2.0));
-
-      carCornersWorld.at(i)[0u] = rad * std::cos(carSO2State->value + psi) + (*carVecState)[0u];
-      carCornersWorld.at(i)[1u] = rad * std::sin(carSO2State->value + psi) + (*carVecState)[1u];
-    }
+  // A state is invalid if the car intersects an obstacle, which the grid checks with the separating
+  // axis theorem, as described here:
+  // https://www.gamedev.net/tutorials/_/technical/game-programming/2d-rotated-rectangle-collision-r2604/
+  return !grid_.intersects((*carVecState)[0u], (*carVecState)[1u], cosine, sine, length_ / 2.0,
+                           width_ / 2.0);
+}
 
-    // Compute the four axes for projection.
-    std::vector<Axis> axes{{obsCornersWorld[1u][0u] - obsCornersWorld[0u][0u],
-                            obsCornersWorld[1u][1u] - obsCornersWorld[0u][1u]},
-                           {obsCornersWorld[1u][0u] - obsCornersWorld[2u][0u],
-                            obsCornersWorld[1u][1u] - obsCornersWorld[2u][1u]},
-                           {carCornersWorld[0u][0u] - carCornersWorld[3u][0u],
-                            carCornersWorld[0u][1u] - carCornersWorld[3u][1u]},
-                           {carCornersWorld[0u][0u] - carCornersWorld[1u][0u],
-                            carCornersWorld[0u][1u] - carCornersWorld[1u][1u]}};
-
-    // Project the corners of the car and obstacle onto the four axes.
-    for (const auto& axis : axes) {
-      std::array<double, 4u> car{0.0, 0.0, 0.0, 0.0};
-      for (auto i = 0u; i < 4u; ++i) {
-        car[i] = dotProduct(project(carCornersWorld[i], axis), axis);
-      }
-      auto [minCar, maxCar] = std::minmax_element(car.begin(), car.end());
-
-      std::array<double, 4u> obs{0.0, 0.0, 0.0, 0.0};
-      for (auto i = 0u; i < 4u; ++i) {
-        obs[i] = dotProduct(project(obsCornersWorld[i], axis), axis);
-      }
-      auto [minObs, maxObs] = std::minmax_element(obs.begin(), obs.end());
-
-      // If there is no overlap, then the obstacle cannot be in collision with the car.
-      if (minCar <= maxObs || minObs <= maxCar) {
-        return false;
-      }
+bool ReedsSheppValidityChecker::isValid(const ompl::base::State* const* states,
+                                        std::size_t numStates) const {
+  // Checking the bounds is much cheaper than checking for collisions.
+  for (std::size_t i = 0u; i < numStates; ++i) {
+    if (!si_->satisfiesBounds(states[i])) {
+      return false;
+    }
+  }
+  for (std::size_t i = 0u; i < numStates; ++i) {
+    if (!isValid(states[i])) {
+      return false;
     }
   }
-
-  // The state satisfies the bounds and is not invalidated by any obstacles.
   return true;
 }
 
@@ -159,24 +107,29 @@ double ReedsSheppValidityChecker::clearance(const ompl::base::State* state) cons
   return minDistance;
 }
 
-std::array<double, 2u> ReedsSheppValidityChecker::project(const Point& point,
-                                                          const Axis& axis) const {
-  const double frac =
-      (point[0u] * axis[0u] + point[1u] * axis[1u]) / (axis[0u] * axis[0u] + axis[1u] * axis[1u]);
-  return {frac * axis[0u], frac * axis[1u]};
-}
-
-double ReedsSheppValidityChecker::dotProduct(const Point& point, const Axis& axis) const {
-  return point[0u] * axis[0u] + point[1u] * axis[1u];
-}
-
 void ReedsSheppValidityChecker::addObstacle(
     const std::shared_ptr<obstacles::BaseObstacle>& obstacle) {
-  obstacles_.push_back(obstacle);
+  addObstacles({obstacle});
 }
 
 void ReedsSheppValidityChecker::addObstacles(
     const std::vector<std::shared_ptr<obstacles::BaseObstacle>>& obstacles) {
+  std::vector<std::array<double, 2u>> centers;
+  std::vector<std::array<double, 2u>> widths;
+  centers.reserve(obstacles.size());
+  widths.reserve(obstacles.size());
+  for (const auto& obstacle : obstacles) {
+    const auto rectangle =
+        std::dynamic_pointer_cast<obstacles::Hyperrectangle<obstacles::BaseObstacle>>(obstacle);
+    if (!rectangle) {
+      OMPL_ERROR("The Reeds-Shepp validity checker only supports rectangular obstacles.");
+      throw std::runtime_error("Validity checker error.");
+    }
+    const auto anchor = rectangle->getAnchor();
+    centers.push_back({{anchor[0u], anchor[1u]}});
+    widths.push_back({{rectangle->getWidths().at(0u), rectangle->getWidths().at(1u)}});
+  }
+  grid_.add(centers, widths);
   obstacles_.insert(obstacles_.end(), obstacles.begin(), obstacles.end());
 }
 
@@ -65,15 +65,8 @@ ContextValidityCheckerRepeatingRectangles::ContextValidityCheckerRepeatingRectan
   }
 }
 
-bool ContextValidityCheckerRepeatingRectangles::isValid(const ompl::base::State* state) const {
-  if (!state) {
-    throw std::runtime_error("ContextValidityCheckerRepeatingRectangles recieved nullptr state.");
-  }
-  // If the state does not satisfy the space bounds, it is not valid.
-  if (!si_->satisfiesBounds(state)) {
-    return false;
-  }
-
+bool ContextValidityCheckerRepeatingRectangles::isCollisionFree(
+    const ompl::base::State* state) const {
   ompl::base::ScopedState<> scopedState(si_->getStateSpace(), state);
   auto bounds = si_->getStateSpace()->as<ompl::base::RealVectorStateSpace>()->getBounds();
 
@@ -106,6 +99,16 @@ bool ContextValidityCheckerRepeatingRectangles::isValid(const ompl::base::State*
   return false;
 }
 
+bool ContextValidityCheckerRepeatingRectangles::isCollisionFree(
+    const ompl::base::State* const* states, std::size_t numStates) const {
+  for (std::size_t i = 0u; i < numStates; ++i) {
+    if (!isCollisionFree(states[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
 RepeatingRectangles::RepeatingRectangles(
     const std::shared_ptr<ompl::base::SpaceInformation>& spaceInfo,
     const std::shared_ptr<const config::Configuration>& config, const std::string& name) :
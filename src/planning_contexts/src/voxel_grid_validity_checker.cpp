@@ -0,0 +1,167 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/planning_contexts/voxel_grid_validity_checker.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include <ompl/base/StateSpaceTypes.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+#include <ompl/base/spaces/SE3StateSpace.h>
+
+namespace pdt {
+
+namespace planning_contexts {
+
+VoxelGridValidityChecker::VoxelGridValidityChecker(
+    const ompl::base::SpaceInformationPtr& spaceInfo,
+    const std::shared_ptr<const obstacles::VoxelMap>& map,
+    const std::vector<std::array<double, 3u>>& robotPoints) :
+    BatchValidityChecker(spaceInfo),
+    map_(map),
+    robotPoints_(robotPoints) {
+  const auto type = spaceInfo->getStateSpace()->getType();
+  isSE3_ = type == ompl::base::StateSpaceType::STATE_SPACE_SE3;
+  if (!isSE3_ && (type != ompl::base::StateSpaceType::STATE_SPACE_REAL_VECTOR ||
+                  spaceInfo->getStateDimension() != 3u)) {
+    throw std::invalid_argument(
+        "VoxelGridValidityChecker only supports three dimensional real vector spaces and SE(3).");
+  }
+  const auto& numVoxels = map_->getNumVoxels();
+  if (std::find(numVoxels.cbegin(), numVoxels.cend(), 0u) != numVoxels.cend()) {
+    throw std::invalid_argument("VoxelGridValidityChecker needs a nonempty map.");
+  }
+  if (robotPoints_.empty()) {
+    throw std::invalid_argument("VoxelGridValidityChecker needs at least one robot point.");
+  }
+
+  // The voxels evenly divide the bounds of the space.
+  const auto& bounds =
+      isSE3_ ? spaceInfo->getStateSpace()->as<ompl::base::SE3StateSpace>()->getBounds()
+             : spaceInfo->getStateSpace()->as<ompl::base::RealVectorStateSpace>()->getBounds();
+  for (auto dim = 0u; dim < 3u; ++dim) {
+    origin_[dim] = bounds.low.at(dim);
+    voxelSideLengths_[dim] =
+        (bounds.high.at(dim) - bounds.low.at(dim)) / static_cast<double>(numVoxels[dim]);
+    voxelsPerUnit_[dim] = 1.0 / voxelSideLengths_[dim];
+  }
+}
+
+bool VoxelGridValidityChecker::isValid(const ompl::base::State* state) const {
+  if (!si_->satisfiesBounds(state)) {
+    return false;
+  }
+
+  // The points of a robot that has an extent can leave the map even if its state is within the
+  // bounds.
+  const auto& numVoxels = map_->getNumVoxels();
+  for (const auto& robotPoint : robotPoints_) {
+    const auto coordinates = getVoxelCoordinates(transform(state, robotPoint));
+    for (auto dim = 0u; dim < 3u; ++dim) {
+      if (coordinates[dim] < 0.0 || coordinates[dim] > static_cast<double>(numVoxels[dim])) {
+        return false;
+      }
+    }
+    if (map_->isOccupied(coordinates.data())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+double VoxelGridValidityChecker::clearance(const ompl::base::State* state) const {
+  auto clearance = std::numeric_limits<double>::infinity();
+  for (const auto& robotPoint : robotPoints_) {
+    const auto coordinates = getVoxelCoordinates(transform(state, robotPoint));
+    clearance =
+        std::min(clearance, map_->computeClearance(coordinates.data(), voxelSideLengths_.data()));
+  }
+  return clearance;
+}
+
+std::shared_ptr<const obstacles::VoxelMap> VoxelGridValidityChecker::getMap() const {
+  return map_;
+}
+
+bool VoxelGridValidityChecker::isPointRobot() const {
+  return robotPoints_.size() == 1u && robotPoints_.front() == std::array<double, 3u>{};
+}
+
+std::array<double, 3u> VoxelGridValidityChecker::getVoxelCoordinates(
+    const std::array<double, 3u>& point) const {
+  return {(point[0u] - origin_[0u]) * voxelsPerUnit_[0u],
+          (point[1u] - origin_[1u]) * voxelsPerUnit_[1u],
+          (point[2u] - origin_[2u]) * voxelsPerUnit_[2u]};
+}
+
+std::array<double, 3u> VoxelGridValidityChecker::getPosition(
+    const ompl::base::State* state) const {
+  if (isSE3_) {
+    const auto se3State = state->as<ompl::base::SE3StateSpace::StateType>();
+    return {se3State->getX(), se3State->getY(), se3State->getZ()};
+  }
+  const auto values = state->as<ompl::base::RealVectorStateSpace::StateType>()->values;
+  return {values[0u], values[1u], values[2u]};
+}
+
+std::array<double, 3u> VoxelGridValidityChecker::transform(
+    const ompl::base::State* state, const std::array<double, 3u>& robotPoint) const {
+  auto position = getPosition(state);
+  if (!isSE3_) {
+    for (auto dim = 0u; dim < 3u; ++dim) {
+      position[dim] += robotPoint[dim];
+    }
+    return position;
+  }
+
+  // Rotate the point by the unit quaternion q as p + 2 w (v x p) + 2 v x (v x p), with v the
+  // vector part of q.
+  const auto& rotation = state->as<ompl::base::SE3StateSpace::StateType>()->rotation();
+  const std::array<double, 3u> t{2.0 * (rotation.y * robotPoint[2u] - rotation.z * robotPoint[1u]),
+                                 2.0 * (rotation.z * robotPoint[0u] - rotation.x * robotPoint[2u]),
+                                 2.0 * (rotation.x * robotPoint[1u] - rotation.y * robotPoint[0u])};
+  position[0u] += robotPoint[0u] + rotation.w * t[0u] + rotation.y * t[2u] - rotation.z * t[1u];
+  position[1u] += robotPoint[1u] + rotation.w * t[1u] + rotation.z * t[0u] - rotation.x * t[2u];
+  position[2u] += robotPoint[2u] + rotation.w * t[2u] + rotation.x * t[1u] - rotation.y * t[0u];
+  return position;
+}
+
+}  // namespace planning_contexts
+
+}  // namespace pdt
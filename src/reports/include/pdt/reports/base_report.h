@@ -62,6 +62,12 @@ class BaseReport {
   std::stringstream preamble() const;
   std::stringstream appendix() const;
 
+  // Lists the planners that were eliminated if the planners were raced.
+  std::stringstream eliminatedPlanners() const;
+
+  // Summarizes the memory usage of the planners if it was profiled.
+  std::stringstream memoryUsage() const;
+
   const std::set<std::string> requirePackages_{"luatex85", "shellesc"};
   const std::set<std::string> usePackages_{"appendix", "booktabs",  "caption",
                                            "listings", "microtype", "tabularx",
@@ -39,10 +39,17 @@
 
 #include <stdlib.h>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <optional>
 
 #include <ompl/util/Console.h>
 
+#include "pdt/loggers/memory_usage.h"
 #include "pdt/pgftikz/define_latex_colors.h"
 
 namespace pdt {
@@ -192,6 +199,120 @@ std::stringstream BaseReport::appendix() const {
   return appendix;
 }
 
+std::stringstream BaseReport::eliminatedPlanners() const {
+  std::stringstream eliminated;
+  if (!config_->contains("experiment/racing/eliminated")) {
+    return eliminated;
+  }
+
+  // Sort the eliminated planners by the round in which they were eliminated.
+  std::vector<std::pair<std::size_t, std::string>> rounds;
+  for (const auto& name : config_->getChildren("experiment/racing/eliminated")) {
+    rounds.emplace_back(
+        config_->get<std::size_t>("experiment/racing/eliminated/"s + name + "/round"s), name);
+  }
+  std::sort(rounds.begin(), rounds.end());
+
+  eliminated << "\\subsection{Eliminated Planners}\\label{sec:overview-eliminated-planners}\n";
+  eliminated << "The planners were raced. After every round, a planner was eliminated if another "
+                "planner had significantly lower final costs or initial solution times on at least "
+                "one query and significantly higher ones on none, according to a one-sided "
+                "Wilcoxon rank-sum test at a significance level of "
+             << config_->get<double>("experiment/racing/significanceLevel")
+             << ". The following planners were eliminated and are not part of the remaining "
+                "results.\n";
+  eliminated << "\\begin{center}\n\\begin{tabular}{lcc}\\toprule\n";
+  eliminated << "Planner & Round & Runs \\\\\\midrule\n";
+  for (const auto& [round, name] : rounds) {
+    std::string plotName = name;
+    if (config_->contains("planner/"s + name + "/report/name"s)) {
+      plotName = config_->get<std::string>("planner/"s + name + "/report/name"s);
+    }
+    eliminated << plotName << " & " << round << " & "
+               << config_->get<std::size_t>("experiment/racing/eliminated/"s + name + "/numRuns"s)
+               << " \\\\\n";
+  }
+  eliminated << "\\bottomrule\n\\end{tabular}\n\\end{center}\n";
+
+  return eliminated;
+}
+
+std::stringstream BaseReport::memoryUsage() const {
+  std::stringstream memory;
+  if (!config_->contains("experiment/memoryUsage")) {
+    return memory;
+  }
+
+  // Collect the memory usage of all runs of all queries.
+  std::map<std::string, std::vector<loggers::MemoryUsage>> usages;
+  for (const auto& path : config_->get<std::vector<std::string>>("experiment/memoryUsage")) {
+    for (const auto& [name, usage] : loggers::readMemoryUsage(path)) {
+      // Planners that were eliminated in a race are not part of the results.
+      if (plotPlannerNames_.count(name) != 0u) {
+        usages[name].push_back(usage);
+      }
+    }
+  }
+
+  // Computes the median of the selected quantity, or nan if it was not measured.
+  auto median = [](const std::vector<loggers::MemoryUsage>& runs, const auto& select) {
+    std::vector<double> values;
+    for (const auto& run : runs) {
+      if (const auto value = select(run)) {
+        values.push_back(static_cast<double>(*value));
+      }
+    }
+    if (values.empty()) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    auto middle = values.begin() + static_cast<long>(values.size() / 2u);
+    std::nth_element(values.begin(), middle, values.end());
+    return *middle;
+  };
+
+  // Formats a quantity for the table, scaled by the given factor.
+  auto format = [](double value, double scale, int precision) {
+    if (std::isnan(value)) {
+      return "--"s;
+    }
+    std::stringstream stream;
+    stream << std::fixed << std::setprecision(precision) << value * scale;
+    return stream.str();
+  };
+  constexpr double toMiB = 1.0 / (1024.0 * 1024.0);
+
+  memory << "\\subsection{Memory Usage}\\label{sec:overview-memory-usage}\n";
+  memory << "The memory usage was measured for every query a planner solved, starting before the "
+            "planner was allocated for the first query. The resident set size is read from the "
+            "kernel and includes memory that the allocator has not returned to it. Allocations are "
+            "only counted if the benchmark was built with \\texttt{PDT\\_COUNT\\_ALLOCATIONS}. "
+            "All values are medians over all runs, except the maximum peak resident set size.\n";
+  memory << "\\begin{center}\n\\begin{tabular}{lccccc}\\toprule\n";
+  memory << "Planner & Peak RSS [MiB] & Max. Peak RSS [MiB] & RSS Change [MiB] & Allocations & "
+            "Allocated [MiB] \\\\\\midrule\n";
+  for (const auto& [name, runs] : usages) {
+    std::size_t maxPeak = 0u;
+    for (const auto& run : runs) {
+      maxPeak = std::max(maxPeak, run.peakResidentSetSize);
+    }
+    const auto peak = median(runs, [](const auto& run) {
+      return std::optional<std::size_t>(run.peakResidentSetSize);
+    });
+    const auto delta = median(runs, [](const auto& run) {
+      return std::optional<std::int64_t>(run.residentSetSizeDelta);
+    });
+    const auto allocations = median(runs, [](const auto& run) { return run.numAllocations; });
+    const auto bytes = median(runs, [](const auto& run) { return run.numAllocatedBytes; });
+    memory << plotPlannerNames_.at(name) << " & " << format(peak, toMiB, 1) << " & "
+           << format(static_cast<double>(maxPeak), toMiB, 1) << " & " << format(delta, toMiB, 1)
+           << " & " << format(allocations, 1.0, 0) << " & " << format(bytes, toMiB, 1)
+           << " \\\\\n";
+  }
+  memory << "\\bottomrule\n\\end{tabular}\n\\end{center}\n";
+
+  return memory;
+}
+
 fs::path BaseReport::compileReport() const {
   // Compiling with lualatex is slower than pdflatex but has dynamic memory allocation. Since
   // these plots can be quite large, pdflatex has run into memory issues. Lualatex should be
@@ -125,7 +125,7 @@ std::stringstream MultiqueryReport::overview() const {
               "Developer Tools (PDT). It presents the results "
               "for the "
            << experimentName_ << " experiment, which executed "
-           << config_->get<std::size_t>("experiment/numRuns") << " runs of "
+           << stats_.getQueryStatistics(0u).getNumRunsPerPlanner() << " runs of "
            << config_->get<std::size_t>("context/" +
                                         config_->get<std::string>("experiment/context") +
                                         "/starts/numGenerated")
@@ -159,6 +159,12 @@ std::stringstream MultiqueryReport::overview() const {
   }
   overview << mqKpiTable.string() << '\n';
 
+  // List the planners that were eliminated when racing.
+  overview << eliminatedPlanners().str();
+
+  // Summarize the memory usage if it was profiled.
+  overview << memoryUsage().str();
+
   overview << "\\subsection{Initial solution time}\\label{sec:soltime}\n";
   auto legend =
       latexPlotter_.createLegendAxis(config_->get<std::vector<std::string>>("experiment/planners"));
@@ -121,7 +121,7 @@ std::stringstream SingleQueryReport::overview() const {
               "Developer Tools (PDT). It presents the results "
               "for the "
            << experimentName_ << " experiment, which executed "
-           << config_->get<std::size_t>("experiment/numRuns") << " runs of ";
+           << stats_.getNumRunsPerPlanner() << " runs of ";
   for (std::size_t i = 0u; i < plannerNames.size() - 1u; ++i) {
     overview << plotPlannerNames_.at(plannerNames.at(i)) << ", ";
   }
@@ -176,6 +176,12 @@ std::stringstream SingleQueryReport::overview() const {
            << std::floor(100.0 * config_->get<double>(medianCiKey.str()))
            << "\\% confidence intervals.}\n\\end{center}\n";
 
+  // List the planners that were eliminated when racing.
+  overview << eliminatedPlanners().str();
+
+  // Summarize the memory usage if it was profiled.
+  overview << memoryUsage().str();
+
   // Create the initial solution overview section.
   overview << "\\pagebreak\n";
   overview << "\\subsection{Initial Solutions}\\label{sec:overview-initial-solutions}\n";
@@ -51,6 +51,7 @@ class LinearInterpolator {
  public:
   LinearInterpolator(const std::vector<X>& x, const std::vector<Y>& y);
   LinearInterpolator(const std::vector<std::pair<X, Y>>& valuePairs);
+  LinearInterpolator(const X* x, const Y* y, std::size_t numValues);
   ~LinearInterpolator() = default;
 
   Y operator()(X x) const;
@@ -115,6 +116,28 @@ LinearInterpolator<X, Y>::LinearInterpolator(const std::vector<std::pair<X, Y>>&
   }
 }
 
+template <typename X, typename Y>
+LinearInterpolator<X, Y>::LinearInterpolator(const X* x, const Y* y, std::size_t numValues) {
+  // Check input.
+  if (numValues < 2u) {
+    auto msg = std::string("Interpolator cannot interpolate fewer than 2 elements");
+    throw std::runtime_error(msg);
+  }
+
+  // Create map.
+  for (std::size_t i = 0u; i < numValues; ++i) {
+    if (std::numeric_limits<X>::has_infinity && x[i] == std::numeric_limits<X>::infinity()) {
+      auto msg = std::string("Domain cannot contain infinity.");
+      throw std::runtime_error(msg);
+    }
+    if (auto it = data_.find(x[i]); it != data_.end() && it->second != y[i]) {
+      auto msg = std::string("The same argument cannot map to a different value.");
+      throw std::runtime_error(msg);
+    }
+    data_.emplace(x[i], y[i]);
+  }
+}
+
 template <typename X, typename Y>
 Y LinearInterpolator<X, Y>::operator()(X x) const {
   // Get the sandwiching iterators.
@@ -39,11 +39,13 @@
 
 #include <experimental/filesystem>
 #include <map>
+#include <memory>
 #include <set>
 #include <utility>
 #include <vector>
 
 #include "pdt/config/configuration.h"
+#include "pdt/loggers/results_reader.h"
 #include "pdt/statistics/population_statistics.h"
 
 namespace pdt {
@@ -54,6 +56,14 @@ class PlannerResults {
  public:
   // The safest option is a vector of pairs, so that durations and costs cannot get decoupled.
   using PlannerResult = std::vector<std::pair<double, double>>;
+
+  // A measured run as it is stored by the results reader, which owns the durations and costs.
+  struct MeasuredRun {
+    const double* durations{nullptr};
+    const double* costs{nullptr};
+    std::size_t numMeasurements{0u};
+  };
+
   PlannerResults() = default;
   ~PlannerResults() = default;
 
@@ -61,13 +71,13 @@ class PlannerResults {
   const std::vector<PlannerResult>& getAllRunsAt(const std::vector<double>& durations) const;
 
   // Access to measured runs.
-  void addMeasuredRun(const PlannerResult& run);
-  const PlannerResult& getMeasuredRun(const std::size_t i) const;
+  void addMeasuredRun(const MeasuredRun& run);
+  const MeasuredRun& getMeasuredRun(const std::size_t i) const;
   void clearMeasuredRuns();
   std::size_t numMeasuredRuns() const;
 
  private:
-  std::vector<PlannerResult> measuredRuns_{};
+  std::vector<MeasuredRun> measuredRuns_{};
   mutable std::vector<PlannerResult> interpolatedRuns_{};
 };
 
@@ -132,10 +142,26 @@ class PlanningStatistics {
   double getMedianInitialSolutionCost(const std::string& plannerName) const;
   double getSuccessRate(const std::string& plannerName) const;
 
+  // Getters for the widths of the confidence intervals about the median initial solution duration
+  // and the median final cost, relative to the respective medians.
+  double getMedianInitialSolutionDurationRelativeIntervalWidth(const std::string& plannerName,
+                                                               const double confidence) const;
+  double getMedianFinalCostRelativeIntervalWidth(const std::string& plannerName,
+                                                 const double confidence) const;
+
+  // The confidence that is actually achieved by the intervals about the medians, which can be
+  // lower than the requested confidence if there are too few runs.
+  double getMedianIntervalConfidence(const double confidence) const;
+
   std::vector<double> getDefaultBinDurations() const;
   std::shared_ptr<config::Configuration> getConfig() const;
 
  private:
+  // Adds a measured run and registers its min and max values. The last cost of the previously
+  // added run is updated to the last cost of this run.
+  void addMeasuredRun(const std::string& name, const double* durations, const double* costs,
+                      const std::size_t numMeasurements, double* lastCost);
+
   // The identifying header line that starts each file produced by this class.
   std::string createHeader(const std::string& statisticType, const std::string& plannerName) const;
 
@@ -158,6 +184,8 @@ class PlanningStatistics {
 
   double getNthValue(std::vector<double>* values, const std::size_t n) const;
 
+  double getMedianRelativeIntervalWidth(std::vector<double> values, const double confidence) const;
+
   std::shared_ptr<config::Configuration> config_;
   const std::experimental::filesystem::path statisticsDirectory_;
   PopulationStatistics populationStats_;
@@ -173,6 +201,9 @@ class PlanningStatistics {
   // The number of runs per planner.
   std::size_t numRunsPerPlanner_{0u};
 
+  // The reader of the results, which holds the measured runs. The planner results point into it.
+  std::shared_ptr<loggers::ResultsReader> reader_{};
+
   // Can we afford loading all of this into memory? Let's see.
   std::map<std::string, PlannerResults> results_{};
 
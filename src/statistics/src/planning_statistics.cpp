@@ -48,12 +48,6 @@
 
 #include <ompl/util/Console.h>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Weffc++"
-#pragma GCC diagnostic ignored "-Wsign-conversion"
-#include "csv/parser.hpp"
-#pragma GCC diagnostic pop
-
 #include "pdt/statistics/linear_interpolator.h"
 #include "pdt/utilities/write_vector_to_file.h"
 
@@ -90,18 +84,19 @@ const std::vector<PlannerResults::PlannerResult>& PlannerResults::getAllRunsAt(
     interpolatedRuns_.back().reserve(durations.size());
 
     // Create an interpolant for this run.
-    LinearInterpolator<double, double> interpolant(measuredRun);
+    LinearInterpolator<double, double> interpolant(measuredRun.durations, measuredRun.costs,
+                                                   measuredRun.numMeasurements);
 
-    // Get the min and max elements of this run to detect extrapolation.
-    // This gets the min and max wrt the durations as std::pair uses a lexicographical comparator.
-    auto [min, max] = std::minmax_element(measuredRun.begin(), measuredRun.end());
+    // Get the min and max durations of this run to detect extrapolation.
+    auto [min, max] = std::minmax_element(measuredRun.durations,
+                                          measuredRun.durations + measuredRun.numMeasurements);
 
     // Compute the costs for each requested duration.
     for (const auto duration : durations) {
-      if (duration < min->first) {
+      if (duration < *min) {
         interpolatedRuns_.back().emplace_back(duration, std::numeric_limits<double>::infinity());
-      } else if (duration > max->first) {
-        OMPL_ERROR("Requested to extrapolate. Max duration: %f, queried duration: %f", max->first,
+      } else if (duration > *max) {
+        OMPL_ERROR("Requested to extrapolate. Max duration: %f, queried duration: %f", *max,
                    duration);
         throw std::runtime_error("Fairness error.");
       } else {
@@ -113,11 +108,11 @@ const std::vector<PlannerResults::PlannerResult>& PlannerResults::getAllRunsAt(
   return interpolatedRuns_;
 }
 
-void PlannerResults::addMeasuredRun(const PlannerResults::PlannerResult& run) {
+void PlannerResults::addMeasuredRun(const PlannerResults::MeasuredRun& run) {
   measuredRuns_.push_back(run);
 }
 
-const PlannerResults::PlannerResult& PlannerResults::getMeasuredRun(const std::size_t i) const {
+const PlannerResults::MeasuredRun& PlannerResults::getMeasuredRun(const std::size_t i) const {
   return measuredRuns_.at(i);
 }
 
@@ -142,159 +137,20 @@ PlanningStatistics::PlanningStatistics(const std::shared_ptr<config::Configurati
   // Create the statistics directory.
   fs::create_directories(statisticsDirectory_);
 
-  // Open the results file.
-  std::ifstream filestream(resultsPath.string());
-  if (filestream.fail()) {
-    auto msg = "PlanningStatistics cannot open results at '"s + resultsPath.string() + "'."s;
-    throw std::runtime_error(msg);
-  }
-
-  // Set up the parser.
-  aria::csv::CsvParser parser(filestream);
+  // Only the planners of the experiment are loaded. The results can contain runs of other planners,
+  // e.g., of planners that were eliminated while racing.
+  const auto experimentPlanners = config_->get<std::vector<std::string>>("experiment/planners");
+  const std::set<std::string> plannerNames(experimentPlanners.begin(), experimentPlanners.end());
 
-  // Parse the file in bulk for now. We could already extract some statistics here, e.g. fastest
-  // initial solution time and associated cost for every planner.
-  bool timeRow = true;
+  // Load the measured runs. They stay in the reader, which reads binary results in place. The last
+  // seen cost is used to detect initial solutions.
+  reader_ = std::make_shared<loggers::ResultsReader>(resultsPath);
   double lastCost{std::numeric_limits<double>::infinity()};
-  std::string name{""};
-  PlannerResults::PlannerResult run;
-  for (auto& row : parser) {
-    if (row.size() == 0) {
-      throw std::runtime_error("Empty row.");
-    }
-    if (timeRow) {
-      name = row.at(0);
-
-      // If this is the first time we're parsing this planner, we need to setup a min max value
-      // containers.
-      if (results_.find(name) == results_.end() && run.empty()) {
-        minCosts_[name] = std::numeric_limits<double>::infinity();
-        maxCosts_[name] = std::numeric_limits<double>::lowest();
-        minInitialSolutionCosts_[name] = std::numeric_limits<double>::infinity();
-        maxInitialSolutionCosts_[name] = std::numeric_limits<double>::lowest();
-        minFinalCosts_[name] = std::numeric_limits<double>::infinity();
-        maxFinalCosts_[name] = std::numeric_limits<double>::lowest();
-        maxNonInfCosts_[name] = std::numeric_limits<double>::lowest();
-        minDurations_[name] = std::numeric_limits<double>::infinity();
-        maxDurations_[name] = std::numeric_limits<double>::lowest();
-        minInitialSolutionDurations_[name] = std::numeric_limits<double>::infinity();
-        maxInitialSolutionDurations_[name] = std::numeric_limits<double>::lowest();
-        maxNonInfInitialSolutionDurations_[name] = std::numeric_limits<double>::lowest();
-        successRates_[name] = 0.0;
-      }
-    } else if (row.at(0) != name) {
-      throw std::runtime_error("Csv file has unexpected structure.");
-    }
-    // Let's get the min and max values on first pass.
-    for (std::size_t i = 1u; i < row.size(); ++i) {
-      if (timeRow) {
-        double duration = std::stod(row.at(i));
-        // Fill the cost row with nan's while filling the time row.
-        run.emplace_back(duration, std::numeric_limits<double>::signaling_NaN());
-
-        // Register overall min and max durations.
-        if (duration < minDuration_) {
-          minDuration_ = duration;
-        }
-        if (duration > maxDuration_) {
-          maxDuration_ = duration;
-        }
-
-        // Register planner specific min and max durations.
-        if (duration < minDurations_.at(name)) {
-          minDurations_.at(name) = duration;
-        }
-        if (duration > maxDurations_.at(name)) {
-          maxDurations_.at(name) = duration;
-        }
-      } else {
-        run.at(i - 1u).second =
-            std::stod(row.at(i));  // i - 1 because the row index (i) has the name as
-                                   // 0th element which is not stored in the run.
-
-        double duration = run.at(i - 1u).first;
-        double cost = run.at(i - 1u).second;
-
-        // Register overall min and max costs.
-        if (cost < minCost_) {
-          minCost_ = cost;
-        }
-        if (cost > maxCost_) {
-          maxCost_ = cost;
-        }
-        if (cost != std::numeric_limits<double>::infinity() && cost > maxNonInfCost_) {
-          maxNonInfCost_ = cost;
-        }
-
-        // Register the overall initial solution durations.
-        if (cost != std::numeric_limits<double>::infinity() &&
-            duration < minInitialSolutionDuration_) {
-          minInitialSolutionDuration_ = duration;
-        }
-        if (cost != std::numeric_limits<double>::infinity() &&
-            lastCost == std::numeric_limits<double>::infinity() &&
-            duration > maxNonInfInitialSolutionDuration_) {
-          maxNonInfInitialSolutionDuration_ = duration;
-        }
-        if (i == row.size() - 1u && cost > maxFinalCost_) {
-          maxFinalCost_ = cost;
-        }
-        if (i == row.size() - 1u && cost < minFinalCost_) {
-          minFinalCost_ = cost;
-        }
-
-        // Register planner specific min and max costs.
-        if (cost < minCosts_.at(name)) {
-          minCosts_.at(name) = cost;
-        }
-        if (cost > maxCosts_.at(name)) {
-          maxCosts_.at(name) = cost;
-        }
-        if (cost != std::numeric_limits<double>::infinity() && cost > maxNonInfCosts_.at(name)) {
-          maxNonInfCosts_.at(name) = cost;
-        }
-        if (cost != std::numeric_limits<double>::infinity() &&
-            duration < minInitialSolutionDurations_.at(name)) {
-          minInitialSolutionDurations_.at(name) = duration;
-        }
-        if (lastCost == std::numeric_limits<double>::infinity() &&
-            cost < minInitialSolutionCosts_.at(name)) {
-          minInitialSolutionCosts_.at(name) = cost;
-        }
-        if (lastCost == std::numeric_limits<double>::infinity() &&
-            (cost != std::numeric_limits<double>::infinity() || i == row.size() - 1u) &&
-            cost > maxInitialSolutionCosts_.at(name)) {
-          maxInitialSolutionCosts_.at(name) = cost;
-        }
-        if (lastCost == std::numeric_limits<double>::infinity() &&
-            (cost != std::numeric_limits<double>::infinity() || i == row.size() - 1u) &&
-            duration > maxInitialSolutionDurations_.at(name)) {
-          maxInitialSolutionDurations_.at(name) = duration;
-        }
-        if (cost != std::numeric_limits<double>::infinity() &&
-            lastCost == std::numeric_limits<double>::infinity() &&
-            duration > maxNonInfInitialSolutionDurations_.at(name)) {
-          maxNonInfInitialSolutionDurations_.at(name) = duration;
-        }
-        if (i == row.size() - 1u && cost > maxFinalCosts_.at(name)) {
-          maxFinalCosts_.at(name) = cost;
-        }
-        if (i == row.size() - 1u && cost < minFinalCosts_.at(name)) {
-          minFinalCosts_.at(name) = cost;
-        }
-        if (i == row.size() - 1u && cost != std::numeric_limits<double>::infinity()) {
-          successRates_.at(name) += 1.0;  // We divide by num runs later.
-        }
-
-        // Remember this cost (for max initial solution durations).
-        lastCost = cost;
-      }
+  for (std::size_t i = 0u; i < reader_->getNumRuns(); ++i) {
+    if (plannerNames.count(reader_->getPlannerName(i)) != 0u) {
+      addMeasuredRun(reader_->getPlannerName(i), reader_->getDurations(i), reader_->getCosts(i),
+                     reader_->getNumMeasurements(i), &lastCost);
     }
-    if (!timeRow) {
-      results_[name].addMeasuredRun(run);
-      run.clear();
-    }
-    timeRow = !timeRow;
   }
 
   // Get the number of runs per planner, check that they're equal.
@@ -342,6 +198,126 @@ PlanningStatistics::PlanningStatistics(const std::shared_ptr<config::Configurati
   }
 }
 
+void PlanningStatistics::addMeasuredRun(const std::string& name, const double* durations,
+                                        const double* costs, const std::size_t numMeasurements,
+                                        double* lastCost) {
+  // If this is the first time we're parsing this planner, we need to setup a min max value
+  // containers.
+  if (results_.find(name) == results_.end()) {
+    minCosts_[name] = std::numeric_limits<double>::infinity();
+    maxCosts_[name] = std::numeric_limits<double>::lowest();
+    minInitialSolutionCosts_[name] = std::numeric_limits<double>::infinity();
+    maxInitialSolutionCosts_[name] = std::numeric_limits<double>::lowest();
+    minFinalCosts_[name] = std::numeric_limits<double>::infinity();
+    maxFinalCosts_[name] = std::numeric_limits<double>::lowest();
+    maxNonInfCosts_[name] = std::numeric_limits<double>::lowest();
+    minDurations_[name] = std::numeric_limits<double>::infinity();
+    maxDurations_[name] = std::numeric_limits<double>::lowest();
+    minInitialSolutionDurations_[name] = std::numeric_limits<double>::infinity();
+    maxInitialSolutionDurations_[name] = std::numeric_limits<double>::lowest();
+    maxNonInfInitialSolutionDurations_[name] = std::numeric_limits<double>::lowest();
+    successRates_[name] = 0.0;
+  }
+
+  for (std::size_t i = 0u; i < numMeasurements; ++i) {
+    const double duration = durations[i];
+    const double cost = costs[i];
+    const bool isFinal = i == numMeasurements - 1u;
+
+    // Register overall min and max durations.
+    if (duration < minDuration_) {
+      minDuration_ = duration;
+    }
+    if (duration > maxDuration_) {
+      maxDuration_ = duration;
+    }
+
+    // Register planner specific min and max durations.
+    if (duration < minDurations_.at(name)) {
+      minDurations_.at(name) = duration;
+    }
+    if (duration > maxDurations_.at(name)) {
+      maxDurations_.at(name) = duration;
+    }
+
+    // Register overall min and max costs.
+    if (cost < minCost_) {
+      minCost_ = cost;
+    }
+    if (cost > maxCost_) {
+      maxCost_ = cost;
+    }
+    if (cost != std::numeric_limits<double>::infinity() && cost > maxNonInfCost_) {
+      maxNonInfCost_ = cost;
+    }
+
+    // Register the overall initial solution durations.
+    if (cost != std::numeric_limits<double>::infinity() &&
+        duration < minInitialSolutionDuration_) {
+      minInitialSolutionDuration_ = duration;
+    }
+    if (cost != std::numeric_limits<double>::infinity() &&
+        *lastCost == std::numeric_limits<double>::infinity() &&
+        duration > maxNonInfInitialSolutionDuration_) {
+      maxNonInfInitialSolutionDuration_ = duration;
+    }
+    if (isFinal && cost > maxFinalCost_) {
+      maxFinalCost_ = cost;
+    }
+    if (isFinal && cost < minFinalCost_) {
+      minFinalCost_ = cost;
+    }
+
+    // Register planner specific min and max costs.
+    if (cost < minCosts_.at(name)) {
+      minCosts_.at(name) = cost;
+    }
+    if (cost > maxCosts_.at(name)) {
+      maxCosts_.at(name) = cost;
+    }
+    if (cost != std::numeric_limits<double>::infinity() && cost > maxNonInfCosts_.at(name)) {
+      maxNonInfCosts_.at(name) = cost;
+    }
+    if (cost != std::numeric_limits<double>::infinity() &&
+        duration < minInitialSolutionDurations_.at(name)) {
+      minInitialSolutionDurations_.at(name) = duration;
+    }
+    if (*lastCost == std::numeric_limits<double>::infinity() &&
+        cost < minInitialSolutionCosts_.at(name)) {
+      minInitialSolutionCosts_.at(name) = cost;
+    }
+    if (*lastCost == std::numeric_limits<double>::infinity() &&
+        (cost != std::numeric_limits<double>::infinity() || isFinal) &&
+        cost > maxInitialSolutionCosts_.at(name)) {
+      maxInitialSolutionCosts_.at(name) = cost;
+    }
+    if (*lastCost == std::numeric_limits<double>::infinity() &&
+        (cost != std::numeric_limits<double>::infinity() || isFinal) &&
+        duration > maxInitialSolutionDurations_.at(name)) {
+      maxInitialSolutionDurations_.at(name) = duration;
+    }
+    if (cost != std::numeric_limits<double>::infinity() &&
+        *lastCost == std::numeric_limits<double>::infinity() &&
+        duration > maxNonInfInitialSolutionDurations_.at(name)) {
+      maxNonInfInitialSolutionDurations_.at(name) = duration;
+    }
+    if (isFinal && cost > maxFinalCosts_.at(name)) {
+      maxFinalCosts_.at(name) = cost;
+    }
+    if (isFinal && cost < minFinalCosts_.at(name)) {
+      minFinalCosts_.at(name) = cost;
+    }
+    if (isFinal && cost != std::numeric_limits<double>::infinity()) {
+      successRates_.at(name) += 1.0;  // We divide by num runs later.
+    }
+
+    // Remember this cost (for max initial solution durations).
+    *lastCost = cost;
+  }
+
+  results_[name].addMeasuredRun({durations, costs, numMeasurements});
+}
+
 fs::path PlanningStatistics::extractMedians(const std::string& plannerName, const double confidence,
                                             const std::vector<double>& binDurations) const {
   if (!config_->get<bool>("planner/"s + plannerName + "/isAnytime"s)) {
@@ -775,6 +751,21 @@ double PlanningStatistics::getSuccessRate(const std::string& plannerName) const
   return successRates_.at(plannerName);
 }
 
+double PlanningStatistics::getMedianInitialSolutionDurationRelativeIntervalWidth(
+    const std::string& plannerName, const double confidence) const {
+  return getMedianRelativeIntervalWidth(getInitialSolutionDurations(results_.at(plannerName)),
+                                        confidence);
+}
+
+double PlanningStatistics::getMedianFinalCostRelativeIntervalWidth(const std::string& plannerName,
+                                                                   const double confidence) const {
+  return getMedianRelativeIntervalWidth(getLastSolutionCosts(results_.at(plannerName)), confidence);
+}
+
+double PlanningStatistics::getMedianIntervalConfidence(const double confidence) const {
+  return populationStats_.findPercentileConfidenceInterval(0.50, confidence).confidence;
+}
+
 std::vector<double> PlanningStatistics::getDefaultBinDurations() const {
   return defaultMedianBinDurations_;
 }
@@ -834,9 +825,9 @@ std::vector<double> PlanningStatistics::getInitialSolutionDurations(
     const auto& measuredRun = results.getMeasuredRun(run);
 
     // Find the first cost that's less than infinity.
-    for (const auto& measurement : measuredRun) {
-      if (measurement.second < std::numeric_limits<double>::infinity()) {
-        initialDurations.push_back(measurement.first);
+    for (std::size_t i = 0u; i < measuredRun.numMeasurements; ++i) {
+      if (measuredRun.costs[i] < std::numeric_limits<double>::infinity()) {
+        initialDurations.push_back(measuredRun.durations[i]);
         break;
       }
     }
@@ -858,7 +849,7 @@ std::vector<double> PlanningStatistics::getLastSolutionDurations(
   for (auto run = 0u; run < results.numMeasuredRuns(); ++run) {
     // Get the durations and costs of this run.
     const auto& measuredRun = results.getMeasuredRun(run);
-    lastDurations.push_back(measuredRun.back().first);
+    lastDurations.push_back(measuredRun.durations[measuredRun.numMeasurements - 1u]);
   }
 
   return lastDurations;
@@ -874,9 +865,9 @@ std::vector<double> PlanningStatistics::getInitialSolutionCosts(
     const auto& measuredRun = results.getMeasuredRun(run);
 
     // Find the first cost that's less than infinity.
-    for (const auto& measurement : measuredRun) {
-      if (measurement.second < std::numeric_limits<double>::infinity()) {
-        initialCosts.push_back(measurement.second);
+    for (std::size_t i = 0u; i < measuredRun.numMeasurements; ++i) {
+      if (measuredRun.costs[i] < std::numeric_limits<double>::infinity()) {
+        initialCosts.push_back(measuredRun.costs[i]);
         break;
       }
     }
@@ -897,7 +888,7 @@ std::vector<double> PlanningStatistics::getLastSolutionCosts(const PlannerResult
   for (auto run = 0u; run < results.numMeasuredRuns(); ++run) {
     // Get the durations and costs of this run.
     const auto& measuredRun = results.getMeasuredRun(run);
-    lastCosts.push_back(measuredRun.back().second);
+    lastCosts.push_back(measuredRun.costs[measuredRun.numMeasurements - 1u]);
   }
 
   return lastCosts;
@@ -937,6 +928,24 @@ double PlanningStatistics::getNthValue(std::vector<double>* values, const std::s
   return *nthIter;
 }
 
+double PlanningStatistics::getMedianRelativeIntervalWidth(std::vector<double> values,
+                                                          const double confidence) const {
+  auto interval = populationStats_.findPercentileConfidenceInterval(0.50, confidence);
+  auto lowerBound = getNthValue(&values, interval.lower);
+  auto upperBound = getNthValue(&values, interval.upper);
+  auto median = getNthValue(&values, populationStats_.estimatePercentileAsIndex(0.50));
+
+  // Identical bounds have no width, even if they are both infinite, e.g., if no run found a
+  // solution. Otherwise an infinite bound or a zero median gives an infinitely wide interval.
+  if (lowerBound == upperBound) {
+    return 0.0;
+  }
+  if (!std::isfinite(upperBound) || median == 0.0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return (upperBound - lowerBound) / std::abs(median);
+}
+
 }  // namespace statistics
 
 }  // namespace pdt
@@ -0,0 +1,102 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/statistics/rank_sum_test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/math/distributions/normal.hpp>
+
+namespace pdt {
+
+namespace statistics {
+
+double computeRankSumPValue(const std::vector<double>& lower, const std::vector<double>& higher) {
+  if (lower.empty() || higher.empty()) {
+    throw std::invalid_argument("The rank-sum test needs at least one value per sample.");
+  }
+
+  // Pool the samples, remembering which sample every value belongs to.
+  std::vector<std::pair<double, bool>> pooled;
+  pooled.reserve(lower.size() + higher.size());
+  for (const auto value : lower) {
+    pooled.emplace_back(value, true);
+  }
+  for (const auto value : higher) {
+    pooled.emplace_back(value, false);
+  }
+  std::sort(pooled.begin(), pooled.end());
+
+  // Sum the ranks of the lower sample. Tied values get the average of the ranks they span.
+  const auto n = static_cast<double>(pooled.size());
+  double rankSum = 0.0;
+  double tieCorrection = 0.0;
+  for (std::size_t begin = 0u; begin < pooled.size();) {
+    auto end = begin;
+    while (end < pooled.size() && pooled[end].first == pooled[begin].first) {
+      ++end;
+    }
+    const auto numTied = static_cast<double>(end - begin);
+    const auto averageRank = static_cast<double>(begin + 1u + end) / 2.0;
+    for (auto i = begin; i < end; ++i) {
+      if (pooled[i].second) {
+        rankSum += averageRank;
+      }
+    }
+    tieCorrection += numTied * numTied * numTied - numTied;
+    begin = end;
+  }
+
+  // Compare the U statistic of the lower sample to its distribution under the null hypothesis.
+  const auto numLower = static_cast<double>(lower.size());
+  const auto numHigher = static_cast<double>(higher.size());
+  const auto u = rankSum - numLower * (numLower + 1.0) / 2.0;
+  const auto mean = numLower * numHigher / 2.0;
+  const auto variance =
+      numLower * numHigher / 12.0 * ((n + 1.0) - tieCorrection / (n * (n - 1.0)));
+  if (variance <= 0.0) {
+    return 1.0;
+  }
+  return boost::math::cdf(boost::math::normal(), (u - mean + 0.5) / std::sqrt(variance));
+}
+
+}  // namespace statistics
+
+}  // namespace pdt
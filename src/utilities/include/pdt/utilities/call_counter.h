@@ -0,0 +1,97 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "pdt/time/time.h"
+
+namespace pdt {
+
+namespace utilities {
+
+// Counts the number of calls to a function and accumulates the time spent in them. Counting is
+// thread safe, as planners may call the counted functions from multiple threads.
+class CallCounter {
+ public:
+  CallCounter() = default;
+  ~CallCounter() = default;
+
+  // Records one call that took the given duration.
+  void count(const time::Duration& duration);
+
+  // Returns the number of calls since the last reset.
+  std::size_t getNumCalls() const;
+
+  // Returns the total time spent in the calls since the last reset.
+  time::Duration getDuration() const;
+
+  // Resets the number of calls and the accumulated duration.
+  void reset();
+
+ private:
+  std::atomic<std::size_t> numCalls_{0u};
+  std::atomic<std::int64_t> nanoseconds_{0};
+};
+
+// Times a single call for the lifetime of this object and records it with a counter.
+class ScopedCall {
+ public:
+  explicit ScopedCall(CallCounter* counter);
+  ~ScopedCall();
+
+ private:
+  CallCounter* counter_;
+  const time::Clock::time_point start_;
+};
+
+// The counters of the functions that are instrumented in a planning context.
+struct CallCounters {
+  CallCounter isValid{};
+  CallCounter clearance{};
+  CallCounter checkMotion{};
+  CallCounter motionCost{};
+
+  // Resets all counters.
+  void reset();
+};
+
+}  // namespace utilities
+
+}  // namespace pdt
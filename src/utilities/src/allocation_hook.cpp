@@ -0,0 +1,152 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+// This translation unit replaces the global allocation functions to count the number of
+// allocations and the allocated bytes. Deallocations are not counted, as the sized deallocation
+// functions are not called consistently enough to track the number of bytes in use.
+
+#include "pdt/utilities/allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace pdt {
+
+namespace utilities {
+
+namespace {
+
+std::atomic<std::size_t> numAllocations{0u};
+std::atomic<std::size_t> numAllocatedBytes{0u};
+
+void* allocate(std::size_t size) noexcept {
+  numAllocations.fetch_add(1u, std::memory_order_relaxed);
+  numAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  return std::malloc(size == 0u ? 1u : size);
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+  numAllocations.fetch_add(1u, std::memory_order_relaxed);
+  numAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  // The size of aligned_alloc must be a multiple of the alignment.
+  const auto align = static_cast<std::size_t>(alignment);
+  const auto alignedSize = ((size == 0u ? 1u : size) + align - 1u) / align * align;
+  return std::aligned_alloc(align, alignedSize);
+}
+
+}  // namespace
+
+std::size_t getNumAllocations() {
+  return numAllocations.load(std::memory_order_relaxed);
+}
+
+std::size_t getNumAllocatedBytes() {
+  return numAllocatedBytes.load(std::memory_order_relaxed);
+}
+
+}  // namespace utilities
+
+}  // namespace pdt
+
+void* operator new(std::size_t size) {
+  if (auto pointer = pdt::utilities::allocate(size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+  if (auto pointer = pdt::utilities::allocate(size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return pdt::utilities::allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return pdt::utilities::allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  if (auto pointer = pdt::utilities::allocateAligned(size, alignment)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  if (auto pointer = pdt::utilities::allocateAligned(size, alignment)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
@@ -0,0 +1,81 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/utilities/call_counter.h"
+
+#include <chrono>
+
+namespace pdt {
+
+namespace utilities {
+
+void CallCounter::count(const time::Duration& duration) {
+  numCalls_.fetch_add(1u, std::memory_order_relaxed);
+  nanoseconds_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(),
+                         std::memory_order_relaxed);
+}
+
+std::size_t CallCounter::getNumCalls() const {
+  return numCalls_.load(std::memory_order_relaxed);
+}
+
+time::Duration CallCounter::getDuration() const {
+  return std::chrono::nanoseconds(nanoseconds_.load(std::memory_order_relaxed));
+}
+
+void CallCounter::reset() {
+  numCalls_.store(0u, std::memory_order_relaxed);
+  nanoseconds_.store(0, std::memory_order_relaxed);
+}
+
+ScopedCall::ScopedCall(CallCounter* counter) : counter_(counter), start_(time::Clock::now()) {
+}
+
+ScopedCall::~ScopedCall() {
+  counter_->count(time::Clock::now() - start_);
+}
+
+void CallCounters::reset() {
+  isValid.reset();
+  clearance.reset();
+  checkMotion.reset();
+  motionCost.reset();
+}
+
+}  // namespace utilities
+
+}  // namespace pdt
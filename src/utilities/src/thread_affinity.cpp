@@ -0,0 +1,185 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Authors: Marlin Strub
+
+#include "pdt/utilities/thread_affinity.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <ompl/util/Console.h>
+
+namespace pdt {
+
+namespace utilities {
+
+namespace {
+
+// Parses a cpu list such as "0-3,8,10-11", as used by sysfs.
+std::vector<std::size_t> parseCpuList(const std::string& list) {
+  std::vector<std::size_t> cpus;
+  std::stringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    try {
+      const auto dash = range.find('-');
+      const auto first = std::stoul(range.substr(0u, dash));
+      const auto last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1u));
+      for (auto cpu = first; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::logic_error&) {
+      // Ignore malformed ranges, e.g., the trailing newline.
+    }
+  }
+  return cpus;
+}
+
+// Returns the cpus this process is allowed to run on, in ascending order.
+std::vector<std::size_t> getAvailableCpus() {
+  std::vector<std::size_t> cpus;
+  cpu_set_t available;
+  CPU_ZERO(&available);
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &available) == 0) {
+    for (std::size_t cpu = 0u; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &available)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+  return cpus;
+}
+
+}  // namespace
+
+std::size_t getNumAvailableCores() {
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &cpuSet) == 0) {
+    return static_cast<std::size_t>(CPU_COUNT(&cpuSet));
+  }
+
+  // Fall back to the number of hardware threads if the affinity mask is not available.
+  const auto numHardwareThreads = std::thread::hardware_concurrency();
+  return numHardwareThreads == 0u ? 1u : static_cast<std::size_t>(numHardwareThreads);
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> getSiblingCorePairs() {
+  const auto cpus = getAvailableCpus();
+  auto indexOf = [&cpus](std::size_t cpu) {
+    return static_cast<std::size_t>(std::find(cpus.begin(), cpus.end(), cpu) - cpus.begin());
+  };
+
+  // Pair every core with its first available sibling that is not yet paired.
+  std::vector<bool> isPaired(cpus.size(), false);
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+  for (std::size_t i = 0u; i < cpus.size(); ++i) {
+    if (isPaired[i]) {
+      continue;
+    }
+    std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpus[i]) +
+                       "/topology/thread_siblings_list");
+    std::string list;
+    std::getline(file, list);
+    for (const auto sibling : parseCpuList(list)) {
+      const auto j = indexOf(sibling);
+      if (j != i && j < cpus.size() && !isPaired[j]) {
+        pairs.emplace_back(i, j);
+        isPaired[i] = true;
+        isPaired[j] = true;
+        break;
+      }
+    }
+  }
+
+  // Pair the remaining cores in order.
+  std::vector<std::size_t> unpaired;
+  for (std::size_t i = 0u; i < cpus.size(); ++i) {
+    if (!isPaired[i]) {
+      unpaired.push_back(i);
+    }
+  }
+  for (std::size_t k = 0u; k < unpaired.size(); k += 2u) {
+    pairs.emplace_back(unpaired[k], unpaired[std::min(k + 1u, unpaired.size() - 1u)]);
+  }
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+
+bool pinCurrentThreadToCore(std::size_t core) {
+  // Collect the cores this process is allowed to run on.
+  cpu_set_t available;
+  CPU_ZERO(&available);
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &available) != 0) {
+    OMPL_WARN("Could not get the cpu affinity of this process.");
+    return false;
+  }
+
+  // Find the requested core among the available ones.
+  const auto numAvailableCores = static_cast<std::size_t>(CPU_COUNT(&available));
+  if (numAvailableCores == 0u) {
+    return false;
+  }
+  std::size_t index = core % numAvailableCores;
+  for (std::size_t cpu = 0u; cpu < CPU_SETSIZE; ++cpu) {
+    if (!CPU_ISSET(cpu, &available)) {
+      continue;
+    }
+    if (index-- == 0u) {
+      cpu_set_t cpuSet;
+      CPU_ZERO(&cpuSet);
+      CPU_SET(cpu, &cpuSet);
+      if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0) {
+        OMPL_WARN("Could not pin thread to core %zu.", cpu);
+        return false;
+      }
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace utilities
+
+}  // namespace pdt
@@ -42,6 +42,7 @@
 #include "pdt/common/context_type.h"
 #include "pdt/common/planner_type.h"
 #include "pdt/config/configuration.h"
+#include "pdt/objectives/costmap_optimization_objective.h"
 #include "pdt/objectives/optimization_objective_visitor.h"
 #include "pdt/objectives/potential_field_optimization_objective.h"
 #include "pdt/objectives/reciprocal_clearance_optimization_objective.h"
@@ -145,13 +146,17 @@ class InteractiveVisualizer : public BaseVisualizer,
   void visit(const planning_contexts::FlankingGap& context) const override;
   void visit(const planning_contexts::FourRooms& context) const override;
   void visit(const planning_contexts::GoalEnclosure& context) const override;
+  void visit(const planning_contexts::MeshR3& context) const override;
+  void visit(const planning_contexts::MeshSE3& context) const override;
   void visit(const planning_contexts::NarrowPassage& context) const override;
   void visit(const planning_contexts::ObstacleFree& context) const override;
+  void visit(const planning_contexts::OccupancyGrid& context) const override;
   void visit(const planning_contexts::RandomRectangles& context) const override;
   void visit(const planning_contexts::RandomRectanglesMultiStartGoal& context) const override;
   void visit(const planning_contexts::ReedsSheppRandomRectangles& context) const override;
   void visit(const planning_contexts::RepeatingRectangles& context) const override;
   void visit(const planning_contexts::StartEnclosure& context) const override;
+  void visit(const planning_contexts::VoxelGrid& context) const override;
   void visit(const planning_contexts::WallGap& context) const override;
 
   // Implement visualizations of obstacles.
@@ -160,6 +165,7 @@ class InteractiveVisualizer : public BaseVisualizer,
       const obstacles::Hyperrectangle<obstacles::BaseAntiObstacle>& antiObstacle) const override;
 
   // Implement visualizations of objectives.
+  void visit(const objectives::CostMapOptimizationObjective& objective) const override;
   void visit(const objectives::PotentialFieldOptimizationObjective& objective) const override;
   void visit(const objectives::ReciprocalClearanceOptimizationObjective& objective) const override;
   void visit(const objectives::MaxMinClearanceOptimizationObjective& objective) const override;
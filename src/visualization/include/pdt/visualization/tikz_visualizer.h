@@ -87,13 +87,17 @@ class TikzVisualizer : public planning_contexts::ContextVisitor, public obstacle
   void visit(const planning_contexts::FlankingGap& context) const override;
   void visit(const planning_contexts::FourRooms& context) const override;
   void visit(const planning_contexts::GoalEnclosure& context) const override;
+  void visit(const planning_contexts::MeshR3& context) const override;
+  void visit(const planning_contexts::MeshSE3& context) const override;
   void visit(const planning_contexts::NarrowPassage& context) const override;
   void visit(const planning_contexts::ObstacleFree& context) const override;
+  void visit(const planning_contexts::OccupancyGrid& context) const override;
   void visit(const planning_contexts::RandomRectangles& context) const override;
   void visit(const planning_contexts::RandomRectanglesMultiStartGoal& context) const override;
   void visit(const planning_contexts::ReedsSheppRandomRectangles& context) const override;
   void visit(const planning_contexts::RepeatingRectangles& context) const override;
   void visit(const planning_contexts::StartEnclosure& context) const override;
+  void visit(const planning_contexts::VoxelGrid& context) const override;
   void visit(const planning_contexts::WallGap& context) const override;
 
   // Implement visualizations of obstacles.
@@ -104,6 +108,7 @@ class TikzVisualizer : public planning_contexts::ContextVisitor, public obstacle
   // Helper functions.
   void drawBoundary(const planning_contexts::RealVectorGeometricContext& context) const;
   void drawBoundary(const planning_contexts::ReedsSheppRandomRectangles& context) const;
+  void drawBoundary(const planning_contexts::MeshSE3& context) const;
   void drawGoal(const std::shared_ptr<ompl::base::Goal>& context) const;
   void drawStartVertex(const ompl::base::PlannerDataVertex& vertex) const;
   void drawStartState(const ompl::base::ScopedState<ompl::base::RealVectorStateSpace>& state) const;
@@ -325,8 +325,16 @@ void InteractiveVisualizer::run() {
       }
     }
 
-    // Draw the obstacles.
+    // Draw the obstacles. The obstacles of occupancy and voxel grids are cells and the obstacles
+    // of mesh contexts are triangles, not geometric primitives.
     if (optionDrawObstacles) {
+      if (auto grid = std::dynamic_pointer_cast<planning_contexts::OccupancyGrid>(context_)) {
+        visit(*grid);
+      } else if (auto voxels = std::dynamic_pointer_cast<planning_contexts::VoxelGrid>(context_)) {
+        visit(*voxels);
+      } else if (auto mesh = std::dynamic_pointer_cast<planning_contexts::MeshR3>(context_)) {
+        visit(*mesh);
+      }
       for (auto obstacle : context_->getObstacles()) {
         obstacle->accept(*this);
       }
@@ -531,12 +539,78 @@ void InteractiveVisualizer::visit(const planning_contexts::FourRooms& /* context
 void InteractiveVisualizer::visit(const planning_contexts::GoalEnclosure& /* context */) const {
 }
 
+void InteractiveVisualizer::visit(const planning_contexts::MeshR3& context) const {
+  // Draw the environment as a wireframe of its triangles.
+  const auto environment = context.getEnvironment();
+  std::vector<Eigen::Vector3f> edges;
+  edges.reserve(6u * environment->size());
+  for (std::size_t i = 0u; i < environment->size(); ++i) {
+    const auto& triangle = environment->getTriangle(i);
+    for (auto vertex = 0u; vertex < 3u; ++vertex) {
+      const auto next = (vertex + 1u) % 3u;
+      edges.emplace_back(static_cast<float>(triangle[3u * vertex]),
+                         static_cast<float>(triangle[3u * vertex + 1u]),
+                         static_cast<float>(triangle[3u * vertex + 2u]));
+      edges.emplace_back(static_cast<float>(triangle[3u * next]),
+                         static_cast<float>(triangle[3u * next + 1u]),
+                         static_cast<float>(triangle[3u * next + 2u]));
+    }
+  }
+  drawLines(edges, 1.0f, black);
+}
+
+void InteractiveVisualizer::visit(const planning_contexts::MeshSE3& /* context */) const {
+}
+
 void InteractiveVisualizer::visit(const planning_contexts::NarrowPassage& /* context */) const {
 }
 
 void InteractiveVisualizer::visit(const planning_contexts::ObstacleFree& /* context */) const {
 }
 
+void InteractiveVisualizer::visit(const planning_contexts::OccupancyGrid& context) const {
+  const auto& boundaries = context.getBoundaries();
+  const auto map = context.getMap();
+
+  // Large maps are drawn in blocks of cells, which are drawn as obstacles if any of their cells is
+  // occupied.
+  constexpr std::size_t maxNumBlocksPerAxis{200u};
+  const auto numRows = map->getNumRows();
+  const auto numCols = map->getNumCols();
+  const auto rowStride = (numRows + maxNumBlocksPerAxis - 1u) / maxNumBlocksPerAxis;
+  const auto colStride = (numCols + maxNumBlocksPerAxis - 1u) / maxNumBlocksPerAxis;
+  const auto cellWidthX = static_cast<float>(boundaries.high.at(0u) - boundaries.low.at(0u)) /
+                          static_cast<float>(numCols);
+  const auto cellWidthY = static_cast<float>(boundaries.high.at(1u) - boundaries.low.at(1u)) /
+                          static_cast<float>(numRows);
+
+  for (std::size_t row = 0u; row < numRows; row += rowStride) {
+    const auto numBlockRows = std::min(rowStride, numRows - row);
+    for (std::size_t col = 0u; col < numCols; col += colStride) {
+      const auto numBlockCols = std::min(colStride, numCols - col);
+      bool isOccupied = false;
+      for (auto r = row; r < row + numBlockRows && !isOccupied; ++r) {
+        for (auto c = col; c < col + numBlockCols && !isOccupied; ++c) {
+          isOccupied = map->isOccupied(r, c);
+        }
+      }
+      if (isOccupied) {
+        drawRectangle2D(
+            std::vector<float>{
+                static_cast<float>(boundaries.low.at(0u)) +
+                    (static_cast<float>(col) + static_cast<float>(numBlockCols) / 2.0f) *
+                        cellWidthX,
+                static_cast<float>(boundaries.low.at(1u)) +
+                    (static_cast<float>(row) + static_cast<float>(numBlockRows) / 2.0f) *
+                        cellWidthY},
+            std::vector<float>{static_cast<float>(numBlockCols) * cellWidthX,
+                               static_cast<float>(numBlockRows) * cellWidthY},
+            black, black);
+      }
+    }
+  }
+}
+
 void InteractiveVisualizer::visit(const planning_contexts::RandomRectangles& /* context */) const {
 }
 
@@ -555,6 +629,31 @@ void InteractiveVisualizer::visit(
 void InteractiveVisualizer::visit(const planning_contexts::StartEnclosure& /* context */) const {
 }
 
+void InteractiveVisualizer::visit(const planning_contexts::VoxelGrid& context) const {
+  const auto& boundaries = context.getBoundaries();
+  const auto map = context.getMap();
+
+  // The voxels are drawn in blocks, which are the occupied nodes and the bricks that contain
+  // occupied voxels.
+  const auto& numVoxels = map->getNumVoxels();
+  std::vector<float> voxelWidths(3u);
+  for (auto dim = 0u; dim < 3u; ++dim) {
+    voxelWidths[dim] = static_cast<float>(boundaries.high.at(dim) - boundaries.low.at(dim)) /
+                       static_cast<float>(numVoxels[dim]);
+  }
+  map->forEachBlock([&](const std::array<std::size_t, 3u>& lower, std::size_t sideLength) {
+    std::vector<float> midpoint(3u);
+    std::vector<float> widths(3u);
+    for (auto dim = 0u; dim < 3u; ++dim) {
+      const auto numBlockVoxels = std::min(sideLength, numVoxels[dim] - lower[dim]);
+      widths[dim] = static_cast<float>(numBlockVoxels) * voxelWidths[dim];
+      midpoint[dim] = static_cast<float>(boundaries.low.at(dim)) +
+                      static_cast<float>(lower[dim]) * voxelWidths[dim] + widths[dim] / 2.0f;
+    }
+    drawRectangle3D(midpoint, widths, black, black);
+  });
+}
+
 void InteractiveVisualizer::visit(const planning_contexts::WallGap& /* context */) const {
 }
 
@@ -862,6 +961,55 @@ void InteractiveVisualizer::visit(
   drawRectangle(anchor, widths, white, white);
 }
 
+void InteractiveVisualizer::visit(
+    const objectives::CostMapOptimizationObjective& objective) const {
+  const auto vectorContext =
+      std::dynamic_pointer_cast<planning_contexts::RealVectorGeometricContext>(context_);
+  if (!vectorContext || bounds_.low.size() != 2u) {
+    throw std::runtime_error(
+        "CostMapOptimizationObjective is only implemented for 2D real vector contexts.");
+  }
+  const auto boundaries = vectorContext->getBoundaries();
+
+  // Large maps are drawn in blocks of cells, each colored by the cost of its first cell.
+  constexpr std::size_t maxNumBlocksPerAxis{100u};
+  const auto numRows = objective.getNumRows();
+  const auto numCols = objective.getNumCols();
+  const auto rowStride = (numRows + maxNumBlocksPerAxis - 1u) / maxNumBlocksPerAxis;
+  const auto colStride = (numCols + maxNumBlocksPerAxis - 1u) / maxNumBlocksPerAxis;
+  const auto cellWidthX = static_cast<float>(boundaries.high.at(0u) - boundaries.low.at(0u)) /
+                          static_cast<float>(numCols);
+  const auto cellWidthY = static_cast<float>(boundaries.high.at(1u) - boundaries.low.at(1u)) /
+                          static_cast<float>(numRows);
+
+  // The map knows its extreme costs.
+  const auto minCost = static_cast<float>(objective.getMinCost());
+  const auto costRange = std::max(static_cast<float>(objective.getMaxCost()) - minCost,
+                                  std::numeric_limits<float>::min());
+
+  for (std::size_t row = 0u; row < numRows; row += rowStride) {
+    const auto numBlockRows = std::min(rowStride, numRows - row);
+    const auto y = static_cast<float>(boundaries.low.at(1u)) +
+                   (static_cast<float>(row) + static_cast<float>(numBlockRows) / 2.0f) * cellWidthY;
+    for (std::size_t col = 0u; col < numCols; col += colStride) {
+      const auto numBlockCols = std::min(colStride, numCols - col);
+      const auto x =
+          static_cast<float>(boundaries.low.at(0u)) +
+          (static_cast<float>(col) + static_cast<float>(numBlockCols) / 2.0f) * cellWidthX;
+
+      // Compute the color for this cost.
+      auto color = interpolateColors(
+          green, red, (static_cast<float>(objective.getCellCost(row, col)) - minCost) / costRange);
+
+      // Draw the rectangle.
+      drawRectangle2D(std::vector<float>{x, y},
+                      std::vector<float>{static_cast<float>(numBlockCols) * cellWidthX,
+                                         static_cast<float>(numBlockRows) * cellWidthY},
+                      color.data(), color.data());
+    }
+  }
+}
+
 void InteractiveVisualizer::visit(
     const objectives::PotentialFieldOptimizationObjective& objective) const {
   if (bounds_.low.size() == 2u) {
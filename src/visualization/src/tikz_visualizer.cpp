@@ -319,6 +319,16 @@ void TikzVisualizer::visit(const planning_contexts::GoalEnclosure& context) cons
   drawBoundary(context);
 }
 
+void TikzVisualizer::visit(const planning_contexts::MeshR3& context) const {
+  // Draw the boundary. Meshes are three dimensional, so only their bounds are projected.
+  drawBoundary(context);
+}
+
+void TikzVisualizer::visit(const planning_contexts::MeshSE3& context) const {
+  // Draw the boundary of the translational part.
+  drawBoundary(context);
+}
+
 void TikzVisualizer::visit(const planning_contexts::NarrowPassage& context) const {
   // Draw the boundary.
   drawBoundary(context);
@@ -329,6 +339,11 @@ void TikzVisualizer::visit(const planning_contexts::ObstacleFree& context) const
   drawBoundary(context);
 }
 
+void TikzVisualizer::visit(const planning_contexts::OccupancyGrid& context) const {
+  // Draw the boundary. Maps have far too many cells to draw them with TikZ.
+  drawBoundary(context);
+}
+
 void TikzVisualizer::visit(const planning_contexts::RandomRectangles& context) const {
   // Draw the boundary.
   drawBoundary(context);
@@ -354,6 +369,11 @@ void TikzVisualizer::visit(const planning_contexts::StartEnclosure& context) con
   drawBoundary(context);
 }
 
+void TikzVisualizer::visit(const planning_contexts::VoxelGrid& context) const {
+  // Draw the boundary.
+  drawBoundary(context);
+}
+
 void TikzVisualizer::visit(const planning_contexts::WallGap& context) const {
   // Draw the boundary.
   drawBoundary(context);
@@ -394,6 +414,15 @@ void TikzVisualizer::drawBoundary(
   drawRectangle(midX, midY, widthX, widthY, pgftikz::zlevels::BOUNDARY, "boundary");
 }
 
+void TikzVisualizer::drawBoundary(const planning_contexts::MeshSE3& context) const {
+  const auto& boundaries = context.getBoundaries();
+  double midX = (boundaries.low.at(0u) + boundaries.high.at(0u)) / 2.0;
+  double midY = (boundaries.low.at(1u) + boundaries.high.at(1u)) / 2.0;
+  double widthX = boundaries.high.at(0u) - boundaries.low.at(0u);
+  double widthY = boundaries.high.at(1u) - boundaries.low.at(1u);
+  drawRectangle(midX, midY, widthX, widthY, pgftikz::zlevels::BOUNDARY, "boundary");
+}
+
 void TikzVisualizer::drawGoal(const std::shared_ptr<ompl::base::Goal>& goal) const {
   switch (goal->getType()) {
     case ompl::base::GoalType::GOAL_STATE: {
@@ -0,0 +1,238 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <experimental/filesystem>
+
+#include <ompl/util/Console.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "pdt/loggers/binary_results.h"
+#include "pdt/loggers/experiment_journal.h"
+#include "pdt/loggers/results_reader.h"
+
+using namespace std::string_literals;
+namespace fs = std::experimental::filesystem;
+
+namespace {
+
+// A measured run of a planner.
+struct Run {
+  std::string plannerName;
+  std::vector<double> durations;
+  std::vector<double> costs;
+};
+
+// Creates an empty directory for the files of a test.
+fs::path createTestDirectory(const std::string& name) {
+  const auto directory = fs::temp_directory_path() / ("test_pdt_loggers_"s + name);
+  fs::remove_all(directory);
+  fs::create_directories(directory);
+  return directory;
+}
+
+// Checks that the reader reads exactly the given runs.
+template <typename Reader>
+void checkRuns(const Reader& reader, const std::vector<Run>& runs) {
+  REQUIRE(reader.getNumRuns() == runs.size());
+  for (std::size_t i = 0u; i < runs.size(); ++i) {
+    CHECK(reader.getPlannerName(i) == runs[i].plannerName);
+    REQUIRE(reader.getNumMeasurements(i) == runs[i].durations.size());
+    for (std::size_t j = 0u; j < runs[i].durations.size(); ++j) {
+      CHECK(reader.getDurations(i)[j] == runs[i].durations[j]);
+      CHECK(reader.getCosts(i)[j] == runs[i].costs[j]);
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Binary results") {
+  // Only print warnings and errors.
+  ompl::msg::setLogLevel(ompl::msg::LogLevel::LOG_WARN);
+
+  const auto directory = createTestDirectory("binary_results");
+  const auto path = directory / ("results"s + pdt::loggers::binary_results::EXTENSION);
+
+  // Runs with names and numbers of measurements that do not align to eight bytes, including runs
+  // without a solution.
+  const auto infinity = std::numeric_limits<double>::infinity();
+  const std::vector<Run> runs{{"RRTConnect", {0.001, 0.5, 1.0}, {2.5, 1.75, 1.5}},
+                              {"BIT*", {}, {}},
+                              {"", {1.0}, {infinity}},
+                              {"EIT*", {1e-9, 0.1, 0.2, 0.3, 0.4}, {infinity, 3.0, 2.0, 1.0, 0.9}}};
+
+  SUBCASE("Round trip") {
+    for (const auto& run : runs) {
+      pdt::loggers::binary_results::appendRun(path, run.plannerName, run.durations, run.costs);
+    }
+    CHECK(pdt::loggers::binary_results::isBinaryResultsFile(path));
+    checkRuns(pdt::loggers::binary_results::Reader(path), runs);
+    checkRuns(pdt::loggers::ResultsReader(path), runs);
+  }
+
+  SUBCASE("Interrupted appends") {
+    // An interrupted append leaves an incomplete last record, which readers ignore and the next
+    // append replaces.
+    for (const auto& run : runs) {
+      pdt::loggers::binary_results::appendRun(path, run.plannerName, run.durations, run.costs);
+    }
+    pdt::loggers::binary_results::appendRun(path, "RRT*", {0.1, 0.2}, {5.0, 4.0});
+    fs::resize_file(path, fs::file_size(path) - 12u);
+    checkRuns(pdt::loggers::binary_results::Reader(path), runs);
+    auto extendedRuns = runs;
+    extendedRuns.push_back({"RRT#", {0.3}, {4.5}});
+    pdt::loggers::binary_results::appendRun(path, "RRT#", {0.3}, {4.5});
+    checkRuns(pdt::loggers::binary_results::Reader(path), extendedRuns);
+
+    // So is anything else behind the last complete record.
+    {
+      std::ofstream file(path.string(), std::ofstream::app | std::ofstream::binary);
+      file << "RRT*";
+    }
+    checkRuns(pdt::loggers::binary_results::Reader(path), extendedRuns);
+    extendedRuns.push_back({"PRM", {}, {}});
+    pdt::loggers::binary_results::appendRun(path, "PRM", {}, {});
+    checkRuns(pdt::loggers::binary_results::Reader(path), extendedRuns);
+  }
+
+  SUBCASE("Runs need a cost per duration") {
+    CHECK_THROWS_AS(pdt::loggers::binary_results::appendRun(path, "RRTConnect", {1.0}, {}),
+                    std::invalid_argument);
+  }
+
+  SUBCASE("Csv results") {
+    // The results reader reads csv results like binary ones.
+    const auto csvPath = directory / "results.csv";
+    {
+      std::ofstream file(csvPath.string());
+      file << "RRTConnect,0.001,0.5,1\nRRTConnect,2.5,1.75,1.5\nBIT*,1\nBIT*,inf\n";
+    }
+    CHECK_FALSE(pdt::loggers::binary_results::isBinaryResultsFile(csvPath));
+    checkRuns(pdt::loggers::ResultsReader(csvPath),
+              {{"RRTConnect", {0.001, 0.5, 1.0}, {2.5, 1.75, 1.5}}, {"BIT*", {1.0}, {infinity}}});
+  }
+
+  SUBCASE("Truncation") {
+    // Truncating keeps the first runs.
+    for (const auto& run : runs) {
+      pdt::loggers::binary_results::appendRun(path, run.plannerName, run.durations, run.costs);
+    }
+    pdt::loggers::truncateResults(path, 2u);
+    checkRuns(pdt::loggers::binary_results::Reader(path), {runs.begin(), runs.begin() + 2});
+    CHECK_THROWS(pdt::loggers::truncateResults(path, 3u));
+  }
+
+  fs::remove_all(directory);
+}
+
+TEST_CASE("Experiment journal") {
+  // Only print warnings and errors.
+  ompl::msg::setLogLevel(ompl::msg::LogLevel::LOG_WARN);
+
+  const auto directory = createTestDirectory("experiment_journal");
+  const auto path = directory / "journal.jsonl";
+  const std::vector<std::vector<std::string>> plannerOrders{{"RRTConnect", "BIT*"},
+                                                            {"BIT*", "RRTConnect"}};
+  const std::vector<pdt::loggers::JournaledQuery> queries{{{{0.1, 0.2}}, {{0.3, 0.4}}},
+                                                          {{{-0.1, -0.2}, {0.0, 0.0}}, {}}};
+
+  // Journal the first run.
+  {
+    pdt::loggers::ExperimentJournal journal(path, 42u, plannerOrders);
+    journal.recordQueries(0u, queries);
+    journal.markCompleted(0u, "RRTConnect", 2u);
+    journal.markCompleted(0u, "BIT*", 2u);
+  }
+
+  SUBCASE("Journals cannot be overwritten") {
+    CHECK_THROWS_AS(pdt::loggers::ExperimentJournal(path, 42u, plannerOrders),
+                    std::ios_base::failure);
+  }
+
+  SUBCASE("Resuming") {
+    pdt::loggers::ExperimentJournal journal(path);
+    CHECK(journal.getSeed() == 42u);
+    CHECK(journal.getPlannerOrders() == plannerOrders);
+    CHECK(journal.getNumCompletedRuns() == 2u);
+    CHECK(journal.isCompleted(0u, "BIT*", 1u));
+    CHECK_FALSE(journal.isCompleted(0u, "BIT*", 2u));
+    CHECK_FALSE(journal.isCompleted(1u, "RRTConnect", 0u));
+    REQUIRE(journal.hasQueries(0u));
+    CHECK_FALSE(journal.hasQueries(1u));
+    REQUIRE(journal.getQueries(0u).size() == queries.size());
+    for (std::size_t i = 0u; i < queries.size(); ++i) {
+      CHECK(journal.getQueries(0u)[i].starts == queries[i].starts);
+      CHECK(journal.getQueries(0u)[i].goals == queries[i].goals);
+    }
+  }
+
+  SUBCASE("Torn last line") {
+    // An experiment that is interrupted while journaling can leave an incomplete last line.
+    {
+      std::ofstream file(path.string(), std::ofstream::app);
+      file << R"({"run":1,"planner":"BIT*","queri)";
+    }
+    {
+      pdt::loggers::ExperimentJournal journal(path);
+      CHECK(journal.getNumCompletedRuns() == 2u);
+      CHECK_FALSE(journal.isCompleted(1u, "BIT*", 0u));
+
+      // Entries that are journaled after resuming do not continue the incomplete line.
+      journal.markCompleted(1u, "BIT*", 2u);
+    }
+    pdt::loggers::ExperimentJournal journal(path);
+    CHECK(journal.getNumCompletedRuns() == 3u);
+    CHECK(journal.isCompleted(1u, "BIT*", 1u));
+  }
+
+  SUBCASE("Corrupt line") {
+    // Only the last line may be incomplete.
+    {
+      std::ofstream file(path.string(), std::ofstream::app);
+      file << R"({"run":1,"planner":"BIT*","queri)" << '\n'
+           << R"({"run":1,"planner":"BIT*","queries":[0,1]})" << '\n';
+    }
+    CHECK_THROWS(pdt::loggers::ExperimentJournal(path));
+  }
+
+  fs::remove_all(directory);
+}
@@ -39,12 +39,16 @@
 #include <ompl/base/objectives/PathLengthOptimizationObjective.h>
 #include <ompl/base/spaces/RealVectorStateSpace.h>
 #include <ompl/util/Console.h>
+#include <ompl/util/RandomNumbers.h>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest/doctest.h"
 #include "pdt/config/configuration.h"
 #include "pdt/config/directory.h"
 #include "pdt/factories/context_factory.h"
+#include "pdt/objectives/costmap_optimization_objective.h"
+#include "pdt/objectives/max_min_clearance_optimization_objective.h"
+#include "pdt/objectives/point_source_tree.h"
 #include "pdt/objectives/reciprocal_clearance_optimization_objective.h"
 
 using namespace std::string_literals;
@@ -425,4 +429,140 @@ TEST_CASE("Optimization objectives") {
       }
     }
   }
+
+  SUBCASE("Max min clearance") {
+    // Load the test configuration.
+    CHECK(fs::exists(configsDir / "obstacle_clearance.json"));
+    config->load(configsDir / "obstacle_clearance.json");
+
+    // Prepare the context creation.
+    pdt::factories::ContextFactory factory(config);
+    const std::vector<std::string> contextNames{"test2d", "test4d", "test8d", "test16d", "test32d"};
+
+    // Loop over all contexts.
+    for (const auto& name : contextNames) {
+      SUBCASE(name.c_str()) {
+        // Create the context.
+        auto context = factory.create(name);
+        const auto spaceInfo = context->getSpaceInformation();
+
+        // The skipping objective must compute exactly the same costs as the exhaustive one.
+        pdt::objectives::MaxMinClearanceOptimizationObjective exhaustive(spaceInfo);
+        pdt::objectives::MaxMinClearanceOptimizationObjective skipping(spaceInfo);
+        skipping.setClearanceLipschitzConstant(1.0);
+
+        auto s1 = spaceInfo->allocState();
+        auto s2 = spaceInfo->allocState();
+        const auto sampler = spaceInfo->allocStateSampler();
+#ifdef PDT_EXTRA_SET_LOCAL_SEEDS
+        sampler->setLocalSeed(42u);  // The tests should never fail/succeed randomly.
+#endif  // #ifdef PDT_EXTRA_SET_LOCAL_SEEDS
+        for (auto i = 0u; i < 1000u; ++i) {
+          sampler->sampleUniform(s1);
+          sampler->sampleUniform(s2);
+          CHECK(skipping.motionCost(s1, s2).value() == exhaustive.motionCost(s1, s2).value());
+        }
+        spaceInfo->freeState(s1);
+        spaceInfo->freeState(s2);
+      }
+    }
+  }
+
+  SUBCASE("Cost map") {
+    // A random cost map on a two dimensional space.
+    auto space = std::make_shared<RealVectorStateSpace>(2u);
+    space->setBounds(-0.5, 0.5);
+    auto spaceInfo = std::make_shared<SpaceInformation>(space);
+    spaceInfo->setStateValidityChecker([](const State*) { return true; });
+    spaceInfo->setup();
+    ompl::RNG rng(42u);  // The tests should never fail/succeed randomly.
+    pdt::obstacles::Raster costMap;
+    costMap.numRows = 37u;
+    costMap.numCols = 23u;
+    for (auto i = 0u; i < costMap.numRows * costMap.numCols; ++i) {
+      costMap.values.push_back(rng.uniformReal(0.5, 10.0));
+    }
+    pdt::objectives::CostMapOptimizationObjective objective(spaceInfo, costMap);
+    CHECK(objective.getMinCost() >= 0.5);
+
+    auto s1 = spaceInfo->allocState()->as<RealVectorStateSpace::StateType>();
+    auto s2 = spaceInfo->allocState()->as<RealVectorStateSpace::StateType>();
+    auto s = spaceInfo->allocState()->as<RealVectorStateSpace::StateType>();
+
+    // The first row spans the lowest y values, the first column the lowest x values.
+    (*s)[0u] = -0.49;
+    (*s)[1u] = 0.49;
+    CHECK(objective.stateCost(s).value() == costMap(costMap.numRows - 1u, 0u));
+
+    // The motion cost must be the line integral of the state costs, which is approximated by the
+    // midpoint rule.
+    constexpr auto numSteps = 100000u;
+    for (auto i = 0u; i < 100u; ++i) {
+      (*s1)[0u] = rng.uniformReal(-0.5, 0.5);
+      (*s1)[1u] = rng.uniformReal(-0.5, 0.5);
+      (*s2)[0u] = rng.uniformReal(-0.5, 0.5);
+      (*s2)[1u] = rng.uniformReal(-0.5, 0.5);
+
+      // Every fourth motion is axis aligned.
+      if (i % 4u == 0u) {
+        (*s2)[i % 8u == 0u ? 0u : 1u] = (*s1)[i % 8u == 0u ? 0u : 1u];
+      }
+
+      double integral = 0.0;
+      for (auto step = 0u; step < numSteps; ++step) {
+        space->interpolate(s1, s2, (step + 0.5) / numSteps, s);
+        integral += objective.stateCost(s).value();
+      }
+      integral *= spaceInfo->distance(s1, s2) / numSteps;
+
+      CHECK(objective.motionCost(s1, s2).value() == doctest::Approx(integral).epsilon(1e-3));
+      CHECK(objective.motionCost(s2, s1).value() ==
+            doctest::Approx(objective.motionCost(s1, s2).value()));
+
+      // Make sure the heuristic is admissible.
+      CHECK_FALSE(objective.isCostBetterThan(objective.motionCost(s1, s2),
+                                             objective.motionCostHeuristic(s1, s2)));
+    }
+
+    spaceInfo->freeState(s1);
+    spaceInfo->freeState(s2);
+    spaceInfo->freeState(s);
+  }
+
+  SUBCASE("Point source tree") {
+    // Random sources in three dimensions, enough for the tree to have several levels.
+    ompl::RNG rng(42u);  // The tests should never fail/succeed randomly.
+    std::vector<std::vector<double>> sources(5000u, std::vector<double>(3u));
+    for (auto& source : sources) {
+      for (auto& coordinate : source) {
+        coordinate = rng.uniformReal(-0.5, 0.5);
+      }
+    }
+    pdt::objectives::PointSourceTree exact(sources, 0.0);
+    pdt::objectives::PointSourceTree approximate(sources, 0.5);
+
+    for (auto i = 0u; i < 100u; ++i) {
+      // Query points on the sources must cap their potential.
+      std::vector<double> point = i % 10u == 0u ? sources[i] : std::vector<double>(3u);
+      if (i % 10u != 0u) {
+        for (auto& coordinate : point) {
+          coordinate = rng.uniformReal(-1.0, 1.0);
+        }
+      }
+
+      // The exact potential sums all sources one by one.
+      double potential = 0.0;
+      for (const auto& source : sources) {
+        double squaredDistance = 0.0;
+        for (auto dim = 0u; dim < 3u; ++dim) {
+          squaredDistance += std::pow(source[dim] - point[dim], 2.0);
+        }
+        potential +=
+            std::min(1.0 / squaredDistance, pdt::objectives::PointSourceTree::MAX_POTENTIAL);
+      }
+      CHECK(exact.potential(point.data()) == doctest::Approx(potential));
+      CHECK(approximate.exactPotential(point.data()) == doctest::Approx(potential));
+      CHECK(approximate.potential(point.data()) == doctest::Approx(potential).epsilon(2e-2));
+    }
+  }
 }
@@ -0,0 +1,555 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <ompl/base/ScopedState.h>
+#include <ompl/base/SpaceInformation.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+#include <ompl/util/Console.h>
+#include <ompl/util/RandomNumbers.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "pdt/obstacles/base_obstacle.h"
+#include "pdt/obstacles/binary_map.h"
+#include "pdt/obstacles/bounding_volume_hierarchy.h"
+#include "pdt/obstacles/distance_field.h"
+#include "pdt/obstacles/hyperrectangle.h"
+#include "pdt/obstacles/hyperrectangle_set.h"
+#include "pdt/obstacles/rectangle_grid.h"
+#include "pdt/obstacles/voxel_map.h"
+
+using namespace ompl::base;
+
+namespace {
+
+using Hyperrectangle = pdt::obstacles::Hyperrectangle<pdt::obstacles::BaseObstacle>;
+
+// Creates the space information of the real vector space [-0.5, 0.5]^dimension.
+SpaceInformationPtr createSpaceInfo(std::size_t dimension) {
+  auto space = std::make_shared<RealVectorStateSpace>(static_cast<unsigned int>(dimension));
+  space->setBounds(-0.5, 0.5);
+  auto spaceInfo = std::make_shared<SpaceInformation>(space);
+  spaceInfo->setup();
+  return spaceInfo;
+}
+
+// Returns the fraction of the segment at which it enters the closed box, or infinity if it does
+// not intersect the box.
+double computeEntryFraction(const double* lower, const double* upper, const double* from,
+                            const double* to, std::size_t dimension) {
+  double entry = 0.0;
+  double exit = 1.0;
+  for (auto dim = 0u; dim < dimension; ++dim) {
+    const auto delta = to[dim] - from[dim];
+    if (delta == 0.0) {
+      if (from[dim] < lower[dim] || from[dim] > upper[dim]) {
+        return std::numeric_limits<double>::infinity();
+      }
+      continue;
+    }
+    const auto first = (lower[dim] - from[dim]) / delta;
+    const auto second = (upper[dim] - from[dim]) / delta;
+    entry = std::max(entry, std::min(first, second));
+    exit = std::min(exit, std::max(first, second));
+  }
+  return entry <= exit ? entry : std::numeric_limits<double>::infinity();
+}
+
+// Returns by how much the rectangle centered at (x, y) with the given half length along the
+// direction (cosine, sine) and the given half width orthogonal to it is separated from the
+// axis-aligned rectangle, which is negative if they overlap. The rectangles are projected onto the
+// four candidate axes with all of their corners.
+double computeSeparation(double x, double y, double cosine, double sine, double halfLength,
+                         double halfWidth, const std::array<double, 2u>& center,
+                         const std::array<double, 2u>& widths) {
+  std::array<std::array<double, 2u>, 4u> oriented;
+  std::array<std::array<double, 2u>, 4u> aligned;
+  for (auto i = 0u; i < 4u; ++i) {
+    const auto length = (i & 1u) ? halfLength : -halfLength;
+    const auto width = (i & 2u) ? halfWidth : -halfWidth;
+    oriented[i] = {{x + length * cosine - width * sine, y + length * sine + width * cosine}};
+    aligned[i] = {{center[0u] + ((i & 1u) ? 0.5 : -0.5) * widths[0u],
+                   center[1u] + ((i & 2u) ? 0.5 : -0.5) * widths[1u]}};
+  }
+  const std::array<std::array<double, 2u>, 4u> axes{
+      {{{1.0, 0.0}}, {{0.0, 1.0}}, {{cosine, sine}}, {{-sine, cosine}}}};
+  auto separation = -std::numeric_limits<double>::infinity();
+  for (const auto& axis : axes) {
+    auto minOriented = std::numeric_limits<double>::infinity();
+    auto maxOriented = -std::numeric_limits<double>::infinity();
+    auto minAligned = std::numeric_limits<double>::infinity();
+    auto maxAligned = -std::numeric_limits<double>::infinity();
+    for (auto i = 0u; i < 4u; ++i) {
+      const auto projectedOriented = oriented[i][0u] * axis[0u] + oriented[i][1u] * axis[1u];
+      const auto projectedAligned = aligned[i][0u] * axis[0u] + aligned[i][1u] * axis[1u];
+      minOriented = std::min(minOriented, projectedOriented);
+      maxOriented = std::max(maxOriented, projectedOriented);
+      minAligned = std::min(minAligned, projectedAligned);
+      maxAligned = std::max(maxAligned, projectedAligned);
+    }
+    separation =
+        std::max(separation, std::max(minAligned - maxOriented, minOriented - maxAligned));
+  }
+  return separation;
+}
+
+}  // namespace
+
+TEST_CASE("Hyperrectangle sets") {
+  // Only print warnings and errors.
+  ompl::msg::setLogLevel(ompl::msg::LogLevel::LOG_WARN);
+
+  ompl::RNG rng(42u);
+  for (const std::size_t dimension : {2u, 3u, 7u, 16u}) {
+    auto spaceInfo = createSpaceInfo(dimension);
+    for (const std::size_t numRectangles : {0u, 1u, 5u, 100u}) {
+      // Store the same hyperrectangles as obstacle objects and in the set.
+      pdt::obstacles::HyperrectangleSet set(dimension);
+      std::vector<std::shared_ptr<pdt::obstacles::BaseObstacle>> rectangles;
+      ScopedState<> anchor(spaceInfo);
+      std::vector<double> center(dimension), widths(dimension);
+      for (auto i = 0u; i < numRectangles; ++i) {
+        for (auto dim = 0u; dim < dimension; ++dim) {
+          center[dim] = anchor[dim] = rng.uniformReal(-0.5, 0.5);
+          widths[dim] = rng.uniformReal(0.1, 0.8);
+        }
+        set.add(center, widths);
+        rectangles.push_back(std::make_shared<Hyperrectangle>(spaceInfo, anchor, widths));
+      }
+      CHECK(set.size() == numRectangles);
+      CHECK(set.empty() == (numRectangles == 0u));
+
+      SUBCASE("Containment and clearance") {
+        ScopedState<RealVectorStateSpace> state(spaceInfo);
+        for (auto i = 0u; i < 1000u; ++i) {
+          for (auto dim = 0u; dim < dimension; ++dim) {
+            state[dim] = rng.uniformReal(-0.5, 0.5);
+          }
+          bool isInside = false;
+          auto clearance = std::numeric_limits<double>::infinity();
+          for (const auto& rectangle : rectangles) {
+            isInside = isInside || rectangle->invalidates(state.get());
+            clearance = std::min(clearance, rectangle->clearance(state.get()));
+          }
+          CHECK(set.contains(state->values) == isInside);
+          if (std::isinf(clearance)) {
+            CHECK(std::isinf(set.clearance(state->values)));
+          } else {
+            CHECK(set.clearance(state->values) == doctest::Approx(clearance));
+          }
+        }
+      }
+
+      SUBCASE("Points on the boundary are inside") {
+        for (auto i = 0u; i < numRectangles; ++i) {
+          std::vector<double> corner(dimension);
+          for (auto dim = 0u; dim < dimension; ++dim) {
+            corner[dim] = set.getCenter(i)[dim] + 0.5 * set.getWidths(i)[dim];
+          }
+          CHECK(set.contains(corner.data()));
+        }
+      }
+
+      SUBCASE("Batches") {
+        std::vector<std::vector<double>> points(3u, std::vector<double>(dimension));
+        std::vector<const double*> pointers;
+        for (const auto& point : points) {
+          pointers.push_back(point.data());
+        }
+        for (auto i = 0u; i < 300u; ++i) {
+          bool anyInside = false;
+          for (auto& point : points) {
+            for (auto dim = 0u; dim < dimension; ++dim) {
+              point[dim] = rng.uniformReal(-0.5, 0.5);
+            }
+            anyInside = anyInside || set.contains(point.data());
+          }
+          CHECK(set.containsAny(pointers.data(), pointers.size()) == anyInside);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Bounding volume hierarchies") {
+  ompl::RNG rng(42u);
+  for (const std::size_t dimension : {2u, 3u, 6u}) {
+    for (const std::size_t numBoxes : {0u, 1u, 3u, 50u, 500u}) {
+      // Draw random boxes.
+      std::vector<double> lowerBounds, upperBounds;
+      for (auto i = 0u; i < numBoxes * dimension; ++i) {
+        const auto center = rng.uniformReal(0.0, 1.0);
+        const auto width = rng.uniformReal(0.01, 0.3);
+        lowerBounds.push_back(center - width / 2.0);
+        upperBounds.push_back(center + width / 2.0);
+      }
+      pdt::obstacles::BoundingVolumeHierarchy hierarchy(dimension);
+      hierarchy.build(lowerBounds, upperBounds);
+      CHECK(hierarchy.size() == numBoxes);
+
+      // Compare the boxes the hierarchy finds to the ones a linear scan finds.
+      std::vector<double> from(dimension), to(dimension);
+      for (auto query = 0u; query < 200u; ++query) {
+        for (auto dim = 0u; dim < dimension; ++dim) {
+          from[dim] = rng.uniformReal(0.0, 1.0);
+          to[dim] = rng.uniformReal(0.0, 1.0);
+        }
+        std::set<std::size_t> containing, intersecting;
+        for (auto i = 0u; i < numBoxes; ++i) {
+          const auto lower = &lowerBounds[i * dimension];
+          const auto upper = &upperBounds[i * dimension];
+          if (computeEntryFraction(lower, upper, from.data(), from.data(), dimension) == 0.0) {
+            containing.insert(i);
+          }
+          if (!std::isinf(computeEntryFraction(lower, upper, from.data(), to.data(), dimension))) {
+            intersecting.insert(i);
+          }
+        }
+
+        std::set<std::size_t> found;
+        CHECK_FALSE(hierarchy.anyContaining(from.data(), [&found](std::size_t i) {
+          found.insert(i);
+          return false;
+        }));
+        CHECK(found == containing);
+        CHECK(hierarchy.anyContaining(from.data(), [](std::size_t) { return true; }) ==
+              !containing.empty());
+
+        found.clear();
+        CHECK_FALSE(hierarchy.anyIntersecting(from.data(), to.data(), [&found](std::size_t i) {
+          found.insert(i);
+          return false;
+        }));
+        CHECK(found == intersecting);
+        CHECK(hierarchy.anyIntersecting(from.data(), to.data(),
+                                        [](std::size_t) { return true; }) ==
+              !intersecting.empty());
+      }
+    }
+  }
+}
+
+TEST_CASE("Distance fields") {
+  // Only print warnings and errors.
+  ompl::msg::setLogLevel(ompl::msg::LogLevel::LOG_WARN);
+
+  CHECK(pdt::obstacles::DistanceField::computeErrorBound(2u, 0.1) ==
+        doctest::Approx(std::sqrt(2.0) / 2.0 * 0.1));
+  CHECK(pdt::obstacles::DistanceField::computeErrorBound(3u, 0.1) ==
+        doctest::Approx(std::sqrt(3.0) / 2.0 * 0.1));
+
+  ompl::RNG rng(42u);
+  for (const std::size_t dimension : {2u, 3u}) {
+    auto spaceInfo = createSpaceInfo(dimension);
+
+    // Place some random hyperrectangles.
+    std::vector<std::shared_ptr<pdt::obstacles::BaseObstacle>> rectangles;
+    ScopedState<> anchor(spaceInfo);
+    std::vector<double> widths(dimension);
+    for (auto i = 0u; i < 10u; ++i) {
+      for (auto dim = 0u; dim < dimension; ++dim) {
+        anchor[dim] = rng.uniformReal(-0.5, 0.5);
+        widths[dim] = rng.uniformReal(0.05, 0.2);
+      }
+      rectangles.push_back(std::make_shared<Hyperrectangle>(spaceInfo, anchor, widths));
+    }
+
+    for (const double resolution : {0.1, 0.03}) {
+      pdt::obstacles::DistanceField field(spaceInfo, rectangles, resolution, 2u);
+      const auto errorBound =
+          pdt::obstacles::DistanceField::computeErrorBound(dimension, resolution);
+      CHECK(field.getErrorBound() == doctest::Approx(errorBound));
+
+      // The interpolated clearance is within the error bound of the exact clearance and changes no
+      // faster than the Lipschitz constant.
+      ScopedState<RealVectorStateSpace> state(spaceInfo), neighbour(spaceInfo);
+      for (auto i = 0u; i < 2000u; ++i) {
+        for (auto dim = 0u; dim < dimension; ++dim) {
+          state[dim] = rng.uniformReal(-0.5, 0.5);
+          neighbour[dim] = std::clamp(state[dim] + rng.uniformReal(-0.05, 0.05), -0.5, 0.5);
+        }
+        REQUIRE(field.covers(state->values));
+        REQUIRE(field.covers(neighbour->values));
+        auto exactClearance = std::numeric_limits<double>::infinity();
+        for (const auto& rectangle : rectangles) {
+          exactClearance = std::min(exactClearance, rectangle->clearance(state.get()));
+        }
+        const auto clearance = field.clearance(state->values);
+        CHECK(std::abs(clearance - exactClearance) <= field.getErrorBound() + 1e-12);
+        CHECK(std::abs(clearance - field.clearance(neighbour->values)) <=
+              field.getLipschitzConstant() * spaceInfo->distance(state.get(), neighbour.get()) +
+                  1e-12);
+      }
+
+      // The field does not cover points outside the bounds of the space.
+      std::vector<double> outside(dimension, 0.0);
+      outside[0u] = 0.6;
+      CHECK_FALSE(field.covers(outside.data()));
+    }
+
+    // A field of no obstacles covers nothing.
+    pdt::obstacles::DistanceField emptyField(spaceInfo, {}, 0.1, 1u);
+    std::vector<double> origin(dimension, 0.0);
+    CHECK_FALSE(emptyField.covers(origin.data()));
+  }
+}
+
+TEST_CASE("Binary map ray traversal") {
+  // Occupy random blocks of cells, which are remembered as boxes in cell coordinates.
+  ompl::RNG rng(42u);
+  const std::size_t numRows = 70u;
+  const std::size_t numCols = 130u;
+  pdt::obstacles::BinaryMap map(numRows, numCols);
+  std::vector<std::array<double, 2u>> lowerBounds, upperBounds;
+  for (auto i = 0u; i < 40u; ++i) {
+    const auto col = static_cast<std::size_t>(rng.uniformInt(0, static_cast<int>(numCols) - 1));
+    const auto row = static_cast<std::size_t>(rng.uniformInt(0, static_cast<int>(numRows) - 1));
+    const auto lastCol =
+        std::min(col + static_cast<std::size_t>(rng.uniformInt(0, 6)), numCols - 1u);
+    const auto lastRow =
+        std::min(row + static_cast<std::size_t>(rng.uniformInt(0, 6)), numRows - 1u);
+    for (auto r = row; r <= lastRow; ++r) {
+      for (auto c = col; c <= lastCol; ++c) {
+        map.setOccupied(r, c, true);
+      }
+    }
+    lowerBounds.push_back({{static_cast<double>(col), static_cast<double>(row)}});
+    upperBounds.push_back({{static_cast<double>(lastCol + 1u), static_cast<double>(lastRow + 1u)}});
+  }
+
+  // The traversal finds where a segment first enters any of the blocks.
+  std::array<double, 2u> from, to;
+  std::size_t numHits = 0u;
+  for (auto i = 0u; i < 2000u; ++i) {
+    from = {{rng.uniformReal(0.0, numCols), rng.uniformReal(0.0, numRows)}};
+    if (i % 2u == 0u) {
+      to = {{rng.uniformReal(0.0, numCols), rng.uniformReal(0.0, numRows)}};
+    } else {
+      // Short segments within a few cells, including axis-aligned ones.
+      to = {{std::clamp(from[0u] + rng.uniformReal(-3.0, 3.0), 0.0, numCols - 1e-9),
+             std::clamp(from[1u] + rng.uniformReal(-3.0, 3.0), 0.0, numRows - 1e-9)}};
+      if (i % 6u == 1u) {
+        to[0u] = from[0u];
+      } else if (i % 6u == 3u) {
+        to[1u] = from[1u];
+      }
+    }
+    auto expected = std::numeric_limits<double>::infinity();
+    for (auto j = 0u; j < lowerBounds.size(); ++j) {
+      expected = std::min(expected, computeEntryFraction(lowerBounds[j].data(),
+                                                         upperBounds[j].data(), from.data(),
+                                                         to.data(), 2u));
+    }
+    CHECK(map.isOccupied(from.data()) == (expected == 0.0));
+    const auto fraction = map.findFirstOccupied(from.data(), to.data());
+    if (std::isinf(expected)) {
+      CHECK(std::isinf(fraction));
+    } else {
+      CHECK(fraction == doctest::Approx(expected).epsilon(1e-9));
+      ++numHits;
+    }
+  }
+  // Make sure the test exercises both outcomes.
+  CHECK(numHits > 100u);
+  CHECK(numHits < 1900u);
+}
+
+TEST_CASE("Voxel map ray traversal") {
+  // Occupy random blocks of voxels across several nodes, which are remembered as boxes in voxel
+  // coordinates.
+  ompl::RNG rng(42u);
+  const std::array<std::size_t, 3u> numVoxels{{200u, 150u, 140u}};
+  pdt::obstacles::VoxelMap map(numVoxels);
+  std::vector<std::array<double, 3u>> lowerBounds, upperBounds;
+  std::set<std::array<std::size_t, 3u>> occupied;
+  for (auto i = 0u; i < 60u; ++i) {
+    std::array<std::size_t, 3u> first, last;
+    for (auto dim = 0u; dim < 3u; ++dim) {
+      first[dim] =
+          static_cast<std::size_t>(rng.uniformInt(0, static_cast<int>(numVoxels[dim]) - 1));
+      last[dim] = std::min(first[dim] + static_cast<std::size_t>(rng.uniformInt(0, 20)),
+                           numVoxels[dim] - 1u);
+    }
+    for (auto x = first[0u]; x <= last[0u]; ++x) {
+      for (auto y = first[1u]; y <= last[1u]; ++y) {
+        for (auto z = first[2u]; z <= last[2u]; ++z) {
+          map.setOccupied({{x, y, z}}, true);
+          occupied.insert({{x, y, z}});
+        }
+      }
+    }
+    lowerBounds.push_back({{static_cast<double>(first[0u]), static_cast<double>(first[1u]),
+                            static_cast<double>(first[2u])}});
+    upperBounds.push_back({{static_cast<double>(last[0u] + 1u),
+                            static_cast<double>(last[1u] + 1u),
+                            static_cast<double>(last[2u] + 1u)}});
+  }
+  map.compact();
+  CHECK(map.countOccupied() == occupied.size());
+
+  // The traversal finds where a segment first enters any of the blocks.
+  std::array<double, 3u> from, to;
+  std::size_t numHits = 0u;
+  for (auto i = 0u; i < 2000u; ++i) {
+    for (auto dim = 0u; dim < 3u; ++dim) {
+      const auto numDimVoxels = static_cast<double>(numVoxels[dim]);
+      from[dim] = rng.uniformReal(0.0, numDimVoxels);
+      to[dim] = i % 2u == 0u ? rng.uniformReal(0.0, numDimVoxels)
+                             : std::clamp(from[dim] + rng.uniformReal(-10.0, 10.0), 0.0,
+                                          numDimVoxels - 1e-9);
+    }
+    auto expected = std::numeric_limits<double>::infinity();
+    for (auto j = 0u; j < lowerBounds.size(); ++j) {
+      expected = std::min(expected, computeEntryFraction(lowerBounds[j].data(),
+                                                         upperBounds[j].data(), from.data(),
+                                                         to.data(), 3u));
+    }
+    CHECK(map.isOccupied(from.data()) == (expected == 0.0));
+    const auto fraction = map.findFirstOccupied(from.data(), to.data());
+    if (std::isinf(expected)) {
+      CHECK(std::isinf(fraction));
+    } else {
+      CHECK(fraction == doctest::Approx(expected).epsilon(1e-9));
+      ++numHits;
+    }
+  }
+  // Make sure the test exercises both outcomes.
+  CHECK(numHits > 100u);
+  CHECK(numHits < 1900u);
+}
+
+TEST_CASE("Rectangle grids") {
+  // The car is a rectangle with a half length of 0.4 and a half width of 0.2.
+  const double halfLength = 0.4;
+  const double halfWidth = 0.2;
+  ompl::RNG rng(42u);
+  for (const std::size_t numRectangles : {1u, 7u, 200u}) {
+    // Add the rectangles in two batches, which rebuilds the grid.
+    pdt::obstacles::RectangleGrid grid(2.0 * std::hypot(halfLength, halfWidth));
+    CHECK(grid.empty());
+    CHECK_FALSE(grid.intersects(0.0, 0.0, 1.0, 0.0, halfLength, halfWidth));
+    std::vector<std::array<double, 2u>> centers, widths;
+    for (auto i = 0u; i < numRectangles; ++i) {
+      centers.push_back({{rng.uniformReal(0.0, 10.0), rng.uniformReal(0.0, 10.0)}});
+      widths.push_back({{rng.uniformReal(0.1, 1.5), rng.uniformReal(0.1, 1.5)}});
+    }
+    const auto half = static_cast<long>(numRectangles / 2u);
+    grid.add({centers.begin(), centers.begin() + half}, {widths.begin(), widths.begin() + half});
+    grid.add({centers.begin() + half, centers.end()}, {widths.begin() + half, widths.end()});
+    CHECK(grid.size() == numRectangles);
+
+    // The grid agrees with a separating axis test on the corners of the rectangles, also for cars
+    // outside the grid. Cars that almost touch a rectangle are skipped, since rounding decides
+    // those.
+    std::size_t numIntersecting = 0u;
+    for (auto i = 0u; i < 5000u; ++i) {
+      const auto x = rng.uniformReal(-1.0, 11.0);
+      const auto y = rng.uniformReal(-1.0, 11.0);
+      const auto yaw = rng.uniformReal(-M_PI, M_PI);
+      const auto cosine = std::cos(yaw);
+      const auto sine = std::sin(yaw);
+      auto separation = std::numeric_limits<double>::infinity();
+      for (auto j = 0u; j < numRectangles; ++j) {
+        separation = std::min(separation, computeSeparation(x, y, cosine, sine, halfLength,
+                                                            halfWidth, centers[j], widths[j]));
+      }
+      if (std::abs(separation) < 1e-9) {
+        continue;
+      }
+      CHECK(grid.intersects(x, y, cosine, sine, halfLength, halfWidth) == (separation < 0.0));
+      numIntersecting += separation < 0.0 ? 1u : 0u;
+    }
+    CHECK(numIntersecting > 0u);
+  }
+}
+
+TEST_CASE("Rectangle grids with extents that are multiples of the cell size") {
+  const double halfLength = 0.4;
+  const double halfWidth = 0.2;
+
+  SUBCASE("Single rectangle") {
+    // The cells are as large as the rectangle, so its upper edges fall on the end of the grid.
+    pdt::obstacles::RectangleGrid grid(1.0);
+    grid.add({{{5.0, 5.0}}}, {{{10.0, 10.0}}});
+    CHECK(grid.intersects(5.0, 5.0, 1.0, 0.0, halfLength, halfWidth));
+    CHECK(grid.intersects(10.3, 10.1, 1.0, 0.0, halfLength, halfWidth));
+    CHECK(grid.intersects(-0.3, -0.1, 1.0, 0.0, halfLength, halfWidth));
+    CHECK_FALSE(grid.intersects(10.5, 5.0, 1.0, 0.0, halfLength, halfWidth));
+    CHECK_FALSE(grid.intersects(5.0, 10.3, 1.0, 0.0, halfLength, halfWidth));
+  }
+
+  SUBCASE("Checkerboard") {
+    // Unit squares on a checkerboard with unit cells, whose edges all fall on cell boundaries.
+    std::vector<std::array<double, 2u>> centers, widths;
+    for (auto row = 0u; row < 4u; ++row) {
+      for (auto column = row % 2u; column < 4u; column += 2u) {
+        centers.push_back({{column + 0.5, row + 0.5}});
+        widths.push_back({{1.0, 1.0}});
+      }
+    }
+    pdt::obstacles::RectangleGrid grid(1.0);
+    grid.add(centers, widths);
+
+    ompl::RNG rng(42u);
+    std::size_t numIntersecting = 0u;
+    for (auto i = 0u; i < 5000u; ++i) {
+      const auto x = rng.uniformReal(-1.0, 5.0);
+      const auto y = rng.uniformReal(-1.0, 5.0);
+      const auto yaw = rng.uniformReal(-M_PI, M_PI);
+      const auto cosine = std::cos(yaw);
+      const auto sine = std::sin(yaw);
+      auto separation = std::numeric_limits<double>::infinity();
+      for (auto j = 0u; j < centers.size(); ++j) {
+        separation = std::min(separation, computeSeparation(x, y, cosine, sine, halfLength,
+                                                            halfWidth, centers[j], widths[j]));
+      }
+      if (std::abs(separation) < 1e-9) {
+        continue;
+      }
+      CHECK(grid.intersects(x, y, cosine, sine, halfLength, halfWidth) == (separation < 0.0));
+      numIntersecting += separation < 0.0 ? 1u : 0u;
+    }
+    CHECK(numIntersecting > 0u);
+  }
+}
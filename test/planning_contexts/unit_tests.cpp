@@ -0,0 +1,420 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <sched.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <experimental/filesystem>
+
+#include <ompl/base/DiscreteMotionValidator.h>
+#include <ompl/base/ScopedState.h>
+#include <ompl/base/goals/GoalState.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+#include <ompl/util/Console.h>
+#include <ompl/util/RandomNumbers.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "pdt/config/configuration.h"
+#include "pdt/config/directory.h"
+#include "pdt/factories/context_factory.h"
+#include "pdt/obstacles/hyperrectangle.h"
+#include "pdt/obstacles/hyperrectangle_set.h"
+#include "pdt/planning_contexts/base_context.h"
+#include "pdt/planning_contexts/context_snapshot.h"
+#include "pdt/planning_contexts/context_validity_checker.h"
+#include "pdt/planning_contexts/context_validity_checker_bvh.h"
+#include "pdt/planning_contexts/real_vector_geometric_context.h"
+#include "pdt/utilities/thread_affinity.h"
+
+using namespace ompl::base;
+namespace fs = std::experimental::filesystem;
+
+namespace {
+
+using Hyperrectangle = pdt::obstacles::Hyperrectangle<pdt::obstacles::BaseObstacle>;
+
+// Loads the test configuration.
+std::shared_ptr<pdt::config::Configuration> loadConfig() {
+  // Instantiate an empty configuration.
+  const char* argv[] = {"test_pdt_planning_contexts\0"};
+  const int argc = sizeof(argv) / sizeof(char*) - 1;
+  auto config = std::make_shared<pdt::config::Configuration>(argc, argv);
+  config->clear();
+
+  // Load the test configuration.
+  const auto configsDir = pdt::config::Directory::SOURCE / "test/planning_contexts/configs";
+  REQUIRE(fs::exists(configsDir / "random_rectangles.json"));
+  config->load(configsDir / "random_rectangles.json");
+  return config;
+}
+
+// Samples a valid state uniformly.
+void sampleValidState(const SpaceInformationPtr& spaceInfo, const StateSamplerPtr& sampler,
+                      State* state) {
+  do {
+    sampler->sampleUniform(state);
+  } while (!spaceInfo->isValid(state));
+}
+
+// Returns the first of the given number of equidistant fractions of the motion at which it is
+// invalid, or infinity if it is valid at all of them.
+double findFirstInvalidFraction(const SpaceInformationPtr& spaceInfo, const State* from,
+                                const State* to, std::size_t numSteps) {
+  ScopedState<RealVectorStateSpace> state(spaceInfo);
+  for (std::size_t step = 0u; step <= numSteps; ++step) {
+    const auto fraction = static_cast<double>(step) / static_cast<double>(numSteps);
+    spaceInfo->getStateSpace()->interpolate(from, to, fraction, state.get());
+    if (!spaceInfo->isValid(state.get())) {
+      return fraction;
+    }
+  }
+  return std::numeric_limits<double>::infinity();
+}
+
+// Resets the generator of the seeds of all random number generators. OMPL reports an error when
+// this happens after seeds have been generated, which is intended here.
+void resetSeedGenerator() {
+  ompl::msg::setLogLevel(ompl::msg::LogLevel::LOG_NONE);
+  ompl::RNG::setSeed(42u);
+  ompl::msg::setLogLevel(ompl::msg::LogLevel::LOG_WARN);
+}
+
+// Checks that two contexts have the same queries with state goals.
+void checkEqualQueries(const pdt::planning_contexts::BaseContext& context,
+                       const pdt::planning_contexts::BaseContext& other) {
+  const auto stateSpace = context.getStateSpace();
+  REQUIRE(other.getNumQueries() == context.getNumQueries());
+  for (std::size_t n = 0u; n < context.getNumQueries(); ++n) {
+    const auto pair = context.getNthStartGoalPair(n);
+    const auto otherPair = other.getNthStartGoalPair(n);
+    REQUIRE(otherPair.start.size() == pair.start.size());
+    for (std::size_t i = 0u; i < pair.start.size(); ++i) {
+      CHECK(stateSpace->equalStates(otherPair.start[i].get(), pair.start[i].get()));
+    }
+    CHECK(stateSpace->equalStates(otherPair.goal->as<GoalState>()->getState(),
+                                  pair.goal->as<GoalState>()->getState()));
+  }
+}
+
+// A context that exposes the generation of random rectangles.
+class RectangleGenerator : public pdt::planning_contexts::RealVectorGeometricContext {
+ public:
+  using RealVectorGeometricContext::RealVectorGeometricContext;
+
+  // Returns the centers and widths of random rectangles drawn with the given seed.
+  std::vector<double> generate(std::size_t numRectangles, std::uint_fast32_t seed) {
+    hyperrectangles_.clear();
+    createRandomRectangles(numRectangles, 0.01, 0.1, seed);
+    std::vector<double> rectangles;
+    for (std::size_t i = 0u; i < hyperrectangles_.size(); ++i) {
+      rectangles.insert(rectangles.end(), hyperrectangles_.getCenter(i),
+                        hyperrectangles_.getCenter(i) + dimensionality_);
+      rectangles.insert(rectangles.end(), hyperrectangles_.getWidths(i),
+                        hyperrectangles_.getWidths(i) + dimensionality_);
+    }
+    return rectangles;
+  }
+};
+
+}  // namespace
+
+TEST_CASE("Motion validators") {
+  // Only print warnings and errors.
+  ompl::msg::setLogLevel(ompl::msg::LogLevel::LOG_WARN);
+
+  auto config = loadConfig();
+  pdt::factories::ContextFactory factory(config);
+
+  SUBCASE("Exact motion validation") {
+    for (const std::string name : {"exact2d", "exact3d"}) {
+      auto context = factory.create(name);
+      auto spaceInfo = context->getSpaceInformation();
+      auto validator = spaceInfo->getMotionValidator();
+      auto sampler = spaceInfo->allocStateSampler();
+      ScopedState<RealVectorStateSpace> from(spaceInfo), to(spaceInfo);
+
+      // A motion that is invalid at any of many fine steps is invalid, and the exact validator
+      // does not report a valid state beyond the first invalid step. The exact validator also
+      // finds collisions between the steps, but these are rare at such a fine resolution.
+      std::size_t numInvalid = 0u;
+      std::size_t numInvalidBetweenSteps = 0u;
+      const std::size_t numMotions = 300u;
+      for (std::size_t i = 0u; i < numMotions; ++i) {
+        sampleValidState(spaceInfo, sampler, from.get());
+        sampleValidState(spaceInfo, sampler, to.get());
+        const auto firstInvalid = findFirstInvalidFraction(spaceInfo, from.get(), to.get(), 10000u);
+        std::pair<State*, double> lastValid{nullptr, 0.0};
+        const auto isValid = validator->checkMotion(from.get(), to.get());
+        CHECK(validator->checkMotion(from.get(), to.get(), lastValid) == isValid);
+        if (isValid) {
+          CHECK(std::isinf(firstInvalid));
+        } else {
+          CHECK(lastValid.second <= firstInvalid);
+          ++numInvalid;
+          numInvalidBetweenSteps += std::isinf(firstInvalid) ? 1u : 0u;
+        }
+      }
+      CHECK(numInvalid > 0u);
+      CHECK(numInvalid < numMotions);
+      CHECK(numInvalidBetweenSteps <= numMotions / 100u);
+    }
+  }
+
+  SUBCASE("Bisection motion validation") {
+    // The bisection validator checks the same states as the discrete validator, only in a
+    // different order, so both agree on every motion. The resolution of the context is fine.
+    auto context = factory.create("bisection2d");
+    auto spaceInfo = context->getSpaceInformation();
+    auto validator = spaceInfo->getMotionValidator();
+    DiscreteMotionValidator discreteValidator(spaceInfo);
+    auto sampler = spaceInfo->allocStateSampler();
+    ScopedState<RealVectorStateSpace> from(spaceInfo), to(spaceInfo);
+    ScopedState<RealVectorStateSpace> lastValidState(spaceInfo), discreteLastValidState(spaceInfo);
+    std::size_t numInvalid = 0u;
+    const std::size_t numMotions = 300u;
+    for (std::size_t i = 0u; i < numMotions; ++i) {
+      sampleValidState(spaceInfo, sampler, from.get());
+      sampleValidState(spaceInfo, sampler, to.get());
+      const auto isValid = discreteValidator.checkMotion(from.get(), to.get());
+      CHECK(validator->checkMotion(from.get(), to.get()) == isValid);
+      numInvalid += isValid ? 0u : 1u;
+
+      // Both report the same last valid state.
+      std::pair<State*, double> lastValid{lastValidState.get(), 0.0};
+      std::pair<State*, double> discreteLastValid{discreteLastValidState.get(), 0.0};
+      CHECK(validator->checkMotion(from.get(), to.get(), lastValid) == isValid);
+      CHECK(discreteValidator.checkMotion(from.get(), to.get(), discreteLastValid) == isValid);
+      if (!isValid) {
+        CHECK(lastValid.second == doctest::Approx(discreteLastValid.second));
+        CHECK(spaceInfo->distance(lastValidState.get(), discreteLastValidState.get()) ==
+              doctest::Approx(0.0));
+      }
+
+      // Both check the motion at the steps of the collision checking resolution.
+      const auto numSegments = spaceInfo->getStateSpace()->validSegmentCount(from.get(), to.get());
+      const auto firstInvalid =
+          findFirstInvalidFraction(spaceInfo, from.get(), to.get(), numSegments);
+      CHECK(std::isinf(firstInvalid) == isValid);
+      if (!isValid) {
+        CHECK(lastValid.second ==
+              doctest::Approx(firstInvalid - 1.0 / static_cast<double>(numSegments)));
+      }
+    }
+    CHECK(numInvalid > 0u);
+    CHECK(numInvalid < numMotions);
+  }
+}
+
+TEST_CASE("Validity checkers") {
+  // Only print warnings and errors.
+  ompl::msg::setLogLevel(ompl::msg::LogLevel::LOG_WARN);
+
+  auto config = loadConfig();
+  pdt::factories::ContextFactory factory(config);
+  auto context = factory.create("bvh4d");
+  auto spaceInfo = context->getSpaceInformation();
+  const auto obstacles = context->getObstacles();
+
+  // Add half of the obstacles as obstacle objects and the other half as compactly stored
+  // hyperrectangles to a linear and a hierarchical validity checker.
+  std::vector<std::shared_ptr<pdt::obstacles::BaseObstacle>> obstacleObjects;
+  pdt::obstacles::HyperrectangleSet hyperrectangles(context->getDimension());
+  for (std::size_t i = 0u; i < obstacles.size(); ++i) {
+    if (i % 2u == 0u) {
+      obstacleObjects.push_back(obstacles[i]);
+    } else {
+      auto hyperrectangle = std::dynamic_pointer_cast<Hyperrectangle>(obstacles[i]);
+      REQUIRE(hyperrectangle);
+      hyperrectangles.add(hyperrectangle->getAnchorCoordinates(), hyperrectangle->getWidths());
+    }
+  }
+  std::vector<std::shared_ptr<pdt::planning_contexts::ContextValidityChecker>> checkers{
+      std::make_shared<pdt::planning_contexts::ContextValidityChecker>(spaceInfo),
+      std::make_shared<pdt::planning_contexts::ContextValidityCheckerBVH>(spaceInfo)};
+  for (const auto& checker : checkers) {
+    checker->addObstacles(obstacleObjects);
+    checker->addHyperrectangles(hyperrectangles);
+  }
+
+  // Both agree with checking every obstacle, for single states and for batches.
+  auto sampler = spaceInfo->allocStateSampler();
+  std::vector<ScopedState<RealVectorStateSpace>> states;
+  for (std::size_t i = 0u; i < 4u; ++i) {
+    states.emplace_back(spaceInfo);
+  }
+  std::vector<const State*> batch;
+  for (const auto& state : states) {
+    batch.push_back(state.get());
+  }
+  std::size_t numInvalid = 0u;
+  for (std::size_t i = 0u; i < 1000u; ++i) {
+    bool isBatchValid = true;
+    for (auto& state : states) {
+      sampler->sampleUniform(state.get());
+      bool isValid = true;
+      for (const auto& obstacle : obstacles) {
+        isValid = isValid && !obstacle->invalidates(state.get());
+      }
+      for (const auto& checker : checkers) {
+        CHECK(checker->isValid(state.get()) == isValid);
+      }
+      CHECK(spaceInfo->isValid(state.get()) == isValid);
+      isBatchValid = isBatchValid && isValid;
+      numInvalid += isValid ? 0u : 1u;
+    }
+    for (const auto& checker : checkers) {
+      CHECK(checker->isValid(batch.data(), batch.size()) == isBatchValid);
+    }
+  }
+  CHECK(numInvalid > 0u);
+}
+
+TEST_CASE("Context snapshots") {
+  // Only print warnings and errors.
+  ompl::msg::setLogLevel(ompl::msg::LogLevel::LOG_WARN);
+
+  // Both contexts share a snapshot in a temporary directory.
+  auto config = loadConfig();
+  const auto directory = fs::temp_directory_path() / "test_pdt_planning_contexts_snapshots";
+  fs::remove_all(directory);
+  fs::create_directories(directory);
+  const auto path = directory / "snapshot.bin";
+  config->add<std::string>("context/snapshot2d/snapshot", path.string());
+  config->add<std::string>("context/snapshot2dChanged/snapshot", path.string());
+  pdt::factories::ContextFactory factory(config);
+  const auto hash = pdt::planning_contexts::context_snapshot::computeConfigHash(*config,
+                                                                                "snapshot2d");
+
+  // Creating the context writes its snapshot.
+  auto generated = factory.create("snapshot2d");
+  REQUIRE(fs::exists(path));
+  {
+    pdt::planning_contexts::context_snapshot::Reader snapshot(path);
+    CHECK(snapshot.getConfigHash() == hash);
+    CHECK(snapshot.getNumObstacles() == 30u);
+    CHECK(snapshot.getNumQueries() == generated->getNumQueries());
+  }
+
+  SUBCASE("Round trip") {
+    // Creating the context again restores the same obstacles and queries from the snapshot.
+    auto restored = factory.create("snapshot2d");
+    const auto generatedObstacles = generated->getObstacles();
+    const auto restoredObstacles = restored->getObstacles();
+    REQUIRE(restoredObstacles.size() == generatedObstacles.size());
+    for (std::size_t i = 0u; i < generatedObstacles.size(); ++i) {
+      auto generatedObstacle = std::dynamic_pointer_cast<Hyperrectangle>(generatedObstacles[i]);
+      auto restoredObstacle = std::dynamic_pointer_cast<Hyperrectangle>(restoredObstacles[i]);
+      REQUIRE(generatedObstacle);
+      REQUIRE(restoredObstacle);
+      CHECK(restoredObstacle->getAnchorCoordinates() == generatedObstacle->getAnchorCoordinates());
+      CHECK(restoredObstacle->getWidths() == generatedObstacle->getWidths());
+    }
+    CHECK(restored->getAntiObstacles().size() == generated->getAntiObstacles().size());
+
+    checkEqualQueries(*generated, *restored);
+
+    // The restored context validates states like the generated one.
+    auto sampler = generated->getSpaceInformation()->allocStateSampler();
+    ScopedState<RealVectorStateSpace> state(generated->getSpaceInformation());
+    for (std::size_t i = 0u; i < 1000u; ++i) {
+      sampler->sampleUniform(state.get());
+      CHECK(restored->getSpaceInformation()->isValid(state.get()) ==
+            generated->getSpaceInformation()->isValid(state.get()));
+    }
+  }
+
+  SUBCASE("Regenerated queries") {
+    // A restored context draws the same random numbers as a generated one, so both regenerate the
+    // same queries.
+    config->add<std::string>("context/snapshot2dMultiquery/snapshot", path.string());
+    resetSeedGenerator();
+    auto generatedMultiquery = factory.create("snapshot2dMultiquery");
+    resetSeedGenerator();
+    auto restoredMultiquery = factory.create("snapshot2dMultiquery");
+    checkEqualQueries(*generatedMultiquery, *restoredMultiquery);
+    generatedMultiquery->regenerateQueries();
+    restoredMultiquery->regenerateQueries();
+    checkEqualQueries(*generatedMultiquery, *restoredMultiquery);
+  }
+
+  SUBCASE("Invalidation") {
+    // A snapshot of a different configuration is stale and is replaced by a new one.
+    const auto changedHash = pdt::planning_contexts::context_snapshot::computeConfigHash(
+        *config, "snapshot2dChanged");
+    CHECK(changedHash != hash);
+    auto changed = factory.create("snapshot2dChanged");
+    CHECK(changed->getObstacles().size() == 40u);
+    pdt::planning_contexts::context_snapshot::Reader snapshot(path);
+    CHECK(snapshot.getConfigHash() == changedHash);
+    CHECK(snapshot.getNumObstacles() == 40u);
+  }
+
+  fs::remove_all(directory);
+}
+
+TEST_CASE("Random rectangles") {
+  // Only print warnings and errors.
+  ompl::msg::setLogLevel(ompl::msg::LogLevel::LOG_WARN);
+
+  // Generate rectangles in a context without start and goal states.
+  auto config = loadConfig();
+  auto stateSpace = std::make_shared<RealVectorStateSpace>(3u);
+  stateSpace->setBounds(-0.5, 0.5);
+  auto spaceInfo = std::make_shared<SpaceInformation>(stateSpace);
+  RectangleGenerator generator(spaceInfo, config, "generator3d");
+  const std::size_t numRectangles = 3000u;
+  const auto rectangles = generator.generate(numRectangles, 42u);
+  REQUIRE(rectangles.size() == 2u * 3u * numRectangles);
+  CHECK(generator.generate(numRectangles, 42u) == rectangles);
+  CHECK(generator.generate(numRectangles, 43u) != rectangles);
+
+  // The rectangles do not depend on the number of cores they are drawn on.
+  cpu_set_t affinity;
+  CPU_ZERO(&affinity);
+  REQUIRE(sched_getaffinity(0, sizeof(cpu_set_t), &affinity) == 0);
+  REQUIRE(pdt::utilities::pinCurrentThreadToCore(0u));
+  CHECK(pdt::utilities::getNumAvailableCores() == 1u);
+  const auto singleCoreRectangles = generator.generate(numRectangles, 42u);
+  REQUIRE(sched_setaffinity(0, sizeof(cpu_set_t), &affinity) == 0);
+  CHECK(singleCoreRectangles == rectangles);
+}
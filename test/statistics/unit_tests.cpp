@@ -0,0 +1,79 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014--2022
+ *  Estimation, Search, and Planning (ESP) Research Group
+ *  All rights reserved
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the names of the organizations nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "pdt/statistics/rank_sum_test.h"
+
+using pdt::statistics::computeRankSumPValue;
+
+TEST_CASE("Rank-sum test") {
+  // The expected p-values are the ones of the normal approximation of the one-sided Mann-Whitney U
+  // test with tie and continuity corrections.
+  SUBCASE("Separated samples") {
+    CHECK(computeRankSumPValue({1.0, 2.0, 3.0, 4.0, 5.0}, {6.0, 7.0, 8.0, 9.0, 10.0}) ==
+          doctest::Approx(0.006092890177672409));
+    CHECK(computeRankSumPValue({6.0, 7.0, 8.0, 9.0, 10.0}, {1.0, 2.0, 3.0, 4.0, 5.0}) ==
+          doctest::Approx(0.9966923245172357));
+  }
+
+  SUBCASE("Identical samples") {
+    CHECK(computeRankSumPValue({1.0, 2.0, 3.0, 4.0, 5.0}, {1.0, 2.0, 3.0, 4.0, 5.0}) ==
+          doctest::Approx(0.5422350133116141));
+  }
+
+  SUBCASE("Samples of different sizes") {
+    CHECK(computeRankSumPValue({0.80, 0.83, 1.89, 1.04, 1.45, 1.38, 1.91, 1.64, 0.73, 1.46},
+                               {1.15, 0.88, 0.90, 0.74, 1.21}) ==
+          doctest::Approx(0.9007753482039937));
+  }
+
+  SUBCASE("Ties of unsuccessful runs") {
+    const auto infinity = std::numeric_limits<double>::infinity();
+    CHECK(computeRankSumPValue({1.0, 2.0, infinity, infinity, 3.0},
+                               {2.0, infinity, infinity, infinity, infinity}) ==
+          doctest::Approx(0.14386286962918235));
+    CHECK(computeRankSumPValue({infinity, infinity, infinity}, {infinity, infinity}) == 1.0);
+  }
+
+  SUBCASE("Empty samples") {
+    CHECK_THROWS_AS(computeRankSumPValue({}, {1.0}), std::invalid_argument);
+    CHECK_THROWS_AS(computeRankSumPValue({1.0}, {}), std::invalid_argument);
+  }
+}